@@ -50,6 +50,17 @@ class ClientMainloop : boost::noncopyable {
             m_ctx.update();
         }
     }
+    /// @brief Like mainloop(), but if there's no data, blocks (holding the
+    /// mutex) until some arrives or maxWaitMicroseconds elapses.
+    /// @return false if the mutex was held elsewhere, so nothing was done.
+    bool mainloopBlocking(uint32_t maxWaitMicroseconds) {
+        lock_type lock(m_mutex, boost::try_to_lock);
+        if (!lock) {
+            return false;
+        }
+        m_ctx.updateBlocking(maxWaitMicroseconds);
+        return true;
+    }
     mutex_type &getMutex() { return m_mutex; }
 
   private:
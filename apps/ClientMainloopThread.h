@@ -38,13 +38,26 @@
 
 static const auto SLEEP_TIME = boost::posix_time::milliseconds(1);
 
+/// Longest each loop blocks waiting for data in MainloopMode::WaitForData:
+/// also bounds how long taking the mutex or stopping the thread can take.
+static const uint32_t MAX_WAIT_MICROSECONDS = 10000;
+
+enum class MainloopMode {
+    /// Update, then sleep for SLEEP_TIME, whether or not anything arrived.
+    Sleep,
+    /// Block until data arrives (or MAX_WAIT_MICROSECONDS elapses), then
+    /// update: lower latency, and no repeated wakeups when idle.
+    WaitForData
+};
+
 class ClientMainloopThread : boost::noncopyable {
   public:
     typedef ClientMainloop::mutex_type mutex_type;
     typedef ClientMainloop::lock_type lock_type;
     ClientMainloopThread(osvr::clientkit::ClientContext &ctx,
-                         bool startNow = false)
-        : m_run(false), m_started(false), m_mainloop(ctx) {
+                         bool startNow = false,
+                         MainloopMode mode = MainloopMode::Sleep)
+        : m_run(false), m_started(false), m_mode(mode), m_mainloop(ctx) {
         if (startNow) {
             start();
         }
@@ -64,7 +77,14 @@ class ClientMainloopThread : boost::noncopyable {
     }
 
     void oneLoop() {
-        m_mainloop.mainloop();
+        if (m_mode == MainloopMode::WaitForData) {
+            if (m_mainloop.mainloopBlocking(MAX_WAIT_MICROSECONDS)) {
+                return;
+            }
+            // Someone else has the mutex: don't spin waiting for them.
+        } else {
+            m_mainloop.mainloop();
+        }
         boost::this_thread::sleep(SLEEP_TIME);
     }
 
@@ -86,6 +106,7 @@ class ClientMainloopThread : boost::noncopyable {
   private:
     volatile bool m_run;
     bool m_started;
+    MainloopMode m_mode;
     ClientMainloop m_mainloop;
     boost::thread m_thread;
 };
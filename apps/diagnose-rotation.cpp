@@ -146,7 +146,7 @@ int main(int argc, char *argv[]) {
     osvr::clientkit::Interface iface = ctx.getInterface(dest);
     {
 
-        ClientMainloopThread client(ctx);
+        ClientMainloopThread client(ctx, false, MainloopMode::WaitForData);
 
         std::string origRouteString;
         if (resetTransform) {
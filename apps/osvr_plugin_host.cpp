@@ -0,0 +1,44 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Server/RunPluginHost.h>
+#include <osvr/Util/Logger.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        auto log = ::osvr::util::log::make_logger("OSVR Plugin Host");
+        log->error() << "This is started by osvr_server as needed - it is not "
+                        "meant to be run directly.";
+        return -1;
+    }
+    return osvr::server::runPluginHost(argv[1]);
+}
@@ -0,0 +1,167 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/BaseDevice.h>
+#include <osvr/Common/CreateDevice.h>
+#include <osvr/Common/SystemComponent.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/program_options.hpp>
+#include <json/value.h>
+#include <vrpn_Connection.h>
+#include <vrpn_ConnectionPtr.h>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// Prints one row of the summary table.
+static void printRow(std::string const &name, Json::Value const &stats,
+                     Json::Value const &buckets, bool histogram) {
+    std::cout << std::left << std::setw(40) << name << std::right
+              << std::setw(10) << stats["updates"].asUInt64() << std::fixed
+              << std::setprecision(1) << std::setw(10)
+              << stats["meanUs"].asDouble() << std::setw(10)
+              << stats["maxUs"].asDouble() << std::setw(8)
+              << stats["slowUpdates"].asUInt64() << std::setw(10)
+              << stats["messages"].asUInt64() << std::setw(12)
+              << stats["bytes"].asUInt64() << "\n";
+    if (!histogram) {
+        return;
+    }
+    auto const &counts = stats["histogram"];
+    for (Json::ArrayIndex i = 0; i < counts.size(); ++i) {
+        auto count = counts[i].asUInt64();
+        if (count == 0) {
+            continue;
+        }
+        std::cout << "    < " << std::setw(9) << buckets[i].asUInt64()
+                  << "us: " << count << "\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::string host;
+    int timeoutMs;
+    namespace po = boost::program_options;
+    // clang-format off
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h", "produce help message")
+        ("host", po::value<std::string>(&host)->default_value("localhost"), "Host running the OSVR server")
+        ("timeout", po::value<int>(&timeoutMs)->default_value(5000), "Milliseconds to wait for a reply")
+        ("json", "Output the raw JSON reply instead of a table")
+        ("histogram", "Show the update duration histogram of each device")
+        ;
+    // clang-format on
+    po::variables_map vm;
+    bool usage = false;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    } catch (std::exception &e) {
+        std::cerr << "\nError parsing command line: " << e.what() << "\n\n";
+        usage = true;
+    }
+    if (usage || vm.count("help")) {
+        std::cerr << "\nRequests and prints the per-device update timing and "
+                     "traffic statistics kept\nby a running OSVR server.\n";
+        std::cerr << "Usage: " << argv[0] << " [options]\n\n";
+        std::cerr << desc << "\n";
+        return 1;
+    }
+
+    auto sysDeviceName =
+        std::string(osvr::common::SystemComponent::deviceName()) + "@" + host;
+    vrpn_ConnectionPtr conn(vrpn_get_connection_by_name(
+        sysDeviceName.c_str(), nullptr, nullptr, nullptr, nullptr, nullptr,
+        true));
+    conn->removeReference(); // Remove extra reference.
+    auto device = osvr::common::createClientDevice(sysDeviceName, conn);
+    auto sys =
+        device->addComponent(osvr::common::SystemComponent::create());
+
+    Json::Value reply;
+    bool gotReply = false;
+    sys->registerDeviceStatsHandler(
+        [&](Json::Value const &stats, osvr::util::time::TimeValue const &) {
+            reply = stats;
+            gotReply = true;
+        });
+
+    using clock = std::chrono::steady_clock;
+    auto deadline = clock::now() + std::chrono::milliseconds(timeoutMs);
+    bool requested = false;
+    while (!gotReply && clock::now() < deadline) {
+        device->update();
+        if (!requested && conn->connected()) {
+            sys->sendDeviceStatsRequest();
+            requested = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!gotReply) {
+        std::cerr << "No reply from the server at " << host
+                  << (requested ? "" : " (could not connect)") << "\n";
+        return 1;
+    }
+
+    if (vm.count("json")) {
+        std::cout << reply.toStyledString() << std::endl;
+        return 0;
+    }
+
+    /// Sort devices by total time spent updating, most first.
+    auto const &devices = reply["devices"];
+    std::vector<std::pair<double, std::string> > order;
+    for (auto const &name : devices.getMemberNames()) {
+        order.emplace_back(devices[name]["totalUs"].asDouble(), name);
+    }
+    std::sort(order.rbegin(), order.rend());
+
+    auto histogram = vm.count("histogram") != 0;
+    auto const &buckets = reply["histogramBucketsUs"];
+    std::cout << std::left << std::setw(40) << "Device" << std::right
+              << std::setw(10) << "Updates" << std::setw(10) << "Mean us"
+              << std::setw(10) << "Max us" << std::setw(8) << "Slow"
+              << std::setw(10) << "Messages" << std::setw(12) << "Bytes"
+              << "\n";
+    printRow("(message dispatch)", reply["dispatch"], buckets, histogram);
+    for (auto const &entry : order) {
+        printRow(entry.second, devices[entry.second], buckets, histogram);
+    }
+    std::cout << "\nUpdates taking longer than "
+              << reply["slowThresholdUs"].asDouble()
+              << "us are counted as slow.\n";
+    return 0;
+}
@@ -120,7 +120,7 @@ int main(int argc, char *argv[]) {
     // are looking for.
     osvr::clientkit::Interface iface = ctx.getInterface(path);
     {
-        ClientMainloopThread client(ctx);
+        ClientMainloopThread client(ctx, false, MainloopMode::WaitForData);
 
         cout << "Running client mainloop briefly to start up..." << endl;
         client.loopForDuration(boost::chrono::seconds(2));
@@ -0,0 +1,111 @@
+/** @file
+    @brief Implementation of a rough benchmark of the overhead of the
+   per-device update timing in ConnectionDevice::process(), over a mainloop
+   of many small devices.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Connection/DeviceUpdateStats.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using osvr::connection::ConnectionDevice;
+using std::chrono::nanoseconds;
+
+static const int NUM_DEVICES = 50;
+/// Busy-work iterations per update: a few microseconds.
+static const int WORK = 500;
+static const int LOOPS = 2000;
+static const int TRIALS = 5;
+
+/// Device whose update does a fixed amount of busy work.
+class DummyDevice : public ConnectionDevice {
+  public:
+    DummyDevice(std::string const &name) : ConnectionDevice(name) {}
+
+    void doWork() {
+        for (int i = 0; i < WORK; ++i) {
+            m_sink = m_sink * 31 + i;
+        }
+    }
+
+  protected:
+    void m_process() override { doWork(); }
+    void m_sendData(osvr::util::time::TimeValue const &,
+                    osvr::connection::MessageType *, const char *,
+                    size_t) override {}
+
+  private:
+    volatile unsigned m_sink = 0;
+};
+
+int main() {
+    std::vector<std::unique_ptr<DummyDevice> > devices;
+    for (int i = 0; i < NUM_DEVICES; ++i) {
+        devices.emplace_back(
+            new DummyDevice("com_osvr_Test/Dummy" + std::to_string(i)));
+    }
+    typedef std::chrono::steady_clock clock;
+    auto bestUntimed = nanoseconds::max();
+    auto bestTimed = nanoseconds::max();
+    for (int trial = 0; trial < TRIALS; ++trial) {
+        auto begin = clock::now();
+        for (int loop = 0; loop < LOOPS; ++loop) {
+            for (auto &dev : devices) {
+                dev->doWork();
+            }
+        }
+        bestUntimed = std::min(bestUntimed, std::chrono::duration_cast<
+                                                nanoseconds>(clock::now() -
+                                                             begin));
+        begin = clock::now();
+        for (int loop = 0; loop < LOOPS; ++loop) {
+            for (auto &dev : devices) {
+                dev->process();
+            }
+        }
+        bestTimed = std::min(bestTimed, std::chrono::duration_cast<
+                                            nanoseconds>(clock::now() - begin));
+    }
+    const double updates = double(NUM_DEVICES) * LOOPS;
+    auto perUpdateUntimed = bestUntimed.count() / updates;
+    auto perUpdateTimed = bestTimed.count() / updates;
+    auto overheadNs = perUpdateTimed - perUpdateUntimed;
+    std::cout << NUM_DEVICES << " devices, best of " << TRIALS
+              << " trials of " << LOOPS << " loops:\n"
+              << "Mean update: " << perUpdateUntimed << "ns untimed, "
+              << perUpdateTimed << "ns timed (overhead " << overheadNs
+              << "ns, " << 100. * overheadNs / perUpdateUntimed << "%)"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,107 @@
+/** @file
+    @brief Implementation of a rough benchmark of consumer read throughput
+   from an IPCRingBuffer, comparing normal pages with large pages.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using osvr::common::IPCRingBuffer;
+
+/// 1920x1080 RGB frame
+static const uint32_t FRAME_SIZE = 1920 * 1080 * 3;
+static const int FRAMES = 2000;
+
+/// Each trial uses its own segment name, so no trial can end up mapping a
+/// segment left over from another one with different options.
+static void runTrial(const char *label, const char *name, bool largePages,
+                     bool prefault) {
+    auto opts = IPCRingBuffer::Options(name)
+                    .setEntrySize(FRAME_SIZE)
+                    .setLargePages(largePages)
+                    .setPrefault(prefault);
+    auto producer = IPCRingBuffer::create(opts);
+    if (!producer) {
+        std::cout << label << ": couldn't create the ring buffer." << std::endl;
+        return;
+    }
+    auto consumer = IPCRingBuffer::find(opts);
+    if (!consumer) {
+        std::cout << label << ": couldn't open the ring buffer." << std::endl;
+        return;
+    }
+
+    std::vector<IPCRingBuffer::value_type> frame(FRAME_SIZE);
+    std::iota(begin(frame), end(frame), IPCRingBuffer::value_type(0));
+
+    using clock = std::chrono::steady_clock;
+    clock::duration readTime{};
+    uint64_t checksum = 0;
+    for (int i = 0; i < FRAMES; ++i) {
+        producer->put(frame.data(), frame.size());
+
+        auto start = clock::now();
+        {
+            auto proxy = consumer->getLatest();
+            if (!proxy) {
+                std::cout << label << ": failed to read frame " << i
+                          << std::endl;
+                return;
+            }
+            // Read every 64th byte - one per cache line - so the cost is
+            // dominated by page walks rather than arithmetic.
+            auto data = proxy.get();
+            for (uint32_t offset = 0; offset < FRAME_SIZE; offset += 64) {
+                checksum += data[offset];
+            }
+        }
+        readTime += clock::now() - start;
+    }
+
+    auto seconds = std::chrono::duration<double>(readTime).count();
+    auto megabytes = double(FRAME_SIZE) * FRAMES / (1024. * 1024.);
+    std::cout << label << ": " << megabytes / seconds
+              << " MiB/s consumer read throughput (checksum " << checksum
+              << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "Reading " << FRAMES << " frames of " << FRAME_SIZE
+              << " bytes each." << std::endl;
+    runTrial("Normal pages           ", "ThroughputNormal", false, false);
+    runTrial("Normal pages, prefault ", "ThroughputPrefault", false, true);
+    runTrial("Large pages            ", "ThroughputLarge", true, false);
+    runTrial("Large pages, prefault  ", "ThroughputLargePrefault", true,
+             true);
+    return 0;
+}
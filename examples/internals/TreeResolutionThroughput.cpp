@@ -0,0 +1,133 @@
+/** @file
+    @brief Implementation of a rough benchmark of resolving many aliased paths
+   after a tree update, with and without a TreeResolutionCache.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/TreeResolutionCache.h>
+
+// Library/third-party includes
+#include <json/value.h>
+
+// Standard includes
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace common = osvr::common;
+namespace elements = osvr::common::elements;
+
+static const int DEVICES = 50;
+static const int SENSORS = 10;
+static const int ALIASES = 500;
+static const int REPETITIONS = 20;
+
+static std::string getAliasPath(int i) {
+    return "/me/alias" + std::to_string(i);
+}
+
+/// Populates a tree with devices and transformed aliases to their sensors.
+static void buildTree(common::PathTree &tree) {
+    tree.reset();
+    for (int dev = 0; dev < DEVICES; ++dev) {
+        auto device = "com_osvr_Example/Device" + std::to_string(dev);
+        tree.getNodeByPath("/" + device)
+            .value() = elements::DeviceElement::createVRPNDeviceElement(
+            device, "localhost:3883");
+        tree.getNodeByPath("/" + device + "/tracker").value() =
+            elements::InterfaceElement();
+    }
+    for (int i = 0; i < ALIASES; ++i) {
+        Json::Value alias(Json::objectValue);
+        alias["rotate"]["axis"] = "y";
+        alias["rotate"]["degrees"] = i % 360;
+        alias["child"] = "/com_osvr_Example/Device" +
+                         std::to_string(i % DEVICES) + "/tracker/" +
+                         std::to_string(i % SENSORS);
+        tree.getNodeByPath(getAliasPath(i)).value() =
+            elements::AliasElement(alias.toStyledString());
+    }
+}
+
+/// Resolves every alias, returning the average time per pass in
+/// microseconds.
+template <typename F> static double timeResolution(F &&resolve) {
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+    std::size_t resolved = 0;
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        for (int i = 0; i < ALIASES; ++i) {
+            if (resolve(getAliasPath(i))) {
+                ++resolved;
+            }
+        }
+    }
+    auto elapsed = clock::now() - start;
+    if (resolved != std::size_t(ALIASES) * REPETITIONS) {
+        std::cout << "Warning: only resolved " << resolved << " paths!"
+                  << std::endl;
+    }
+    return std::chrono::duration<double, std::micro>(elapsed).count() /
+           REPETITIONS;
+}
+
+int main() {
+    common::PathTree tree;
+    buildTree(tree);
+
+    auto uncached = timeResolution([&](std::string const &path) {
+        return common::resolveTreeNode(tree, path).is_initialized();
+    });
+
+    common::TreeResolutionCache cache;
+    for (int i = 0; i < ALIASES; ++i) {
+        common::resolveTreeNode(tree, getAliasPath(i), cache);
+    }
+    // A single unrelated change.
+    tree.getNodeByPath("/me/unrelated").value() =
+        elements::AliasElement("/com_osvr_Example/Device0/tracker/0");
+    auto cachedUnrelated = timeResolution([&](std::string const &path) {
+        return common::resolveTreeNode(tree, path, cache).is_initialized();
+    });
+
+    // Replacing the whole tree with an identical one, as the client does.
+    buildTree(tree);
+    auto cachedReplaced = timeResolution([&](std::string const &path) {
+        return common::resolveTreeNode(tree, path, cache).is_initialized();
+    });
+
+    std::cout << "Resolving " << ALIASES << " aliased paths:\n"
+              << "  uncached:                         " << uncached
+              << " us\n"
+              << "  cached, after an unrelated change: " << cachedUnrelated
+              << " us\n"
+              << "  cached, after tree replacement:    " << cachedReplaced
+              << " us\n"
+              << "  (" << cache.getHits() << " hits, " << cache.getMisses()
+              << " misses)" << std::endl;
+    return 0;
+}
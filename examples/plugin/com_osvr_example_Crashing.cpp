@@ -0,0 +1,127 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/PluginKit/PluginKit.h>
+#include <osvr/PluginKit/AnalogInterfaceC.h>
+
+// Generated JSON header file
+#include "com_osvr_example_Crashing_json.h"
+
+// Library/third-party includes
+#include <json/value.h>
+#include <json/reader.h>
+
+// Standard includes
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+// Anonymous namespace to avoid symbol collision
+namespace {
+
+/// A device that reports its uptime, then deliberately crashes (or hangs),
+/// for trying out out-of-process plugin hosting: see
+/// osvr_server_config.PluginHost.sample.json
+class CrashingDevice {
+  public:
+    typedef std::chrono::steady_clock clock;
+    CrashingDevice(OSVR_PluginRegContext ctx, double failAfter, bool hang)
+        : m_start(clock::now()), m_failAfter(failAfter), m_hang(hang) {
+        /// Create the initialization options
+        OSVR_DeviceInitOptions opts = osvrDeviceCreateInitOptions(ctx);
+
+        /// Indicate that we'll want 1 analog channel.
+        osvrDeviceAnalogConfigure(opts, &m_analog, 1);
+
+        /// Create the sync device token with the options
+        m_dev.initSync(ctx, "CrashingDevice", opts);
+
+        /// Send JSON descriptor
+        m_dev.sendJsonDescriptor(com_osvr_example_Crashing_json);
+
+        /// Register update callback
+        m_dev.registerUpdateCallback(this);
+    }
+
+    OSVR_ReturnCode update() {
+        std::chrono::duration<double> uptime = clock::now() - m_start;
+        if (uptime.count() > m_failAfter) {
+            if (m_hang) {
+                std::cerr << "CrashingDevice: hanging now!" << std::endl;
+                for (;;) {
+                    std::this_thread::sleep_for(std::chrono::seconds(1));
+                }
+            }
+            std::cerr << "CrashingDevice: crashing now!" << std::endl;
+            std::abort();
+        }
+
+        /// Report the uptime on channel 0
+        osvrDeviceAnalogSetValue(m_dev, m_analog, uptime.count(), 0);
+        return OSVR_RETURN_SUCCESS;
+    }
+
+  private:
+    osvr::pluginkit::DeviceToken m_dev;
+    OSVR_AnalogDeviceInterface m_analog;
+    clock::time_point m_start;
+    double m_failAfter;
+    bool m_hang;
+};
+
+class CrashingDeviceConstructor {
+  public:
+    OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx, const char *params) {
+        Json::Value root;
+        if (params) {
+            Json::Reader r;
+            if (!r.parse(params, root)) {
+                std::cerr << "Could not parse parameters!" << std::endl;
+            }
+        }
+
+        /// Seconds to run normally before failing.
+        double failAfter = root.get("failAfter", 5.0).asDouble();
+        /// Hang (stop returning from update) instead of crashing.
+        bool hang = root.get("hang", false).asBool();
+
+        osvr::pluginkit::registerObjectForDeletion(
+            ctx, new CrashingDevice(ctx, failAfter, hang));
+
+        return OSVR_RETURN_SUCCESS;
+    }
+};
+} // namespace
+
+OSVR_PLUGIN(com_osvr_example_Crashing) {
+
+    /// Tell the core we're available to create a device object.
+    osvr::pluginkit::registerDriverInstantiationCallback(
+        ctx, "CrashingDevice", new CrashingDeviceConstructor);
+
+    return OSVR_RETURN_SUCCESS;
+}
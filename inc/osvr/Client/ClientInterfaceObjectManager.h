@@ -32,6 +32,7 @@
 #include <osvr/Util/Logger.h>
 #include <osvr/Common/PathTree_fwd.h>
 #include <osvr/Common/ClientContext_fwd.h>
+#include <osvr/Common/TreeResolutionCache.h>
 #include <osvr/Client/InterfaceTree.h>
 
 // Library/third-party includes
@@ -110,6 +111,11 @@ namespace client {
         /// common::PathTreeOwner events.
         common::PathTreeObserverPtr m_treeObserver;
 
+        /// @brief Resolution results from previous trees, so that paths whose
+        /// aliases and devices are unchanged by a tree update needn't be
+        /// resolved from scratch.
+        common::TreeResolutionCache m_resolutionCache;
+
         /// @brief Factory for producing remote handlers
         RemoteHandlerFactory &m_factory;
 
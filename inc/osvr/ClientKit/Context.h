@@ -58,6 +58,22 @@ namespace clientkit {
         }
     }
 
+    inline void ClientContext::updateBlocking(uint32_t maxWaitMicroseconds) {
+        OSVR_ReturnCode ret =
+            osvrClientUpdateBlocking(m_context, maxWaitMicroseconds);
+        if (OSVR_RETURN_SUCCESS != ret) {
+            throw std::runtime_error("Error updating context.");
+        }
+    }
+
+    inline void ClientContext::updateWithBudget(uint32_t maxMicroseconds) {
+        OSVR_ReturnCode ret =
+            osvrClientUpdateWithBudget(m_context, maxMicroseconds);
+        if (OSVR_RETURN_SUCCESS != ret) {
+            throw std::runtime_error("Error updating context.");
+        }
+    }
+
     inline Interface ClientContext::getInterface(const std::string &path) {
         OSVR_ClientInterface iface = NULL;
         OSVR_ReturnCode ret =
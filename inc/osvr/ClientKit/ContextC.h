@@ -69,6 +69,37 @@ OSVR_CLIENTKIT_EXPORT OSVR_ClientContext osvrClientInit(
 */
 OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode osvrClientUpdate(OSVR_ClientContext ctx);
 
+/** @brief Like osvrClientUpdate(), but if no data is waiting, first blocks
+    until some arrives or the given time elapses.
+
+    Intended for a dedicated client thread, in place of calling
+    osvrClientUpdate() and sleeping: it returns as soon as there is data, and
+    doesn't repeatedly wake when there is none.
+
+    @param ctx Client context
+    @param maxWaitMicroseconds Longest time to wait for data.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientUpdateBlocking(OSVR_ClientContext ctx, uint32_t maxWaitMicroseconds);
+
+/** @brief Like osvrClientUpdate(), but stops delivering callbacks once the
+    given time has been spent, so a burst of incoming data can't cause a hitch
+    in the calling thread.
+
+    Reports that arrive after the time is up still update interface state
+    right away, but their callbacks are deferred to the next update call, with
+    only the newest report of each type and sensor per interface kept. Button
+    and eye tracker blink reports are never dropped this way: all of them are
+    deferred, in order. (Imaging reports are never deferred.) Deferred
+    callbacks are delivered first thing in the next update call, before any
+    new data is taken in.
+
+    @param ctx Client context
+    @param maxMicroseconds Time after which no more callbacks are delivered.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientUpdateWithBudget(OSVR_ClientContext ctx, uint32_t maxMicroseconds);
+
 /** @brief Checks to see if the client context is fully started up and connected
     properly to a server.
 
@@ -73,6 +73,16 @@ namespace clientkit {
         /// mainloop.
         void update();
 
+        /// @brief Updates the state of the context, first waiting (up to
+        /// maxWaitMicroseconds) for data to arrive if there is none - for use
+        /// in a dedicated thread instead of update() and a sleep.
+        void updateBlocking(uint32_t maxWaitMicroseconds);
+
+        /// @brief Updates the state of the context, but defers callbacks that
+        /// would run after maxMicroseconds have passed to the next update -
+        /// for use in a render loop that can't afford a hitch.
+        void updateWithBudget(uint32_t maxMicroseconds);
+
         /// @brief Get the interface associated with the given path.
         /// @param path A resource path.
         /// @returns The interface object.
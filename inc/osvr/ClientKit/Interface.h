@@ -63,6 +63,14 @@ namespace clientkit {
         m_interface = NULL;
     }
 
+    inline void Interface::setChangeFilter(double analogDeadband) {
+        osvrClientSetInterfaceChangeFilter(m_interface, analogDeadband);
+    }
+
+    inline void Interface::clearChangeFilter() {
+        osvrClientClearInterfaceChangeFilter(m_interface);
+    }
+
     inline void
     Interface::takeOwnership(util::boost_util::DeletablePtr const &obj) {
         m_deletables.push_back(obj);
@@ -69,6 +69,38 @@ osvrClientGetInterface(OSVR_ClientContext ctx, const char path[],
 OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
 osvrClientFreeInterface(OSVR_ClientContext ctx, OSVR_ClientInterface iface);
 
+/** @brief Only let analog and button reports through to an interface (its
+    state and callbacks) when they change the value last delivered for their
+    channel.
+
+    Useful for devices with many channels that report all of them in every
+    update, such as gamepads: callbacks then fire for the channels that
+    changed rather than for all of them. State queries return the value (and
+    timestamp) of the last delivered report.
+
+    Other report types are not affected. Off by default.
+
+    @param iface The interface object
+    @param analogDeadband Analog reports are suppressed unless they differ
+   from the last delivered value for their channel by more than this: 0 means
+   exact equality.
+
+    @returns OSVR_RETURN_FAILURE if given a null interface.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientSetInterfaceChangeFilter(OSVR_ClientInterface iface,
+                                   double analogDeadband);
+
+/** @brief Turn off the filter set by osvrClientSetInterfaceChangeFilter(), so
+    all reports are delivered again.
+
+    @param iface The interface object
+
+    @returns OSVR_RETURN_FAILURE if given a null interface.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientClearInterfaceChangeFilter(OSVR_ClientInterface iface);
+
 /** @} */
 OSVR_EXTERN_C_END
 
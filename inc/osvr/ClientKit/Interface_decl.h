@@ -92,6 +92,15 @@ namespace clientkit {
         /// @throws std::logic_error if the interface is null or already freed.
         void free();
 
+        /// @brief Only deliver analog and button reports that change their
+        /// channel's value.
+        ///
+        /// @sa osvrClientSetInterfaceChangeFilter()
+        void setChangeFilter(double analogDeadband = 0);
+
+        /// @brief Deliver all reports again.
+        void clearChangeFilter();
+
         /// @brief Take (shared) ownership of some Deletable object.
         void takeOwnership(util::boost_util::DeletablePtr const &obj);
 
@@ -34,6 +34,9 @@
 #include <osvr/Common/MessageRegistration.h>
 #include <osvr/Common/Buffer.h>
 #include <osvr/Common/NetworkClassOfService.h>
+#include <osvr/Common/StreamingMessageQueue.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/StdInt.h>
 #include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
@@ -101,8 +104,24 @@ namespace common {
         template <typename T>
         void packMessage(Buffer<T> const &buf, RawMessageType const &msgType);
 
+        /// @brief Packs a message carrying data for a single sensor, using the
+        /// delivery policy declared by the message type: for streaming
+        /// message types, an unsent earlier message for the same sensor is
+        /// replaced rather than sent.
+        template <typename T, typename Message>
+        void packSensorMessage(Buffer<T> const &buf,
+                               MessageRegistration<Message> const &message,
+                               OSVR_ChannelCount sensor,
+                               util::time::TimeValue const &timestamp);
+
         std::string const &getDeviceName() const;
 
+        /// @brief Number of messages handed to the connection so far.
+        uint64_t getMessagesSent() const { return m_messagesSent; }
+        /// @brief Total payload size of the messages handed to the
+        /// connection so far.
+        uint64_t getBytesSent() const { return m_bytesSent; }
+
       protected:
         /// @brief Constructor
         OSVR_COMMON_EXPORT BaseDevice();
@@ -127,10 +146,33 @@ namespace common {
                            RawMessageType const &msgType,
                            util::time::TimeValue const &timestamp,
                            uint32_t classOfService);
+
+        /// @brief Packs a message that isn't streaming, after flushing any
+        /// pending streaming messages so they precede it. If this message is
+        /// reliable, they are sent reliably too, so they stay ahead of it on
+        /// the same ordered channel: a notification is never seen before the
+        /// data it refers to.
+        void m_packOrderedMessage(size_t len, const char *buf,
+                                  RawMessageType const &msgType,
+                                  util::time::TimeValue const &timestamp,
+                                  uint32_t classOfService);
+
+        void m_packStreamingMessage(size_t len, const char *buf,
+                                    RawMessageType const &msgType,
+                                    OSVR_ChannelCount sensor,
+                                    util::time::TimeValue const &timestamp,
+                                    uint32_t classOfService);
+
+        /// @brief Hands the newest message of each stream to the connection.
+        void m_flushStreamingMessages();
+
         DeviceComponentList m_components;
+        StreamingMessageQueue m_streamingMessages;
         vrpn_ConnectionPtr m_conn;
         RawSenderType m_sender;
         std::string m_name;
+        uint64_t m_messagesSent = 0;
+        uint64_t m_bytesSent = 0;
     };
 
     template <typename T, typename ClassOfService>
@@ -138,7 +180,7 @@ namespace common {
         Buffer<T> const &buf, RawMessageType const &msgType,
         util::time::TimeValue const &timestamp,
         class_of_service::ClassOfServiceBase<ClassOfService> const &) {
-        m_packMessage(
+        m_packOrderedMessage(
             buf.size(), buf.data(), msgType, timestamp,
             class_of_service::VRPNConnectionValue<ClassOfService>::value);
     }
@@ -164,6 +206,27 @@ namespace common {
                                         RawMessageType const &msgType) {
         packMessage(buf, msgType, class_of_service::Reliable());
     }
+
+    template <typename T, typename Message>
+    inline void
+    BaseDevice::packSensorMessage(Buffer<T> const &buf,
+                                  MessageRegistration<Message> const &message,
+                                  OSVR_ChannelCount sensor,
+                                  util::time::TimeValue const &timestamp) {
+        typedef typename Message::delivery_type Delivery;
+        typedef typename Delivery::class_of_service_type ClassOfService;
+        const uint32_t classOfService =
+            class_of_service::VRPNConnectionValue<ClassOfService>::value;
+        if (Delivery::latest_wins) {
+            m_packStreamingMessage(buf.size(), buf.data(),
+                                   message.getMessageType(), sensor, timestamp,
+                                   classOfService);
+        } else {
+            m_packOrderedMessage(buf.size(), buf.data(),
+                                 message.getMessageType(), timestamp,
+                                 classOfService);
+        }
+    }
 } // namespace common
 } // namespace osvr
 
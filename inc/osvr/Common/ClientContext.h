@@ -37,12 +37,15 @@
 #include <osvr/Util/SharedPtr.h>
 #include <osvr/Util/LogLevel.h>
 #include <osvr/Util/Logger.h>
+#include <osvr/Util/TimeValue_fwd.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
 #include <boost/any.hpp>
 
 // Standard includes
+#include <chrono>
 #include <string>
 #include <vector>
 #include <map>
@@ -56,6 +59,52 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     /// @brief System-wide update method.
     OSVR_COMMON_EXPORT void update();
 
+    /// @brief System-wide update method that first blocks until incoming
+    /// data arrives or maxWait elapses, instead of returning immediately if
+    /// there is nothing to do. Lets a dedicated client thread sleep while
+    /// idle without adding a fixed sleep period of latency.
+    ///
+    /// Doesn't wait at all if callbacks deferred by an earlier budgeted
+    /// update are still pending. Callbacks for reports that arrive during the
+    /// wait are held and delivered by the update that follows, after any
+    /// older ones.
+    OSVR_COMMON_EXPORT void update(osvr::util::time::TimeValue const &maxWait);
+
+    /// @brief System-wide update method that stops delivering callbacks once
+    /// the given time has elapsed, so a burst of incoming data can't stall the
+    /// caller. Reports arriving after that still update interface state, but
+    /// their callbacks are deferred to the start of the next update: only for
+    /// the newest report of each type and sensor, per interface, except for
+    /// edge-triggered reports like buttons, which are all kept in order.
+    OSVR_COMMON_EXPORT void
+    updateWithBudget(osvr::util::time::TimeValue const &maxTime);
+
+    /// @brief Whether we're in an update with a time budget that's been used
+    /// up: interfaces should defer callbacks if this is true.
+    OSVR_COMMON_EXPORT bool isUpdateBudgetExhausted() const;
+
+    /// @brief Whether we're waiting for data in update(maxWait): interfaces
+    /// should hold (but not coalesce) callbacks if this is true.
+    bool isWaitingForData() const { return m_waitingForData; }
+
+    /// @brief Called by interfaces when they defer the callbacks for a
+    /// report.
+    /// @param coalesced Whether the report replaced an older deferred one.
+    void noteDeferredReport(bool coalesced) {
+        ++m_deferredReports;
+        if (coalesced) {
+            ++m_coalescedReports;
+        }
+    }
+
+    /// @brief Total number of reports whose callbacks were deferred by an
+    /// update budget.
+    uint64_t getDeferredReportCount() const { return m_deferredReports; }
+
+    /// @brief Total number of deferred reports that were replaced by a newer
+    /// report before their callbacks were delivered.
+    uint64_t getCoalescedReportCount() const { return m_coalescedReports; }
+
     /// @brief Accessor for app ID
     std::string const &getAppId() const;
 
@@ -135,7 +184,23 @@ struct OSVR_ClientContextObject : boost::noncopyable {
         osvr::common::ClientInterfaceFactory const &interfaceFactory,
         osvr::common::ClientContextDeleter del);
 
+    /// @brief Optional implementation-specific waiting for incoming data, for
+    /// at most maxWait: may also process some of that data (callbacks are
+    /// held meanwhile), and is always followed by update(). The default
+    /// implementation just sleeps for maxWait, and is available to derived
+    /// classes that can't always wait for data.
+    OSVR_COMMON_EXPORT virtual void
+    m_waitForData(osvr::util::time::TimeValue const &maxWait);
+
   private:
+    /// @brief Delivers callbacks deferred by an earlier update's budget, until
+    /// done or out of budget.
+    /// @return true if all were delivered.
+    bool m_deliverDeferredCallbacks();
+
+    /// @brief Whether any interface has deferred callbacks pending.
+    bool m_haveDeferredCallbacks() const;
+
     virtual void m_update() = 0;
     virtual void m_sendRoute(std::string const &route) = 0;
     OSVR_COMMON_EXPORT virtual bool m_getStatus() const;
@@ -173,6 +238,15 @@ struct OSVR_ClientContextObject : boost::noncopyable {
     osvr::util::log::LoggerPtr m_logger;
     /// Logger for the client's exclusive use
     osvr::util::log::LoggerPtr m_clientLogger;
+
+    /// @name Update budget
+    /// @{
+    bool m_haveUpdateDeadline = false;
+    std::chrono::steady_clock::time_point m_updateDeadline;
+    uint64_t m_deferredReports = 0;
+    uint64_t m_coalescedReports = 0;
+    bool m_waitingForData = false;
+    /// @}
 };
 
 namespace osvr {
@@ -31,11 +31,13 @@
 #include <osvr/Common/ClientInterfacePtr.h>
 #include <osvr/Common/InterfaceState.h>
 #include <osvr/Common/InterfaceCallbacks.h>
+#include <osvr/Common/ReportChangeFilter.h>
 #include <osvr/Common/StateType.h>
 #include <osvr/Common/ReportStateTraits.h>
 #include <osvr/Common/Tracing.h>
 #include <osvr/Util/ClientOpaqueTypesC.h>
 #include <osvr/Util/ClientCallbackTypesC.h>
+#include <osvr/Util/ChannelCountC.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -45,6 +47,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <type_traits>
 
 struct OSVR_ClientInterfaceObject : boost::noncopyable {
 
@@ -107,12 +110,31 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
 
     /// @brief Trigger all callbacks for the given known report
     /// type.
+    ///
+    /// If the context's update budget is used up and this is a report type
+    /// we keep state for, the callbacks are deferred until
+    /// deliverDeferredCallbacks() instead. If only the newest report matters
+    /// (see traits::CoalesceReport), that replaces any callbacks already
+    /// deferred for this report type and sensor; otherwise it's queued
+    /// behind them. While the context is waiting for data, callbacks are
+    /// likewise queued, without coalescing, for the update that follows.
     template <typename ReportType>
     void triggerCallbacks(const OSVR_TimeValue &timestamp,
                           ReportType const &report) {
-        m_callbacks.triggerCallbacks(timestamp, report);
+        m_triggerCallbacks(
+            timestamp, report,
+            osvr::common::traits::KeepStateForReport<ReportType>{});
     }
 
+    /// @brief Delivers deferred callbacks, oldest first, until done or the
+    /// context's update budget is used up.
+    /// @return true if there are no more deferred callbacks.
+    OSVR_COMMON_EXPORT bool deliverDeferredCallbacks();
+
+    /// @brief Whether any callbacks are waiting for
+    /// deliverDeferredCallbacks().
+    bool hasDeferredCallbacks() const { return !m_deferred.empty(); }
+
     /// @brief Get the number of registered callbacks for the given report type.
     template <typename ReportType>
     std::size_t getNumCallbacksFor(ReportType const &r) const {
@@ -125,15 +147,70 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
 
     osvr::common::ClientContext &getContext() const { return m_ctx; }
 
+    /// @brief Access the filter deciding which incoming reports update this
+    /// interface's state and trigger its callbacks.
+    osvr::common::ReportChangeFilter &changeFilter() { return m_changeFilter; }
+
     /// @brief Access the type-erased data for this interface.
     boost::any &data() { return m_data; }
 
   private:
+    template <typename ReportType>
+    void m_triggerCallbacks(const OSVR_TimeValue &timestamp,
+                            ReportType const &report, std::true_type) {
+        if (m_callbacks.getNumCallbacksFor(report) == 0) {
+            return;
+        }
+        if (!m_shouldDeferCallbacks()) {
+            m_callbacks.triggerCallbacks(timestamp, report);
+            return;
+        }
+        m_deferCallbacks(
+            m_deferralKey<ReportType>(),
+            static_cast<OSVR_ChannelCount>(report.sensor),
+            osvr::common::traits::CoalesceReport<ReportType>::value,
+            [this, timestamp, report] {
+                m_callbacks.triggerCallbacks(timestamp, report);
+            });
+    }
+
+    /// Reports we don't keep state for (such as images) can't be coalesced,
+    /// so they're always delivered right away.
+    template <typename ReportType>
+    void m_triggerCallbacks(const OSVR_TimeValue &timestamp,
+                            ReportType const &report, std::false_type) {
+        m_callbacks.triggerCallbacks(timestamp, report);
+    }
+
+    /// @brief A unique value for each report type, identifying its deferred
+    /// callbacks.
+    template <typename ReportType> static void const *m_deferralKey() {
+        static const char key = 0;
+        return &key;
+    }
+
+    OSVR_COMMON_EXPORT bool m_shouldDeferCallbacks() const;
+    OSVR_COMMON_EXPORT void m_deferCallbacks(void const *key,
+                                             OSVR_ChannelCount sensor,
+                                             bool coalesce,
+                                             std::function<void()> &&call);
+
+    /// @brief A deferred callback delivery, with the report type (as
+    /// returned by m_deferralKey()) and sensor it's for.
+    struct DeferredCallbacks {
+        void const *key;
+        OSVR_ChannelCount sensor;
+        std::function<void()> call;
+    };
+
     osvr::common::ClientContext &m_ctx;
     std::string const m_path;
     osvr::common::InterfaceCallbacks m_callbacks;
     osvr::common::InterfaceState m_state;
+    osvr::common::ReportChangeFilter m_changeFilter;
     boost::any m_data;
+    /// Deferred callback deliveries, oldest first.
+    std::vector<DeferredCallbacks> m_deferred;
 };
 
 #endif // INCLUDED_ClientInterface_h_GUID_A3A55368_DE2F_4980_BAE9_1C398B0D40A1
@@ -0,0 +1,140 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_CompiledTransform_h_GUID_4D037463_D758_4C13_84F1_B57788F15812
+#define INCLUDED_CompiledTransform_h_GUID_4D037463_D758_4C13_84F1_B57788F15812
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/Transform.h>
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+#include <json/value.h>
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    /// @brief The result of parsing transform JSON (the same format handled by
+    /// JSONTransformVisitor) once, folded down to the fewest matrix operations
+    /// that reproduce it.
+    ///
+    /// Every level of transform JSON contributes a matrix multiplied on the
+    /// right of the pose (pre), on the left (post), or both (changeBasis).
+    /// Since the two sides never interact, all pre matrices fold into one and
+    /// all post matrices into another, regardless of how many rotations,
+    /// translations, and basis changes the JSON nests. Sides that end up as
+    /// the identity are skipped entirely when applying the transform.
+    class CompiledTransform {
+      public:
+        /// @brief Parses and folds the transform JSON.
+        ///
+        /// @throws std::runtime_error on malformed transform JSON, just like
+        /// JSONTransformVisitor.
+        OSVR_COMMON_EXPORT explicit CompiledTransform(Json::Value const &root);
+
+        /// @brief Wraps an already-folded transform (with a null leaf).
+        OSVR_COMMON_EXPORT explicit CompiledTransform(
+            Transform const &xform = Transform{});
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /// @brief Gets the result of applying another transform around this
+        /// one, as Transform::transform(Transform const &) would, folded the
+        /// same way. Keeps the leaf.
+        OSVR_COMMON_EXPORT CompiledTransform
+        composedWith(Transform const &outer) const;
+
+        /// @brief Apply the transformation to a matrix representing a pose.
+        Eigen::Matrix4d apply(Eigen::Matrix4d const &input) const {
+            if (m_hasPre && m_hasPost) {
+                return m_transform.getPost() * input * m_transform.getPre();
+            }
+            if (m_hasPost) {
+                return m_transform.getPost() * input;
+            }
+            if (m_hasPre) {
+                return input * m_transform.getPre();
+            }
+            return input;
+        }
+
+        /// @brief Apply only the rotation/basis change to a vector
+        /// representing a velocity or acceleration, as
+        /// Transform::transformDerivative does.
+        Eigen::Vector3d transformDerivative(
+            Eigen::Ref<Eigen::Vector3d const> const &vec) const {
+            if (!m_hasPost) {
+                return vec;
+            }
+            return m_transform.transformDerivative(vec);
+        }
+
+        /// @brief Transform a rotational derivative: angular velocity or
+        /// acceleration.
+        Eigen::Quaterniond
+        transformDerivative(Eigen::Quaterniond const &quat) const {
+            if (!m_hasPost) {
+                return quat;
+            }
+            return m_transform.transformDerivative(quat);
+        }
+
+        /// @brief Gets the folded transform, for use where a Transform is
+        /// expected.
+        Transform const &getTransform() const { return m_transform; }
+
+        /// @brief Gets the innermost, non-transform value of the JSON (usually
+        /// a path).
+        Json::Value const &getLeaf() const { return m_leaf; }
+
+        /// @brief Whether applying this transform changes anything at all.
+        bool isIdentity() const { return !m_hasPre && !m_hasPost; }
+
+        /// @brief Number of matrix multiplications per application: at most 2.
+        std::size_t getNumOperations() const {
+            return (m_hasPre ? 1 : 0) + (m_hasPost ? 1 : 0);
+        }
+
+        /// @brief Number of non-identity matrices the transform JSON
+        /// described, before folding.
+        std::size_t getNumSourceOperations() const { return m_sourceOps; }
+
+      private:
+        void m_setMatrices(Eigen::Matrix4d const &pre,
+                           Eigen::Matrix4d const &post);
+        Transform m_transform;
+        Json::Value m_leaf;
+        bool m_hasPre = false;
+        bool m_hasPost = false;
+        std::size_t m_sourceOps = 0;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_CompiledTransform_h_GUID_4D037463_D758_4C13_84F1_B57788F15812
@@ -0,0 +1,79 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_CompiledTransformCache_h_GUID_DE3E2A93_5D53_4815_8C08_C3EA77FCBD00
+#define INCLUDED_CompiledTransformCache_h_GUID_DE3E2A93_5D53_4815_8C08_C3EA77FCBD00
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+#include <json/value.h>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace osvr {
+namespace common {
+    typedef shared_ptr<CompiledTransform const> CompiledTransformPtr;
+
+    /// @brief Remembers compiled transforms, keyed by (a hash of) the compact
+    /// serialization of the JSON they were compiled from, so each distinct
+    /// transform is only parsed and folded once even though routes are
+    /// re-resolved after every tree update.
+    class CompiledTransformCache {
+      public:
+        /// @brief Gets the compiled form of the given transform JSON,
+        /// compiling it if it hasn't been seen before.
+        ///
+        /// @throws std::runtime_error on malformed transform JSON (which is
+        /// not cached).
+        OSVR_COMMON_EXPORT CompiledTransformPtr get(Json::Value const &root);
+
+        /// @brief Forgets all compiled transforms.
+        OSVR_COMMON_EXPORT void clear();
+
+        std::size_t size() const { return m_entries.size(); }
+
+        /// @name Statistics
+        /// @{
+        std::size_t getHits() const { return m_hits; }
+        std::size_t getMisses() const { return m_misses; }
+        /// @}
+
+      private:
+        std::unordered_map<std::string, CompiledTransformPtr> m_entries;
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_CompiledTransformCache_h_GUID_DE3E2A93_5D53_4815_8C08_C3EA77FCBD00
@@ -50,6 +50,7 @@ namespace common {
     namespace messages {
         class DirectionRecord : public MessageRegistration<DirectionRecord> {
           public:
+            typedef delivery::Streaming delivery_type;
             class MessageSerialization;
 
             static const char *identifier();
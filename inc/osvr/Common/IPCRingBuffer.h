@@ -100,12 +100,30 @@ namespace common {
             Options &setEntrySize(entry_size_type entrySize);
             entry_size_type getEntrySize() const { return m_entrySize; }
 
+            /// @brief Requests that the segment be backed by large ("huge")
+            /// pages where the platform and backend support it, with each
+            /// entry aligned to a page boundary. On find, advises the
+            /// client's mapping of the segment the same way. This is only
+            /// advice: if large pages are unavailable, normal pages are used.
+            /// @return *this for chained method idiom.
+            Options &setLargePages(bool largePages);
+            bool getLargePages() const { return m_largePages; }
+
+            /// @brief Requests that every entry be written once at creation,
+            /// so the page faults happen then rather than on the first
+            /// frames to pass through the buffer.
+            /// @return *this for chained method idiom.
+            Options &setPrefault(bool prefault);
+            bool getPrefault() const { return m_prefault; }
+
           private:
             std::string m_name;
             BackendType m_shmBackend;
-            alignment_type m_alignment = 16;
+            alignment_type m_alignment = 64;
             entry_count_type m_entries = 16;
             entry_size_type m_entrySize = 65536;
+            bool m_largePages = false;
+            bool m_prefault = false;
         };
 
         /// @brief Gets an integer representing a unique arrangement of the
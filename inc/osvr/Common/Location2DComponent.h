@@ -50,6 +50,7 @@ namespace common {
     namespace messages {
         class LocationRecord : public MessageRegistration<LocationRecord> {
           public:
+            typedef delivery::Streaming delivery_type;
             class MessageSerialization;
 
             static const char *identifier();
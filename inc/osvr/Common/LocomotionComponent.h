@@ -57,6 +57,7 @@ namespace common {
         class NaviVelocityRecord
             : public MessageRegistration<NaviVelocityRecord> {
           public:
+            typedef delivery::Streaming delivery_type;
             class MessageSerialization;
 
             static const char *identifier();
@@ -65,6 +66,7 @@ namespace common {
         class NaviPositionRecord
             : public MessageRegistration<NaviPositionRecord> {
           public:
+            typedef delivery::Streaming delivery_type;
             class MessageSerialization;
 
             static const char *identifier();
@@ -34,6 +34,7 @@
 
 // Standard includes
 #include <memory>
+#include <vector>
 
 namespace osvr {
 namespace common {
@@ -43,7 +44,8 @@ namespace common {
     ///
     /// Typical usage would be for a class to hold a unique_ptr of this,
     /// instantiate a new one only when you need to enter the mode, then reset
-    /// the pointer when you don't need it any more.
+    /// the pointer when you don't need it any more. Some settings apply only
+    /// to the calling thread, so create and destroy it on the same thread.
     ///
     /// Explanation, by way of implementation detail: On Windows, this requests
     /// a change to the Windows global timer frequency with timeBeginPeriod and
@@ -51,13 +53,80 @@ namespace common {
     /// is VR" so when milliseconds count, it might be OK. Bruce Dawson even
     /// says so :)
     /// https://randomascii.wordpress.com/2016/03/08/power-wastage-on-an-idle-laptop/#comment-20184
+    ///
+    /// On Linux, this drops the calling thread's timer slack to the minimum
+    /// (so sleeps wake up when asked, not up to 50us later), and optionally
+    /// locks the process memory, requests a real-time scheduling policy, and
+    /// pins the calling thread to a set of CPUs. Each of those that can't be
+    /// granted (typically for lack of privileges) is skipped with a log
+    /// message, and everything that was changed is restored on destruction.
     class LowLatency {
       public:
+        /// Optional, more intrusive, requests. Currently only have an effect
+        /// on Linux.
+        class Options {
+          public:
+            /// @brief Requests that all current and future pages of the process
+            /// be locked into memory (mlockall), so a page fault never delays
+            /// a time-critical wakeup.
+            /// @return *this for chained method idiom.
+            Options &setLockMemory(bool lockMemory) {
+                m_lockMemory = lockMemory;
+                return *this;
+            }
+            bool getLockMemory() const { return m_lockMemory; }
+
+            /// @brief Requests a real-time scheduling policy for the calling
+            /// thread at the given priority (1-99 on Linux); 0, the default,
+            /// leaves the scheduling policy alone.
+            /// @return *this for chained method idiom.
+            Options &setRealtimePriority(int priority) {
+                m_realtimePriority = priority;
+                return *this;
+            }
+            int getRealtimePriority() const { return m_realtimePriority; }
+
+            /// @brief Whether the real-time policy requested should be
+            /// round-robin (SCHED_RR) rather than first-in first-out
+            /// (SCHED_FIFO, the default)
+            /// @return *this for chained method idiom.
+            Options &setRoundRobin(bool roundRobin) {
+                m_roundRobin = roundRobin;
+                return *this;
+            }
+            bool getRoundRobin() const { return m_roundRobin; }
+
+            /// @brief Requests that the calling thread be pinned to the given
+            /// CPUs (zero-based indices). Empty, the default, leaves affinity
+            /// alone.
+            /// @return *this for chained method idiom.
+            Options &setCpus(std::vector<int> const &cpus) {
+                m_cpus = cpus;
+                return *this;
+            }
+            std::vector<int> const &getCpus() const { return m_cpus; }
+
+          private:
+            bool m_lockMemory = false;
+            int m_realtimePriority = 0;
+            bool m_roundRobin = false;
+            std::vector<int> m_cpus;
+        };
+
         OSVR_COMMON_EXPORT LowLatency();
+        OSVR_COMMON_EXPORT explicit LowLatency(Options const &opts);
         OSVR_COMMON_EXPORT ~LowLatency();
         LowLatency(LowLatency const &) = delete;
         LowLatency &operator=(LowLatency const &) = delete;
 
+        /// @name Queries for which requests were actually granted.
+        /// @{
+        OSVR_COMMON_EXPORT bool isTimerResolutionRaised() const;
+        OSVR_COMMON_EXPORT bool isMemoryLocked() const;
+        OSVR_COMMON_EXPORT bool isRealtimeScheduled() const;
+        OSVR_COMMON_EXPORT bool isCpuPinned() const;
+        /// @}
+
       private:
         // private implementation, if any is needed.
         struct Impl;
@@ -26,6 +26,7 @@
 #define INCLUDED_MessageRegistration_h_GUID_F431F1DB_4193_42AB_3376_C67740E2C6FE
 
 // Internal Includes
+#include <osvr/Common/NetworkClassOfService.h>
 #include <osvr/Common/RawMessageType.h>
 
 // Library/third-party includes
@@ -36,13 +37,37 @@
 
 namespace osvr {
 namespace common {
+    /// @brief Tag types describing how messages of a given type should be
+    /// delivered.
+    namespace delivery {
+        /// @brief Every message matters: send each one, reliably and in
+        /// order. The default.
+        struct Reliable {
+            typedef class_of_service::Reliable class_of_service_type;
+            static const bool latest_wins = false;
+        };
+
+        /// @brief Messages are samples of a continuously-updated value from
+        /// a sensor, so only the newest one matters: send with low-latency
+        /// class of service, and let a newer sample for the same sensor
+        /// replace an older one that hasn't been sent yet.
+        struct Streaming {
+            typedef class_of_service::LowLatency class_of_service_type;
+            static const bool latest_wins = true;
+        };
+    } // namespace delivery
+
     /// @brief CRTP class template wrapping message-specific data and/or logic.
     ///
     /// @tparam Derived Derived class, your message-specific type: must have a
     /// `static const char * identifier()` method returning the string ID of the
-    /// message.
+    /// message. It may also have a `delivery_type` typedef naming one of the
+    /// tags in osvr::common::delivery to override the default of
+    /// delivery::Reliable.
     template <typename Derived> class MessageRegistration {
       public:
+        typedef delivery::Reliable delivery_type;
+
         static const char *identifier() { return Derived::identifier(); }
 
         RawMessageType getMessageType() const { return m_type; }
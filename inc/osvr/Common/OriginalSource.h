@@ -62,6 +62,12 @@ namespace common {
 
         void nestTransform(Json::Value const &transform);
 
+        /// @brief Replaces the accumulated transform.
+        void setTransform(GeneralizedTransform const &transform);
+
+        /// @brief Gets the accumulated transform, without the leaf.
+        GeneralizedTransform const &getTransform() const;
+
         PathNode *getDevice() const;
 
         /// @brief Gets the full path of the device node
@@ -0,0 +1,140 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_ReportChangeFilter_h_GUID_B2824642_E947_46AC_BE3C_708825AF8D08
+#define INCLUDED_ReportChangeFilter_h_GUID_B2824642_E947_46AC_BE3C_708825AF8D08
+
+// Internal Includes
+#include <osvr/Util/ClientReportTypesC.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief Optional per-interface filter that lets through only analog and
+    /// button reports that change the value last delivered for their channel,
+    /// so a many-axis device with one axis moving doesn't wake every
+    /// callback (or touch the state) for the unchanged channels.
+    ///
+    /// Analog channels may have a deadband: a report is suppressed unless it
+    /// differs from the last value delivered for its channel by more than
+    /// that. Reports of other types always pass.
+    class ReportChangeFilter {
+      public:
+        /// @brief Channels with numbers at or above this are never filtered.
+        static const std::size_t MAX_FILTERED_CHANNELS = 1024;
+
+        /// @brief Turns on filtering, forgetting any previously delivered
+        /// values.
+        /// @param deadband Largest change in an analog channel that is
+        /// considered "unchanged": 0 means exact equality.
+        void enable(double deadband = 0) {
+            m_enabled = true;
+            m_deadband = deadband > 0 ? deadband : 0;
+            m_analog.clear();
+            m_button.clear();
+        }
+
+        /// @brief Turns off filtering: all reports pass.
+        void disable() {
+            m_enabled = false;
+            m_analog.clear();
+            m_button.clear();
+        }
+
+        bool isEnabled() const { return m_enabled; }
+        double getDeadband() const { return m_deadband; }
+
+        /// @brief Number of reports suppressed since construction.
+        std::size_t getSuppressedCount() const { return m_suppressed; }
+
+        /// @brief Checks a report, recording its value as delivered if it
+        /// passes.
+        /// @return true if the report should be used to update state and
+        /// trigger callbacks.
+        bool shouldDeliver(OSVR_AnalogReport const &report) {
+            return m_check(m_analog, report.sensor, report.state,
+                           [&](OSVR_AnalogState last) {
+                               return std::abs(report.state - last) <=
+                                      m_deadband;
+                           });
+        }
+
+        /// @overload
+        bool shouldDeliver(OSVR_ButtonReport const &report) {
+            return m_check(
+                m_button, report.sensor, report.state,
+                [&](OSVR_ButtonState last) { return report.state == last; });
+        }
+
+        /// @overload
+        ///
+        /// Other report types are not filtered.
+        template <typename ReportType>
+        bool shouldDeliver(ReportType const &) {
+            return true;
+        }
+
+      private:
+        template <typename StateType> struct Slot {
+            StateType value;
+            bool valid;
+        };
+        template <typename StateType, typename F>
+        bool m_check(std::vector<Slot<StateType> > &slots,
+                     OSVR_ChannelCount sensor, StateType state,
+                     F &&isUnchanged) {
+            if (!m_enabled || sensor >= MAX_FILTERED_CHANNELS) {
+                return true;
+            }
+            if (slots.size() <= sensor) {
+                slots.resize(sensor + 1, Slot<StateType>{StateType(), false});
+            }
+            auto &slot = slots[sensor];
+            if (slot.valid && isUnchanged(slot.value)) {
+                ++m_suppressed;
+                return false;
+            }
+            slot.value = state;
+            slot.valid = true;
+            return true;
+        }
+
+        bool m_enabled = false;
+        double m_deadband = 0;
+        std::size_t m_suppressed = 0;
+        std::vector<Slot<OSVR_AnalogState> > m_analog;
+        std::vector<Slot<OSVR_ButtonState> > m_button;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ReportChangeFilter_h_GUID_B2824642_E947_46AC_BE3C_708825AF8D08
@@ -46,6 +46,20 @@ namespace common {
         template <>
         struct KeepStateForReport<OSVR_ImagingReport> : std::false_type {};
 
+        /// @brief Type predicate: Whether callbacks only care about the newest
+        /// report of a type from a given sensor, so a newer report may replace
+        /// an older one whose callbacks haven't been delivered yet.
+        template <typename T> struct CoalesceReport : KeepStateForReport<T> {};
+
+        /// @brief Button presses and releases are edges: replacing one with
+        /// the next would lose a click.
+        template <>
+        struct CoalesceReport<OSVR_ButtonReport> : std::false_type {};
+
+        /// @brief Blinks are edges too.
+        template <>
+        struct CoalesceReport<OSVR_EyeTrackerBlinkReport> : std::false_type {};
+
     } // namespace traits
 
 } // namespace common
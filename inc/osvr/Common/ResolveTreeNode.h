@@ -39,9 +39,18 @@
 namespace osvr {
 namespace common {
 
+    class TreeResolutionCache;
+
     OSVR_COMMON_EXPORT boost::optional<OriginalSource>
     resolveTreeNode(PathTree &pathTree, std::string const &path);
 
+    /// @brief Like resolveTreeNode(), but reuses a previous result for the
+    /// path from the cache if nothing it depended on has changed, and stores
+    /// the result otherwise.
+    OSVR_COMMON_EXPORT boost::optional<OriginalSource>
+    resolveTreeNode(PathTree &pathTree, std::string const &path,
+                    TreeResolutionCache &cache);
+
 } // namespace common
 } // namespace osvr
 
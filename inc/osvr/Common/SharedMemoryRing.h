@@ -0,0 +1,120 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_SharedMemoryRing_h_GUID_4C5638C3_722D_449F_B48F_9A4E8377441B
+#define INCLUDED_SharedMemoryRing_h_GUID_4C5638C3_722D_449F_B48F_9A4E8377441B
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+
+namespace osvr {
+namespace common {
+    class SharedMemoryRing;
+    typedef unique_ptr<SharedMemoryRing> SharedMemoryRingPtr;
+
+    /// @brief A single-producer, single-consumer queue of variable-length
+    /// messages in a named shared memory segment, for passing a stream of
+    /// small messages from one process to another.
+    ///
+    /// Unlike IPCRingBuffer, which broadcasts large buffers and lets the
+    /// producer overwrite entries nobody is reading, every message pushed is
+    /// delivered exactly once, in order, unless the queue is full (in which
+    /// case the push fails and is counted). There are no locks: the producer
+    /// and consumer each own one index, so either process can die at any point
+    /// without leaving the other blocked.
+    class SharedMemoryRing : boost::noncopyable {
+      public:
+        typedef uint32_t size_type;
+
+        /// @brief Creates a named ring, replacing any existing segment with
+        /// the same name. The segment is removed when the returned object is
+        /// destroyed.
+        ///
+        /// @param name Segment name: should be made of letters, digits,
+        /// underscores and dashes.
+        /// @param entries Maximum number of messages queued at once (rounded
+        /// up to a power of two).
+        /// @param entrySize Maximum size of a single message, in bytes.
+        /// @return an empty pointer if the segment could not be created.
+        OSVR_COMMON_EXPORT static SharedMemoryRingPtr
+        create(std::string const &name, size_type entries,
+               size_type entrySize);
+
+        /// @brief Opens a ring created (by another process, usually) with
+        /// create().
+        /// @return an empty pointer if the segment could not be found or is
+        /// not a valid ring.
+        OSVR_COMMON_EXPORT static SharedMemoryRingPtr
+        open(std::string const &name);
+
+        OSVR_COMMON_EXPORT ~SharedMemoryRing();
+
+        /// @name Producer methods
+        /// @{
+        /// @brief Copies a message into the ring.
+        /// @return false (and counts the message as dropped) if the ring is
+        /// full or the message is larger than getEntrySize().
+        OSVR_COMMON_EXPORT bool push(const char *data, std::size_t len);
+        /// @}
+
+        /// @name Consumer methods
+        /// @{
+        /// @brief Gets the oldest message in the ring without removing it. The
+        /// data stays valid until release() is called.
+        /// @return false if the ring is empty.
+        OSVR_COMMON_EXPORT bool peek(const char *&data, size_type &len) const;
+
+        /// @brief Removes the oldest message from the ring, after a successful
+        /// peek().
+        OSVR_COMMON_EXPORT void release();
+        /// @}
+
+        OSVR_COMMON_EXPORT std::string const &getName() const;
+        OSVR_COMMON_EXPORT size_type getEntries() const;
+        OSVR_COMMON_EXPORT size_type getEntrySize() const;
+        /// @brief Number of messages currently queued.
+        OSVR_COMMON_EXPORT size_type size() const;
+        /// @brief Total number of messages the producer failed to push (kept
+        /// in the shared segment, so visible to both processes).
+        OSVR_COMMON_EXPORT uint32_t getDroppedCount() const;
+
+      private:
+        class Impl;
+        explicit SharedMemoryRing(unique_ptr<Impl> &&impl);
+        unique_ptr<Impl> m_impl;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_SharedMemoryRing_h_GUID_4C5638C3_722D_449F_B48F_9A4E8377441B
@@ -0,0 +1,152 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_StreamingMessageQueue_h_GUID_52C69F9E_5A1E_4B66_BE68_B9164283CED2
+#define INCLUDED_StreamingMessageQueue_h_GUID_52C69F9E_5A1E_4B66_BE68_B9164283CED2
+
+// Internal Includes
+#include <osvr/Common/RawMessageType.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief Holds the newest not-yet-sent message for each combination of
+    /// message type and sensor, for message types with "streaming" delivery.
+    ///
+    /// A sample that arrives before the previous one for the same sensor has
+    /// been handed to the connection replaces it instead of queueing behind
+    /// it, so a slow consumer sees fresh data rather than a backlog. Pending
+    /// messages are flushed in the order they were pushed (a superseding
+    /// message takes the place in line of its latest push), so messages that
+    /// describe the same sample stay in order. Storage for each slot is
+    /// reused, so steady-state operation doesn't allocate.
+    class StreamingMessageQueue {
+      public:
+        /// @brief Stores a message, replacing any pending message for the
+        /// same message type and sensor.
+        /// @return true if a pending message was superseded.
+        bool push(RawMessageType const &msgType, OSVR_ChannelCount sensor,
+                  util::time::TimeValue const &timestamp, const char *data,
+                  std::size_t len, uint32_t classOfService) {
+            auto &entry = m_getEntry(msgType, sensor);
+            auto superseded = entry.pending;
+            if (superseded) {
+                ++m_superseded;
+            } else {
+                ++m_numPending;
+            }
+            entry.sequence = m_nextSequence++;
+            entry.timestamp = timestamp;
+            entry.classOfService = classOfService;
+            entry.data.assign(data, data + len);
+            entry.pending = true;
+            return superseded;
+        }
+
+        /// @brief Calls the given function, with signature like `void(size_t
+        /// len, const char *data, RawMessageType const &msgType,
+        /// util::time::TimeValue const &timestamp, uint32_t
+        /// classOfService)`, for each pending message in push order, then
+        /// marks them sent.
+        template <typename F> void flush(F &&sendFunc) {
+            if (0 == m_numPending) {
+                return;
+            }
+            m_flushOrder.clear();
+            for (std::size_t i = 0, e = m_entries.size(); i < e; ++i) {
+                if (m_entries[i].pending) {
+                    m_flushOrder.push_back(i);
+                }
+            }
+            std::sort(begin(m_flushOrder), end(m_flushOrder),
+                      [&](std::size_t a, std::size_t b) {
+                          return m_entries[a].sequence <
+                                 m_entries[b].sequence;
+                      });
+            for (auto i : m_flushOrder) {
+                auto &entry = m_entries[i];
+                entry.pending = false;
+                sendFunc(entry.data.size(), entry.data.data(), entry.msgType,
+                         entry.timestamp, entry.classOfService);
+            }
+            m_numPending = 0;
+        }
+
+        bool empty() const { return 0 == m_numPending; }
+
+        /// @brief Number of messages waiting to be flushed.
+        std::size_t size() const { return m_numPending; }
+
+        /// @brief Total number of messages that were replaced by a newer one
+        /// before being sent.
+        uint64_t getSupersededCount() const { return m_superseded; }
+
+      private:
+        struct Entry {
+            RawMessageType msgType;
+            OSVR_ChannelCount sensor;
+            util::time::TimeValue timestamp;
+            uint32_t classOfService;
+            std::vector<char> data;
+            bool pending;
+            /// Order of the latest push to this entry.
+            uint64_t sequence;
+        };
+
+        /// Linear search: a device has a handful of message types and
+        /// sensors at most.
+        Entry &m_getEntry(RawMessageType const &msgType,
+                          OSVR_ChannelCount sensor) {
+            for (auto &entry : m_entries) {
+                if (entry.sensor == sensor &&
+                    entry.msgType.get() == msgType.get()) {
+                    return entry;
+                }
+            }
+            m_entries.push_back(Entry{msgType, sensor, util::time::TimeValue{},
+                                      0, std::vector<char>{}, false, 0});
+            return m_entries.back();
+        }
+
+        std::vector<Entry> m_entries;
+        /// Scratch storage for flush(), kept to avoid allocation.
+        std::vector<std::size_t> m_flushOrder;
+        std::size_t m_numPending = 0;
+        uint64_t m_nextSequence = 0;
+        uint64_t m_superseded = 0;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_StreamingMessageQueue_h_GUID_52C69F9E_5A1E_4B66_BE68_B9164283CED2
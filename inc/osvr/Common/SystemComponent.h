@@ -69,6 +69,19 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+
+        class DeviceStatsRequestToServer
+            : public MessageRegistration<DeviceStatsRequestToServer> {
+          public:
+            static const char *identifier();
+        };
+
+        class DeviceStatsFromServer
+            : public MessageRegistration<DeviceStatsFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component, to be used only with the "OSVR" special
@@ -112,13 +125,32 @@ namespace common {
 
         OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree);
 
+        /// @brief Message from client to server, asking for the server's
+        /// per-device update timing and traffic statistics.
+        messages::DeviceStatsRequestToServer deviceStatsRequest;
+
+        OSVR_COMMON_EXPORT void sendDeviceStatsRequest();
+        OSVR_COMMON_EXPORT void
+        registerDeviceStatsRequestHandler(vrpn_MESSAGEHANDLER handler,
+                                          void *userdata);
+
+        /// @brief Message from server, replying to a device stats request
+        /// with a JSON object.
+        messages::DeviceStatsFromServer deviceStatsOut;
+
+        OSVR_COMMON_EXPORT void sendDeviceStats(Json::Value const &stats);
+        OSVR_COMMON_EXPORT void registerDeviceStatsHandler(JsonHandler cb);
+
       private:
         SystemComponent();
         virtual void m_parentSet();
         static int VRPN_CALLBACK
         m_handleReplaceTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleDeviceStats(void *userdata, vrpn_HANDLERPARAM p);
 
         std::vector<JsonHandler> m_replaceTreeHandlers;
+        std::vector<JsonHandler> m_deviceStatsHandlers;
     };
 } // namespace common
 } // namespace osvr
@@ -73,15 +73,16 @@ namespace common {
 
         /// @brief Apply only the rotation/basis change (not the translation) to
         /// a vector representing a velocity or acceleration
-        Eigen::Vector3d
-        transformDerivative(Eigen::Ref<Eigen::Vector3d const> const &vec) {
+        Eigen::Vector3d transformDerivative(
+            Eigen::Ref<Eigen::Vector3d const> const &vec) const {
             return transformDerivativeImpl(Eigen::Translation3d(vec))
                 .translation();
         }
 
         /// @brief Transform a rotational derivative: angular velocity or
         /// acceleration.
-        Eigen::Quaterniond transformDerivative(Eigen::Quaterniond const &quat) {
+        Eigen::Quaterniond
+        transformDerivative(Eigen::Quaterniond const &quat) const {
             return Eigen::Quaterniond(transformDerivativeImpl(quat).rotation());
         }
 
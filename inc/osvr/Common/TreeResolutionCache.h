@@ -0,0 +1,109 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TreeResolutionCache_h_GUID_9A2C6D84_2171_4FDE_92A6_0A6FF6FCD045
+#define INCLUDED_TreeResolutionCache_h_GUID_9A2C6D84_2171_4FDE_92A6_0A6FF6FCD045
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/PathTree_fwd.h>
+#include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/OriginalSource.h>
+
+// Library/third-party includes
+#include <boost/optional.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief Remembers the results of resolveTreeNode() for paths, along with
+    /// the tree node elements each result was derived from.
+    ///
+    /// Trees are frequently replaced wholesale (e.g. every time a client
+    /// receives an updated tree from the server), so rather than relying on
+    /// node identity, each cached result is considered current as long as
+    /// every node it depended on (the alias chain and the ancestors of the
+    /// node it landed on) still has an equal element. That makes revalidation
+    /// a handful of lookups and comparisons, instead of re-parsing alias JSON
+    /// and re-nesting transforms for every path after every tree update.
+    class TreeResolutionCache {
+      public:
+        /// @brief The element of a node followed by those of zero or more of
+        /// its ancestors, nearest first.
+        typedef std::vector<elements::PathElement> ElementLineage;
+
+        /// @brief Tree paths that a resolution depended on, along with the
+        /// elements each (and, for the node the resolution landed on, its
+        /// ancestors) had.
+        typedef std::vector<std::pair<std::string, ElementLineage>>
+            Dependencies;
+
+        /// @brief Gets the cached result for a path, if there is one and all
+        /// of its dependencies are unchanged in the given tree.
+        ///
+        /// @return an empty optional on a cache miss, otherwise the cached
+        /// result (which itself may be empty, if the path did not resolve)
+        OSVR_COMMON_EXPORT boost::optional<boost::optional<OriginalSource>>
+        get(PathTree &tree, std::string const &path);
+
+        /// @brief Records the result of resolving a path and the dependencies
+        /// discovered while doing so.
+        OSVR_COMMON_EXPORT void
+        store(std::string const &path,
+              boost::optional<OriginalSource> const &source,
+              Dependencies &&deps);
+
+        /// @brief Forgets all cached results.
+        OSVR_COMMON_EXPORT void clear();
+
+        std::size_t size() const { return m_entries.size(); }
+
+        /// @name Statistics
+        /// @{
+        std::size_t getHits() const { return m_hits; }
+        std::size_t getMisses() const { return m_misses; }
+        /// @}
+
+      private:
+        struct Entry {
+            /// The last dependency is always the node resolution landed on.
+            Dependencies deps;
+            bool resolved;
+            GeneralizedTransform transform;
+        };
+        std::unordered_map<std::string, Entry> m_entries;
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TreeResolutionCache_h_GUID_9A2C6D84_2171_4FDE_92A6_0A6FF6FCD045
@@ -31,6 +31,7 @@
 #include <osvr/Connection/ConnectionDevicePtr.h>
 #include <osvr/Connection/ConnectionPtr.h>
 #include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceUpdateStats.h>
 #include <osvr/Util/DeviceCallbackTypesC.h>
 #include <osvr/PluginHost/RegistrationContext_fwd.h>
 #include <osvr/Util/Log.h>
@@ -73,6 +74,12 @@ namespace connection {
 
         OSVR_CONNECTION_EXPORT static std::tuple<void *, ConnectionPtr>
         createLoopbackConnection();
+
+        /// @brief Factory method to wrap a connection of the underlying
+        /// implementation created elsewhere (for VRPN, a vrpn_Connection *,
+        /// which gets referenced so should have auto-delete enabled).
+        OSVR_CONNECTION_EXPORT static ConnectionPtr
+        createFromUnderlyingObject(void *underlying);
         /// @}
 
         /// @name Context Storage
@@ -110,8 +117,28 @@ namespace connection {
         /// @brief Process messages. This shouldn't block.
         ///
         /// Someone needs to call this method frequently.
+        ///
+        /// Incoming message dispatch and each device update are timed: see
+        /// getDispatchStats() and ConnectionDevice::getUpdateStats().
         OSVR_CONNECTION_EXPORT void process();
 
+        /// @brief Timing of the connection's own processing (dispatching
+        /// incoming messages to their handlers) in process().
+        DeviceUpdateStats const &getDispatchStats() const {
+            return m_dispatchStats;
+        }
+
+        /// @brief Sets how long a single device update may take before a
+        /// warning is logged. Warnings for a given device are throttled to
+        /// its 1st, 10th, 100th, ... slow update. Zero disables the warnings.
+        OSVR_CONNECTION_EXPORT void
+        setSlowUpdateThreshold(DeviceUpdateStats::duration threshold);
+
+        /// @brief Gets the slow-update warning threshold.
+        DeviceUpdateStats::duration getSlowUpdateThreshold() const {
+            return m_slowUpdateThreshold;
+        }
+
         /// @brief Register a function to be called when a client connects or
         /// pings.
         OSVR_CONNECTION_EXPORT void
@@ -201,9 +228,12 @@ namespace connection {
         Connection();
 
       private:
+        void m_checkSlowUpdate(ConnectionDevice &dev);
         DeviceList m_devices;
         std::vector<std::function<void()> > m_descriptorHandlers;
         util::log::LoggerPtr m_log;
+        DeviceUpdateStats m_dispatchStats;
+        DeviceUpdateStats::duration m_slowUpdateThreshold;
     };
 } // namespace connection
 } // namespace osvr
@@ -30,6 +30,7 @@
 #include <osvr/Connection/ConnectionDevicePtr.h>
 #include <osvr/Connection/MessageTypePtr.h>
 #include <osvr/Connection/DeviceTokenPtr.h>
+#include <osvr/Connection/DeviceUpdateStats.h>
 #include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
@@ -58,10 +59,13 @@ namespace connection {
 
         /// @brief Process messages. This shouldn't block.
         ///
-        /// Someone needs to call this method frequently.
-        void process();
+        /// Someone needs to call this method frequently. Each call is timed
+        /// and recorded in the update statistics.
+        OSVR_CONNECTION_EXPORT void process();
 
         /// @brief Send message (as primary device name)
+        ///
+        /// Counted in the update statistics.
         void sendData(util::time::TimeValue const &timestamp, MessageType *type,
                       const char *bytestream, size_t len);
 
@@ -78,6 +82,11 @@ namespace connection {
         /// @brief Get the most current JSON device descriptor
         OSVR_CONNECTION_EXPORT std::string const &getDeviceDescriptor() const;
 
+        /// @brief Timing and traffic counters for this device.
+        DeviceUpdateStats const &getUpdateStats() const { return m_stats; }
+        /// @overload
+        DeviceUpdateStats &getUpdateStats() { return m_stats; }
+
       protected:
         /// @brief Does this connection device have a device token? Should be
         /// true in nearly every case.
@@ -103,6 +112,7 @@ namespace connection {
         NameList m_names;
         DeviceToken *m_token;
         std::string m_descriptor;
+        DeviceUpdateStats m_stats;
     };
 } // namespace connection
 } // namespace osvr
@@ -0,0 +1,159 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_DeviceUpdateStats_h_GUID_E3B1039B_A76F_40EF_BB53_24E4A276EA45
+#define INCLUDED_DeviceUpdateStats_h_GUID_E3B1039B_A76F_40EF_BB53_24E4A276EA45
+
+// Internal Includes
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace osvr {
+namespace connection {
+    /// @brief Lightweight counters describing how long a device's update takes
+    /// and how much it sends.
+    ///
+    /// Update durations are kept in a histogram with power-of-two microsecond
+    /// buckets: bucket 0 holds updates shorter than 1us, and bucket i > 0 holds
+    /// those in [2^(i-1), 2^i) us, with the last bucket open-ended. Recording
+    /// is a handful of integer operations, so it can run on every update.
+    class DeviceUpdateStats {
+      public:
+        typedef std::chrono::steady_clock clock;
+        typedef std::chrono::nanoseconds duration;
+
+        static const std::size_t NUM_BUCKETS = 20;
+        typedef std::array<uint64_t, NUM_BUCKETS> Histogram;
+
+        DeviceUpdateStats() { reset(); }
+
+        /// @brief Records the duration of a single update.
+        void recordUpdate(duration d) {
+            auto ns = static_cast<uint64_t>(d.count() < 0 ? 0 : d.count());
+            ++m_updates;
+            m_totalNanoseconds += ns;
+            m_lastNanoseconds = ns;
+            if (ns > m_maxNanoseconds) {
+                m_maxNanoseconds = ns;
+            }
+            ++m_histogram[getBucket(ns)];
+        }
+
+        /// @brief Records messages sent by the device, along with their total
+        /// payload size.
+        void recordMessages(uint64_t count, uint64_t bytes) {
+            m_messages += count;
+            m_bytes += bytes;
+        }
+
+        /// @brief Notes that the last update was considered slow.
+        /// @return the number of slow updates so far, including this one.
+        uint64_t recordSlowUpdate() { return ++m_slowUpdates; }
+
+        /// @brief Gets the histogram bucket for an update duration.
+        static std::size_t getBucket(uint64_t nanoseconds) {
+            auto us = nanoseconds / 1000;
+            std::size_t bucket = 0;
+            while (us != 0 && bucket + 1 < NUM_BUCKETS) {
+                us >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        /// @brief Gets the exclusive upper bound, in microseconds, of a
+        /// histogram bucket (the last bucket has no real upper bound).
+        static uint64_t getBucketUpperBoundMicroseconds(std::size_t bucket) {
+            return uint64_t(1) << bucket;
+        }
+
+        uint64_t getUpdateCount() const { return m_updates; }
+        uint64_t getTotalNanoseconds() const { return m_totalNanoseconds; }
+        uint64_t getMaxNanoseconds() const { return m_maxNanoseconds; }
+        uint64_t getLastNanoseconds() const { return m_lastNanoseconds; }
+        uint64_t getSlowUpdateCount() const { return m_slowUpdates; }
+        uint64_t getMessageCount() const { return m_messages; }
+        uint64_t getByteCount() const { return m_bytes; }
+        Histogram const &getHistogram() const { return m_histogram; }
+
+        /// @brief Mean update duration in nanoseconds, or 0 if there have been
+        /// no updates.
+        double getMeanNanoseconds() const {
+            return m_updates == 0 ? 0.
+                                  : static_cast<double>(m_totalNanoseconds) /
+                                        static_cast<double>(m_updates);
+        }
+
+        void reset() {
+            m_updates = 0;
+            m_totalNanoseconds = 0;
+            m_maxNanoseconds = 0;
+            m_lastNanoseconds = 0;
+            m_slowUpdates = 0;
+            m_messages = 0;
+            m_bytes = 0;
+            m_histogram.fill(0);
+        }
+
+      private:
+        uint64_t m_updates;
+        uint64_t m_totalNanoseconds;
+        uint64_t m_maxNanoseconds;
+        uint64_t m_lastNanoseconds;
+        uint64_t m_slowUpdates;
+        uint64_t m_messages;
+        uint64_t m_bytes;
+        Histogram m_histogram;
+    };
+
+    /// @brief Times the enclosing scope, recording it as an update in a
+    /// DeviceUpdateStats on destruction.
+    class ScopedUpdateTimer {
+      public:
+        explicit ScopedUpdateTimer(DeviceUpdateStats &stats)
+            : m_stats(stats), m_begin(DeviceUpdateStats::clock::now()) {}
+        ~ScopedUpdateTimer() {
+            m_stats.recordUpdate(std::chrono::duration_cast<
+                                 DeviceUpdateStats::duration>(
+                DeviceUpdateStats::clock::now() - m_begin));
+        }
+
+      private:
+        ScopedUpdateTimer(ScopedUpdateTimer const &) = delete;
+        ScopedUpdateTimer &operator=(ScopedUpdateTimer const &) = delete;
+        DeviceUpdateStats &m_stats;
+        DeviceUpdateStats::clock::time_point m_begin;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_DeviceUpdateStats_h_GUID_E3B1039B_A76F_40EF_BB53_24E4A276EA45
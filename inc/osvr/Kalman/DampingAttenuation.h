@@ -0,0 +1,83 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DampingAttenuation_h_GUID_809A89F8_27F2_48B1_AE69_5CAFBD8AD296
+#define INCLUDED_DampingAttenuation_h_GUID_809A89F8_27F2_48B1_AE69_5CAFBD8AD296
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+
+namespace osvr {
+namespace kalman {
+    /// Computes the coefficient m in v_new = m * v_old for exponential decay
+    /// of a velocity with a given damping value, that is, damping^dt.
+    ///
+    /// Rather than calling std::pow every prediction, the logarithm of the
+    /// damping is computed when it's set, so each attenuation is a single
+    /// std::exp, and the most recent attenuation is kept so that repeated
+    /// predictions with the same dt (a fixed-rate IMU, or the transition
+    /// matrix and the state estimate for the same step) skip even that.
+    class DampingAttenuation {
+      public:
+        /// @param damping Must be positive.
+        explicit DampingAttenuation(double damping) { setDamping(damping); }
+
+        /// @param damping Must be positive.
+        void setDamping(double damping) {
+            m_damping = damping;
+            m_logDamping = std::log(damping);
+            m_lastDt = 0;
+            m_lastAttenuation = 1;
+        }
+
+        double getDamping() const { return m_damping; }
+
+        /// Gets damping^dt
+        double operator()(double dt) const {
+            if (dt != m_lastDt) {
+                m_lastDt = dt;
+                m_lastAttenuation = std::exp(m_logDamping * dt);
+            }
+            return m_lastAttenuation;
+        }
+
+      private:
+        double m_damping;
+        double m_logDamping;
+        /// Cache of the most recent computation: mutable since it doesn't
+        /// change the observable behavior, and the process model methods that
+        /// need an attenuation are const.
+        mutable double m_lastDt;
+        mutable double m_lastAttenuation;
+    };
+} // namespace kalman
+} // namespace osvr
+
+#endif // INCLUDED_DampingAttenuation_h_GUID_809A89F8_27F2_48B1_AE69_5CAFBD8AD296
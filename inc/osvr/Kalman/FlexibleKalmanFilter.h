@@ -47,9 +47,15 @@ namespace kalman {
                                  state.errorCovariance());
     }
 
+    /// Corrects the state with a measurement.
+    ///
+    /// @return the normalized innovation squared (NIS) of the measurement,
+    /// deltaz^T S^-1 deltaz: for a consistent filter, this is chi-squared
+    /// distributed with as many degrees of freedom as the measurement has
+    /// dimensions, so it can be used to gate measurements or adapt noise.
     template <typename StateType, typename ProcessModelType,
               typename MeasurementType>
-    inline void correct(StateType &state, ProcessModelType &processModel,
+    inline double correct(StateType &state, ProcessModelType &processModel,
                         MeasurementType &meas) {
         /// Dimension of measurement
         static const auto m = types::Dimension<MeasurementType>::value;
@@ -97,9 +103,11 @@ namespace kalman {
         EIGEN_STATIC_ASSERT_VECTOR_SPECIFIC_SIZE(decltype(deltaz), m);
         OSVR_KALMAN_DEBUG_OUTPUT("deltaz", deltaz.transpose());
 
-        types::Vector<n> stateCorrection = PHt * denom.solve(deltaz);
+        types::Vector<m> solvedDeltaz = denom.solve(deltaz);
+        types::Vector<n> stateCorrection = PHt * solvedDeltaz;
         OSVR_KALMAN_DEBUG_OUTPUT("state correction",
-                                 (PHt * denom.solve(deltaz)).transpose());
+                                 stateCorrection.transpose());
+        const double nis = deltaz.dot(solvedDeltaz);
 
         // Correct the state estimate
         state.setStateVector(state.stateVector() + stateCorrection);
@@ -134,6 +142,7 @@ namespace kalman {
         // Let the state do any cleanup it has to (like fixing externalized
         // quaternions)
         state.postCorrect();
+        return nis;
     }
 
     /// The main class implementing the common components of the Kalman family
@@ -174,8 +183,8 @@ namespace kalman {
         }
 
         template <typename MeasurementType>
-        void correct(MeasurementType &meas) {
-            kalman::correct(state(), processModel(), meas);
+        double correct(MeasurementType &meas) {
+            return kalman::correct(state(), processModel(), meas);
         }
 
         ProcessModel &processModel() { return m_processModel; }
@@ -0,0 +1,118 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_InnovationAdaptiveNoise_h_GUID_29372D5D_B54C_4A34_AF05_49D5C2D6947E
+#define INCLUDED_InnovationAdaptiveNoise_h_GUID_29372D5D_B54C_4A34_AF05_49D5C2D6947E
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace osvr {
+namespace kalman {
+    /// Estimates a scale factor for a process model's noise from the
+    /// normalized innovation squared (NIS) values returned by correct().
+    ///
+    /// For a consistent filter, NIS divided by the measurement dimension
+    /// averages 1: a larger average means the filter is surprised by the
+    /// measurements (too little process noise - it lags), a smaller one
+    /// means it is trusting them more than it needs to (too much process
+    /// noise - it jitters). The log of the scale is nudged toward balancing
+    /// that with an exponential window, and clamped to a fixed range, so a
+    /// single outlier or a long stretch of no motion can't run it away.
+    class InnovationAdaptiveNoiseScale {
+      public:
+        /// Largest normalized innovation a single measurement may contribute,
+        /// so outliers that made it past any gating only count as "large".
+        static double maxNormalizedInnovation() { return 10.; }
+
+        /// @param window Approximate number of measurements the estimate
+        /// is averaged over.
+        /// @param minScale Smallest scale factor that will be returned.
+        /// @param maxScale Largest scale factor that will be returned.
+        explicit InnovationAdaptiveNoiseScale(std::size_t window = 50,
+                                              double minScale = 0.1,
+                                              double maxScale = 10.)
+            : m_alpha(1. / static_cast<double>(std::max(window,
+                                                         std::size_t(1)))),
+              m_logMin(std::log(std::min(minScale, 1.))),
+              m_logMax(std::log(std::max(maxScale, 1.))) {}
+
+        /// @param nis Normalized innovation squared, as returned by
+        /// kalman::correct()
+        /// @param dimension Dimension of the measurement it came from.
+        void addInnovation(double nis, std::size_t dimension) {
+            if (!(nis >= 0) || dimension == 0) {
+                // NaN or nonsense: ignore rather than poison the estimate.
+                return;
+            }
+            const double ratio =
+                std::min(nis / static_cast<double>(dimension),
+                         maxNormalizedInnovation());
+            m_meanRatio += m_alpha * (ratio - m_meanRatio);
+            m_logScale = std::min(
+                std::max(m_logScale + m_alpha * (ratio - 1.), m_logMin),
+                m_logMax);
+            ++m_count;
+        }
+
+        /// @brief Current multiplier for the process noise.
+        double getScale() const { return std::exp(m_logScale); }
+
+        /// @brief Windowed average of NIS divided by the measurement
+        /// dimension: near 1 when the scaled process noise is consistent
+        /// with the measurements.
+        double getMeanNormalizedInnovation() const { return m_meanRatio; }
+
+        /// @brief Number of innovations incorporated since construction or
+        /// the last reset.
+        std::size_t getCount() const { return m_count; }
+
+        /// @brief Returns to a scale of 1 with no history.
+        void reset() {
+            m_logScale = 0;
+            m_meanRatio = 1;
+            m_count = 0;
+        }
+
+      private:
+        double m_alpha;
+        double m_logMin;
+        double m_logMax;
+        double m_logScale = 0;
+        double m_meanRatio = 1;
+        std::size_t m_count = 0;
+    };
+} // namespace kalman
+} // namespace osvr
+
+#endif // INCLUDED_InnovationAdaptiveNoise_h_GUID_29372D5D_B54C_4A34_AF05_49D5C2D6947E
@@ -0,0 +1,74 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_LinearAccelerationInput_h_GUID_34C028F0_35D7_43C4_B932_93415813BDBC
+#define INCLUDED_LinearAccelerationInput_h_GUID_34C028F0_35D7_43C4_B932_93415813BDBC
+
+// Internal Includes
+#include "FlexibleKalmanBase.h"
+#include "PoseState.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace kalman {
+    namespace pose_externalized_rotation {
+        /// Applies a known linear acceleration (such as a gravity-compensated
+        /// accelerometer reading), held constant over dt, to the position and
+        /// velocity of the state: a control input to be used right after
+        /// predicting with a constant-velocity process model over the same dt.
+        ///
+        /// The uncertainty in the acceleration is propagated into the
+        /// position and velocity error covariance as discrete white noise
+        /// acceleration.
+        ///
+        /// @param accel Acceleration, in the same space as the state.
+        /// @param variance Variance of each component of accel.
+        inline void applyLinearAcceleration(State &state,
+                                            Eigen::Vector3d const &accel,
+                                            double variance, double dt) {
+            const double dt2 = dt * dt;
+            state.position() += 0.5 * dt2 * accel;
+            state.velocity() += dt * accel;
+
+            /// Noise enters through G = [dt^2/2 I; dt I] on the position and
+            /// velocity rows, so Q = variance * G * G^T.
+            using Mat3 = types::SquareMatrix<3>;
+            const Mat3 I = Mat3::Identity();
+            auto &P = state.errorCovariance();
+            P.block<3, 3>(0, 0) += (variance * dt2 * dt2 / 4.) * I;
+            P.block<3, 3>(0, 6) += (variance * dt2 * dt / 2.) * I;
+            P.block<3, 3>(6, 0) += (variance * dt2 * dt / 2.) * I;
+            P.block<3, 3>(6, 6) += (variance * dt2) * I;
+        }
+    } // namespace pose_externalized_rotation
+} // namespace kalman
+} // namespace osvr
+
+#endif // INCLUDED_LinearAccelerationInput_h_GUID_34C028F0_35D7_43C4_B932_93415813BDBC
@@ -0,0 +1,136 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_OrientationAndAngularVelocityMeasurement_h_GUID_670262EB_FF19_4DD2_9FA6_773AE0874BF3
+#define INCLUDED_OrientationAndAngularVelocityMeasurement_h_GUID_670262EB_FF19_4DD2_9FA6_773AE0874BF3
+
+// Internal Includes
+#include "FlexibleKalmanBase.h"
+#include "PoseState.h"
+#include "AbsoluteOrientationMeasurement.h"
+#include "AngularVelocityMeasurement.h"
+#include <osvr/Util/EigenCoreGeometry.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace kalman {
+    /// A measurement of both absolute orientation and angular velocity taken
+    /// at the same time (as from an IMU that reports both), stacked so they
+    /// can be incorporated in a single correction step.
+    ///
+    /// The measurement vector is the orientation residual (as a rotation
+    /// vector) followed by the angular velocity.
+    class OrientationAndAngularVelocityBase {
+      public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        static const types::DimensionType DIMENSION = 6;
+        using MeasurementVector = types::Vector<DIMENSION>;
+        using MeasurementSquareMatrix = types::SquareMatrix<DIMENSION>;
+        OrientationAndAngularVelocityBase(
+            Eigen::Quaterniond const &quat,
+            types::Vector<3> const &quatVariance,
+            types::Vector<3> const &angVel,
+            types::Vector<3> const &angVelVariance)
+            : m_orientation(quat, quatVariance),
+              m_angVel(angVel, angVelVariance) {
+            types::Vector<DIMENSION> variance;
+            variance << quatVariance, angVelVariance;
+            m_covariance = variance.asDiagonal();
+        }
+
+        template <typename State>
+        MeasurementSquareMatrix const &getCovariance(State const &) {
+            return m_covariance;
+        }
+
+        /// Gets the measurement residual, also known as innovation: predicts
+        /// the measurement from the predicted state, and returns the
+        /// difference.
+        ///
+        /// State type doesn't matter as long as we can
+        /// `.getCombinedQuaternion()` and `.angularVelocity()`
+        template <typename State>
+        MeasurementVector getResidual(State const &s) const {
+            MeasurementVector ret;
+            ret << m_orientation.getResidual(s), m_angVel.getResidual(s);
+            return ret;
+        }
+
+        /// Convenience method to be able to store and re-use measurements.
+        void setMeasurement(Eigen::Quaterniond const &quat,
+                            types::Vector<3> const &angVel) {
+            m_orientation.setMeasurement(quat);
+            m_angVel.setMeasurement(angVel);
+        }
+
+      private:
+        AbsoluteOrientationBase m_orientation;
+        AngularVelocityBase m_angVel;
+        MeasurementSquareMatrix m_covariance;
+    };
+
+    /// This is the subclass of OrientationAndAngularVelocityBase: only explicit
+    /// specializations, and on state types.
+    template <typename StateType>
+    class OrientationAndAngularVelocityMeasurement;
+
+    /// OrientationAndAngularVelocityMeasurement with a
+    /// pose_externalized_rotation::State
+    template <>
+    class OrientationAndAngularVelocityMeasurement<
+        pose_externalized_rotation::State>
+        : public OrientationAndAngularVelocityBase {
+      public:
+        using State = pose_externalized_rotation::State;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        static const types::DimensionType STATE_DIMENSION =
+            types::Dimension<State>::value;
+        using Base = OrientationAndAngularVelocityBase;
+
+        OrientationAndAngularVelocityMeasurement(
+            Eigen::Quaterniond const &quat,
+            types::Vector<3> const &quatVariance,
+            types::Vector<3> const &angVel,
+            types::Vector<3> const &angVelVariance)
+            : Base(quat, quatVariance, angVel, angVelVariance) {}
+
+        types::Matrix<DIMENSION, STATE_DIMENSION>
+        getJacobian(State const &) const {
+            using Jacobian = types::Matrix<DIMENSION, STATE_DIMENSION>;
+            Jacobian ret = Jacobian::Zero();
+            // Orientation measures the incremental rotation...
+            ret.block<3, 3>(0, 3) = types::SquareMatrix<3>::Identity();
+            // ...and angular velocity measures angular velocity.
+            ret.block<3, 3>(3, 9) = types::SquareMatrix<3>::Identity();
+            return ret;
+        }
+    };
+} // namespace kalman
+} // namespace osvr
+#endif // INCLUDED_OrientationAndAngularVelocityMeasurement_h_GUID_670262EB_FF19_4DD2_9FA6_773AE0874BF3
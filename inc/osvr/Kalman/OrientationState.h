@@ -28,6 +28,7 @@
 // Internal Includes
 #include "FlexibleKalmanBase.h"
 #include "ExternalQuaternion.h"
+#include "DampingAttenuation.h"
 
 // Library/third-party includes
 #include <Eigen/Core>
@@ -82,6 +83,13 @@ namespace kalman {
             A.bottomRightCorner<3, 3>() *= attenuation;
             return A;
         }
+        inline StateSquareMatrix
+        stateTransitionMatrixWithVelocityDamping(
+            double dt, DampingAttenuation const &damping) {
+            auto A = stateTransitionMatrix(dt);
+            A.bottomRightCorner<3, 3>() *= damping(dt);
+            return A;
+        }
         /// Computes A(deltaT)xhat(t-deltaT)
         inline StateVector applyVelocity(StateVector const &state, double dt) {
             // eq. 4.5 in Welch 1996
@@ -100,6 +108,12 @@ namespace kalman {
             angularVelocity(state) *= attenuation;
         }
 
+        inline void dampenVelocities(StateVector &state,
+                                     DampingAttenuation const &damping,
+                                     double dt) {
+            angularVelocity(state) *= damping(dt);
+        }
+
         inline Eigen::Quaterniond
         incrementalOrientationToQuat(StateVector const &state) {
             return external_quat::vecToQuat(incrementalOrientation(state));
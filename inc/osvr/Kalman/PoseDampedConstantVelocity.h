@@ -66,7 +66,7 @@ namespace kalman {
         /// Set the damping - must be positive
         void setDamping(double damping) {
             if (damping > 0) {
-                m_damp = damping;
+                m_damp.setDamping(damping);
             }
         }
 
@@ -103,7 +103,7 @@ namespace kalman {
 
       private:
         BaseProcess m_constantVelModel;
-        double m_damp = 0.1;
+        DampingAttenuation m_damp{0.1};
     };
 
 } // namespace kalman
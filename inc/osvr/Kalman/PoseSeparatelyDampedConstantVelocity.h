@@ -53,24 +53,41 @@ namespace kalman {
             double positionNoise = 0.01, double orientationNoise = 0.1)
             : m_constantVelModel(positionNoise, orientationNoise) {
             setDamping(positionDamping, orientationDamping);
+            setNoiseAutocorrelation(positionNoise, orientationNoise);
         }
 
         void setNoiseAutocorrelation(double positionNoise = 0.01,
                                      double orientationNoise = 0.1) {
-            m_constantVelModel.setNoiseAutocorrelation(positionNoise,
-                                                       orientationNoise);
+            m_baseNoise.head<3>() = types::Vector<3>::Constant(positionNoise);
+            m_baseNoise.tail<3>() =
+                types::Vector<3>::Constant(orientationNoise);
+            m_applyNoise();
         }
 
         void setNoiseAutocorrelation(NoiseAutocorrelation const &noise) {
-            m_constantVelModel.setNoiseAutocorrelation(noise);
+            m_baseNoise = noise;
+            m_applyNoise();
+        }
+
+        /// Multiply the position and orientation noise autocorrelation set
+        /// by setNoiseAutocorrelation() by the given (positive) factors,
+        /// e.g. to adapt the process noise to the observed innovations.
+        void setNoiseScale(double positionScale, double orientationScale) {
+            if (positionScale > 0) {
+                m_posNoiseScale = positionScale;
+            }
+            if (orientationScale > 0) {
+                m_oriNoiseScale = orientationScale;
+            }
+            m_applyNoise();
         }
         /// Set the damping - must be in (0, 1)
         void setDamping(double posDamping, double oriDamping) {
             if (posDamping > 0 && posDamping < 1) {
-                m_posDamp = posDamping;
+                m_posDamp.setDamping(posDamping);
             }
             if (oriDamping > 0 && oriDamping < 1) {
-                m_oriDamp = oriDamping;
+                m_oriDamp.setDamping(oriDamping);
             }
         }
 
@@ -108,9 +125,18 @@ namespace kalman {
         }
 
       private:
+        void m_applyNoise() {
+            NoiseAutocorrelation noise = m_baseNoise;
+            noise.head<3>() *= m_posNoiseScale;
+            noise.tail<3>() *= m_oriNoiseScale;
+            m_constantVelModel.setNoiseAutocorrelation(noise);
+        }
         BaseProcess m_constantVelModel;
-        double m_posDamp = 0.2;
-        double m_oriDamp = 0.01;
+        NoiseAutocorrelation m_baseNoise;
+        double m_posNoiseScale = 1;
+        double m_oriNoiseScale = 1;
+        DampingAttenuation m_posDamp{0.2};
+        DampingAttenuation m_oriDamp{0.01};
     };
 
 } // namespace kalman
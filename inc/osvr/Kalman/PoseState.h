@@ -28,6 +28,7 @@
 // Internal Includes
 #include "FlexibleKalmanBase.h"
 #include "ExternalQuaternion.h"
+#include "DampingAttenuation.h"
 
 // Library/third-party includes
 #include <Eigen/Core>
@@ -101,6 +102,13 @@ namespace kalman {
             return std::pow(damping, dt);
         }
 
+        /// @overload
+        /// Uses a precomputed damping, for repeated use by a process model.
+        inline double computeAttenuation(DampingAttenuation const &damping,
+                                         double dt) {
+            return damping(dt);
+        }
+
         /// Returns the state transition matrix for a constant velocity with a
         /// single damping parameter (not for direct use in computing state
         /// transition, because it is very sparse, but in computing other
@@ -113,6 +121,15 @@ namespace kalman {
             return A;
         }
 
+        /// @overload
+        inline StateSquareMatrix
+        stateTransitionMatrixWithVelocityDamping(
+            double dt, DampingAttenuation const &damping) {
+            auto A = stateTransitionMatrix(dt);
+            A.bottomRightCorner<6, 6>() *= damping(dt);
+            return A;
+        }
+
         /// Returns the state transition matrix for a constant velocity with
         /// separate damping paramters for linear and angular velocity (not for
         /// direct use in computing state transition, because it is very sparse,
@@ -128,6 +145,17 @@ namespace kalman {
             return A;
         }
 
+        /// @overload
+        inline StateSquareMatrix
+        stateTransitionMatrixWithSeparateVelocityDamping(
+            double dt, DampingAttenuation const &posDamping,
+            DampingAttenuation const &oriDamping) {
+            auto A = stateTransitionMatrix(dt);
+            A.block<3, 3>(6, 6) *= posDamping(dt);
+            A.bottomRightCorner<3, 3>() *= oriDamping(dt);
+            return A;
+        }
+
         /// Computes A(deltaT)xhat(t-deltaT)
         inline StateVector applyVelocity(StateVector const &state, double dt) {
             // eq. 4.5 in Welch 1996
@@ -148,6 +176,13 @@ namespace kalman {
             velocities(state) *= attenuation;
         }
 
+        /// @overload
+        inline void dampenVelocities(StateVector &state,
+                                     DampingAttenuation const &damping,
+                                     double dt) {
+            velocities(state) *= damping(dt);
+        }
+
         /// Separately dampen the linear and angular velocities
         inline void separatelyDampenVelocities(StateVector &state,
                                                double posDamping,
@@ -156,6 +191,16 @@ namespace kalman {
             angularVelocity(state) *= computeAttenuation(oriDamping, dt);
         }
 
+        /// @overload
+        inline void
+        separatelyDampenVelocities(StateVector &state,
+                                   DampingAttenuation const &posDamping,
+                                   DampingAttenuation const &oriDamping,
+                                   double dt) {
+            velocity(state) *= posDamping(dt);
+            angularVelocity(state) *= oriDamping(dt);
+        }
+
         inline Eigen::Quaterniond
         incrementalOrientationToQuat(StateVector const &state) {
             return external_quat::vecToQuat(incrementalOrientation(state));
@@ -32,6 +32,7 @@
 // Internal Includes
 #include "FlexibleKalmanBase.h"
 #include "MatrixExponentialMap.h"
+#include "DampingAttenuation.h"
 
 // Library/third-party includes
 // - none
@@ -101,6 +102,10 @@ namespace kalman {
         inline double computeAttenuation(double damping, double dt) {
             return std::pow(damping, dt);
         }
+        inline double computeAttenuation(DampingAttenuation const &damping,
+                                         double dt) {
+            return damping(dt);
+        }
         inline StateSquareMatrix
         stateTransitionMatrixWithVelocityDamping(double dt, double damping) {
 
@@ -111,6 +116,13 @@ namespace kalman {
             A.bottomRightCorner<6, 6>() *= attenuation;
             return A;
         }
+        inline StateSquareMatrix
+        stateTransitionMatrixWithVelocityDamping(
+            double dt, DampingAttenuation const &damping) {
+            auto A = stateTransitionMatrix(dt);
+            A.bottomRightCorner<6, 6>() *= damping(dt);
+            return A;
+        }
         /// Computes A(deltaT)xhat(t-deltaT)
         inline StateVector applyVelocity(StateVector const &state, double dt) {
             // eq. 4.5 in Welch 1996
@@ -129,6 +141,12 @@ namespace kalman {
             auto attenuation = computeAttenuation(damping, dt);
             velocities(state) *= attenuation;
         }
+
+        inline void dampenVelocities(StateVector &state,
+                                     DampingAttenuation const &damping,
+                                     double dt) {
+            velocities(state) *= damping(dt);
+        }
         class State : public HasDimension<12> {
           public:
             EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -114,6 +114,13 @@ namespace pluginhost {
         OSVR_PLUGINHOST_EXPORT virtual void registerHardwareDetectCallback(
             OSVR_HardwareDetectCallback detectCallback, void *userData) = 0;
 
+        /// @brief Register a probe callback to be invoked off the main thread
+        /// on some hardware detection event, followed by a detect callback on
+        /// the main thread if the probe found something.
+        OSVR_PLUGINHOST_EXPORT virtual void registerAsyncHardwareDetectCallback(
+            OSVR_HardwareProbeCallback probeCallback,
+            OSVR_HardwareDetectCallback detectCallback, void *userData) = 0;
+
         /// @brief Register a callback for constructing a driver by name with
         /// parameters.
         ///
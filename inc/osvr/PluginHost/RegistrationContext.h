@@ -39,8 +39,10 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <functional>
 #include <string>
 #include <map>
+#include <vector>
 
 namespace osvr {
 /// @brief PluginHost functionality: loading, hosting, registering, destroying,
@@ -73,9 +75,26 @@ namespace pluginhost {
         OSVR_PLUGINHOST_EXPORT void
         adoptPluginRegistrationContext(PluginRegPtr ctx);
 
-        /// @brief Trigger any registered hardware detect callbacks.
+        /// @brief Trigger any registered hardware detect callbacks, including
+        /// both halves of the asynchronous ones, in this thread.
         OSVR_PLUGINHOST_EXPORT void triggerHardwareDetect();
 
+        /// @brief Trigger only the hardware detect callbacks that must run in
+        /// the main thread (the ones registered without a probe callback).
+        OSVR_PLUGINHOST_EXPORT void triggerSynchronousHardwareDetect();
+
+        /// @brief A function that probes for hardware, safe to call from any
+        /// thread, and returns a function to complete detection in the main
+        /// thread (or an empty function, if nothing was found).
+        typedef std::function<std::function<void()>()> HardwareProbe;
+        typedef std::vector<HardwareProbe> HardwareProbeList;
+
+        /// @brief Get probes for all asynchronous hardware detect callbacks.
+        ///
+        /// The probes keep their plugin's registration context alive, but
+        /// must still be done running before plugins are unloaded.
+        OSVR_PLUGINHOST_EXPORT HardwareProbeList getAsyncHardwareProbes();
+
         /// @brief Call a driver instantiation callback for the given plugin
         /// name and driver name.
         /// @throws std::runtime_error if the plugin named hasn't been loaded,
@@ -71,6 +71,20 @@ namespace pluginkit {
             ::osvr::pluginkit::registerHardwareDetectCallback(m_ctx, functor);
         }
 
+        /// @brief Register an asynchronous hardware detect callback
+        ///
+        /// Your object should have a thread-safe `OSVR_ReturnCode probe()`
+        /// method, as well as a function call operator taking one parameter
+        /// of type ::OSVR_PluginRegContext and returning a value of type
+        /// ::OSVR_ReturnCode
+        ///
+        /// @sa ::osvr::pluginkit::registerAsyncHardwareDetectCallback()
+        template <typename T>
+        void registerAsyncHardwareDetectCallback(T functor) {
+            ::osvr::pluginkit::registerAsyncHardwareDetectCallback(m_ctx,
+                                                                   functor);
+        }
+
         /// @brief Register a driver instantiation callback
         ///
         /// Your callback should take a parameter of type
@@ -111,6 +111,44 @@ namespace pluginkit {
             return registerHardwareDetectCallbackImpl(ctx, functorCopy);
         }
 
+        /// @brief Calls the probe() method of an asynchronous hardware detect
+        /// function object.
+        template <typename FunctorType>
+        inline OSVR_ReturnCode callHardwareProbe(void *userData) {
+            return static_cast<FunctorType *>(userData)->probe();
+        }
+
+        /// @brief Traits-based overload to register an asynchronous hardware
+        /// detect callback where we're given a pointer to a function object.
+        template <typename T>
+        inline OSVR_ReturnCode registerAsyncHardwareDetectCallbackImpl(
+            OSVR_PluginRegContext ctx, T functor,
+            typename boost::enable_if<boost::is_pointer<T> >::type * = NULL) {
+            typedef typename boost::remove_pointer<T>::type FunctorType;
+            registerObjectForDeletion(ctx, functor);
+            return osvrPluginRegisterAsyncHardwareDetectCallback(
+                ctx, &callHardwareProbe<FunctorType>,
+                &util::GenericCaller<OSVR_HardwareDetectCallback, FunctorType,
+                                     util::this_last_t>::call,
+                static_cast<void *>(functor));
+        }
+
+        /// @brief Traits based overload to copy an asynchronous hardware
+        /// detect callback passed by value then register the copy.
+        template <typename T>
+        inline OSVR_ReturnCode registerAsyncHardwareDetectCallbackImpl(
+            OSVR_PluginRegContext ctx, T functor,
+            typename boost::disable_if<boost::is_pointer<T> >::type * = NULL) {
+#ifdef OSVR_HAVE_BOOST_IS_COPY_CONSTRUCTIBLE
+            BOOST_STATIC_ASSERT_MSG(boost::is_copy_constructible<T>::value,
+                                    "Hardware detect callback functors must be "
+                                    "either passed as a pointer or be "
+                                    "copy-constructible");
+#endif
+            T *functorCopy = new T(functor);
+            return registerAsyncHardwareDetectCallbackImpl(ctx, functorCopy);
+        }
+
         /// @brief Traits-based overload to register an instantiation callback
         /// where we're given a pointer to a function object.
         template <typename T>
@@ -169,6 +207,36 @@ namespace pluginkit {
         }
     }
 
+    /// @brief Registers a function object to detect hardware in two steps
+    /// when the core requests a hardware detection: its probe() method is
+    /// called on a worker thread, and if that returns OSVR_RETURN_SUCCESS, its
+    /// function call operator is called later on the server main loop.
+    ///
+    /// Your object should have a method `OSVR_ReturnCode probe()`, which must
+    /// not call into OSVR and must be safe to run concurrently with the rest
+    /// of your plugin, as well as a function call operator taking one
+    /// parameter of type ::OSVR_PluginRegContext and returning a value of
+    /// type ::OSVR_ReturnCode to instantiate drivers for what probe() found.
+    ///
+    /// Also provides for deletion of the function object.
+    ///
+    /// @param ctx The registration context passed to your entry point.
+    /// @param functor A function object as described above. Pass either a
+    /// pointer, which will transfer ownership, or an object by value, which
+    /// will result in a copy being made.
+    ///
+    /// @sa osvrPluginRegisterAsyncHardwareDetectCallback()
+    template <typename T>
+    inline void registerAsyncHardwareDetectCallback(OSVR_PluginRegContext ctx,
+                                                    T functor) {
+        OSVR_ReturnCode ret =
+            detail::registerAsyncHardwareDetectCallbackImpl(ctx, functor);
+        if (ret != OSVR_RETURN_SUCCESS) {
+            throw std::runtime_error(
+                "registerAsyncHardwareDetectCallback failed!");
+        }
+    }
+
     /// @brief Registers a function object to be called when the server is told
     /// to instantiate a driver by name with parameters.
     ///
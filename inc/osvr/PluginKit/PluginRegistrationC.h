@@ -92,6 +92,41 @@ OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode osvrPluginRegisterHardwareDetectCallback(
     OSVR_IN OSVR_HardwareDetectCallback detectCallback,
     OSVR_IN_OPT void *userData OSVR_CPP_ONLY(= NULL)) OSVR_FUNC_NONNULL((1));
 
+/** @brief Register a pair of callbacks to detect hardware without holding up
+   the server's main loop: use this instead of
+   osvrPluginRegisterHardwareDetectCallback() if probing for your hardware
+   (enumerating buses, opening ports, etc.) may take a noticeable amount of
+   time.
+
+   When hardware should be detected again, your probe callback is invoked on a
+   worker thread, with the userdata you provide here. It must not call any
+   OSVR API functions, and must be safe to run concurrently with your plugin's
+   devices and other callbacks. It may store whatever it found in your
+   userdata, and returns OSVR_RETURN_SUCCESS if there is anything to
+   instantiate, OSVR_RETURN_FAILURE otherwise.
+
+   If the probe succeeded, your detect callback is later invoked on the
+   server's main loop, just like a callback registered with
+   osvrPluginRegisterHardwareDetectCallback(), to instantiate device drivers
+   for what was found.
+
+   Detection requests that arrive while a probe is running are combined into
+   a single follow-up pass.
+
+   @param ctx The registration context passed to your entry point.
+   @param probeCallback The address of your probe callback function
+   @param detectCallback The address of your detect callback function
+   @param userData An optional opaque pointer that will be returned to you when
+   either callback you register here is called.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrPluginRegisterAsyncHardwareDetectCallback(
+    OSVR_INOUT_PTR OSVR_PluginRegContext ctx,
+    OSVR_IN OSVR_HardwareProbeCallback probeCallback,
+    OSVR_IN OSVR_HardwareDetectCallback detectCallback,
+    OSVR_IN_OPT void *userData OSVR_CPP_ONLY(= NULL))
+    OSVR_FUNC_NONNULL((1, 2, 3));
+
 /** @brief Register an instantiation callback (constructor) for a driver type.
     The given constructor may be called with a string containing configuration
     information, the format of which you should document with your plugin. JSON
@@ -140,6 +140,16 @@ namespace server {
         OSVR_SERVER_EXPORT ErrorList const &getFailedInstantiations() const;
         /// @}
 
+        /// @brief Starts out-of-process plugin hosts as specified.
+        ///
+        /// Looks for an array with the key of `pluginHosts`, containing
+        /// objects each with its own `plugins` and `drivers` arrays (in the
+        /// same format as the top-level ones) and optionally a `name`: see
+        /// Server::addPluginHost().
+        ///
+        /// @return true if any were found and started.
+        OSVR_SERVER_EXPORT bool processPluginHosts();
+
         OSVR_SERVER_EXPORT bool processRoutes();
         OSVR_SERVER_EXPORT bool processAliases();
 
@@ -117,6 +117,10 @@ namespace server {
             }
         }
 
+        if (srvConfig.processPluginHosts()) {
+            log->info() << "Plugin hosts found and started from config file.";
+        }
+
         if (srvConfig.processExternalDevices()) {
             log->info()
                 << "External devices found and parsed from config file.";
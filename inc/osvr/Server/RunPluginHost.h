@@ -0,0 +1,51 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_RunPluginHost_h_GUID_F37634F0_422A_4E39_A63E_27693B7E5875
+#define INCLUDED_RunPluginHost_h_GUID_F37634F0_422A_4E39_A63E_27693B7E5875
+
+// Internal Includes
+#include <osvr/Server/Export.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace server {
+    /// @brief Runs the plugins and drivers the server sends over the named
+    /// channel, relaying their devices' descriptors and messages back to the
+    /// server, until the server says to stop or goes away. This is the body
+    /// of osvr_plugin_host, which the server starts for each entry in the
+    /// `pluginHosts` array of its config file.
+    ///
+    /// @return a process exit code.
+    OSVR_SERVER_EXPORT int runPluginHost(std::string const &channel);
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_RunPluginHost_h_GUID_F37634F0_422A_4E39_A63E_27693B7E5875
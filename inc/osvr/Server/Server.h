@@ -30,6 +30,7 @@
 #include <osvr/Server/ServerPtr.h>
 #include <osvr/Connection/ConnectionPtr.h>
 #include <osvr/Common/PathElementTypes_fwd.h>
+#include <osvr/Common/LowLatency.h>
 #include <osvr/Util/UniquePtr.h>
 
 // Library/third-party includes
@@ -176,6 +177,11 @@ namespace server {
 
         /// @brief Run all hardware detect callbacks.
         ///
+        /// Callbacks registered with a probe (see
+        /// osvrPluginRegisterAsyncHardwareDetectCallback()) probe on a worker
+        /// thread, so they don't hold up the main loop. Requests made while
+        /// a probe is still running are combined into one follow-up pass.
+        ///
         /// Safe to call from any thread, even when server is running.
         OSVR_SERVER_EXPORT void triggerHardwareDetect();
 
@@ -235,6 +241,24 @@ namespace server {
             std::string const &path, std::string const &deviceName,
             std::string const &server, std::string const &descriptor);
 
+        /// @brief Run plugins and drivers in a separate plugin host process
+        /// (osvr_plugin_host), whose devices the server re-exposes as its own.
+        ///
+        /// A plugin that crashes or hangs in a host takes down only that
+        /// host, which is restarted without clients having to reconnect, and
+        /// each host's drivers get a main loop of their own.
+        ///
+        /// @param name A name for the host, for log messages.
+        /// @param config JSON object with `plugins` and `drivers` arrays,
+        /// formatted as in the server config file, and optionally `sleep`
+        /// (milliseconds per host loop, like the server setting) and
+        /// `executable` (path to the host, by default next to the running
+        /// executable).
+        ///
+        /// Safe to call from any thread, even when server is running.
+        OSVR_SERVER_EXPORT void addPluginHost(std::string const &name,
+                                              Json::Value const &config);
+
         /// @brief Sets the amount of time (in microseconds) that the server
         /// loop will sleep each loop when a client is connected (0 means no
         /// sleep)
@@ -242,6 +266,14 @@ namespace server {
         /// Call only before starting the server or from within server thread.
         OSVR_SERVER_EXPORT void setSleepTime(int microseconds);
 
+        /// @brief Sets the additional (memory locking, real-time scheduling,
+        /// CPU pinning) requests made of the system, for the server thread,
+        /// while a client is connected.
+        ///
+        /// Call only before starting the server or from within server thread.
+        OSVR_SERVER_EXPORT void
+        setLowLatencyOptions(common::LowLatency::Options const &opts);
+
 #if 0
         /// @brief Returns the amount of time (in microseconds) that the server
         /// loop sleeps each loop.
@@ -51,6 +51,10 @@ typedef void (*OSVR_PluginDataDeleteCallback)(void *pluginData);
 typedef OSVR_ReturnCode (*OSVR_HardwareDetectCallback)(
     OSVR_PluginRegContext ctx, void *userData);
 
+/** @brief Function type of a Hardware Probe callback: see
+    osvrPluginRegisterAsyncHardwareDetectCallback() */
+typedef OSVR_ReturnCode (*OSVR_HardwareProbeCallback)(void *userData);
+
 /** @brief Function type of a driver instantiation callback */
 typedef OSVR_ReturnCode (*OSVR_DriverInstantiationCallback)(
     OSVR_PluginRegContext ctx, const char *params, void *userData);
@@ -0,0 +1,114 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TripleBuffer_h_GUID_B848EB28_40F2_4EC1_A281_2E91543B0567
+#define INCLUDED_TripleBuffer_h_GUID_B848EB28_40F2_4EC1_A281_2E91543B0567
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace osvr {
+namespace util {
+
+    /// @brief A wait-free handoff of the latest value of some type from a
+    /// single producer thread to a single consumer thread.
+    ///
+    /// There are three buffers: one the producer writes into, one the
+    /// consumer reads from, and one in the middle. Publishing and consuming
+    /// both just swap their buffer with the middle one using a single atomic
+    /// exchange, so neither side ever blocks or fails, and the consumer always
+    /// sees the most recent complete value (intermediate values it was too slow
+    /// to see are dropped). No copies are made by the handoff itself.
+    ///
+    /// Requires T to be default-constructible. If T needs over-alignment (for
+    /// instance, fixed-size vectorizable Eigen types), allocate the containing
+    /// object accordingly.
+    template <typename T> class TripleBuffer {
+      public:
+        TripleBuffer() = default;
+        TripleBuffer(TripleBuffer const &) = delete;
+        TripleBuffer &operator=(TripleBuffer const &) = delete;
+
+        /// @name Producer-thread methods
+        /// @{
+        /// @brief Access the buffer to fill in before calling publish(). Its
+        /// contents are whatever was last handed back by the consumer, so
+        /// overwrite everything that matters.
+        T &getWriteBuffer() { return m_buffers[m_writeIndex]; }
+
+        /// @brief Makes the contents of the write buffer available to the
+        /// consumer, and gets a new write buffer.
+        void publish() {
+            auto prev = m_middle.exchange(
+                static_cast<std::uint8_t>(m_writeIndex | FRESH_BIT),
+                std::memory_order_acq_rel);
+            m_writeIndex = prev & INDEX_MASK;
+        }
+        /// @}
+
+        /// @name Consumer-thread methods
+        /// @{
+        /// @brief If a value has been published since the last call, makes it
+        /// the read buffer.
+        /// @return true if the read buffer changed.
+        bool consume() {
+            if (!(m_middle.load(std::memory_order_relaxed) & FRESH_BIT)) {
+                return false;
+            }
+            auto prev =
+                m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+            m_readIndex = prev & INDEX_MASK;
+            return true;
+        }
+
+        /// @brief Access the most recently consumed value (or a
+        /// value-initialized one, if none has been consumed yet).
+        T const &getReadBuffer() const { return m_buffers[m_readIndex]; }
+        /// @}
+
+      private:
+        static const std::uint8_t INDEX_MASK = 0x03;
+        static const std::uint8_t FRESH_BIT = 0x04;
+        std::array<T, 3> m_buffers{};
+        /// Index of the middle buffer, plus FRESH_BIT if it was last swapped in
+        /// by the producer and not yet taken by the consumer.
+        std::atomic<std::uint8_t> m_middle{std::uint8_t(1)};
+        /// Owned by the producer thread
+        std::uint8_t m_writeIndex = 0;
+        /// Owned by the consumer thread
+        std::uint8_t m_readIndex = 2;
+    };
+
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_TripleBuffer_h_GUID_B848EB28_40F2_4EC1_A281_2E91543B0567
@@ -64,166 +64,192 @@
 #include <sstream>
 #include <vector>
 #include <algorithm>
+#include <mutex>
 
 #ifdef OSVR_MULTISERVER_VERBOSE
 #include <iostream>
 #endif
 
+/// The parts of a HID device enumeration entry we need, copied out of
+/// hidapi's list so they can be passed from the probe to the detect callback.
+struct HidDeviceInfo {
+    std::string path;
+    unsigned short vendor_id;
+    unsigned short product_id;
+    int interface_number;
+};
+
 class VRPNHardwareDetect : boost::noncopyable {
   public:
     VRPNHardwareDetect(VRPNMultiserverData &data) : m_data(data) {}
-    OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx) {
-        bool gotDevice;
+
+    /// Called on the hardware detect worker thread: enumerates HID devices
+    /// and succeeds only if there's a supported device we haven't opened yet,
+    /// which it saves for the detect callback. Doesn't touch OSVR or VRPN.
+    OSVR_ReturnCode probe() {
+        std::vector<HidDeviceInfo> found;
+        struct hid_device_info *enumData = hid_enumerate(0, 0);
+        for (struct hid_device_info *dev = enumData; dev != nullptr;
+             dev = dev->next) {
 #ifdef OSVR_MULTISERVER_VERBOSE
-        bool first = true;
+            std::cout << "[OSVR Multiserver] HID Enumeration: "
+                      << boost::format("0x%04x") % dev->vendor_id << ":"
+                      << boost::format("0x%04x") % dev->product_id
+                      << std::endl;
 #endif
-        do {
-            gotDevice = false;
-            struct hid_device_info *enumData = hid_enumerate(0, 0);
-            for (struct hid_device_info *dev = enumData; dev != nullptr;
-                 dev = dev->next) {
+            if (dev->path == nullptr ||
+                !m_isSupported(dev->vendor_id, dev->product_id) ||
+                m_isPathHandled(dev->path)) {
+                continue;
+            }
+            found.push_back(HidDeviceInfo{dev->path, dev->vendor_id,
+                                          dev->product_id,
+                                          dev->interface_number});
+        }
+        hid_free_enumeration(enumData);
 
-                if (m_isPathHandled(dev->path)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_found = std::move(found);
+        return m_found.empty() ? OSVR_RETURN_FAILURE : OSVR_RETURN_SUCCESS;
+    }
+
+    /// Called on the server main loop after a successful probe(): creates
+    /// devices for what it found.
+    OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx) {
+        std::vector<HidDeviceInfo> found;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            found.swap(m_found);
+        }
+        for (auto it = begin(found), e = end(found); it != e; ++it) {
+            auto const &dev = *it;
+            if (m_isPathHandled(dev.path.c_str())) {
+                continue;
+            }
+            // Razer Hydra
+            if (dev.vendor_id == 0x1532 && dev.product_id == 0x0300) {
+                // OK, found one half of device, let's find the other half.
+                HidDeviceInfo const *dataDev = &dev;
+                auto other = std::find_if(
+                    it + 1, e, [&](HidDeviceInfo const &candidate) {
+                        return candidate.vendor_id == 0x1532 &&
+                               candidate.product_id == 0x0300 &&
+                               !m_isPathHandled(candidate.path.c_str());
+                    });
+                if (other == e) {
+                    std::cout
+                        << "com_osvr_Multiserver warning: could only find "
+                           "one of two interfaces for the Razer Hydra!"
+                        << std::endl;
                     continue;
                 }
-
-#ifdef OSVR_MULTISERVER_VERBOSE
-                if (first) {
-                    std::cout << "[OSVR Multiserver] HID Enumeration: "
-                              << boost::format("0x%04x") % dev->vendor_id << ":"
-                              << boost::format("0x%04x") % dev->product_id
-                              << std::endl;
+                HidDeviceInfo const *ctrlDev = &(*other);
+                if (dataDev->interface_number == 1 &&
+                    ctrlDev->interface_number == 0) {
+                    // If we found these reversed, swap them: the data
+                    // device should be interface 0, control is interface 1
+                    // (if the interface numbers are valid at all)
+                    std::swap(dataDev, ctrlDev);
                 }
-#endif
 
-                if (gotDevice) {
-                    continue;
-                }
-                // Razer Hydra
-                if (dev->vendor_id == 0x1532 && dev->product_id == 0x0300) {
-                    // OK, found one half of device, let's find the other half.
-                    auto dataDev = dev;
-                    auto ctrlDev = dev->next;
-                    while (ctrlDev != nullptr &&
-                           !(ctrlDev->vendor_id == 0x1532 &&
-                             ctrlDev->product_id == 0x0300)) {
-                        ctrlDev = ctrlDev->next;
-                    }
-                    if (!ctrlDev) {
-                        std::cout
-                            << "com_osvr_Multiserver warning: could only find "
-                               "one of two interfaces for the Razer Hydra!"
-                            << std::endl;
-                        continue;
-                    }
-                    if (dataDev->interface_number == 1 && ctrlDev->interface_number == 0) {
-                        // If we found these reversed, swap them: the data
-                        // device should be interface 0, control is interface 1
-                        // (if the interface numbers are valid at all)
-                        std::swap(dataDev, ctrlDev);
-                    }
+                m_handlePath(dataDev->path);
+                m_handlePath(ctrlDev->path);
 
-                    gotDevice = true;
-                    m_handlePath(dataDev->path);
-                    m_handlePath(ctrlDev->path);
+                auto hydraJsonString = osvr::util::makeString(
+                    com_osvr_Multiserver_RazerHydra_json);
+                Json::Value hydraJson;
+                Json::Reader reader;
+                if (!reader.parse(hydraJsonString, hydraJson)) {
+                    throw std::logic_error("Faulty JSON file for Hydra - "
+                                           "should not be possible!");
+                }
+                /// Decorated name for Hydra
+                std::string name;
+                {
+                    // Razer Hydra
+                    osvr::vrpnserver::VRPNDeviceRegistration reg(ctx);
+                    name =
+                        reg.useDecoratedName(m_data.getName("RazerHydra"));
+                    reg.registerDevice(new vrpn_Tracker_RazerHydra(
+                        name.c_str(), ctrlDev->path.c_str(),
+                        dataDev->path.c_str(), reg.getVRPNConnection()));
+                    reg.setDeviceDescriptor(hydraJsonString);
+                }
+                std::string localName = "*" + name;
 
-                    auto hydraJsonString = osvr::util::makeString(
-                        com_osvr_Multiserver_RazerHydra_json);
-                    Json::Value hydraJson;
-                    Json::Reader reader;
-                    if (!reader.parse(hydraJsonString, hydraJson)) {
-                        throw std::logic_error("Faulty JSON file for Hydra - "
-                                               "should not be possible!");
+                {
+                    // Copy semantic paths for corresponding filter: just
+                    // want left/$target and right/$target
+                    Json::Value filterJson;
+                    if (!reader.parse(
+                            osvr::util::makeString(
+                                com_osvr_Multiserver_OneEuroFilter_json),
+                            filterJson)) {
+                        throw std::logic_error("Faulty JSON file for One "
+                                               "Euro Filter - should not "
+                                               "be possible!");
                     }
-                    /// Decorated name for Hydra
-                    std::string name;
-                    {
-                        // Razer Hydra
-                        osvr::vrpnserver::VRPNDeviceRegistration reg(ctx);
-                        name =
-                            reg.useDecoratedName(m_data.getName("RazerHydra"));
-                        reg.registerDevice(new vrpn_Tracker_RazerHydra(
-                            name.c_str(), ctrlDev->path, dataDev->path,
-                            reg.getVRPNConnection()));
-                        reg.setDeviceDescriptor(hydraJsonString);
+                    auto &filterSem =
+                        (filterJson["semantic"] = Json::objectValue);
+                    auto &hydraSem = hydraJson["semantic"];
+                    for (auto const &element : {"left", "right"}) {
+                        filterSem[element] = Json::objectValue;
+                        filterSem[element]["$target"] =
+                            hydraSem[element]["$target"];
+                    }
+                    auto &filterAuto = (filterJson["automaticAliases"] =
+                                            Json::objectValue);
+                    filterAuto["$priority"] =
+                        130; // enough to override a normal automatic route.
+                    auto &hydraAuto = hydraJson["automaticAliases"];
+                    for (auto const &element :
+                         {"/me/hands/left", "/me/hands/right"}) {
+                        filterAuto[element] = hydraAuto[element];
                     }
-                    std::string localName = "*" + name;
-
-                    {
-                        // Copy semantic paths for corresponding filter: just
-                        // want left/$target and right/$target
-                        Json::Value filterJson;
-                        if (!reader.parse(
-                                osvr::util::makeString(
-                                    com_osvr_Multiserver_OneEuroFilter_json),
-                                filterJson)) {
-                            throw std::logic_error("Faulty JSON file for One "
-                                                   "Euro Filter - should not "
-                                                   "be possible!");
-                        }
-                        auto &filterSem =
-                            (filterJson["semantic"] = Json::objectValue);
-                        auto &hydraSem = hydraJson["semantic"];
-                        for (auto const &element : {"left", "right"}) {
-                            filterSem[element] = Json::objectValue;
-                            filterSem[element]["$target"] =
-                                hydraSem[element]["$target"];
-                        }
-                        auto &filterAuto = (filterJson["automaticAliases"] =
-                                                Json::objectValue);
-                        filterAuto["$priority"] =
-                            130; // enough to override a normal automatic route.
-                        auto &hydraAuto = hydraJson["automaticAliases"];
-                        for (auto const &element :
-                             {"/me/hands/left", "/me/hands/right"}) {
-                            filterAuto[element] = hydraAuto[element];
-                        }
 
-                        // Corresponding filter
-                        osvr::vrpnserver::VRPNDeviceRegistration reg(ctx);
-                        reg.registerDevice(new vrpn_Tracker_FilterOneEuro(
-                            reg.useDecoratedName(
-                                    m_data.getName("OneEuroFilter")).c_str(),
-                            reg.getVRPNConnection(), localName.c_str(), 2, 1.15,
-                            1.0, 1.2, 1.5, 5.0, 1.2));
+                    // Corresponding filter
+                    osvr::vrpnserver::VRPNDeviceRegistration reg(ctx);
+                    reg.registerDevice(new vrpn_Tracker_FilterOneEuro(
+                        reg.useDecoratedName(
+                                m_data.getName("OneEuroFilter")).c_str(),
+                        reg.getVRPNConnection(), localName.c_str(), 2, 1.15,
+                        1.0, 1.2, 1.5, 5.0, 1.2));
 
-                        reg.setDeviceDescriptor(filterJson.toStyledString());
-                    }
-                    continue;
+                    reg.setDeviceDescriptor(filterJson.toStyledString());
                 }
+                continue;
+            }
 
-                // OSVR Hacker Dev Kit
-                if ((dev->vendor_id == 0x1532 && dev->product_id == 0x0b00) ||
-                    (dev->vendor_id == 0x03EB && dev->product_id == 0x2421)) {
-                    gotDevice = true;
-                    m_handlePath(dev->path);
-                    osvr::vrpnserver::VRPNDeviceRegistration reg(ctx);
-                    auto name = m_data.getName("OSVRHackerDevKit");
-                    auto decName = reg.useDecoratedName(name);
-                    reg.constructAndRegisterDevice<
-                        vrpn_Tracker_OSVRHackerDevKit>(name);
-                    reg.setDeviceDescriptor(osvr::util::makeString(
+            // OSVR Hacker Dev Kit
+            if ((dev.vendor_id == 0x1532 && dev.product_id == 0x0b00) ||
+                (dev.vendor_id == 0x03EB && dev.product_id == 0x2421)) {
+                m_handlePath(dev.path);
+                osvr::vrpnserver::VRPNDeviceRegistration reg(ctx);
+                auto name = m_data.getName("OSVRHackerDevKit");
+                auto decName = reg.useDecoratedName(name);
+                reg.constructAndRegisterDevice<
+                    vrpn_Tracker_OSVRHackerDevKit>(name);
+                reg.setDeviceDescriptor(osvr::util::makeString(
+                    com_osvr_Multiserver_OSVRHackerDevKit_json));
+                {
+                    osvr::vrpnserver::VRPNDeviceRegistration reg2(ctx);
+                    reg2.registerDevice(
+                        new vrpn_Tracker_DeadReckoning_Rotation(
+                            reg2.useDecoratedName(m_data.getName(
+                                "OSVRHackerDevKitPrediction")),
+                            reg2.getVRPNConnection(), "*" + decName, 1,
+                            32.0e-3, false));
+                    reg2.setDeviceDescriptor(osvr::util::makeString(
                         com_osvr_Multiserver_OSVRHackerDevKit_json));
-                    {
-                        osvr::vrpnserver::VRPNDeviceRegistration reg2(ctx);
-                        reg2.registerDevice(
-                            new vrpn_Tracker_DeadReckoning_Rotation(
-                                reg2.useDecoratedName(m_data.getName(
-                                    "OSVRHackerDevKitPrediction")),
-                                reg2.getVRPNConnection(), "*" + decName, 1,
-                                32.0e-3, false));
-                        reg2.setDeviceDescriptor(osvr::util::makeString(
-                            com_osvr_Multiserver_OSVRHackerDevKit_json));
-                    }
-                    continue;
                 }
+                continue;
+            }
 
 				//Sensics zSight (This block adds detection of Sensics zSight 1280 dual input device by osvr server)
 				//you can add other zSight devices by adding vendor id and product id in if block.
 				#if defined(_WIN32) && defined(VRPN_USE_DIRECTINPUT) && defined(VRPN_HAVE_ATLBASE)
-					if ((dev->vendor_id == 0x16d0 && dev->product_id == 0x0515)) {
-						gotDevice = true;
-						m_handlePath(dev->path);
+					if ((dev.vendor_id == 0x16d0 && dev.product_id == 0x0515)) {
+						m_handlePath(dev.path);
 						osvr::vrpnserver::VRPNDeviceRegistration reg(ctx);
 						auto name = m_data.getName("Sensics_zSight");
 						auto decName = reg.useDecoratedName(name);
@@ -234,27 +260,44 @@ class VRPNHardwareDetect : boost::noncopyable {
 						continue;
 					}
 				#endif
-            }
-            hid_free_enumeration(enumData);
-
-#ifdef OSVR_MULTISERVER_VERBOSE
-            first = false;
-#endif
-
-        } while (gotDevice);
+        }
         return OSVR_RETURN_SUCCESS;
     }
 
   private:
+    static bool m_isSupported(unsigned short vid, unsigned short pid) {
+        // Razer Hydra
+        if (vid == 0x1532 && pid == 0x0300) {
+            return true;
+        }
+        // OSVR Hacker Dev Kit
+        if ((vid == 0x1532 && pid == 0x0b00) ||
+            (vid == 0x03EB && pid == 0x2421)) {
+            return true;
+        }
+#if defined(_WIN32) && defined(VRPN_USE_DIRECTINPUT) &&                        \
+    defined(VRPN_HAVE_ATLBASE)
+        // Sensics zSight
+        if (vid == 0x16d0 && pid == 0x0515) {
+            return true;
+        }
+#endif
+        return false;
+    }
     bool m_isPathHandled(const char *path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
         return std::find(begin(m_handledPaths), end(m_handledPaths),
                          std::string(path)) != end(m_handledPaths);
     }
-    void m_handlePath(const char *path) {
-        m_handledPaths.push_back(std::string(path));
+    void m_handlePath(std::string const &path) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_handledPaths.push_back(path);
     }
     VRPNMultiserverData &m_data;
+    /// Protects the members below, which are shared with probe().
+    std::mutex m_mutex;
     std::vector<std::string> m_handledPaths;
+    std::vector<HidDeviceInfo> m_found;
 };
 
 OSVR_PLUGIN(com_osvr_Multiserver) {
@@ -262,7 +305,10 @@ OSVR_PLUGIN(com_osvr_Multiserver) {
 
     VRPNMultiserverData &data =
         *context.registerObjectForDeletion(new VRPNMultiserverData);
-    context.registerHardwareDetectCallback(new VRPNHardwareDetect(data));
+    // hid_init() isn't thread-safe, so do it here rather than letting the
+    // first enumeration on the probe thread do it implicitly.
+    hid_init();
+    context.registerAsyncHardwareDetectCallback(new VRPNHardwareDetect(data));
 
     osvrRegisterDriverInstantiationCallback(
         ctx, "YEI_3Space_Sensor", &wrappedConstructor<&createYEI>, &data);
@@ -30,51 +30,109 @@
 #include <osvr/Kalman/FlexibleKalmanFilter.h>
 #include <osvr/Kalman/AbsoluteOrientationMeasurement.h>
 #include <osvr/Kalman/AngularVelocityMeasurement.h>
-#include <osvr/Util/EigenQuatExponentialMap.h>
+#include <osvr/Kalman/LinearAccelerationInput.h>
+#include <osvr/Kalman/OrientationAndAngularVelocityMeasurement.h>
 
 // Standard includes
 // - none
 
 namespace osvr {
 namespace vbtracker {
+    /// Gets the orientation from the measurement, rotated into camera space.
+    inline Eigen::Quaterniond
+    getCameraSpaceOrientation(TrackingSystem const &sys,
+                              CannedIMUMeasurement const &meas) {
+        Eigen::Quaterniond quat;
+        meas.restoreQuat(quat);
+        /// @todo do this without rotating into camera space?
+        return getQuatToCameraSpace(sys) * quat;
+    }
+
+    /// Gets the angular velocity from the measurement, rotated into camera
+    /// space - it's bTb and we want cTc
+    inline Eigen::Vector3d
+    getCameraSpaceAngVel(BodyState const &state,
+                         CannedIMUMeasurement const &meas) {
+        Eigen::Vector3d angVel;
+        meas.restoreAngVel(angVel);
+        /// Conjugating the incremental rotation exp(angVel) by cTb is the same
+        /// as rotating its axis by cTb, so there's no need to go through the
+        /// exponential map and back.
+        /// @todo do this without rotating into camera space?
+        return state.getQuaternion() * angVel;
+    }
+
+    /// Corrects the state with an IMU-derived measurement, letting the
+    /// process model adapt to the innovation.
+    template <typename MeasurementType>
+    inline void correctWithIMU(BodyState &state,
+                               BodyProcessModel &processModel,
+                               MeasurementType &kalmanMeas) {
+        auto nis = kalman::correct(state, processModel, kalmanMeas);
+        processModel.addIMUInnovation(
+            nis, kalman::types::Dimension<MeasurementType>::value);
+    }
+
     inline void applyOriToState(TrackingSystem const &sys, BodyState &state,
                                 BodyProcessModel &processModel,
                                 CannedIMUMeasurement const &meas) {
-        Eigen::Quaterniond quat;
-        meas.restoreQuat(quat);
         Eigen::Vector3d var;
         meas.restoreQuatVariance(var);
-
-        /// Rotate it into camera space
-        /// @todo do this without rotating into camera space?
-        quat = getQuatToCameraSpace(sys) * quat;
         /// @todo transform variance?
 
-        kalman::AbsoluteOrientationMeasurement<BodyState> kalmanMeas{quat, var};
-        kalman::correct(state, processModel, kalmanMeas);
+        kalman::AbsoluteOrientationMeasurement<BodyState> kalmanMeas{
+            getCameraSpaceOrientation(sys, meas), var};
+        correctWithIMU(state, processModel, kalmanMeas);
     }
 
     inline void applyAngVelToState(TrackingSystem const &sys, BodyState &state,
                                    BodyProcessModel &processModel,
                                    CannedIMUMeasurement const &meas) {
-
-        Eigen::Vector3d angVel;
-        meas.restoreAngVel(angVel);
         Eigen::Vector3d var;
         meas.restoreAngVelVariance(var);
+        /// @todo transform variance?
 
-        /// Rotate it into camera space - it's bTb and we want cTc
-        /// @todo do this without rotating into camera space?
-        Eigen::Quaterniond cTb = state.getQuaternion();
-        //Eigen::Matrix3d bTc(state.getQuaternion().conjugate());
-        Eigen::Quaterniond incrementalQuat = cTb * util::quat_exp_map(angVel).exp() *
-            cTb.conjugate();
-        angVel = util::quat_exp_map(incrementalQuat).ln();
-        // angVel = (getRotationMatrixToCameraSpace(sys) * angVel).eval();
+        kalman::AngularVelocityMeasurement<BodyState> kalmanMeas{
+            getCameraSpaceAngVel(state, meas), var};
+        correctWithIMU(state, processModel, kalmanMeas);
+    }
+
+    /// Applies an orientation and angular velocity from the same instant in
+    /// a single correction.
+    inline void applyOriAndAngVelToState(TrackingSystem const &sys,
+                                         BodyState &state,
+                                         BodyProcessModel &processModel,
+                                         CannedIMUMeasurement const &meas) {
+        Eigen::Vector3d quatVar;
+        meas.restoreQuatVariance(quatVar);
+        Eigen::Vector3d angVelVar;
+        meas.restoreAngVelVariance(angVelVar);
         /// @todo transform variance?
 
-        kalman::AngularVelocityMeasurement<BodyState> kalmanMeas{angVel, var};
-        kalman::correct(state, processModel, kalmanMeas);
+        kalman::OrientationAndAngularVelocityMeasurement<BodyState> kalmanMeas{
+            getCameraSpaceOrientation(sys, meas), quatVar,
+            getCameraSpaceAngVel(state, meas), angVelVar};
+        correctWithIMU(state, processModel, kalmanMeas);
+    }
+
+    /// Integrates a linear acceleration measurement over dt: the specific
+    /// force is rotated into camera space with the current orientation
+    /// estimate, and gravity is added back to get the acceleration of the
+    /// body.
+    inline void applyLinAccelToState(TrackingSystem const &sys,
+                                     BodyState &state,
+                                     CannedIMUMeasurement const &meas,
+                                     double dt) {
+        Eigen::Vector3d accel;
+        meas.restoreLinAccel(accel);
+        Eigen::Vector3d var;
+        meas.restoreLinAccelVariance(var);
+        /// @todo transform variance? It's currently isotropic anyway.
+
+        Eigen::Vector3d cameraSpaceAccel =
+            state.getQuaternion() * accel + getCameraSpaceGravity(sys);
+        kalman::pose_externalized_rotation::applyLinearAcceleration(
+            state, cameraSpaceAccel, var.maxCoeff(), dt);
     }
 
     void applyIMUToState(TrackingSystem const &sys,
@@ -86,15 +144,23 @@ namespace vbtracker {
             auto dt = osvrTimeValueDurationSeconds(&newTime, &initialTime);
             kalman::predict(state, processModel, dt);
             state.externalizeRotation();
+            if (meas.linAccelValid()) {
+                /// Held from newTime back to initialTime: the newest
+                /// acceleration is the best estimate we have for the interval.
+                applyLinAccelToState(sys, state, meas, dt);
+            }
         }
-        if (meas.orientationValid()) {
+        if (meas.orientationValid() && meas.angVelValid()) {
+            applyOriAndAngVelToState(sys, state, processModel, meas);
+        } else if (meas.orientationValid()) {
             applyOriToState(sys, state, processModel, meas);
         } else if (meas.angVelValid()) {
             applyAngVelToState(sys, state, processModel, meas);
 
         } else {
-            // unusually, the measurement is totally invalid. Just normalize and
-            // go on.
+            // Nothing to correct with: either an acceleration-only
+            // measurement (already applied above) or, unusually, a totally
+            // invalid one. Just normalize and go on.
             state.postCorrect();
         }
     }
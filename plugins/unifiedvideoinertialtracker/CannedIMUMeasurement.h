@@ -38,8 +38,9 @@
 namespace osvr {
 namespace vbtracker {
 
-    /// A safe way to store and transport an orientation measurement or an
-    /// angular velocity measurement without needing special alignment
+    /// A safe way to store and transport an orientation measurement, an
+    /// angular velocity measurement, or a linear acceleration measurement
+    /// without needing special alignment
     class CannedIMUMeasurement {
       public:
         void setOrientation(Eigen::Quaterniond const &quat,
@@ -85,6 +86,30 @@ namespace vbtracker {
             var = Eigen::Vector3d::Map(m_angVelVar.data());
         }
 
+        /// @param accel Specific force (what an accelerometer reads: includes
+        /// the reaction to gravity) in the body frame, with any estimated
+        /// bias already removed. Units: m/s^2
+        void setLinAccel(Eigen::Vector3d const &accel,
+                         Eigen::Vector3d const &variance) {
+            Eigen::Vector3d::Map(m_linAccel.data()) = accel;
+            Eigen::Vector3d::Map(m_linAccelVar.data()) = variance;
+            m_linAccelValid = true;
+        }
+
+        bool linAccelValid() const { return m_linAccelValid; }
+        void restoreLinAccel(Eigen::Vector3d &accel) const {
+            BOOST_ASSERT_MSG(linAccelValid(), "restoring lin accel on "
+                                              "an invalid lin accel "
+                                              "measurement!");
+            accel = Eigen::Vector3d::Map(m_linAccel.data());
+        }
+        void restoreLinAccelVariance(Eigen::Vector3d &var) const {
+            BOOST_ASSERT_MSG(linAccelValid(), "restoring lin accel variance "
+                                              "on an invalid lin accel "
+                                              "measurement!");
+            var = Eigen::Vector3d::Map(m_linAccelVar.data());
+        }
+
       private:
         bool m_orientationValid = false;
         std::array<double, 4> m_quat;
@@ -92,6 +117,9 @@ namespace vbtracker {
         bool m_angVelValid = false;
         std::array<double, 3> m_angVel;
         std::array<double, 3> m_angVelVar;
+        bool m_linAccelValid = false;
+        std::array<double, 3> m_linAccel;
+        std::array<double, 3> m_linAccelVar;
     };
 } // namespace vbtracker
 } // namespace osvr
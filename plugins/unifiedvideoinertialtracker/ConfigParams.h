@@ -52,6 +52,20 @@ namespace vbtracker {
 
         /// units: (rad/sec)^2
         double angularVelocityVariance = 1.0e-8;
+
+        /// Should linear acceleration reports be used to propagate position
+        /// (mainly so that short optical dropouts don't leave position to
+        /// coast on velocity alone)? Reports must be raw accelerometer
+        /// readings (including the reaction to gravity), in m/s^2, in the
+        /// same frame as the orientation reports.
+        bool useLinearAcceleration = false;
+
+        /// units: (m/s^2)^2
+        double linearAccelerationVariance = 0.1;
+
+        /// Random-walk noise of the accelerometer bias estimate.
+        /// units: (m/s^2)^2/sec
+        double accelerometerBiasNoise = 1.0e-5;
     };
 
     /// General configuration parameters
@@ -62,6 +76,44 @@ namespace vbtracker {
         /// Seconds beyond the current time to predict, using the Kalman state.
         double additionalPrediction = 24. / 1000.;
 
+        /// Seconds from the middle of a camera frame's exposure to the
+        /// earliest the image source could hand us that frame (half the
+        /// exposure, plus readout and transfer). Frame timestamps are
+        /// backdated by this much, after jitter in the delivery times has been
+        /// removed. Any time accounted for here can come out of
+        /// additionalPrediction.
+        double cameraLatency = 0.;
+
+        /// On Linux, the Video4Linux2 device (such as "/dev/video0") to
+        /// capture the tracking camera from directly, rather than through
+        /// OpenCV (which is used for camera 0 if this is empty, the default,
+        /// or can't be opened). Frames from this device carry driver
+        /// timestamps, so cameraLatency then only needs to cover up to when
+        /// the driver received the frame.
+        std::string v4l2Device;
+
+        /// Number of driver buffers to request for v4l2Device. The newest
+        /// filled buffer is always the one used, so more buffers only guard
+        /// against the driver dropping frames.
+        int v4l2Buffers = 3;
+
+        /// Resolution to capture from v4l2Device at: the device is not used
+        /// if it can't provide exactly this. The default is the HDK IR
+        /// camera's.
+        int v4l2Width = 640;
+        int v4l2Height = 480;
+
+        /// Frame rate to request from v4l2Device. The default is the HDK IR
+        /// camera's.
+        int v4l2FrameRate = 100;
+
+        /// Frames whose estimated exposure time is more than this many
+        /// seconds in the past by the time the tracker gets to them are
+        /// skipped (the IMU carries the estimate until a fresh frame arrives).
+        /// Frames that a newer one replaced before the tracker got to them
+        /// are always skipped.
+        double maxFrameAge = 0.1;
+
         /// Max residual (pixel units) for a beacon before applying a variance
         /// penalty.
         double maxResidual = 75;
@@ -76,6 +128,49 @@ namespace vbtracker {
         /// "keypoint diameter", and still be considered the same blob.
         double blobMoveThreshold = 4.;
 
+        /// Whether, while a target is being tracked, identified LEDs should be
+        /// matched to this frame's blobs near where the (IMU-propagated) body
+        /// state predicts their beacons will appear, rather than near where
+        /// they were last frame. Keeps LED identities (and thus their blink
+        /// code history) through motion too fast for blobMoveThreshold alone.
+        bool predictiveBlobAssociation = true;
+
+        /// Whether, while a target is being tracked, a blob whose blink code
+        /// hasn't been read yet may be provisionally identified as the
+        /// otherwise-unseen, camera-facing beacon whose predicted location it
+        /// is unambiguously nearest, so it can be used right away. The blink
+        /// code confirms or revokes the provisional ID once it's been read.
+        bool provisionalIdentification = true;
+
+        /// Maximum distance, in pixels, between a blob and a beacon's
+        /// predicted location for provisional identification.
+        double provisionalIdentificationMaxDistance = 6.;
+
+        /// A blob is only provisionally identified if the next-nearest
+        /// candidate beacon is predicted at least this many times as far away
+        /// as the nearest.
+        double provisionalIdentificationAmbiguityRatio = 2.;
+
+        /// Number of iterations of the full 6-DoF RANSAC PnP used to acquire a
+        /// target (at startup, or after losing it without a usable IMU
+        /// orientation).
+        int ransacIterations = 5;
+
+        /// Whether, once room calibration is complete, a target should be
+        /// (re)acquired by taking its rotation from the IMU and solving only
+        /// for translation, which needs as few as two identified beacons.
+        /// The full PnP then only refines the result, when there are enough
+        /// beacons for it.
+        bool imuAidedAcquisition = true;
+
+        /// Maximum number of two-beacon hypotheses for IMU-aided acquisition:
+        /// when there are no more beacon pairs than this, all are tried.
+        int imuAidedAcquisitionHypotheses = 32;
+
+        /// IMU orientation reports further than this many seconds from the
+        /// frame time aren't trusted for IMU-aided acquisition.
+        double imuAidedAcquisitionMaxAge = 0.1;
+
         /// Whether to show the debug windows and debug messages.
         bool debug = false;
 
@@ -98,6 +193,22 @@ namespace vbtracker {
         /// smaller = faster decay/higher damping. In range [0, 1]
         double angularVelocityDecayCoefficient = 0.9;
 
+        /// Whether to scale the process noise autocorrelation above based on
+        /// the normalized innovations of the video and IMU measurements,
+        /// rather than using it as-is: lower noise (less jitter) when the
+        /// measurements agree with the predictions, higher (less lag) when
+        /// they don't.
+        bool adaptiveProcessNoise = false;
+
+        /// Approximate number of measurements the adaptive process noise
+        /// estimate averages over.
+        int adaptiveNoiseWindow = 50;
+
+        /// Bounds on the factor the adaptive process noise may scale the
+        /// process noise autocorrelation by.
+        double adaptiveNoiseMinScale = 0.1;
+        double adaptiveNoiseMaxScale = 10.;
+
         /// The measurement variance (units: m^2) is included in the plugin
         /// along with the coordinates of the beacons. Some beacons are observed
         /// with higher variance than others, due to known difficulties in
@@ -71,13 +71,36 @@ namespace vbtracker {
 
         getOptionalParameter(config.additionalPrediction, root,
                              "additionalPrediction");
+        getOptionalParameter(config.cameraLatency, root, "cameraLatency");
+        getOptionalParameter(config.v4l2Device, root, "v4l2Device");
+        getOptionalParameter(config.v4l2Buffers, root, "v4l2Buffers");
+        getOptionalParameter(config.v4l2Width, root, "v4l2Width");
+        getOptionalParameter(config.v4l2Height, root, "v4l2Height");
+        getOptionalParameter(config.v4l2FrameRate, root, "v4l2FrameRate");
+        getOptionalParameter(config.maxFrameAge, root, "maxFrameAge");
         getOptionalParameter(config.maxResidual, root, "maxResidual");
         getOptionalParameter(config.initialBeaconError, root,
                              "initialBeaconError");
         getOptionalParameter(config.blobMoveThreshold, root,
                              "blobMoveThreshold");
+        getOptionalParameter(config.predictiveBlobAssociation, root,
+                             "predictiveBlobAssociation");
+        getOptionalParameter(config.provisionalIdentification, root,
+                             "provisionalIdentification");
+        getOptionalParameter(config.provisionalIdentificationMaxDistance, root,
+                             "provisionalIdentificationMaxDistance");
+        getOptionalParameter(config.provisionalIdentificationAmbiguityRatio,
+                             root, "provisionalIdentificationAmbiguityRatio");
         getOptionalParameter(config.blobsKeepIdentity, root,
                              "blobsKeepIdentity");
+        getOptionalParameter(config.ransacIterations, root,
+                             "ransacIterations");
+        getOptionalParameter(config.imuAidedAcquisition, root,
+                             "imuAidedAcquisition");
+        getOptionalParameter(config.imuAidedAcquisitionHypotheses, root,
+                             "imuAidedAcquisitionHypotheses");
+        getOptionalParameter(config.imuAidedAcquisitionMaxAge, root,
+                             "imuAidedAcquisitionMaxAge");
         getOptionalParameter(config.numThreads, root, "numThreads");
 #if 0
         getOptionalParameter(config.streamBeaconDebugInfo, root,
@@ -111,6 +134,14 @@ namespace vbtracker {
                              "linearVelocityDecayCoefficient");
         getOptionalParameter(config.angularVelocityDecayCoefficient, root,
                              "angularVelocityDecayCoefficient");
+        getOptionalParameter(config.adaptiveProcessNoise, root,
+                             "adaptiveProcessNoise");
+        getOptionalParameter(config.adaptiveNoiseWindow, root,
+                             "adaptiveNoiseWindow");
+        getOptionalParameter(config.adaptiveNoiseMinScale, root,
+                             "adaptiveNoiseMinScale");
+        getOptionalParameter(config.adaptiveNoiseMaxScale, root,
+                             "adaptiveNoiseMaxScale");
         getOptionalParameter(config.measurementVarianceScaleFactor, root,
                              "measurementVarianceScaleFactor");
         getOptionalParameter(config.highResidualVariancePenalty, root,
@@ -152,6 +183,25 @@ namespace vbtracker {
                                  "maxThresholdAlpha");
             getOptionalParameter(config.blobParams.thresholdSteps, blob,
                                  "thresholdSteps");
+            getOptionalParameter(config.blobParams.useIntegerMoments, blob,
+                                 "useIntegerMoments");
+            getOptionalParameter(config.blobParams.adaptiveThreshold, blob,
+                                 "adaptiveThreshold");
+            getOptionalParameter(config.blobParams.adaptiveMaxSpuriousBlobs,
+                                 blob, "adaptiveMaxSpuriousBlobs");
+            getOptionalParameter(
+                config.blobParams.adaptiveMinIdentifiedBeacons, blob,
+                "adaptiveMinIdentifiedBeacons");
+            getOptionalParameter(config.blobParams.adaptiveTargetLostFrames,
+                                 blob, "adaptiveTargetLostFrames");
+            getOptionalParameter(config.blobParams.adaptiveHysteresisFrames,
+                                 blob, "adaptiveHysteresisFrames");
+            getOptionalParameter(config.blobParams.adaptiveThresholdStep, blob,
+                                 "adaptiveThresholdStep");
+            getOptionalParameter(config.blobParams.adaptiveMinThresholdOffset,
+                                 blob, "adaptiveMinThresholdOffset");
+            getOptionalParameter(config.blobParams.adaptiveMaxThresholdOffset,
+                                 blob, "adaptiveMaxThresholdOffset");
         }
 
         /// IMU-related parameters
@@ -166,6 +216,12 @@ namespace vbtracker {
                                  "useAngularVelocity");
             getOptionalParameter(config.imu.angularVelocityVariance, imu,
                                  "angularVelocityVariance");
+            getOptionalParameter(config.imu.useLinearAcceleration, imu,
+                                 "useLinearAcceleration");
+            getOptionalParameter(config.imu.linearAccelerationVariance, imu,
+                                 "linearAccelerationVariance");
+            getOptionalParameter(config.imu.accelerometerBiasNoise, imu,
+                                 "accelerometerBiasNoise");
         }
 
         return config;
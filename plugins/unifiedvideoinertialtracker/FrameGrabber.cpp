@@ -0,0 +1,151 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "FrameGrabber.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <utility>
+
+namespace osvr {
+namespace vbtracker {
+    FrameGrabber::FrameGrabber(ImageSource &source,
+                               FrameTimestampModel const &model,
+                               Callback const &onNewFrame)
+        : m_source(source), m_timestampModel(model),
+          m_onNewFrame(onNewFrame) {}
+
+    FrameGrabber::~FrameGrabber() { stop(); }
+
+    void FrameGrabber::start() {
+        if (m_thread.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_run = true;
+        }
+        m_thread = std::thread{[&] { m_threadAction(); }};
+    }
+
+    void FrameGrabber::stop() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_run = false;
+        }
+        m_newFrameCondVar.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    bool FrameGrabber::haveNewFrame() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_haveNewFrame;
+    }
+
+    bool FrameGrabber::takeNewestFrame(GrabbedFrame &out) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_takeNewestFrameLocked(out);
+    }
+
+    bool FrameGrabber::waitForNewestFrame(GrabbedFrame &out) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_newFrameCondVar.wait(lock, [&] { return m_haveNewFrame || !m_run; });
+        return m_takeNewestFrameLocked(out);
+    }
+
+    FrameGrabber::Stats FrameGrabber::getStats() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+    bool FrameGrabber::m_takeNewestFrameLocked(GrabbedFrame &out) {
+        if (!m_haveNewFrame) {
+            return false;
+        }
+        m_haveNewFrame = false;
+        // Hand over the image buffers rather than swapping them: the taker
+        // may keep references to its old frames (e.g. for debug display), so
+        // only buffers of superseded frames, which nobody else has seen, get
+        // reused for capture.
+        out = m_newest;
+        m_newest.frame.release();
+        m_newest.frameGray.release();
+        return true;
+    }
+
+    void FrameGrabber::m_threadAction() {
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_run) {
+                    return;
+                }
+            }
+            if (!m_source.ok()) {
+                // Might regain the camera, so wait a bit and try again.
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            auto grabbed = m_source.grab();
+            if (grabbed) {
+                // Backdate from when the grab completed (or, if the source
+                // knows, when the driver received the frame) to when the
+                // frame was actually exposed.
+                util::time::TimeValue delivered;
+                if (!m_source.getGrabTimestamp(delivered)) {
+                    delivered = util::time::getNow();
+                }
+                m_back.tv = m_timestampModel(delivered);
+                m_source.retrieve(m_back.frame, m_back.frameGray);
+                grabbed = m_back.frame.data && m_back.frameGray.data;
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!grabbed) {
+                    ++m_stats.grabFailures;
+                    continue;
+                }
+                ++m_stats.captured;
+                m_back.sequence = m_stats.captured;
+                if (m_haveNewFrame) {
+                    ++m_stats.superseded;
+                }
+                std::swap(m_back, m_newest);
+                m_haveNewFrame = true;
+            }
+            m_newFrameCondVar.notify_all();
+            if (m_onNewFrame) {
+                m_onNewFrame();
+            }
+        }
+    }
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,137 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_FrameGrabber_h_GUID_25796D61_0A37_42DA_AEE8_402AC862CD55
+#define INCLUDED_FrameGrabber_h_GUID_25796D61_0A37_42DA_AEE8_402AC862CD55
+
+// Internal Includes
+#include "FrameTimestampModel.h"
+#include "ImageSources/ImageSource.h"
+
+// Library/third-party includes
+#include <osvr/Util/TimeValue.h>
+
+#include <opencv2/core/core.hpp>
+
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace osvr {
+namespace vbtracker {
+    /// A frame as captured by the FrameGrabber.
+    struct GrabbedFrame {
+        cv::Mat frame;
+        cv::Mat frameGray;
+        /// Estimated exposure time.
+        util::time::TimeValue tv = {};
+        /// Number of the frame among all those captured, starting at 1.
+        std::uint64_t sequence = 0;
+    };
+
+    /// Keeps an image source drained on a thread of its own, holding on to
+    /// only the newest frame.
+    ///
+    /// grab() blocks until the camera delivers, and cameras/drivers buffer
+    /// frames that aren't picked up, so a consumer that can't keep up with the
+    /// frame rate would otherwise process ever-older frames. With this in
+    /// between, a slow consumer just skips frames, and the one it gets is
+    /// always the most recent. Frames are timestamped (with the supplied
+    /// timestamp model) as soon as they are grabbed, so skipping doesn't
+    /// distort timestamps either.
+    class FrameGrabber : boost::noncopyable {
+      public:
+        /// Called (from the grabbing thread) each time a new frame becomes
+        /// available.
+        using Callback = std::function<void()>;
+
+        struct Stats {
+            /// Frames grabbed and retrieved successfully.
+            std::uint64_t captured = 0;
+            /// Frames replaced by a newer one before being taken.
+            std::uint64_t superseded = 0;
+            /// Calls to grab() or retrieve() that failed.
+            std::uint64_t grabFailures = 0;
+        };
+
+        FrameGrabber(ImageSource &source, FrameTimestampModel const &model,
+                     Callback const &onNewFrame = Callback{});
+        /// Stops the grabbing thread if it is running.
+        ~FrameGrabber();
+
+        /// Starts the grabbing thread: the image source must not be used by
+        /// anyone else until stop() is called.
+        void start();
+
+        /// Stops and joins the grabbing thread (after the current grab
+        /// completes).
+        void stop();
+
+        /// Whether a frame has been captured since the last one taken.
+        bool haveNewFrame() const;
+
+        /// If there's a frame newer than the last one taken, moves it into
+        /// @p out and returns true. The cv::Mat objects are swapped, not
+        /// copied.
+        bool takeNewestFrame(GrabbedFrame &out);
+
+        /// Blocks until there's a new frame to take or the grabber is
+        /// stopped, then behaves as takeNewestFrame().
+        bool waitForNewestFrame(GrabbedFrame &out);
+
+        Stats getStats() const;
+
+      private:
+        void m_threadAction();
+        bool m_takeNewestFrameLocked(GrabbedFrame &out);
+
+        ImageSource &m_source;
+        FrameTimestampModel m_timestampModel;
+        Callback m_onNewFrame;
+
+        /// Only touched by the grabbing thread.
+        GrabbedFrame m_back;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_newFrameCondVar;
+        /// @name Protected by m_mutex
+        /// @{
+        GrabbedFrame m_newest;
+        bool m_haveNewFrame = false;
+        bool m_run = false;
+        Stats m_stats;
+        /// @}
+
+        std::thread m_thread;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_FrameGrabber_h_GUID_25796D61_0A37_42DA_AEE8_402AC862CD55
@@ -0,0 +1,146 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "FrameTimestampModel.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace osvr {
+namespace vbtracker {
+    /// How much of a late delivery is assumed to be clock drift rather than
+    /// jitter: small, so jitter is mostly rejected.
+    static const double DRIFT_GAIN = 0.02;
+    /// How quickly the frame period estimate follows observed intervals.
+    static const double PERIOD_GAIN = 0.01;
+    /// Smoothing for the mean-jitter statistic.
+    static const double JITTER_ALPHA = 0.05;
+    /// A gap of more than this many frame periods is treated as a stall and
+    /// re-anchors the frame clock.
+    static const double MAX_GAP_FRAMES = 10.;
+
+    FrameTimestampModel::FrameTimestampModel(double captureLatency)
+        : m_captureLatency(captureLatency) {}
+
+    void FrameTimestampModel::reset() {
+        m_haveEpoch = false;
+        m_lastDelivery = 0;
+        m_lastIdeal = 0;
+        m_intervals = 0;
+        m_period = 0;
+        m_meanJitter = 0;
+    }
+
+    util::time::TimeValue FrameTimestampModel::
+    operator()(util::time::TimeValue const &deliveryTime) {
+        if (!m_haveEpoch) {
+            m_epoch = deliveryTime;
+            m_haveEpoch = true;
+            return m_stamp(0);
+        }
+        auto t = util::time::duration(deliveryTime, m_epoch);
+        auto interval = t - m_lastDelivery;
+        if (interval <= 0) {
+            // Time went backwards or stood still: we can't make sense of
+            // that, so start over from here.
+            reset();
+            return (*this)(deliveryTime);
+        }
+        m_lastDelivery = t;
+
+        if (!havePeriod()) {
+            // Just learning the period for now.
+            m_warmupIntervals[m_intervals] = interval;
+            ++m_intervals;
+            if (havePeriod()) {
+                m_computeInitialPeriod();
+            }
+            m_lastIdeal = t;
+            return m_stamp(t);
+        }
+
+        // Account for frames we never saw.
+        auto framesElapsed =
+            std::max(1., std::round((t - m_lastIdeal) / m_period));
+        if (framesElapsed > MAX_GAP_FRAMES) {
+            m_lastIdeal = t;
+            return m_stamp(t);
+        }
+        auto predicted = m_lastIdeal + framesElapsed * m_period;
+        auto residual = t - predicted;
+
+        // Delivery delays can only make a frame later than the camera clock,
+        // so an early frame means our clock is running late: snap to it.
+        auto ideal = residual < 0 ? t : predicted + DRIFT_GAIN * residual;
+
+        // Delivery jitter is zero-mean over the long run, so the (slowly)
+        // averaged raw interval is an unbiased estimate of the period.
+        auto intervalFrames = std::max(1., std::round(interval / m_period));
+        m_period += PERIOD_GAIN * (interval / intervalFrames - m_period);
+        m_meanJitter += JITTER_ALPHA * ((t - ideal) - m_meanJitter);
+        m_lastIdeal = ideal;
+        return m_stamp(ideal);
+    }
+
+    void FrameTimestampModel::m_computeInitialPeriod() {
+        // The median interval is a single frame period (give or take jitter)
+        // as long as fewer than half of the warmup frames were dropped, so it
+        // tells us which intervals span more than one frame and would bias a
+        // plain average upwards.
+        auto sorted = m_warmupIntervals;
+        auto middle = sorted.begin() + sorted.size() / 2;
+        std::nth_element(sorted.begin(), middle, sorted.end());
+        auto nominal = *middle;
+
+        double sum = 0;
+        std::size_t count = 0;
+        for (auto interval : m_warmupIntervals) {
+            if (std::round(interval / nominal) == 1.) {
+                sum += interval;
+                ++count;
+            }
+        }
+        // The median itself always counts, so count is never zero.
+        m_period = sum / count;
+    }
+
+    util::time::TimeValue
+    FrameTimestampModel::m_stamp(double secondsSinceEpoch) const {
+        auto offset = secondsSinceEpoch - m_captureLatency;
+        auto wholeSeconds = std::floor(offset);
+        util::time::TimeValue delta;
+        delta.seconds = static_cast<OSVR_TimeValue_Seconds>(wholeSeconds);
+        delta.microseconds = static_cast<OSVR_TimeValue_Microseconds>(
+            std::round((offset - wholeSeconds) * 1e6));
+        auto ret = m_epoch;
+        osvrTimeValueSum(&ret, &delta);
+        return ret;
+    }
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,101 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_FrameTimestampModel_h_GUID_4AACF3F9_3B23_4F83_81A8_F59CA3AC62AC
+#define INCLUDED_FrameTimestampModel_h_GUID_4AACF3F9_3B23_4F83_81A8_F59CA3AC62AC
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/Util/TimeValue.h>
+
+// Standard includes
+#include <array>
+#include <cstddef>
+
+namespace osvr {
+namespace vbtracker {
+    /// Turns the times at which an image source hands us frames into estimates
+    /// of when those frames were actually exposed.
+    ///
+    /// Cameras expose frames on a (nearly) regular clock, but the time grab()
+    /// returns adds exposure, readout, transfer, and scheduling delays, only
+    /// part of which is constant. This model learns the frame period online,
+    /// tracks the lower envelope of delivery times against that regular clock
+    /// (since delays can only make a frame late, never early) to strip the
+    /// variable part, and then subtracts the configured constant part.
+    class FrameTimestampModel {
+      public:
+        /// @param captureLatency Seconds from the middle of a frame's exposure
+        /// to the earliest that grab() could return it.
+        explicit FrameTimestampModel(double captureLatency = 0.);
+
+        /// Call with the time grab() returned: returns the estimated time of
+        /// the middle of that frame's exposure.
+        util::time::TimeValue
+        operator()(util::time::TimeValue const &deliveryTime);
+
+        /// Forget all learned state, e.g. after the camera restarts.
+        void reset();
+
+        /// Whether enough frames have been seen to regularize timestamps.
+        bool havePeriod() const { return m_intervals >= WARMUP_INTERVALS; }
+
+        /// The current estimate of the frame period in seconds (only
+        /// meaningful if havePeriod())
+        double getFramePeriod() const { return m_period; }
+
+        /// Average of how late frames were delivered relative to the
+        /// regularized frame clock, in seconds: the variable delay that is
+        /// being removed from timestamps.
+        double getMeanDeliveryJitter() const { return m_meanJitter; }
+
+        double getCaptureLatency() const { return m_captureLatency; }
+
+      private:
+        /// Number of frame intervals averaged to seed the period estimate
+        /// before we start correcting timestamps.
+        static const std::size_t WARMUP_INTERVALS = 10;
+        /// Seeds m_period from the intervals collected during warmup.
+        void m_computeInitialPeriod();
+        util::time::TimeValue m_stamp(double secondsSinceEpoch) const;
+
+        double m_captureLatency;
+        bool m_haveEpoch = false;
+        /// Time of the first frame: all other times are kept as seconds since
+        /// this.
+        util::time::TimeValue m_epoch;
+        double m_lastDelivery = 0;
+        /// Regularized ("ideal") delivery time of the last frame.
+        double m_lastIdeal = 0;
+        std::size_t m_intervals = 0;
+        std::array<double, WARMUP_INTERVALS> m_warmupIntervals;
+        double m_period = 0;
+        double m_meanJitter = 0;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_FrameTimestampModel_h_GUID_4AACF3F9_3B23_4F83_81A8_F59CA3AC62AC
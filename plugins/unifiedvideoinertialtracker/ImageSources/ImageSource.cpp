@@ -38,5 +38,8 @@ namespace vbtracker {
         retrieveColor(color);
         cv::cvtColor(color, gray, CV_RGB2GRAY);
     }
+    bool ImageSource::getGrabTimestamp(util::time::TimeValue &) const {
+        return false;
+    }
 } // namespace vbtracker
 } // namespace osvr
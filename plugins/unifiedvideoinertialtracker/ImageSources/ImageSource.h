@@ -29,6 +29,7 @@
 // - none
 
 // Library/third-party includes
+#include <osvr/Util/TimeValue.h>
 #include <opencv2/core/core.hpp>
 
 // Standard includes
@@ -57,6 +58,12 @@ namespace vbtracker {
         /// Call after grab() to get the actual image data.
         virtual void retrieve(cv::Mat &color, cv::Mat &gray);
 
+        /// Call after grab(): if the source knows when the grabbed frame was
+        /// captured (for instance, from a driver timestamp), sets @p tv to
+        /// that time and returns true. Otherwise, returns false, and the
+        /// caller should timestamp the frame as grab() returns.
+        virtual bool getGrabTimestamp(util::time::TimeValue &tv) const;
+
         /// Get resolution of the images from this source.
         virtual cv::Size resolution() const = 0;
 
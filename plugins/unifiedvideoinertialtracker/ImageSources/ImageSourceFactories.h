@@ -32,7 +32,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <string>
 
 namespace osvr {
 namespace vbtracker {
@@ -44,6 +44,18 @@ namespace vbtracker {
     ImageSourcePtr openHDKCameraDirectShow();
 #endif
 
+#ifdef __linux__
+    /// Factory method to open a Video4Linux2 capture device (such as
+    /// "/dev/video0") directly, using memory-mapped streaming with the given
+    /// number of driver buffers, and the driver's frame timestamps. Requires a
+    /// device that can capture GREY or YUYV at exactly the given resolution;
+    /// the frame rate is requested, and a warning given if it isn't what the
+    /// device picks.
+    ImageSourcePtr openV4L2Camera(std::string const &device,
+                                  unsigned int numBuffers, cv::Size res,
+                                  unsigned int frameRate);
+#endif
+
     /// Factory method to open a directory of tif files named 0001.tif and
     /// onward as an image source (looping)
     ImageSourcePtr openImageFileSequence(std::string const &dir);
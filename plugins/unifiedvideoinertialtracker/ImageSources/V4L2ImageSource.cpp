@@ -0,0 +1,385 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "ImageSourceFactories.h"
+
+// Library/third-party includes
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace osvr {
+namespace vbtracker {
+    /// How long grab() waits for a frame before reporting failure.
+    static const int GRAB_TIMEOUT_MS = 1000;
+
+    /// ioctl, retried if interrupted by a signal.
+    static inline int xioctl(int fd, unsigned long request, void *arg) {
+        int ret;
+        do {
+            ret = ioctl(fd, request, arg);
+        } while (ret == -1 && errno == EINTR);
+        return ret;
+    }
+
+    static inline std::ostream &v4l2Msg() {
+        return std::cerr << "[V4L2 Image Source] ";
+    }
+
+    /// Captures from a Video4Linux2 device with memory-mapped streaming I/O,
+    /// handing out the luma plane as the grayscale image directly (copied
+    /// once, out of the driver's buffer) and using the driver's timestamps.
+    class V4L2ImageSource : public ImageSource {
+      public:
+        V4L2ImageSource(std::string const &device, unsigned int numBuffers,
+                        cv::Size res, unsigned int frameRate);
+        virtual ~V4L2ImageSource();
+
+        bool ok() const override { return m_streaming; }
+        bool grab() override;
+        void retrieve(cv::Mat &color, cv::Mat &gray) override;
+        void retrieveColor(cv::Mat &color) override;
+        cv::Size resolution() const override { return m_res; }
+        bool getGrabTimestamp(util::time::TimeValue &tv) const override;
+
+      private:
+        bool m_open(std::string const &device, unsigned int numBuffers,
+                    cv::Size res, unsigned int frameRate);
+        /// Requests the frame rate, warning if the device won't provide it.
+        void m_setFrameRate(std::string const &device, unsigned int frameRate);
+        void m_close();
+        /// Gives a dequeued buffer back to the driver.
+        void m_requeue(std::uint32_t index);
+
+        struct Buffer {
+            void *start;
+            std::size_t length;
+        };
+        int m_fd = -1;
+        std::vector<Buffer> m_buffers;
+        bool m_streaming = false;
+        std::uint32_t m_pixelFormat = 0;
+        std::size_t m_stride = 0;
+        cv::Size m_res;
+
+        /// The buffer of the most recently grabbed frame, held (dequeued)
+        /// until it's retrieved or the next grab.
+        bool m_haveHeld = false;
+        v4l2_buffer m_held;
+        bool m_haveTimestamp = false;
+        util::time::TimeValue m_timestamp = {};
+    };
+
+    ImageSourcePtr openV4L2Camera(std::string const &device,
+                                  unsigned int numBuffers, cv::Size res,
+                                  unsigned int frameRate) {
+        auto ret = ImageSourcePtr{};
+        std::unique_ptr<V4L2ImageSource> cam{
+            new V4L2ImageSource{device, numBuffers, res, frameRate}};
+        if (cam->ok()) {
+            ret = std::move(cam);
+        }
+        return ret;
+    }
+
+    V4L2ImageSource::V4L2ImageSource(std::string const &device,
+                                     unsigned int numBuffers, cv::Size res,
+                                     unsigned int frameRate) {
+        if (!m_open(device, numBuffers, res, frameRate)) {
+            m_close();
+        }
+    }
+
+    V4L2ImageSource::~V4L2ImageSource() { m_close(); }
+
+    bool V4L2ImageSource::m_open(std::string const &device,
+                                 unsigned int numBuffers, cv::Size res,
+                                 unsigned int frameRate) {
+        m_fd = ::open(device.c_str(), O_RDWR | O_NONBLOCK);
+        if (m_fd < 0) {
+            v4l2Msg() << "Could not open " << device << ": "
+                      << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        v4l2_capability cap = {};
+        if (xioctl(m_fd, VIDIOC_QUERYCAP, &cap) == -1 ||
+            !(cap.capabilities & V4L2_CAP_VIDEO_CAPTURE) ||
+            !(cap.capabilities & V4L2_CAP_STREAMING)) {
+            v4l2Msg() << device << " is not a streaming video capture device"
+                      << std::endl;
+            return false;
+        }
+
+        /// Set everything explicitly, rather than relying on whatever the
+        /// last user of the device left it at, preferring a format whose luma
+        /// we can use without conversion: 8-bit gray, then YUYV.
+        v4l2_format fmt = {};
+        bool formatSet = false;
+        for (auto pixelFormat : {V4L2_PIX_FMT_GREY, V4L2_PIX_FMT_YUYV}) {
+            fmt = v4l2_format{};
+            fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            fmt.fmt.pix.width = static_cast<std::uint32_t>(res.width);
+            fmt.fmt.pix.height = static_cast<std::uint32_t>(res.height);
+            fmt.fmt.pix.pixelformat = pixelFormat;
+            fmt.fmt.pix.field = V4L2_FIELD_NONE;
+            if (xioctl(m_fd, VIDIOC_S_FMT, &fmt) == 0 &&
+                fmt.fmt.pix.pixelformat == pixelFormat &&
+                fmt.fmt.pix.width == static_cast<std::uint32_t>(res.width) &&
+                fmt.fmt.pix.height == static_cast<std::uint32_t>(res.height)) {
+                formatSet = true;
+                break;
+            }
+        }
+        if (!formatSet) {
+            v4l2Msg() << device << " can't capture GREY or YUYV at "
+                      << res.width << "x" << res.height << std::endl;
+            return false;
+        }
+        m_pixelFormat = fmt.fmt.pix.pixelformat;
+        m_stride = fmt.fmt.pix.bytesperline;
+        m_res = res;
+        m_setFrameRate(device, frameRate);
+
+        v4l2_requestbuffers req = {};
+        req.count = numBuffers;
+        req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        req.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(m_fd, VIDIOC_REQBUFS, &req) == -1 || req.count < 2) {
+            v4l2Msg() << "Could not get capture buffers from " << device
+                      << std::endl;
+            return false;
+        }
+        for (std::uint32_t i = 0; i < req.count; ++i) {
+            v4l2_buffer buf = {};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            buf.index = i;
+            if (xioctl(m_fd, VIDIOC_QUERYBUF, &buf) == -1) {
+                return false;
+            }
+            auto start = mmap(nullptr, buf.length, PROT_READ | PROT_WRITE,
+                              MAP_SHARED, m_fd, buf.m.offset);
+            if (start == MAP_FAILED) {
+                v4l2Msg() << "Could not map capture buffer: "
+                          << std::strerror(errno) << std::endl;
+                return false;
+            }
+            m_buffers.push_back(Buffer{start, buf.length});
+            if (xioctl(m_fd, VIDIOC_QBUF, &buf) == -1) {
+                return false;
+            }
+        }
+
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        if (xioctl(m_fd, VIDIOC_STREAMON, &type) == -1) {
+            v4l2Msg() << "Could not start streaming from " << device << ": "
+                      << std::strerror(errno) << std::endl;
+            return false;
+        }
+        m_streaming = true;
+        v4l2Msg() << "Capturing " << m_res.width << "x" << m_res.height << " "
+                  << (m_pixelFormat == V4L2_PIX_FMT_GREY ? "GREY" : "YUYV")
+                  << " from " << device << " with " << m_buffers.size()
+                  << " buffers" << std::endl;
+        return true;
+    }
+
+    void V4L2ImageSource::m_setFrameRate(std::string const &device,
+                                         unsigned int frameRate) {
+        v4l2_streamparm parm = {};
+        parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        parm.parm.capture.timeperframe.numerator = 1;
+        parm.parm.capture.timeperframe.denominator = frameRate;
+        if (xioctl(m_fd, VIDIOC_S_PARM, &parm) == -1 ||
+            !(parm.parm.capture.capability & V4L2_CAP_TIMEPERFRAME)) {
+            v4l2Msg() << "Warning: could not set the frame rate of " << device
+                      << ", capturing at its default rate" << std::endl;
+            return;
+        }
+        auto const &tpf = parm.parm.capture.timeperframe;
+        if (tpf.numerator == 0 ||
+            tpf.denominator != frameRate * tpf.numerator) {
+            v4l2Msg() << "Warning: asked " << device << " for " << frameRate
+                      << " frames per second, got " << tpf.denominator << "/"
+                      << tpf.numerator << std::endl;
+        }
+    }
+
+    void V4L2ImageSource::m_close() {
+        if (m_streaming) {
+            v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            xioctl(m_fd, VIDIOC_STREAMOFF, &type);
+            m_streaming = false;
+        }
+        for (auto const &buf : m_buffers) {
+            munmap(buf.start, buf.length);
+        }
+        m_buffers.clear();
+        m_haveHeld = false;
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    void V4L2ImageSource::m_requeue(std::uint32_t index) {
+        v4l2_buffer buf = {};
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index = index;
+        xioctl(m_fd, VIDIOC_QBUF, &buf);
+    }
+
+    bool V4L2ImageSource::grab() {
+        if (!m_streaming) {
+            return false;
+        }
+        if (m_haveHeld) {
+            /// Grabbed but never retrieved.
+            m_requeue(m_held.index);
+            m_haveHeld = false;
+        }
+
+        pollfd pfd = {};
+        pfd.fd = m_fd;
+        pfd.events = POLLIN;
+        int ret;
+        do {
+            ret = poll(&pfd, 1, GRAB_TIMEOUT_MS);
+        } while (ret == -1 && errno == EINTR);
+        if (ret <= 0) {
+            return false;
+        }
+
+        /// Drain everything the driver has filled, keeping only the newest,
+        /// so we never hand out a frame that's been waiting in the queue.
+        while (true) {
+            v4l2_buffer buf = {};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = V4L2_MEMORY_MMAP;
+            if (xioctl(m_fd, VIDIOC_DQBUF, &buf) == -1) {
+                if (errno != EAGAIN) {
+                    v4l2Msg() << "Could not dequeue a frame: "
+                              << std::strerror(errno) << std::endl;
+                    m_close();
+                }
+                break;
+            }
+            if (m_haveHeld) {
+                m_requeue(m_held.index);
+            }
+            m_held = buf;
+            m_haveHeld = true;
+        }
+        if (!m_haveHeld) {
+            return false;
+        }
+        if (m_held.flags & V4L2_BUF_FLAG_ERROR) {
+            m_requeue(m_held.index);
+            m_haveHeld = false;
+            return false;
+        }
+
+        /// The driver stamps buffers with CLOCK_MONOTONIC: carry that back
+        /// from our clock's "now" by the frame's age.
+        m_haveTimestamp = false;
+        if ((m_held.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) ==
+            V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+            timespec monoNow;
+            if (clock_gettime(CLOCK_MONOTONIC, &monoNow) == 0) {
+                m_timestamp = util::time::getNow();
+                util::time::TimeValue age;
+                age.seconds = static_cast<OSVR_TimeValue_Seconds>(
+                    monoNow.tv_sec - m_held.timestamp.tv_sec);
+                age.microseconds = static_cast<OSVR_TimeValue_Microseconds>(
+                    monoNow.tv_nsec / 1000 - m_held.timestamp.tv_usec);
+                osvrTimeValueNormalize(&age);
+                osvrTimeValueDifference(&m_timestamp, &age);
+                m_haveTimestamp = true;
+            }
+        }
+        return true;
+    }
+
+    void V4L2ImageSource::retrieve(cv::Mat &color, cv::Mat &gray) {
+        if (!m_haveHeld) {
+            color.release();
+            gray.release();
+            return;
+        }
+        auto data =
+            static_cast<const unsigned char *>(m_buffers[m_held.index].start);
+        if (m_pixelFormat == V4L2_PIX_FMT_GREY) {
+            /// Wrap the driver's buffer just long enough to copy it out.
+            cv::Mat(m_res, CV_8UC1, const_cast<unsigned char *>(data),
+                    m_stride)
+                .copyTo(gray);
+        } else {
+            /// YUYV: luma is every other byte.
+            gray.create(m_res, CV_8UC1);
+            for (int y = 0; y < m_res.height; ++y) {
+                auto src = data + m_stride * y;
+                auto dest = gray.ptr<unsigned char>(y);
+                for (int x = 0; x < m_res.width; ++x) {
+                    dest[x] = src[2 * x];
+                }
+            }
+        }
+        m_requeue(m_held.index);
+        m_haveHeld = false;
+        cv::cvtColor(gray, color, CV_GRAY2RGB);
+    }
+
+    void V4L2ImageSource::retrieveColor(cv::Mat &color) {
+        cv::Mat dummy;
+        retrieve(color, dummy);
+    }
+
+    bool V4L2ImageSource::getGrabTimestamp(util::time::TimeValue &tv) const {
+        if (m_haveTimestamp) {
+            tv = m_timestamp;
+        }
+        return m_haveTimestamp;
+    }
+} // namespace vbtracker
+} // namespace osvr
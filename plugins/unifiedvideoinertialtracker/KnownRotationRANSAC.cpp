@@ -0,0 +1,174 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "KnownRotationRANSAC.h"
+
+// Library/third-party includes
+#include <Eigen/Cholesky>
+
+// Standard includes
+#include <limits>
+
+namespace osvr {
+namespace vbtracker {
+    /// Minimum sine of the angle between the rays of a two-beacon sample:
+    /// nearly parallel rays pin down the translation poorly along them.
+    static const double MIN_RAY_ANGLE_SINE = 1.e-3;
+
+    KnownRotationRANSAC::KnownRotationRANSAC(std::size_t maxHypotheses)
+        : m_maxHypotheses(maxHypotheses) {}
+
+    bool KnownRotationRANSAC::m_solve(std::vector<std::size_t> const &indices,
+                                      Eigen::Vector3d &translation) const {
+        // Each beacon contributes (I - d d^T)(t + R X) = 0: the component of
+        // its camera-space position perpendicular to its ray must vanish.
+        Eigen::Matrix3d A = Eigen::Matrix3d::Zero();
+        Eigen::Vector3d b = Eigen::Vector3d::Zero();
+        for (auto i : indices) {
+            auto const &d = m_directions[i];
+            Eigen::Matrix3d P =
+                Eigen::Matrix3d::Identity() - d * d.transpose();
+            A += P;
+            b -= P * m_rotatedModel[i];
+        }
+        Eigen::LDLT<Eigen::Matrix3d> ldlt(A);
+        if (ldlt.info() != Eigen::Success || !ldlt.isPositive() ||
+            ldlt.vectorD().minCoeff() <= 0) {
+            return false;
+        }
+        translation = ldlt.solve(b);
+        return translation.allFinite();
+    }
+
+    double KnownRotationRANSAC::m_findInliers(
+        Eigen::Vector3d const &translation,
+        std::vector<std::size_t> &inliers) const {
+        inliers.clear();
+        double sumSquaredError = 0;
+        auto const &normalized = *m_normalized;
+        const auto n = m_rotatedModel.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            Eigen::Vector3d camPoint = m_rotatedModel[i] + translation;
+            if (camPoint.z() <= 0) {
+                continue;
+            }
+            auto err = (camPoint.head<2>() / camPoint.z() -
+                        normalized[i].head<2>())
+                           .squaredNorm();
+            if (err <= m_thresholdSquared) {
+                inliers.push_back(i);
+                sumSquaredError += err;
+            }
+        }
+        return sumSquaredError;
+    }
+
+    bool KnownRotationRANSAC::
+    operator()(double inlierThreshold, Eigen::Quaterniond const &rotation,
+               std::vector<Eigen::Vector3d> const &normalizedPoints,
+               std::vector<Eigen::Vector3d> const &modelPoints,
+               Eigen::Vector3d &translation,
+               std::vector<std::size_t> &inliers) {
+        const auto n = modelPoints.size();
+        if (n < 2 || normalizedPoints.size() != n) {
+            return false;
+        }
+        m_thresholdSquared = inlierThreshold * inlierThreshold;
+        m_normalized = &normalizedPoints;
+        m_rotatedModel.resize(n);
+        m_directions.resize(n);
+        const Eigen::Matrix3d R = rotation.toRotationMatrix();
+        for (std::size_t i = 0; i < n; ++i) {
+            m_rotatedModel[i] = R * modelPoints[i];
+            m_directions[i] = normalizedPoints[i].normalized();
+        }
+
+        std::vector<std::size_t> bestInliers;
+        double bestError = std::numeric_limits<double>::max();
+        Eigen::Vector3d hypothesis;
+        m_sample.resize(2);
+        auto tryPair = [&](std::size_t a, std::size_t b) {
+            if (m_directions[a].cross(m_directions[b]).norm() <
+                MIN_RAY_ANGLE_SINE) {
+                return;
+            }
+            m_sample[0] = a;
+            m_sample[1] = b;
+            if (!m_solve(m_sample, hypothesis)) {
+                return;
+            }
+            auto err = m_findInliers(hypothesis, m_candidateInliers);
+            if (m_candidateInliers.size() > bestInliers.size() ||
+                (m_candidateInliers.size() == bestInliers.size() &&
+                 err < bestError)) {
+                bestInliers.swap(m_candidateInliers);
+                bestError = err;
+            }
+        };
+
+        const std::size_t numPairs = n * (n - 1) / 2;
+        if (numPairs <= m_maxHypotheses) {
+            for (std::size_t a = 0; a + 1 < n; ++a) {
+                for (std::size_t b = a + 1; b < n; ++b) {
+                    tryPair(a, b);
+                }
+            }
+        } else {
+            std::uniform_int_distribution<std::size_t> first(0, n - 1);
+            std::uniform_int_distribution<std::size_t> second(0, n - 2);
+            for (std::size_t i = 0; i < m_maxHypotheses; ++i) {
+                auto a = first(m_rng);
+                auto b = second(m_rng);
+                // Skip over a so the pair is always distinct.
+                if (b >= a) {
+                    ++b;
+                }
+                tryPair(a, b);
+            }
+        }
+
+        if (bestInliers.size() < 2) {
+            return false;
+        }
+
+        // Refine using every inlier: the refined estimate may pick up more.
+        Eigen::Vector3d refined;
+        if (!m_solve(bestInliers, refined)) {
+            return false;
+        }
+        m_findInliers(refined, m_candidateInliers);
+        if (m_candidateInliers.size() > bestInliers.size()) {
+            bestInliers.swap(m_candidateInliers);
+            if (!m_solve(bestInliers, refined)) {
+                return false;
+            }
+        }
+        translation = refined;
+        inliers = bestInliers;
+        return true;
+    }
+} // namespace vbtracker
+} // namespace osvr
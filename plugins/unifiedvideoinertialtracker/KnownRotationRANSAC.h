@@ -0,0 +1,100 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_KnownRotationRANSAC_h_GUID_7C636E67_0CB5_4002_AC4F_1E5CB771E5CE
+#define INCLUDED_KnownRotationRANSAC_h_GUID_7C636E67_0CB5_4002_AC4F_1E5CB771E5CE
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+
+// Standard includes
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// Estimates just the translation of a target whose rotation into camera
+    /// space is already known (from an IMU), using a tiny RANSAC over pairs of
+    /// identified beacons.
+    ///
+    /// With the rotation fixed, each beacon measurement constrains the
+    /// translation to a line (the ray through the measurement, offset by the
+    /// rotated beacon position), so two beacons determine it, and the least
+    /// squares intersection of any number of such lines is a 3x3 linear solve.
+    /// When there are few enough beacons, every pair is tried, so the result
+    /// is deterministic exactly when acquisition is hardest.
+    class KnownRotationRANSAC {
+      public:
+        /// @param maxHypotheses Upper bound on the number of two-beacon
+        /// hypotheses tried.
+        explicit KnownRotationRANSAC(std::size_t maxHypotheses = 32);
+
+        /// @param inlierThreshold Maximum reprojection error of an inlier, in
+        /// normalized image plane units (that is, pixels divided by the focal
+        /// length).
+        /// @param rotation Rotation taking model space into camera space.
+        /// @param normalizedPoints Undistorted measurements in homogeneous
+        /// normalized image coordinates (x, y, 1), parallel to modelPoints.
+        /// @param modelPoints Beacon positions in model space.
+        /// @param[out] translation Translation taking rotated model space into
+        /// camera space. Only modified if return value is true.
+        /// @param[out] inliers Indices of the beacons consistent with the
+        /// estimate. Only modified if return value is true.
+        /// @return true if an estimate with at least two inliers was found.
+        bool operator()(double inlierThreshold,
+                        Eigen::Quaterniond const &rotation,
+                        std::vector<Eigen::Vector3d> const &normalizedPoints,
+                        std::vector<Eigen::Vector3d> const &modelPoints,
+                        Eigen::Vector3d &translation,
+                        std::vector<std::size_t> &inliers);
+
+      private:
+        /// Least-squares translation from the beacons with the given indices.
+        bool m_solve(std::vector<std::size_t> const &indices,
+                     Eigen::Vector3d &translation) const;
+        /// Collects the beacons that reproject within the threshold, and
+        /// returns the sum of their squared errors.
+        double m_findInliers(Eigen::Vector3d const &translation,
+                             std::vector<std::size_t> &inliers) const;
+
+        std::size_t m_maxHypotheses;
+        double m_thresholdSquared = 0;
+        std::mt19937 m_rng;
+
+        /// Per-call data: rotated model points and ray directions.
+        std::vector<Eigen::Vector3d> m_rotatedModel;
+        std::vector<Eigen::Vector3d> m_directions;
+        std::vector<Eigen::Vector3d> const *m_normalized = nullptr;
+        std::vector<std::size_t> m_sample;
+        std::vector<std::size_t> m_candidateInliers;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_KnownRotationRANSAC_h_GUID_7C636E67_0CB5_4002_AC4F_1E5CB771E5CE
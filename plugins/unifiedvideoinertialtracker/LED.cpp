@@ -45,9 +45,16 @@ namespace vbtracker {
             m_id = ZeroBasedBeaconId(
                 SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA);
         } else {
-            auto oldId = m_id;
+            auto oldId = getID();
             m_id = m_identifier->getId(m_id, m_brightnessHistory, m_lastBright,
                                        blobsKeepId);
+            if (m_id.value() !=
+                SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA) {
+                /// The flash pattern has spoken: it either confirms the
+                /// provisional ID, overrides it, or says this isn't a beacon
+                /// at all.
+                clearProvisionalID();
+            }
 #if 0
             m_newlyRecognized = oldId < 0 && m_id >= 0;
             auto lostRecognition = m_id < 0 && oldId >= 0;
@@ -61,8 +68,8 @@ namespace vbtracker {
             /// sentinel.
 
             /// Right now, any change in ID is considered being "newly
-            /// recognized".
-            if (oldId != m_id) {
+            /// recognized". A confirmed provisional ID is not a change.
+            if (oldId != getID() || provisionallyIdentified()) {
                 /// If newly recognized, start at max novelty
                 m_novelty = MAX_NOVELTY;
             } else if (m_novelty != 0) {
@@ -113,6 +120,12 @@ namespace vbtracker {
 
     LedMeasurementVecIterator Led::nearest(LedMeasurementVec &meas,
                                            double threshold) const {
+        return nearest(meas, threshold, getLocation());
+    }
+
+    LedMeasurementVecIterator
+    Led::nearest(LedMeasurementVec &meas, double threshold,
+                 cv::Point2f const &location) const {
         // If we have no elements in the vector, return the end().
         if (meas.empty()) {
             return end(meas);
@@ -120,7 +133,6 @@ namespace vbtracker {
 
         // Squaring the threshold to avoid doing a square-root in a tight loop.
         auto thresholdSquared = threshold * threshold;
-        auto location = getLocation();
 
         auto computeDistSquared = [location](LedMeasurementVecIterator it) {
             auto diff = (location - it->loc);
@@ -150,7 +162,23 @@ namespace vbtracker {
         return end(meas);
     }
 
+    void Led::setProvisionalID(ZeroBasedBeaconId id) {
+        BOOST_ASSERT_MSG(!beaconIdentified(m_id),
+                         "Can only provisionally identify an LED whose flash "
+                         "pattern hasn't identified it!");
+        if (id != m_provisionalId) {
+            m_provisionalId = id;
+            m_novelty = MAX_NOVELTY;
+        }
+    }
+
+    void Led::clearProvisionalID() {
+        m_provisionalId = ZeroBasedBeaconId(
+            SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA);
+    }
+
     void Led::markMisidentified() {
+        clearProvisionalID();
         m_id = ZeroBasedBeaconId(
             SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA);
         if (!m_brightnessHistory.empty()) {
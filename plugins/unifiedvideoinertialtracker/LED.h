@@ -83,16 +83,40 @@ namespace vbtracker {
         /// - An index of -1 means not yet determined.
         /// - An index below -1 means known not to be an LED (different
         ///   identifiers use different codes to differentiate between cases).
-        /// - An index of 0 or higher is determined based on the flash pattern.
-        ZeroBasedBeaconId getID() const { return m_id; }
+        /// - An index of 0 or higher is determined based on the flash pattern,
+        ///   or, until the flash pattern has been read, may be a provisional
+        ///   identification (see setProvisionalID())
+        ZeroBasedBeaconId getID() const {
+            return provisionallyIdentified() ? m_provisionalId : m_id;
+        }
 
         /// @brief Gets either the raw negative sentinel ID or a 1-based ID (for
         /// display purposes)
         OneBasedBeaconId getOneBasedID() const { return makeOneBased(getID()); }
 
-        /// @brief Do we have a positive identification as a known LED?
+        /// @brief Do we have a positive (possibly provisional) identification
+        /// as a known LED?
         bool identified() const { return beaconIdentified(getID()); }
 
+        /// @brief Is our identification provisional, that is, from a model
+        /// rather than from our flash pattern?
+        bool provisionallyIdentified() const {
+            return beaconIdentified(m_provisionalId);
+        }
+
+        /// @brief Provisionally identify this blob (which must not already be
+        /// identified by its flash pattern) as the given beacon, based on
+        /// where the tracked model predicts that beacon appears.
+        ///
+        /// Once enough of the flash pattern has been seen, it confirms or
+        /// replaces this ID; until then, the caller is responsible for
+        /// clearing it when it is no longer supported by the model. The LED is
+        /// kept at maximum novelty while provisionally identified.
+        void setProvisionalID(ZeroBasedBeaconId id);
+
+        /// @brief Drops any provisional identification.
+        void clearProvisionalID();
+
         /// @brief Returns a value (decreasing per frame from some maximum down
         /// to a minimum of zero) indicating how new the identification of this
         /// blob with its current ID is. This can be used to compensate for
@@ -135,6 +159,16 @@ namespace vbtracker {
         LedMeasurementVecIterator nearest(LedMeasurementVec &meas,
                                           double threshold) const;
 
+        /// @brief Find the nearest measurement to a location other than the
+        /// most-recently-added one (such as where the tracked pose predicts
+        /// this LED will be this frame), if there is one within the specified
+        /// threshold.
+        /// @return end() if there is not a nearest within threshold (or an
+        /// empty container).
+        LedMeasurementVecIterator nearest(LedMeasurementVec &meas,
+                                          double threshold,
+                                          cv::Point2f const &location) const;
+
         /// @brief Returns the most-recent boolean "bright" state according to
         /// the LED identifier. Note that the value is only meaningful if
         /// `identified()` is true.
@@ -164,6 +198,11 @@ namespace vbtracker {
         ZeroBasedBeaconId m_id = ZeroBasedBeaconId(
             SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA);
 
+        /// @brief Model-based ID used until m_id is determined, if
+        /// non-negative.
+        ZeroBasedBeaconId m_provisionalId = ZeroBasedBeaconId(
+            SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA);
+
         /// @brief Object used to determine the identity of an LED
         LedIdentifier *m_identifier = nullptr;
 
@@ -171,7 +210,7 @@ namespace vbtracker {
         bool m_lastBright = false;
 
         bool m_newlyRecognized = false;
-        uint8_t m_novelty;
+        uint8_t m_novelty = MAX_NOVELTY;
 
         bool m_wasUsedLastFrame = false;
     };
@@ -29,11 +29,13 @@
 // - none
 
 // Library/third-party includes
+#include <osvr/Kalman/InnovationAdaptiveNoise.h>
 #include <osvr/Kalman/PoseState.h>
 #include <osvr/Kalman/PoseSeparatelyDampedConstantVelocity.h>
 #include <osvr/Kalman/PureVectorState.h>
 
 // Standard includes
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -41,8 +43,70 @@ namespace osvr {
 namespace vbtracker {
 
     using BodyState = kalman::pose_externalized_rotation::State;
-    using BodyProcessModel =
-        osvr::kalman::PoseSeparatelyDampedConstantVelocityProcessModel;
+
+    /// The body process model, optionally scaling its process noise based
+    /// on the innovations of the video (SCAAT) and IMU measurements applied
+    /// to the body: the video innovations drive the position noise, the IMU
+    /// innovations (if there are any) the orientation noise.
+    class BodyProcessModel
+        : public kalman::PoseSeparatelyDampedConstantVelocityProcessModel {
+      public:
+        using AdaptiveScale = kalman::InnovationAdaptiveNoiseScale;
+
+        /// @brief Turns noise adaptation on or off, resetting its state.
+        void configureAdaptation(bool enabled, std::size_t window,
+                                 double minScale, double maxScale) {
+            m_adaptive = enabled;
+            m_videoScale = AdaptiveScale(window, minScale, maxScale);
+            m_imuScale = AdaptiveScale(window, minScale, maxScale);
+            setNoiseScale(1, 1);
+        }
+
+        bool isAdaptive() const { return m_adaptive; }
+
+        /// @param nis Normalized innovation squared returned by
+        /// kalman::correct() for a video-based measurement.
+        void addVideoInnovation(double nis, std::size_t dimension) {
+            if (!m_adaptive) {
+                return;
+            }
+            m_videoScale.addInnovation(nis, dimension);
+            m_updateNoiseScale();
+        }
+
+        /// @param nis Normalized innovation squared returned by
+        /// kalman::correct() for an IMU measurement.
+        void addIMUInnovation(double nis, std::size_t dimension) {
+            if (!m_adaptive) {
+                return;
+            }
+            m_imuScale.addInnovation(nis, dimension);
+            m_updateNoiseScale();
+        }
+
+        /// @name Adaptation estimator state, for debugging
+        /// @{
+        AdaptiveScale const &getVideoNoiseScale() const {
+            return m_videoScale;
+        }
+        AdaptiveScale const &getIMUNoiseScale() const { return m_imuScale; }
+        double getPositionNoiseScale() const {
+            return m_videoScale.getScale();
+        }
+        double getOrientationNoiseScale() const {
+            return m_imuScale.getCount() > 0 ? m_imuScale.getScale()
+                                             : m_videoScale.getScale();
+        }
+        /// @}
+
+      private:
+        void m_updateNoiseScale() {
+            setNoiseScale(getPositionNoiseScale(), getOrientationNoiseScale());
+        }
+        bool m_adaptive = false;
+        AdaptiveScale m_videoScale;
+        AdaptiveScale m_imuScale;
+    };
 
     using BeaconState = kalman::PureVectorState<3>;
     using BeaconStatePtr = std::unique_ptr<BeaconState>;
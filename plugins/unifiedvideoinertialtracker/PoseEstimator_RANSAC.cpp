@@ -31,18 +31,99 @@
 // Library/third-party includes
 #include <opencv2/core/core.hpp>
 #include <opencv2/calib3d/calib3d.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
 
 // Standard includes
 #include <algorithm>
+#include <cmath>
 
 namespace osvr {
 namespace vbtracker {
-    bool RANSACPoseEstimator::operator()(CameraParameters const &camParams,
-                                         LedPtrList const &leds,
-                                         BeaconStateVec const &beacons,
-                                         std::vector<BeaconData> &beaconDebug,
-                                         Eigen::Vector3d &outXlate,
-                                         Eigen::Quaterniond &outQuat) {
+    /// Maximum reprojection error (pixels) of a RANSAC inlier.
+    static const float RANSAC_REPROJECTION_ERROR = 8.0f;
+
+    static const double PI = 3.14159265358979323846;
+
+    /// How far (radians) the full PnP refinement may rotate away from the
+    /// orientation prior before we decide it found a different minimum and
+    /// keep the prior instead.
+    static const double MAX_PRIOR_REFINEMENT_ANGLE = 10. * PI / 180.;
+
+    RANSACPoseEstimator::RANSACPoseEstimator()
+        : RANSACPoseEstimator(ConfigParams{}) {}
+
+    RANSACPoseEstimator::RANSACPoseEstimator(ConfigParams const &params)
+        : m_iterations(params.ransacIterations),
+          m_knownRotation(static_cast<std::size_t>(
+              std::max(params.imuAidedAcquisitionHypotheses, 1))) {}
+
+    bool RANSACPoseEstimator::m_estimateWithOrientationPrior(
+        CameraParameters const &camParams, LedPtrList const &pointLeds,
+        std::vector<cv::Point3f> const &objectPoints,
+        std::vector<cv::Point2f> const &imagePoints,
+        Eigen::Quaterniond const &rotation, Eigen::Vector3d &outXlate,
+        Eigen::Quaterniond &outQuat) {
+        std::vector<cv::Point2f> undistorted;
+        cv::undistortPoints(imagePoints, undistorted, camParams.cameraMatrix,
+                            camParams.distortionParameters);
+        const auto n = objectPoints.size();
+        m_normalizedPoints.resize(n);
+        m_modelPoints.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            m_normalizedPoints[i] =
+                Eigen::Vector3d(undistorted[i].x, undistorted[i].y, 1.);
+            m_modelPoints[i] = cvToVector(objectPoints[i]).cast<double>();
+        }
+
+        Eigen::Vector3d xlate;
+        std::vector<std::size_t> inliers;
+        const double threshold =
+            RANSAC_REPROJECTION_ERROR / camParams.focalLength();
+        if (!m_knownRotation(threshold, rotation, m_normalizedPoints,
+                             m_modelPoints, xlate, inliers)) {
+            return false;
+        }
+
+        Eigen::Quaterniond quat = rotation;
+        if (inliers.size() >= m_requiredInliers) {
+            // Enough beacons for the full PnP to refine all six degrees of
+            // freedom, starting from the IMU-aided estimate.
+            std::vector<cv::Point3f> inlierObjectPoints;
+            std::vector<cv::Point2f> inlierImagePoints;
+            for (auto i : inliers) {
+                inlierObjectPoints.push_back(objectPoints[i]);
+                inlierImagePoints.push_back(imagePoints[i]);
+            }
+            cv::Mat rvec = eiQuatToRotVec(rotation);
+            cv::Mat tvec =
+                (cv::Mat_<double>(3, 1) << xlate.x(), xlate.y(), xlate.z());
+            bool useExtrinsicGuess = true;
+            if (cv::solvePnP(inlierObjectPoints, inlierImagePoints,
+                             camParams.cameraMatrix,
+                             camParams.distortionParameters, rvec, tvec,
+                             useExtrinsicGuess)) {
+                Eigen::Quaterniond refined = cvRotVecToQuat(rvec);
+                if (refined.angularDistance(rotation) <
+                    MAX_PRIOR_REFINEMENT_ANGLE) {
+                    quat = refined;
+                    xlate = cvToVector3d(tvec);
+                }
+            }
+        }
+
+        for (auto i : inliers) {
+            pointLeds[i]->markAsUsed();
+        }
+        outXlate = xlate;
+        outQuat = quat;
+        return true;
+    }
+
+    bool RANSACPoseEstimator::operator()(
+        CameraParameters const &camParams, LedPtrList const &leds,
+        BeaconStateVec const &beacons, std::vector<BeaconData> &beaconDebug,
+        Eigen::Vector3d &outXlate, Eigen::Quaterniond &outQuat,
+        Eigen::Quaterniond const *orientationPrior) {
 
         // We need to get a pair of matched vectors of points: 2D locations
         // with in the image and 3D locations in model space.  There needs to
@@ -54,7 +135,15 @@ namespace vbtracker {
         std::vector<cv::Point3f> objectPoints;
         std::vector<cv::Point2f> imagePoints;
         std::vector<ZeroBasedBeaconId> beaconIds;
+        /// The LEDs the points came from, in the same order: not all LEDs
+        /// contribute a point.
+        LedPtrList pointLeds;
         for (auto const &led : leds) {
+            if (led->provisionallyIdentified()) {
+                /// Provisional IDs come from the very model we're trying to
+                /// (re)acquire, so they're no help here.
+                continue;
+            }
             auto id = makeZeroBased(led->getID());
             auto index = asIndex(id);
             beaconDebug[index].variance = -1;
@@ -66,6 +155,16 @@ namespace vbtracker {
             imagePoints.push_back(led->getLocationForTracking());
             objectPoints.push_back(
                 vec3dToCVPoint3f(beacons[index]->stateVector()));
+            pointLeds.push_back(led);
+        }
+
+        // With the rotation known, two beacons are enough to acquire.
+        if (orientationPrior && objectPoints.size() >= 2 &&
+            m_estimateWithOrientationPrior(camParams, pointLeds, objectPoints,
+                                           imagePoints, *orientationPrior,
+                                           outXlate, outQuat)) {
+            ++m_priorAcquisitions;
+            return true;
         }
 
         // Make sure we have enough points to do our estimation.
@@ -81,9 +180,8 @@ namespace vbtracker {
         // We tried using the previous guess to reduce the amount of computation
         // being done, but this got us stuck in infinite locations.  We seem to
         // do okay without using it, so leaving it out.
-        // @todo Make number of iterations into a parameter.
         bool usePreviousGuess = false;
-        int iterationsCount = 5;
+        int iterationsCount = m_iterations;
         cv::Mat inlierIndices;
 
         cv::Mat rvec;
@@ -92,7 +190,7 @@ namespace vbtracker {
         cv::solvePnPRansac(
             objectPoints, imagePoints, camParams.cameraMatrix,
             camParams.distortionParameters, rvec, tvec, usePreviousGuess,
-            iterationsCount, 8.0f,
+            iterationsCount, RANSAC_REPROJECTION_ERROR,
             static_cast<int>(objectPoints.size() - m_permittedOutliers),
             inlierIndices);
 #elif CV_MAJOR_VERSION == 3
@@ -104,7 +202,8 @@ namespace vbtracker {
         auto ransacResult = cv::solvePnPRansac(
             objectPoints, imagePoints, camParams.cameraMatrix,
             camParams.distortionParameters, rvec, tvec, usePreviousGuess,
-            iterationsCount, 8.0f, confidence, inlierIndices);
+            iterationsCount, RANSAC_REPROJECTION_ERROR, confidence,
+            inlierIndices);
         if (!ransacResult) {
             return false;
         }
@@ -200,6 +299,7 @@ namespace vbtracker {
 
         outXlate = cvToVector3d(tvec);
         outQuat = cvRotVecToQuat(rvec);
+        ++m_fullAcquisitions;
         return true;
     }
 
@@ -216,14 +316,15 @@ namespace vbtracker {
         InitialVelocityStateError,    InitialVelocityStateError,
         InitialVelocityStateError,    InitialAngVelStateError,
         InitialAngVelStateError,      InitialAngVelStateError};
-    bool RANSACPoseEstimator::operator()(EstimatorInOutParams const &p,
-                                         LedPtrList const &leds) {
+    bool RANSACPoseEstimator::
+    operator()(EstimatorInOutParams const &p, LedPtrList const &leds,
+               Eigen::Quaterniond const *orientationPrior) {
         Eigen::Vector3d xlate;
         Eigen::Quaterniond quat;
         /// Call the main pose estimation to get the vector and quat.
         {
             auto ret = (*this)(p.camParams, leds, p.beacons, p.beaconDebug,
-                               xlate, quat);
+                               xlate, quat, orientationPrior);
             if (!ret) {
                 return false;
             }
@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "ConfigParams.h"
+#include "KnownRotationRANSAC.h"
 #include "PoseEstimatorTypes.h"
 
 // Library/third-party includes
@@ -34,20 +35,30 @@
 
 // Standard includes
 #include <cstddef>
+#include <vector>
 
 namespace osvr {
 namespace vbtracker {
     class RANSACPoseEstimator {
       public:
+        /// Uses the default parameters.
+        RANSACPoseEstimator();
+        explicit RANSACPoseEstimator(ConfigParams const &params);
+
         /// Perform RANSAC-based pose estimation.
         ///
+        /// @param orientationPrior If non-null, a trusted camera-space
+        /// orientation of the target (from the IMU): the translation is then
+        /// acquired from as few as two beacons, with the full 6-DoF solve
+        /// only refining the result when there are enough inliers for it.
         /// @param[out] outXlate translation output parameter
         /// @param[out] outQuat rotation output parameter
         /// @return true if a pose was estimated.
         bool operator()(CameraParameters const &camParams,
                         LedPtrList const &leds, BeaconStateVec const &beacons,
                         std::vector<BeaconData> &beaconDebug,
-                        Eigen::Vector3d &outXlate, Eigen::Quaterniond &outQuat);
+                        Eigen::Vector3d &outXlate, Eigen::Quaterniond &outQuat,
+                        Eigen::Quaterniond const *orientationPrior = nullptr);
 
         /// Perform RANSAC-based pose estimation and use it to update a body
         /// state (state vector and error covariance)
@@ -55,11 +66,38 @@ namespace vbtracker {
         /// @param[out] state Tracked body state that will be updated if a pose
         /// was estimated
         /// @return true if a pose was estimated.
-        bool operator()(EstimatorInOutParams const &p, LedPtrList const &leds);
+        bool operator()(EstimatorInOutParams const &p, LedPtrList const &leds,
+                        Eigen::Quaterniond const *orientationPrior = nullptr);
+
+        /// @name Acquisition counters
+        /// @{
+        std::size_t getOrientationPriorAcquisitions() const {
+            return m_priorAcquisitions;
+        }
+        std::size_t getFullPnPAcquisitions() const {
+            return m_fullAcquisitions;
+        }
+        /// @}
 
       private:
+        /// Acquisition with the rotation fixed by an orientation prior.
+        /// @param pointLeds The LED each object/image point came from, which
+        /// gets marked as used if it's an inlier.
+        bool m_estimateWithOrientationPrior(
+            CameraParameters const &camParams, LedPtrList const &pointLeds,
+            std::vector<cv::Point3f> const &objectPoints,
+            std::vector<cv::Point2f> const &imagePoints,
+            Eigen::Quaterniond const &rotation, Eigen::Vector3d &outXlate,
+            Eigen::Quaterniond &outQuat);
+
         const std::size_t m_requiredInliers = 4;
         const std::size_t m_permittedOutliers = 0;
+        int m_iterations;
+        KnownRotationRANSAC m_knownRotation;
+        std::vector<Eigen::Vector3d> m_normalizedPoints;
+        std::vector<Eigen::Vector3d> m_modelPoints;
+        std::size_t m_priorAcquisitions = 0;
+        std::size_t m_fullAcquisitions = 0;
     };
 } // namespace vbtracker
 } // namespace osvr
@@ -258,7 +258,9 @@ namespace vbtracker {
             /// Now, do the correction.
             auto model = kalman::makeAugmentedProcessModel(p.processModel,
                                                            beaconProcess);
-            kalman::correct(state, model, meas);
+            auto nis = kalman::correct(state, model, meas);
+            p.processModel.addVideoInnovation(
+                nis, kalman::types::Dimension<ImagePointMeasurement>::value);
             gotMeasurement = true;
 #ifdef DEBUG_MEASUREMENT_RESIDUALS
             if (s) {
@@ -280,6 +282,21 @@ namespace vbtracker {
                 0.5 * p.state.errorCovariance().transpose();
             p.state.errorCovariance() = cov;
         }
+        if (m_extraVerbose && p.processModel.isAdaptive()) {
+            if (++m_adaptiveStride) {
+                auto const &video = p.processModel.getVideoNoiseScale();
+                auto const &imu = p.processModel.getIMUNoiseScale();
+                std::cout << "Adaptive process noise: position scale "
+                          << p.processModel.getPositionNoiseScale()
+                          << ", orientation scale "
+                          << p.processModel.getOrientationNoiseScale()
+                          << "; mean NIS/dim video "
+                          << video.getMeanNormalizedInnovation() << " ("
+                          << video.getCount() << "), IMU "
+                          << imu.getMeanNormalizedInnovation() << " ("
+                          << imu.getCount() << ")" << std::endl;
+            }
+        }
 
         /// Probation: Dealing with ratios of bad to good residuals
         bool incrementProbation = false;
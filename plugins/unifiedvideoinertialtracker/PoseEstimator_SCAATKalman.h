@@ -32,7 +32,7 @@
 #include "TrackedBodyTarget.h"
 
 // Library/third-party includes
-// - none
+#include <util/Stride.h>
 
 // Standard includes
 #include <random>
@@ -91,6 +91,8 @@ namespace vbtracker {
         std::size_t m_framesInProbation = 0;
         std::size_t m_framesWithoutIdentifiedBlobs = 0;
         std::size_t m_framesWithoutUtilizedMeasurements = 0;
+        /// Paces the extra-verbose adaptive process noise output.
+        ::util::Stride m_adaptiveStride{101};
     };
 } // namespace vbtracker
 } // namespace osvr
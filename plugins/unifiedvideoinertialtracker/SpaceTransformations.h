@@ -45,6 +45,18 @@ namespace vbtracker {
         return getQuatToCameraSpace(sys).matrix();
     }
 
+    /// Standard gravity, in m/s^2
+    static const double STANDARD_GRAVITY = 9.80665;
+
+    /// Acceleration due to gravity in room space (where Y is up).
+    inline Eigen::Vector3d getRoomSpaceGravity() {
+        return Eigen::Vector3d(0, -STANDARD_GRAVITY, 0);
+    }
+
+    inline Eigen::Vector3d getCameraSpaceGravity(TrackingSystem const &sys) {
+        return getQuatToCameraSpace(sys) * getRoomSpaceGravity();
+    }
+
 } // namespace vbtracker
 } // namespace osvr
 
@@ -30,7 +30,7 @@
 #include <osvr/Util/EigenInterop.h>
 
 // Standard includes
-// - none
+#include <chrono>
 
 namespace osvr {
 namespace vbtracker {
@@ -80,39 +80,20 @@ namespace vbtracker {
     }
 
     BodyReport BodyReporting::getReport(double additionalPrediction) {
-        BodyState state;
-        bool doingPrediction = false;
-        BodyProcessModel process;
-        util::time::TimeValue dataTime;
-        Eigen::Isometry3d trackerToRoom;
-        {
-            std::unique_lock<std::mutex> lock{m_mutex, std::try_to_lock};
-            if (!lock.owns_lock()) {
-                // Didn't get the lock.
-                return BodyReport::makeReportWithStatus(
-                    ReportStatus::MutexLocked);
-            }
-            // OK, we got the lock.
-            if (!m_shouldReport) {
-                // Told we shouldn't report, OK.
-                return BodyReport::makeReportWithStatus(
-                    ReportStatus::NoReportAvailable);
-            }
-            /// If we got here, then we're reporting something.
-            state = m_state;
-            if (state.stateVector().tail<6>() !=
-                kalman::types::Vector<6>::Zero()) {
-                // If we have non-zero velocity, then we can do some prediction,
-                // which we'll need the process for.
-                doingPrediction = true;
-                process = m_process;
-            }
-            dataTime = m_dataTime;
-            trackerToRoom = m_trackerToRoom;
-        } // unlock
+        /// Pick up the latest published snapshot, if there's a new one.
+        m_handoff.consume();
+        auto const &snapshot = m_handoff.getReadBuffer();
+        if (!snapshot.shouldReport) {
+            // Told we shouldn't report, OK.
+            return BodyReport::makeReportWithStatus(
+                ReportStatus::NoReportAvailable);
+        }
+        /// If we got here, then we're reporting something.
+        auto const &dataTime = snapshot.dataTime;
+        BodyState state = snapshot.state;
 
         auto ret = BodyReport::makeReportWithStatus();
-        if (doingPrediction) {
+        if (state.stateVector().tail<6>() != kalman::types::Vector<6>::Zero()) {
             // If we have non-zero velocity, then we can do some prediction.
             auto currentTime = util::time::getNow();
             /// Difference between measurement time and now.
@@ -121,17 +102,17 @@ namespace vbtracker {
             dt += additionalPrediction;
             /// Using computeEstimate instead of the normal prediction saves us
             /// the unneeded prediction of the error covariance.
-            state.setStateVector(process.computeEstimate(state, dt));
+            state.setStateVector(snapshot.process.computeEstimate(state, dt));
             /// Be sure to post-correct.
             state.postCorrect();
 
             /// OK, now set a proper timestamp for our prediction.
             ret.timestamp = currentTime +
                             std::chrono::duration<double>(additionalPrediction);
-            assignStateToBodyReport(state, ret, trackerToRoom);
+            assignStateToBodyReport(state, ret, snapshot.trackerToRoom);
         } else {
             ret.timestamp = dataTime;
-            assignStateToBodyReport(state, ret, trackerToRoom);
+            assignStateToBodyReport(state, ret, snapshot.trackerToRoom);
             /// @todo should we set the "don't report" flag here once we report
             /// a can't-predict state once?
         }
@@ -140,38 +121,46 @@ namespace vbtracker {
     }
 
     void BodyReporting::markShouldNotReport() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_shouldReport = false;
+        m_latest.shouldReport = false;
+        m_publish();
     }
     /// Updates the state, implicitly setting the flag that the mainloop
     /// should report.
     void BodyReporting::updateState(util::time::TimeValue const &tv,
                                     BodyState const &state,
                                     BodyProcessModel const &process) {
-
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_shouldReport = true;
-        m_dataTime = tv;
-        m_state = state;
-        m_process = process;
+        m_latest.shouldReport = true;
+        m_latest.dataTime = tv;
+        m_latest.state = state;
+        m_latest.process = process;
+        m_publish();
     }
 
     void BodyReporting::updateState(util::time::TimeValue const &tv,
                                     BodyState const &state) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_shouldReport = true;
-        m_dataTime = tv;
-        m_state = state;
+        m_latest.shouldReport = true;
+        m_latest.dataTime = tv;
+        m_latest.state = state;
+        m_publish();
     }
 
     void
     BodyReporting::setTrackerToRoomTransform(Eigen::Isometry3d const &xform) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_trackerToRoom = xform;
+        m_latest.trackerToRoom = xform;
+        m_publish();
     }
 
-    BodyReporting::BodyReporting()
-        : m_trackerToRoom(Eigen::Isometry3d::Identity()) {}
+    void BodyReporting::m_publish() {
+        /// The write buffer holds a stale snapshot (whatever the mainloop
+        /// handed back), so it must be overwritten completely.
+        m_handoff.getWriteBuffer() = m_latest;
+        m_handoff.publish();
+    }
+
+    BodyReporting::Snapshot::Snapshot()
+        : trackerToRoom(Eigen::Isometry3d::Identity()) {}
+
+    BodyReporting::BodyReporting() {}
 
 } // namespace vbtracker
 } // namespace osvr
@@ -31,15 +31,15 @@
 // Library/third-party includes
 #include <osvr/Util/TimeValue.h>
 #include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TripleBuffer.h>
 #include <boost/optional.hpp>
 
 // Standard includes
-#include <mutex>
 #include <memory>
 
 namespace osvr {
 namespace vbtracker {
-    enum class ReportStatus { Valid, MutexLocked, NoReportAvailable };
+    enum class ReportStatus { Valid, NoReportAvailable };
     struct BodyReport {
 
         static BodyReport
@@ -62,6 +62,10 @@ namespace vbtracker {
 
     /// A per-body class intended to marshall data coming from the
     /// tracking/processing thread back to the mainloop thread.
+    ///
+    /// The handoff is wait-free in both directions: the processing thread
+    /// never blocks on the mainloop, and the mainloop always gets the latest
+    /// complete state.
     class BodyReporting {
       public:
         /// Factory function
@@ -75,15 +79,14 @@ namespace vbtracker {
         /// only if it is ReportStatus::Valid does it contain anything useful,
         /// for the timestamp it says on the object.
         ///
-        /// Otherwise either the mutex was locked (you're in a
-        /// fast-spinning loop, just get it next time), or there's nothing worth
-        /// reporting - in both cases, the other fields are not initialized!
+        /// Otherwise there's nothing worth reporting, and the other fields are
+        /// not initialized!
         BodyReport getReport(double additionalPrediction);
         /// @}
 
         /// @name processing-thread methods
-        /// @brief These all block on the mutex, because the processing thread
-        /// needs to get its message through.
+        /// @brief Each of these publishes a complete new snapshot to the
+        /// mainloop thread, without waiting on it.
         /// @{
         /// Sets the flag that the mainloop should not report. Doesn't touch the
         /// other members since they're unusuable by definition if you should
@@ -105,15 +108,22 @@ namespace vbtracker {
         /// @}
       private:
         BodyReporting();
-        std::mutex m_mutex;
-        /// @name Protected by mutex
-        /// @{
-        bool m_shouldReport = false;
-        util::time::TimeValue m_dataTime;
-        BodyState m_state;
-        BodyProcessModel m_process;
-        Eigen::Isometry3d m_trackerToRoom;
-        /// @}
+        /// Everything the mainloop needs to produce a report.
+        struct Snapshot {
+            Snapshot();
+            bool shouldReport = false;
+            util::time::TimeValue dataTime;
+            BodyState state;
+            BodyProcessModel process;
+            Eigen::Isometry3d trackerToRoom;
+        };
+        /// Copies m_latest into the handoff buffer and publishes it.
+        void m_publish();
+
+        /// Owned by the processing thread: the most recent snapshot, which
+        /// partial updates are applied to before publishing.
+        Snapshot m_latest;
+        util::TripleBuffer<Snapshot> m_handoff;
     };
     using BodyReportingPtr = std::unique_ptr<BodyReporting>;
 
@@ -40,6 +40,7 @@
 #include <util/Stride.h>
 
 // Standard includes
+#include <algorithm>
 #include <iostream>
 
 namespace osvr {
@@ -61,6 +62,12 @@ namespace vbtracker {
                                   getParams().angularVelocityDecayCoefficient);
         m_processModel.setNoiseAutocorrelation(
             kalman::types::Vector<6>(getParams().processNoiseAutocorrelation));
+        m_processModel.configureAdaptation(
+            getParams().adaptiveProcessNoise,
+            static_cast<std::size_t>(
+                std::max(getParams().adaptiveNoiseWindow, 1)),
+            getParams().adaptiveNoiseMinScale,
+            getParams().adaptiveNoiseMaxScale);
     }
 
     TrackedBody::~TrackedBody() {}
@@ -26,8 +26,10 @@
 #include "TrackedBodyIMU.h"
 #include "TrackedBody.h"
 #include "TrackingSystem.h"
+#include "SpaceTransformations.h"
 
 // Library/third-party includes
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
 #include <boost/assert.hpp>
 
 // Standard includes
@@ -35,6 +37,60 @@
 
 namespace osvr {
 namespace vbtracker {
+    /// Initial variance of each component of the accelerometer bias, in
+    /// (m/s^2)^2.
+    static const double INITIAL_ACCEL_BIAS_VARIANCE = 0.05;
+
+    /// Oldest an acceleration report can be, in seconds, and still be used
+    /// to propagate position.
+    static const double MAX_LINEAR_ACCELERATION_AGE = 0.05;
+
+    /// @name Thresholds for considering the body at rest, for the purposes of
+    /// estimating accelerometer bias.
+    /// @{
+    /// m/s^2 difference between the magnitude of the reading and gravity
+    static const double AT_REST_SPECIFIC_FORCE_TOLERANCE = 0.5;
+    /// m/s
+    static const double AT_REST_MAX_SPEED = 0.02;
+    /// rad/s
+    static const double AT_REST_MAX_ANGULAR_SPEED = 0.05;
+    /// @}
+
+    /// Measurement of the accelerometer bias directly: the difference between
+    /// a reading taken at rest and the reading expected from gravity alone.
+    class AccelBiasMeasurement {
+      public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+        static const kalman::types::DimensionType DIMENSION = 3;
+        using MeasurementVector = kalman::types::Vector<DIMENSION>;
+        using MeasurementSquareMatrix = kalman::types::SquareMatrix<DIMENSION>;
+        AccelBiasMeasurement(MeasurementVector const &bias, double variance)
+            : m_bias(bias),
+              m_covariance(MeasurementSquareMatrix::Identity() * variance) {}
+
+        template <typename State>
+        MeasurementSquareMatrix const &getJacobian(State const &) const {
+            return identity();
+        }
+        template <typename State>
+        MeasurementSquareMatrix const &getCovariance(State const &) const {
+            return m_covariance;
+        }
+        template <typename State>
+        MeasurementVector getResidual(State const &s) const {
+            return m_bias - s.stateVector();
+        }
+
+      private:
+        static MeasurementSquareMatrix const &identity() {
+            static const MeasurementSquareMatrix ident =
+                MeasurementSquareMatrix::Identity();
+            return ident;
+        }
+        MeasurementVector m_bias;
+        MeasurementSquareMatrix m_covariance;
+    };
+
     TrackedBodyIMU::TrackedBodyIMU(TrackedBody &body,
                                    double orientationVariance,
                                    double angularVelocityVariance)
@@ -42,7 +98,17 @@ namespace vbtracker {
           m_useOrientation(getParams().imu.useOrientation),
           m_orientationVariance(orientationVariance),
           m_useAngularVelocity(getParams().imu.useAngularVelocity),
-          m_angularVelocityVariance(angularVelocityVariance) {}
+          m_angularVelocityVariance(angularVelocityVariance),
+          m_useLinearAcceleration(getParams().imu.useLinearAcceleration),
+          m_linearAccelerationVariance(
+              getParams().imu.linearAccelerationVariance),
+          m_linearAcceleration(Eigen::Vector3d::Zero()),
+          m_accelBias(AccelBiasState::StateVector::Zero(),
+                      AccelBiasState::SquareMatrix::Identity() *
+                          INITIAL_ACCEL_BIAS_VARIANCE) {
+        m_accelBiasProcess.setNoiseAutocorrelation(
+            getParams().imu.accelerometerBiasNoise);
+    }
     void
     TrackedBodyIMU::updatePoseFromOrientation(util::time::TimeValue const &tv,
                                               Eigen::Quaterniond const &quat) {
@@ -78,6 +144,98 @@ namespace vbtracker {
         updatePoseFromMeasurement(tv,
                                   preprocessAngularVelocity(tv, deltaquat, dt));
     }
+    void TrackedBodyIMU::updatePoseFromOrientationAndAngularVelocity(
+        util::time::TimeValue const &tv, Eigen::Quaterniond const &quat,
+        Eigen::Quaterniond const &deltaquat, double dt) {
+        if (!m_yawKnown) {
+            // Only the orientation is useful to calibration.
+            updatePoseFromOrientation(tv, quat);
+            return;
+        }
+        m_quat = transformRawIMUOrientation(quat);
+        m_hasOrientation = true;
+        m_last = tv;
+
+        // Can both halves together so the filter can take them in at once.
+        auto meas = CannedIMUMeasurement{};
+        if (m_useOrientation) {
+            meas.setOrientation(
+                m_quat, Eigen::Vector3d::Constant(m_orientationVariance));
+        }
+        if (m_useAngularVelocity) {
+            meas.setAngVel(
+                deltaQuatToAngularVelocity(deltaquat, dt),
+                Eigen::Vector3d::Constant(m_angularVelocityVariance));
+        }
+        updatePoseFromMeasurement(tv, meas);
+    }
+
+    void TrackedBodyIMU::updatePoseFromLinearAcceleration(
+        util::time::TimeValue const &tv, Eigen::Vector3d const &accel) {
+        if (!m_yawKnown || !m_hasOrientation) {
+            // No calibration yet, or no orientation to compensate for gravity
+            // with.
+            return;
+        }
+        if (!m_useLinearAcceleration) {
+            return;
+        }
+        updateAccelerometerBias(tv, accel);
+        m_linearAcceleration = accel - m_accelBias.stateVector();
+        m_linearAccelerationTime = tv;
+        m_hasLinearAcceleration = true;
+        // The acceleration gets attached to every measurement, so this one
+        // doesn't need anything else in it.
+        updatePoseFromMeasurement(tv, CannedIMUMeasurement{});
+    }
+
+    void TrackedBodyIMU::updateAccelerometerBias(
+        util::time::TimeValue const &tv, Eigen::Vector3d const &accel) {
+        if (m_hasLinearAcceleration) {
+            auto dt = osvrTimeValueDurationSeconds(&tv,
+                                                   &m_linearAccelerationTime);
+            if (dt > 0) {
+                kalman::predict(m_accelBias, m_accelBiasProcess, dt);
+            }
+        }
+
+        auto const &body = getBody();
+        auto const &state = body.getState();
+        auto atRest =
+            body.hasPoseEstimate() &&
+            std::abs(accel.norm() - STANDARD_GRAVITY) <
+                AT_REST_SPECIFIC_FORCE_TOLERANCE &&
+            state.velocity().norm() < AT_REST_MAX_SPEED &&
+            state.angularVelocity().norm() < AT_REST_MAX_ANGULAR_SPEED;
+        if (!atRest) {
+            return;
+        }
+        // At rest, an accelerometer reads the reaction to gravity, in its own
+        // frame: anything else is bias.
+        Eigen::Vector3d expected = m_quat.conjugate() * -getRoomSpaceGravity();
+        AccelBiasMeasurement meas{accel - expected,
+                                  m_linearAccelerationVariance};
+        kalman::correct(m_accelBias, m_accelBiasProcess, meas);
+    }
+
+    void
+    TrackedBodyIMU::addLinearAcceleration(util::time::TimeValue const &tv,
+                                          CannedIMUMeasurement &meas) const {
+        if (!m_hasLinearAcceleration) {
+            return;
+        }
+        auto age = std::abs(
+            osvrTimeValueDurationSeconds(&tv, &m_linearAccelerationTime));
+        if (age > MAX_LINEAR_ACCELERATION_AGE) {
+            return;
+        }
+        // Bias uncertainty adds to the measurement noise: it's estimated
+        // separately, so it's not otherwise accounted for in body state.
+        meas.setLinAccel(m_linearAcceleration,
+                         Eigen::Vector3d::Constant(
+                             m_linearAccelerationVariance) +
+                             m_accelBias.errorCovariance().diagonal());
+    }
 
     Eigen::Quaterniond TrackedBodyIMU::transformRawIMUOrientation(
         Eigen::Quaterniond const &input) const {
@@ -97,10 +255,8 @@ namespace vbtracker {
         return ret;
     }
 
-    /// Processes an angular velocity
-    CannedIMUMeasurement TrackedBodyIMU::preprocessAngularVelocity(
-        util::time::TimeValue const &tv, Eigen::Quaterniond const &deltaquat,
-        double dt) {
+    Eigen::Vector3d TrackedBodyIMU::deltaQuatToAngularVelocity(
+        Eigen::Quaterniond const &deltaquat, double dt) {
         /// @todo handle transform for off-center velocity!
 
         /// @todo This has HDK-specific transforms in it!
@@ -111,15 +267,24 @@ namespace vbtracker {
             auto angle = std::acos(deltaquat.w());
             rot = deltaquat.vec().normalized() * angle * 2 / dt;
         }
+        return rot;
+    }
+
+    /// Processes an angular velocity
+    CannedIMUMeasurement TrackedBodyIMU::preprocessAngularVelocity(
+        util::time::TimeValue const &tv, Eigen::Quaterniond const &deltaquat,
+        double dt) {
         auto ret = CannedIMUMeasurement{};
-        ret.setAngVel(rot,
+        ret.setAngVel(deltaQuatToAngularVelocity(deltaquat, dt),
                       Eigen::Vector3d::Constant(m_angularVelocityVariance));
         return ret;
     }
 
     bool TrackedBodyIMU::updatePoseFromMeasurement(
-        util::time::TimeValue const &tv, CannedIMUMeasurement const &meas) {
-        if (!meas.orientationValid() && !meas.angVelValid()) {
+        util::time::TimeValue const &tv, CannedIMUMeasurement meas) {
+        addLinearAcceleration(tv, meas);
+        if (!meas.orientationValid() && !meas.angVelValid() &&
+            !meas.linAccelValid()) {
             return false;
         }
         getBody().incorporateNewMeasurementFromIMU(tv, meas);
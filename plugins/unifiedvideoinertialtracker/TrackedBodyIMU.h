@@ -30,6 +30,8 @@
 #include "CannedIMUMeasurement.h"
 
 // Library/third-party includes
+#include <osvr/Kalman/ConstantProcess.h>
+#include <osvr/Kalman/PureVectorState.h>
 #include <osvr/Util/Angles.h>
 #include <osvr/Util/EigenCoreGeometry.h>
 #include <osvr/Util/TimeValue.h>
@@ -60,6 +62,22 @@ namespace vbtracker {
                                            Eigen::Quaterniond const &deltaquat,
                                            double dt);
 
+        /// Processes an orientation and an angular velocity reported for the
+        /// same instant, incorporating them into state in a single update.
+        void updatePoseFromOrientationAndAngularVelocity(
+            util::time::TimeValue const &tv, Eigen::Quaterniond const &quat,
+            Eigen::Quaterniond const &deltaquat, double dt);
+
+        /// Processes a linear acceleration: a raw accelerometer reading, in
+        /// the same frame as orientation reports.
+        void updatePoseFromLinearAcceleration(util::time::TimeValue const &tv,
+                                              Eigen::Vector3d const &accel);
+
+        /// Current estimate of the accelerometer bias, in the IMU frame.
+        Eigen::Vector3d const &getAccelerometerBias() const {
+            return m_accelBias.stateVector();
+        }
+
         bool hasPoseEstimate() const { return m_hasOrientation; }
         util::time::TimeValue const &getLastUpdate() const { return m_last; }
         /// This estimate incorporates the calibration yaw correction.
@@ -80,6 +98,11 @@ namespace vbtracker {
         Eigen::Quaterniond
         transformRawIMUOrientation(Eigen::Quaterniond const &input) const;
 
+        /// Converts a raw delta quat over dt into an angular velocity vector.
+        static Eigen::Vector3d
+        deltaQuatToAngularVelocity(Eigen::Quaterniond const &deltaquat,
+                                   double dt);
+
         /// Takes in raw delta quats, dt, and timestamps, transforms them, and
         /// spits out a "canned" measurement that can be stored and incorporated
         /// into state.
@@ -95,12 +118,26 @@ namespace vbtracker {
         preprocessOrientation(util::time::TimeValue const &tv,
                               Eigen::Quaterniond const &quat);
 
-        /// Takes in timestamps and a canned measurement and passes it to the
-        /// body to incorporate into state.
+        /// Updates the accelerometer bias estimate: only corrected when the
+        /// body is known to be at rest, so the reading should be just the
+        /// reaction to gravity.
+        void updateAccelerometerBias(util::time::TimeValue const &tv,
+                                     Eigen::Vector3d const &accel);
+
+        /// Adds the most recent (bias-corrected) acceleration, if there is a
+        /// fresh enough one, to a canned measurement, so that every
+        /// prediction interval uses it, not just those ending in an
+        /// acceleration report.
+        void addLinearAcceleration(util::time::TimeValue const &tv,
+                                   CannedIMUMeasurement &meas) const;
+
+        /// Takes in timestamps and a canned measurement, adds any current
+        /// linear acceleration, and passes it to the body to incorporate into
+        /// state.
         /// @return false if you pass a completely invalid/empty canned
         /// measurement.
         bool updatePoseFromMeasurement(util::time::TimeValue const &tv,
-                                       CannedIMUMeasurement const &meas);
+                                       CannedIMUMeasurement meas);
 
         ConfigParams const &getParams() const;
         TrackedBody &m_body;
@@ -113,6 +150,15 @@ namespace vbtracker {
         bool m_useAngularVelocity;
         double m_angularVelocityVariance;
 
+        bool m_useLinearAcceleration;
+        double m_linearAccelerationVariance;
+        bool m_hasLinearAcceleration = false;
+        Eigen::Vector3d m_linearAcceleration;
+        util::time::TimeValue m_linearAccelerationTime;
+        using AccelBiasState = kalman::PureVectorState<3>;
+        AccelBiasState m_accelBias;
+        kalman::ConstantProcess<AccelBiasState> m_accelBiasProcess;
+
         bool m_hasOrientation = false;
         Eigen::Quaterniond m_quat;
         util::time::TimeValue m_last;
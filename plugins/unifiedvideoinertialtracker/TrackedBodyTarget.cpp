@@ -25,6 +25,9 @@
 // Internal Includes
 #include "TrackedBodyTarget.h"
 #include "TrackedBody.h"
+#include "TrackedBodyIMU.h"
+#include "TrackingSystem.h"
+#include "SpaceTransformations.h"
 #include "LED.h"
 #include "cvToEigen.h"
 #include "HDKLedIdentifier.h"
@@ -33,13 +36,18 @@
 #include "PoseEstimator_SCAATKalman.h"
 #include "PoseEstimator_RANSACKalman.h"
 #include "BodyTargetInterface.h"
+#include "ProjectPoint.h"
 
 // Library/third-party includes
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
 #include <boost/assert.hpp>
 #include <util/Stride.h>
 
 // Standard includes
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 /// Define this to use the RANSAC Kalman instead of the autocalibrating SCAAT
 /// Kalman, primarily for troubleshooting purposes.
@@ -93,7 +101,8 @@ namespace vbtracker {
     };
     struct TrackedBodyTarget::Impl {
         Impl(ConfigParams const &params, BodyTargetInterface const &bodyIface)
-            : bodyInterface(bodyIface), kalmanEstimator(params) {}
+            : bodyInterface(bodyIface), ransacEstimator(params),
+              kalmanEstimator(params) {}
         BodyTargetInterface bodyInterface;
         LedGroup leds;
         LedPtrList usableLeds;
@@ -109,6 +118,19 @@ namespace vbtracker {
         TargetTrackingState trackingState = TargetTrackingState::RANSAC;
         bool hasPrev = false;
         osvr::util::time::TimeValue lastEstimate;
+
+        /// Where each beacon is predicted to appear in the current frame, in
+        /// LED measurement (not tracking) image coordinates: parallel to the
+        /// beacon vectors, and only filled if predictive association is on.
+        std::vector<cv::Point2f> predictedBeaconLocations;
+        /// Whether the corresponding entry in predictedBeaconLocations is
+        /// meaningful (the beacon is in front of the camera)
+        std::vector<bool> beaconLocationPredicted;
+        /// Whether each beacon is predicted to be emitting towards the camera
+        /// squarely enough to be used.
+        std::vector<bool> beaconFacingCamera;
+
+        ProvisionalIdStats provisionalIdStats;
     };
 
     inline BeaconStateVec createBeaconStateVec(ConfigParams const &params,
@@ -212,7 +234,9 @@ namespace vbtracker {
     }
 
     std::size_t TrackedBodyTarget::processLedMeasurements(
-        LedMeasurementVec const &undistortedLeds) {
+        LedMeasurementVec const &undistortedLeds,
+        osvr::util::time::TimeValue const &tv,
+        CameraParameters const &camParams) {
         // std::list<LedMeasurement> measurements{begin(undistortedLeds),
         // end(undistortedLeds)};
         LedMeasurementVec measurements{undistortedLeds};
@@ -255,12 +279,39 @@ namespace vbtracker {
             return false;
         };
 
+        /// If we're tracking this target, we can look for identified LEDs
+        /// where the body state says they should be now, rather than where
+        /// they were last frame, so they don't lose their identity when the
+        /// target moves quickly.
+        /// The same predictions let us provisionally identify new blobs.
+        const bool predictiveAssociation =
+            getParams().predictiveBlobAssociation;
+        const bool provisionalIdentification =
+            getParams().provisionalIdentification;
+        const bool havePredictions =
+            (predictiveAssociation || provisionalIdentification) &&
+            m_predictBeaconLocations(tv, camParams);
+        auto &predicted = m_impl->predictedBeaconLocations;
+        auto &isPredicted = m_impl->beaconLocationPredicted;
+        auto &provisionalStats = m_impl->provisionalIdStats;
+
         auto led = begin(myLeds);
         while (led != end(myLeds)) {
             led->resetUsed();
             handleOutOfRangeIds(*led);
             auto threshold = blobMoveThreshold * led->getMeasurement().diameter;
-            auto nearest = led->nearest(measurements, threshold);
+            auto nearest = end(measurements);
+            if (havePredictions && predictiveAssociation &&
+                led->identified()) {
+                auto index = asIndex(led->getID());
+                if (index < isPredicted.size() && isPredicted[index]) {
+                    nearest =
+                        led->nearest(measurements, threshold, predicted[index]);
+                }
+            }
+            if (nearest == end(measurements)) {
+                nearest = led->nearest(measurements, threshold);
+            }
             if (nearest == end(measurements)) {
                 // We have no blob corresponding to this LED, so we need
                 // to delete this LED.
@@ -269,7 +320,18 @@ namespace vbtracker {
                 // Update the values in this LED and then go on to the
                 // next one. Remove this blob from the list of
                 // potential matches.
+                const bool wasProvisional = led->provisionallyIdentified();
+                const auto oldId = led->getID();
                 led->addMeasurement(*nearest, blobsKeepIdentity);
+                if (wasProvisional && !led->provisionallyIdentified()) {
+                    /// The blink code has been read: see if the model got it
+                    /// right.
+                    if (led->getID() == oldId) {
+                        provisionalStats.confirmed++;
+                    } else {
+                        provisionalStats.revoked++;
+                    }
+                }
                 if (!handleOutOfRangeIds(*led)) {
                     /// If that measurement didn't cause this beacon to go awry,
                     /// then we'll actually handle the measurement and increment
@@ -290,9 +352,181 @@ namespace vbtracker {
         for (auto &remainingLed : measurements) {
             myLeds.emplace_back(m_impl->identifier.get(), remainingLed);
         }
+
+        if (provisionalIdentification && havePredictions) {
+            m_updateProvisionalIds();
+        } else {
+            /// Without a tracked pose, there's nothing to back up any
+            /// provisional IDs.
+            for (auto &led : myLeds) {
+                led.clearProvisionalID();
+            }
+        }
         return usedMeasurements;
     }
 
+    void TrackedBodyTarget::m_updateProvisionalIds() {
+        auto &myLeds = m_impl->leds;
+        auto const &predicted = m_impl->predictedBeaconLocations;
+        auto const &isPredicted = m_impl->beaconLocationPredicted;
+        auto const &facing = m_impl->beaconFacingCamera;
+        const auto numBeacons = predicted.size();
+
+        /// Beacons whose blink codes have been read off of some blob aren't
+        /// up for grabs.
+        std::vector<bool> claimed(numBeacons, false);
+        for (auto const &led : myLeds) {
+            if (led.identified() && !led.provisionallyIdentified()) {
+                auto index = asIndex(led.getID());
+                if (index < numBeacons) {
+                    claimed[index] = true;
+                }
+            }
+        }
+
+        const auto maxDist = getParams().provisionalIdentificationMaxDistance;
+        const auto maxDistSq = maxDist * maxDist;
+        const auto ratio = getParams().provisionalIdentificationAmbiguityRatio;
+        const auto ratioSq = ratio * ratio;
+
+        /// Re-evaluated from scratch every frame, so a provisional ID only
+        /// lasts as long as the model keeps supporting it.
+        struct Candidate {
+            double distSq;
+            Led *led;
+            std::size_t beacon;
+        };
+        std::vector<Candidate> candidates;
+        for (auto &led : myLeds) {
+            if (!led.provisionallyIdentified() &&
+                led.getID().value() !=
+                    Led::SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA) {
+                /// The blink code has already said which beacon this is, or
+                /// that it isn't one.
+                continue;
+            }
+            auto loc = led.getLocation();
+            auto bestDistSq = std::numeric_limits<double>::max();
+            auto secondDistSq = std::numeric_limits<double>::max();
+            auto best = numBeacons;
+            for (std::size_t i = 0; i < numBeacons; ++i) {
+                if (!isPredicted[i]) {
+                    continue;
+                }
+                auto diff = predicted[i] - loc;
+                auto distSq = static_cast<double>(diff.dot(diff));
+                if (claimed[i] || !facing[i]) {
+                    /// Can't be this beacon, but being near it still makes
+                    /// the call less certain (reflections, merged blobs).
+                    secondDistSq = std::min(secondDistSq, distSq);
+                    continue;
+                }
+                if (distSq < bestDistSq) {
+                    secondDistSq = bestDistSq;
+                    bestDistSq = distSq;
+                    best = i;
+                } else if (distSq < secondDistSq) {
+                    secondDistSq = distSq;
+                }
+            }
+            if (best == numBeacons || bestDistSq > maxDistSq ||
+                secondDistSq < ratioSq * bestDistSq) {
+                /// Nothing close enough, or too close to call.
+                led.clearProvisionalID();
+                continue;
+            }
+            candidates.push_back(Candidate{bestDistSq, &led, best});
+        }
+
+        /// Closest matches get first pick of the beacons.
+        std::sort(begin(candidates), end(candidates),
+                  [](Candidate const &a, Candidate const &b) {
+                      return a.distSq < b.distSq;
+                  });
+        auto &stats = m_impl->provisionalIdStats;
+        for (auto const &candidate : candidates) {
+            auto &led = *candidate.led;
+            if (claimed[candidate.beacon]) {
+                led.clearProvisionalID();
+                continue;
+            }
+            claimed[candidate.beacon] = true;
+            auto id = ZeroBasedBeaconId(
+                static_cast<UnderlyingBeaconIdType>(candidate.beacon));
+            if (!led.provisionallyIdentified() || led.getID() != id) {
+                stats.assigned++;
+            }
+            led.setProvisionalID(id);
+        }
+    }
+
+    bool TrackedBodyTarget::m_predictBeaconLocations(
+        osvr::util::time::TimeValue const &tv,
+        CameraParameters const &camParams) {
+        if (!m_hasPoseEstimate ||
+            m_impl->trackingState != TargetTrackingState::Kalman) {
+            /// RANSAC mode means we don't trust the state enough to steer the
+            /// blob association with it.
+            return false;
+        }
+        auto &body = getBody();
+        util::time::TimeValue stateTime;
+        BodyState state;
+        if (!body.getStateAtOrBefore(tv, stateTime, state)) {
+            return false;
+        }
+        if (stateTime != tv) {
+            /// This state already incorporates any IMU reports up to
+            /// stateTime: carry it the rest of the way to the frame time.
+            auto dt = util::time::duration(tv, stateTime);
+            kalman::predict(state, body.getProcessModel(), dt);
+            state.externalizeRotation();
+        }
+
+        const auto numBeacons = m_beacons.size();
+        auto &predicted = m_impl->predictedBeaconLocations;
+        auto &isPredicted = m_impl->beaconLocationPredicted;
+        auto &facing = m_impl->beaconFacingCamera;
+        predicted.resize(numBeacons);
+        isPredicted.assign(numBeacons, false);
+        facing.assign(numBeacons, false);
+        const auto maxZComponent = getParams().maxZComponent;
+
+        const Eigen::Quaterniond rot = state.getCombinedQuaternion();
+        /// Same transformation as the state correction and image point
+        /// measurement applied in the Kalman estimator.
+        const Eigen::Vector3d xlate =
+            state.position() + rot * (m_beaconOffset + m_targetToBody);
+        const auto focalLength = camParams.focalLength();
+        const Eigen::Vector2d principalPoint = camParams.eiPrincipalPoint();
+        const auto &imageSize = camParams.imageSize;
+        for (std::size_t i = 0; i < numBeacons; ++i) {
+            Eigen::Vector3d camPoint =
+                rot * m_beacons[i]->stateVector() + xlate;
+            if (camPoint.z() <= 0) {
+                // Behind the camera - no meaningful projection.
+                continue;
+            }
+            /// Same test the Kalman estimator uses to skip oblique beacons.
+            facing[i] =
+                (rot * cvToVector(m_beaconEmissionDirection[i])).z() <=
+                maxZComponent;
+            Eigen::Vector2d pt =
+                projectPoint(focalLength, principalPoint, camPoint);
+            /// Projection is into the tracking coordinate system: undo the
+            /// flip that getLocationForTracking() applies, if any.
+            if (USING_INVERTED_LED_POSITION) {
+                pt = Eigen::Vector2d(static_cast<double>(imageSize.width),
+                                     static_cast<double>(imageSize.height)) -
+                     pt;
+            }
+            predicted[i] = cv::Point2f(static_cast<float>(pt.x()),
+                                       static_cast<float>(pt.y()));
+            isPredicted[i] = true;
+        }
+        return true;
+    }
+
     bool TrackedBodyTarget::updatePoseEstimateFromLeds(
         CameraParameters const &camParams,
         osvr::util::time::TimeValue const &tv, BodyState &bodyState,
@@ -367,7 +601,10 @@ namespace vbtracker {
                                            m_targetToBody};
         switch (m_impl->trackingState) {
         case TargetTrackingState::RANSAC: {
-            m_hasPoseEstimate = m_impl->ransacEstimator(params, usableLeds());
+            Eigen::Quaterniond orientationPrior;
+            auto havePrior = m_getIMUOrientationPrior(tv, orientationPrior);
+            m_hasPoseEstimate = m_impl->ransacEstimator(
+                params, usableLeds(), havePrior ? &orientationPrior : nullptr);
             break;
         }
 
@@ -432,6 +669,29 @@ namespace vbtracker {
         return m_hasPoseEstimate;
     }
 
+    bool TrackedBodyTarget::m_getIMUOrientationPrior(
+        osvr::util::time::TimeValue const &tv, Eigen::Quaterniond &quat) {
+        if (!getParams().imuAidedAcquisition) {
+            return false;
+        }
+        auto &body = getBody();
+        if (!body.hasIMU() || !body.getSystem().isRoomCalibrationComplete()) {
+            return false;
+        }
+        auto const &imu = body.getIMU();
+        if (!imu.hasPoseEstimate() || !imu.calibrationYawKnown()) {
+            return false;
+        }
+        auto age = std::abs(util::time::duration(tv, imu.getLastUpdate()));
+        if (age > getParams().imuAidedAcquisitionMaxAge) {
+            return false;
+        }
+        /// Same camera-space orientation the IMU measurements are applied to
+        /// the body state with.
+        quat = getQuatToCameraSpace(body.getSystem()) * imu.getPoseEstimate();
+        return true;
+    }
+
     bool TrackedBodyTarget::uncalibratedRANSACPoseEstimateFromLeds(
         CameraParameters const &camParams, Eigen::Vector3d &xlate,
         Eigen::Quaterniond &quat) {
@@ -511,6 +771,11 @@ namespace vbtracker {
             usable.push_back(&led);
         }
     }
+    ProvisionalIdStats const &
+    TrackedBodyTarget::getProvisionalIdStats() const {
+        return m_impl->provisionalIdStats;
+    }
+
     osvr::util::time::TimeValue const &
     TrackedBodyTarget::getLastUpdate() const {
         return m_impl->lastEstimate;
@@ -39,6 +39,7 @@
 #include <boost/assert.hpp>
 
 // Standard includes
+#include <cstddef>
 #include <vector>
 #include <iosfwd>
 
@@ -56,6 +57,14 @@ namespace vbtracker {
         void reset() { *this = BeaconData{}; }
     };
 
+    /// Running totals of model-based provisional identifications of blobs,
+    /// and how they turned out once the blobs' blink codes were read.
+    struct ProvisionalIdStats {
+        std::size_t assigned = 0;
+        std::size_t confirmed = 0;
+        std::size_t revoked = 0;
+    };
+
     class TrackedBody;
     struct BodyTargetInterface;
     /// Corresponds to a rigid arrangements of discrete beacons detected by
@@ -96,10 +105,16 @@ namespace vbtracker {
         /// Called each frame with the results of the blob finding and
         /// undistortion (part of the first phase of the tracking system)
         ///
+        /// @param tv Timestamp of the frame the measurements came from
+        /// @param camParams Undistorted camera parameters for that frame: used
+        /// with the body state to predict where identified LEDs should appear.
+        ///
         /// @return number of LED measurements/blobs used locally on existing
         /// LEDs.
         std::size_t
-        processLedMeasurements(LedMeasurementVec const &undistortedLeds);
+        processLedMeasurements(LedMeasurementVec const &undistortedLeds,
+                               osvr::util::time::TimeValue const &tv,
+                               CameraParameters const &camParams);
 
         /// Update the pose estimate using the updated LEDs - part of the third
         /// phase of tracking.
@@ -127,6 +142,8 @@ namespace vbtracker {
             CameraParameters const &camParams, Eigen::Vector3d &xlate,
             Eigen::Quaterniond &quat);
 
+        ProvisionalIdStats const &getProvisionalIdStats() const;
+
         /// Did this target yet, or last time it was asked to, compute a
         /// pose estimate?
         bool hasPoseEstimate() const { return m_hasPoseEstimate; }
@@ -162,6 +179,26 @@ namespace vbtracker {
 
         LedPtrList &usableLeds();
 
+        /// Predict the body state forward to tv and project each beacon into
+        /// the image, filling in the predicted beacon locations in the
+        /// private implementation.
+        ///
+        /// @return false if there was no state suitable to predict from.
+        bool m_predictBeaconLocations(osvr::util::time::TimeValue const &tv,
+                                      CameraParameters const &camParams);
+
+        /// Provisionally identify blobs not yet identified by their blink
+        /// codes using the predicted beacon locations, and drop provisional
+        /// IDs the predictions no longer support.
+        void m_updateProvisionalIds();
+
+        /// Gets the camera-space orientation of the body according to the
+        /// IMU, if there is an IMU, its orientation can be put into camera
+        /// space (room calibration is complete), and it has reported close
+        /// enough to the given frame time.
+        bool m_getIMUOrientationPrior(osvr::util::time::TimeValue const &tv,
+                                      Eigen::Quaterniond &quat);
+
         ConfigParams const &getParams() const;
         void m_verifyInvariants() const {
             BOOST_ASSERT_MSG(m_beacons.size() ==
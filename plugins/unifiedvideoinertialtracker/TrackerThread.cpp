@@ -27,12 +27,14 @@
 #include "TrackedBody.h"
 #include "TrackedBodyIMU.h"
 #include "SpaceTransformations.h"
+#include "BlobThresholdController.h"
 
 // Library/third-party includes
 #include <osvr/Util/Finally.h>
 #include <osvr/Util/EigenInterop.h>
 
 // Standard includes
+#include <algorithm>
 #include <iostream>
 #include <future>
 
@@ -44,8 +46,17 @@ namespace vbtracker {
                                  ImageSource &imageSource,
                                  BodyReportingVector &reportingVec,
                                  CameraParameters const &camParams)
-        : m_trackingSystem(trackingSystem), m_cam(imageSource),
-          m_reportingVec(reportingVec), m_camParams(camParams) {
+        : m_trackingSystem(trackingSystem), m_reportingVec(reportingVec),
+          m_camParams(camParams),
+          m_grabber(imageSource,
+                    FrameTimestampModel{
+                        trackingSystem.getParams().cameraLatency},
+                    [&] {
+                        // Lock so the notification can't slip in between a
+                        // waiter checking its predicate and going to sleep.
+                        { std::lock_guard<std::mutex> lock(m_messageMutex); }
+                        m_messageCondVar.notify_one();
+                    }) {
         msg() << "Tracker thread object created." << std::endl;
     }
     TrackerThread::~TrackerThread() {
@@ -71,6 +82,28 @@ namespace vbtracker {
         std::this_thread::sleep_for(std::chrono::milliseconds(500));
         msg() << "Tracker thread object entering its main execution loop."
               << std::endl;
+        m_grabber.start();
+        auto stopGrabber = util::finally([&] {
+            m_grabber.stop();
+            auto stats = getFrameStats();
+            msg() << "Frames processed: " << stats.processed
+                  << ", dropped: " << stats.dropped
+                  << ", stale: " << stats.stale
+                  << ", mean capture-to-estimate age: "
+                  << stats.meanAge * 1000. << "ms (max "
+                  << stats.maxAge * 1000. << "ms)" << std::endl;
+            if (m_trackingSystem.getParams().blobParams.adaptiveThreshold) {
+                auto const &thresh =
+                    m_trackingSystem.getBlobThresholdController();
+                msg() << "Mean blobs per frame: "
+                      << thresh.getMeanBlobsPerFrame()
+                      << ", identified beacons: "
+                      << thresh.getMeanIdentifiedPerFrame()
+                      << ", threshold steps: " << thresh.getStepCount()
+                      << ", final offset: " << thresh.getOffset()
+                      << std::endl;
+            }
+        });
 
 #ifdef OSVR_TRACKER_THREAD_WRAP_WITH_TRY
         try {
@@ -104,8 +137,21 @@ namespace vbtracker {
     void TrackerThread::triggerStop() {
         /// Main thread method!
         msg() << "Tracker thread object: triggerStop() called" << std::endl;
-        std::lock_guard<std::mutex> lock(m_runMutex);
-        m_run = false;
+        {
+            std::lock_guard<std::mutex> lock(m_runMutex);
+            m_run = false;
+        }
+        {
+            // In case we're waiting for a frame that's not coming.
+            std::lock_guard<std::mutex> lock(m_messageMutex);
+            m_stopRequested = true;
+        }
+        m_messageCondVar.notify_one();
+    }
+
+    TrackerFrameStats TrackerThread::getFrameStats() const {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        return m_stats;
     }
 
     void TrackerThread::submitIMUReport(TrackedBodyIMU &imu,
@@ -129,74 +175,116 @@ namespace vbtracker {
         }
         m_messageCondVar.notify_one();
     }
+    void
+    TrackerThread::submitIMUReport(TrackedBodyIMU &imu,
+                                   util::time::TimeValue const &tv,
+                                   OSVR_LinearAccelerationReport const &report) {
+        /// Main thread method!
+        {
+            std::lock_guard<std::mutex> lock(m_messageMutex);
+            m_messages.push(std::make_tuple(&imu, tv, report));
+        }
+        m_messageCondVar.notify_one();
+    }
 
     std::ostream &TrackerThread::msg() const {
         return std::cout << "[UnifiedTracker] ";
     }
     std::ostream &TrackerThread::warn() const { return msg() << "Warning: "; }
-    void TrackerThread::doFrame() {
-        // Check camera status.
-        if (!m_cam.ok()) {
-            // Hmm, camera seems bad. Might regain it? Skip for now...
-            warn() << "Camera is reporting it is not OK." << std::endl;
-            return;
-        }
-        // Trigger a grab.
-        if (!m_cam.grab()) {
-            // Again failing without quitting, in hopes we get better luck
-            // next time...
-            warn() << "Camera grab failed." << std::endl;
-            return;
-        }
-        // When we triggered the grab is our current best guess of the time
-        // for the image
-        /// @todo backdate to account for image transfer image, exposure
-        /// time, etc.
-        m_triggerTime = util::time::getNow();
-
-        /// Launch an asynchronous task to perform the image retrieval and
-        /// initial image processing.
-        launchTimeConsumingImageStep();
-
-        bool finishedImage = false;
+    template <typename F>
+    inline void TrackerThread::processIMUMessagesUntil(F &&pred) {
+        bool done = false;
         do {
 
             MessageEntry message = boost::none;
+            MessageEntry nextMessage = boost::none;
             {
-                /// Wait for something to do (Completion of image, IMU reports)
+                /// Wait for something to do (predicate, IMU reports)
                 std::unique_lock<std::mutex> lock(m_messageMutex);
-                m_messageCondVar.wait(lock, [&] {
-                    return m_timeConsumingImageStepComplete ||
-                           !m_messages.empty();
-                });
-                if (m_timeConsumingImageStepComplete) {
-                    /// Set a flag to get us out of this innermost loop - we'll
-                    /// finish up processing this frame and trigger another grab
-                    /// before we look at more IMU data.
-                    finishedImage = true;
+                m_messageCondVar.wait(
+                    lock, [&] { return pred() || !m_messages.empty(); });
+                if (pred()) {
+                    /// Set a flag to get us out of this loop - the caller has
+                    /// more important things to do before we look at more IMU
+                    /// data.
+                    done = true;
                 } else {
                     // OK, we have some IMU reports to keep us busy in the
                     // meantime. Grab the first one and we'll process it while
                     // not holding the mutex.
                     message = m_messages.front();
                     m_messages.pop();
+                    // Take the next one too, in case it's the other half of
+                    // a pair we can process jointly.
+                    if (!m_messages.empty()) {
+                        nextMessage = m_messages.front();
+                        m_messages.pop();
+                    }
                 }
             } // unlock
 
+            if (processIMUMessagePair(message, nextMessage)) {
+                continue;
+            }
             if (!message.empty()) {
                 processIMUMessage(message);
             }
-        } while (!finishedImage);
+            if (!nextMessage.empty()) {
+                processIMUMessage(nextMessage);
+            }
+        } while (!done);
+    }
 
-        // OK, once we get here, we know the timeConsumingImageStep is complete.
-        if (!m_frame.data || !m_frameGray.data) {
-            // but it ended early due to error.
-            warn() << "Camera retrieve appeared to fail: frames had null "
-                      "pointers!"
+    void TrackerThread::doFrame() {
+        /// Wait for the grabber to have a frame, keeping up with the IMU in
+        /// the meantime.
+        processIMUMessagesUntil(
+            [&] { return m_stopRequested || m_grabber.haveNewFrame(); });
+        if (!m_grabber.takeNewestFrame(m_grabbedFrame)) {
+            // Stop requested.
+            return;
+        }
+
+        auto grabFailures = m_grabber.getStats().grabFailures;
+        if (grabFailures != m_lastGrabFailures) {
+            // Failing without quitting, in hopes we get better luck next
+            // time...
+            warn() << "Camera grab failed "
+                   << (grabFailures - m_lastGrabFailures) << " time(s)."
                    << std::endl;
+            m_lastGrabFailures = grabFailures;
+        }
+
+        auto const &frame = m_grabbedFrame;
+        {
+            // Anything between this frame and the last one we took was
+            // superseded while we were busy.
+            std::lock_guard<std::mutex> lock(m_statsMutex);
+            m_stats.dropped += frame.sequence - m_lastSequence - 1;
+        }
+        m_lastSequence = frame.sequence;
+
+        if (util::time::duration(util::time::getNow(), frame.tv) >
+            m_trackingSystem.getParams().maxFrameAge) {
+            // Too late to be worth the work: let the IMU carry us until the
+            // next one.
+            std::lock_guard<std::mutex> lock(m_statsMutex);
+            ++m_stats.stale;
             return;
         }
 
+        m_triggerTime = frame.tv;
+        m_frame = frame.frame;
+        m_frameGray = frame.frameGray;
+
+        /// Launch an asynchronous task to perform the initial image
+        /// processing.
+        launchTimeConsumingImageStep();
+
+        processIMUMessagesUntil(
+            [&] { return m_timeConsumingImageStepComplete; });
+
+        // OK, once we get here, we know the timeConsumingImageStep is complete.
         if (!m_imageData) {
             // but it failed to set the pointer? this is very strange...
             warn() << "Initial image processing failed somehow!" << std::endl;
@@ -207,6 +295,7 @@ namespace vbtracker {
         auto bodyIds =
             m_trackingSystem.updateBodiesFromVideoData(std::move(m_imageData));
         m_imageData.reset();
+        recordProcessedFrame();
 
         // Process any accumulated IMU messages so we don't get backed up.
         std::vector<MessageEntry> imuMessages;
@@ -223,12 +312,28 @@ namespace vbtracker {
                 }
             }
         } // unlock
-        for (auto const &msg : imuMessages) {
-            processIMUMessage(msg);
+        const auto numMessages = imuMessages.size();
+        for (std::size_t i = 0; i < numMessages; ++i) {
+            if (i + 1 < numMessages &&
+                processIMUMessagePair(imuMessages[i], imuMessages[i + 1])) {
+                ++i;
+                continue;
+            }
+            processIMUMessage(imuMessages[i]);
         }
 
         updateReportingVector(bodyIds);
     }
+
+    void TrackerThread::recordProcessedFrame() {
+        auto age = util::time::duration(util::time::getNow(), m_triggerTime);
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_stats.processed;
+        m_stats.lastAge = age;
+        m_stats.meanAge += (age - m_stats.meanAge) / m_stats.processed;
+        m_stats.maxAge = std::max(m_stats.maxAge, age);
+    }
+
     class IMUMessageProcessor : public boost::static_visitor<> {
       public:
         void operator()(boost::none_t const &) const {
@@ -262,12 +367,45 @@ namespace vbtracker {
                     .quat(),
                 angVel.state.dt);
         }
+
+        static void updatePose(TrackedBodyIMU &imu,
+                               util::time::TimeValue const &timestamp,
+                               OSVR_LinearAccelerationReport const &accel) {
+            imu.updatePoseFromLinearAcceleration(
+                timestamp, util::eigen_interop::map(accel.state));
+        }
     };
 
     void TrackerThread::processIMUMessage(MessageEntry const &m) {
         boost::apply_visitor(IMUMessageProcessor{}, m);
     }
 
+    bool TrackerThread::processIMUMessagePair(MessageEntry const &first,
+                                              MessageEntry const &second) {
+        auto ori = boost::get<TimestampedOrientation>(&first);
+        auto angVel = boost::get<TimestampedAngVel>(&second);
+        if (!ori || !angVel) {
+            ori = boost::get<TimestampedOrientation>(&second);
+            angVel = boost::get<TimestampedAngVel>(&first);
+        }
+        if (!ori || !angVel) {
+            return false;
+        }
+        auto &imu = *std::get<0>(*ori);
+        auto const &timestamp = std::get<1>(*ori);
+        if (&imu != std::get<0>(*angVel) || timestamp != std::get<1>(*angVel)) {
+            return false;
+        }
+        auto const &oriReport = std::get<2>(*ori);
+        auto const &angVelReport = std::get<2>(*angVel);
+        imu.updatePoseFromOrientationAndAngularVelocity(
+            timestamp, util::eigen_interop::map(oriReport.rotation).quat(),
+            util::eigen_interop::map(angVelReport.state.incrementalRotation)
+                .quat(),
+            angVelReport.state.dt);
+        return true;
+    }
+
     void TrackerThread::updateReportingVector(BodyIndices const &bodyIds) {
         for (auto const &bodyId : bodyIds) {
             auto &body = m_trackingSystem.getBody(bodyId);
@@ -359,14 +497,6 @@ namespace vbtracker {
             m_messageCondVar.notify_one();
         });
 
-        // Pull the image into an OpenCV matrix named m_frame.
-        m_cam.retrieve(m_frame, m_frameGray);
-        if (!m_frame.data || !m_frameGray.data) {
-            // let the tracker thread warn if it wants to, we'll just get
-            // out.
-            return;
-        }
-
         // Do the slow, but intentionally async-able part of the image
         // processing.
         m_imageData = m_trackingSystem.performInitialImageProcessing(
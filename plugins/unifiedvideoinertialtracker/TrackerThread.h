@@ -26,6 +26,7 @@
 #define INCLUDED_TrackerThread_h_GUID_6544B03C_4EB4_4B82_77F1_16EF83578C64
 
 // Internal Includes
+#include "FrameGrabber.h"
 #include "TrackingSystem.h"
 #include "ThreadsafeBodyReporting.h"
 #include "CameraParameters.h"
@@ -48,6 +49,7 @@
 #include <condition_variable>
 #include <tuple>
 #include <chrono>
+#include <cstdint>
 #include <future>
 
 namespace osvr {
@@ -60,8 +62,29 @@ namespace vbtracker {
     using TimestampedAngVel =
         std::tuple<TrackedBodyIMU *, util::time::TimeValue,
                    OSVR_AngularVelocityReport>;
-    using MessageEntry = boost::variant<boost::none_t, TimestampedOrientation,
-                                        TimestampedAngVel>;
+    using TimestampedLinAccel =
+        std::tuple<TrackedBodyIMU *, util::time::TimeValue,
+                   OSVR_LinearAccelerationReport>;
+    using MessageEntry =
+        boost::variant<boost::none_t, TimestampedOrientation,
+                       TimestampedAngVel, TimestampedLinAccel>;
+
+    /// Statistics on how camera frames have been consumed by the tracker.
+    struct TrackerFrameStats {
+        /// Frames submitted to the tracking system.
+        std::uint64_t processed = 0;
+        /// Frames that a newer frame replaced before we got to them.
+        std::uint64_t dropped = 0;
+        /// Frames skipped for exceeding ConfigParams::maxFrameAge.
+        std::uint64_t stale = 0;
+        /// @name Seconds from a processed frame's (estimated) exposure to the
+        /// body estimates having been updated with it.
+        /// @{
+        double lastAge = 0;
+        double meanAge = 0;
+        double maxAge = 0;
+        /// @}
+    };
 
     class TrackerThread : boost::noncopyable {
       public:
@@ -90,6 +113,12 @@ namespace vbtracker {
         void submitIMUReport(TrackedBodyIMU &imu,
                              util::time::TimeValue const &tv,
                              OSVR_AngularVelocityReport const &report);
+        void submitIMUReport(TrackedBodyIMU &imu,
+                             util::time::TimeValue const &tv,
+                             OSVR_LinearAccelerationReport const &report);
+
+        /// Get a snapshot of the frame statistics.
+        TrackerFrameStats getFrameStats() const;
         /// @}
 
       private:
@@ -102,6 +131,13 @@ namespace vbtracker {
         /// video.
         void doFrame();
 
+        /// Processes IMU messages as they arrive until the predicate
+        /// (evaluated with m_messageMutex held) is true.
+        template <typename F> void processIMUMessagesUntil(F &&pred);
+
+        /// Updates statistics after a frame has been processed.
+        void recordProcessedFrame();
+
         /// Copy updated body state into the reporting vector.
         void updateReportingVector(BodyIndices const &bodyIds);
 
@@ -109,37 +145,55 @@ namespace vbtracker {
         /// timeConsumingImageStep() asynchronously.
         void launchTimeConsumingImageStep();
 
-        /// The "time consuming image step" - specifically, retrieving the image
-        /// and performing the initial blob detection on it. This gets launched
+        /// The "time consuming image step" - specifically, performing the
+        /// initial blob detection on the image. This gets launched
         /// asynchronously by launchTimeConsumingImageStep()
         void timeConsumingImageStep();
 
         void processIMUMessage(MessageEntry const &m);
 
+        /// If the two messages are an orientation and an angular velocity
+        /// from the same IMU for the same instant (in either order), processes
+        /// them as a single joint update and returns true. Otherwise, does
+        /// nothing and returns false.
+        bool processIMUMessagePair(MessageEntry const &first,
+                                   MessageEntry const &second);
+
         TrackingSystem &m_trackingSystem;
-        ImageSource &m_cam;
         BodyReportingVector &m_reportingVec;
         CameraParameters m_camParams;
 
         using our_clock = std::chrono::steady_clock;
         boost::optional<our_clock::time_point> m_nextCameraPoseReport;
 
-        /// Time that the last camera grab was triggered.
+        /// Estimated exposure time of the frame being processed.
         util::time::TimeValue m_triggerTime;
 
+        /// Sequence number of the last frame taken from the grabber.
+        std::uint64_t m_lastSequence = 0;
+        std::uint64_t m_lastGrabFailures = 0;
+
+        /// @name Frame statistics
+        /// @{
+        mutable std::mutex m_statsMutex;
+        TrackerFrameStats m_stats;
+        /// @}
+
         /// a void promise, as suggested by Scott Meyers, to hold the thread
         /// operation at the beginning until we want it to really start running.
         std::promise<void> m_startupSignal;
 
         bool m_setCameraPose = false;
 
-        /// @name Updated asynchronously by timeConsumingImageStep()
+        /// @name Input to timeConsumingImageStep()
         /// @{
         cv::Mat m_frame;
         cv::Mat m_frameGray;
-        ImageOutputDataPtr m_imageData;
         /// @}
 
+        /// Updated asynchronously by timeConsumingImageStep()
+        ImageOutputDataPtr m_imageData;
+
         /// @name Run flag
         /// @{
         std::mutex m_runMutex;
@@ -153,10 +207,16 @@ namespace vbtracker {
         std::mutex m_messageMutex;
         std::queue<MessageEntry> m_messages;
         bool m_timeConsumingImageStepComplete = false;
+        bool m_stopRequested = false;
         /// @}
 
         /// The thread used by timeConsumingImageStep()
         std::thread m_imageThread;
+
+        /// Captures frames on its own thread, so we always get the newest
+        /// one. Declared last since it notifies on m_messageCondVar.
+        FrameGrabber m_grabber;
+        GrabbedFrame m_grabbedFrame;
     };
 } // namespace vbtracker
 } // namespace osvr
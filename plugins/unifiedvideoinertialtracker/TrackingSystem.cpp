@@ -26,6 +26,7 @@
 #include "TrackingSystem.h"
 #include "TrackedBody.h"
 #include "TrackedBodyTarget.h"
+#include "LED.h"
 #include "UndistortMeasurements.h"
 #include "ForEachTracked.h"
 #include "TrackingSystem_Impl.h"
@@ -95,14 +96,49 @@ namespace vbtracker {
         /// Go through each target and try to process the measurements.
         forEachTarget(*this, [&](TrackedBodyTarget &target) {
             auto usedMeasurements =
-                target.processLedMeasurements(imageData->ledMeasurements);
+                target.processLedMeasurements(imageData->ledMeasurements,
+                                              imageData->tv,
+                                              imageData->camParams);
             if (usedMeasurements != 0) {
                 updateCount[target.getQualifiedId()] = usedMeasurements;
             }
         });
+
+        if (m_params.blobParams.adaptiveThreshold) {
+            updateBlobThreshold(imageData->ledMeasurements.size());
+        }
         return updateCount;
     }
 
+    void TrackingSystem::updateBlobThreshold(std::size_t numBlobs) {
+        /// Provisional IDs are guesses from the model, not evidence that the
+        /// threshold lets the blink codes be read, so they don't count.
+        std::size_t numIdentified = 0;
+        forEachTarget(*this, [&](TrackedBodyTarget const &target) {
+            for (auto const &led : target.leds()) {
+                if (led.identified() && !led.provisionallyIdentified()) {
+                    ++numIdentified;
+                }
+            }
+        });
+        auto &controller = m_impl->thresholdController;
+        if (!controller.update(numBlobs, numIdentified)) {
+            return;
+        }
+        /// Takes effect from the next frame's blob extraction.
+        m_impl->blobExtractor->setThresholdOffset(controller.getOffset());
+        std::cout << "[UnifiedTracker] Blob threshold offset "
+                  << getAdjustmentName(controller.getAdjustment()) << " to "
+                  << controller.getOffset() << ": " << numBlobs
+                  << " blobs, " << numIdentified << " identified beacons"
+                  << std::endl;
+    }
+
+    BlobThresholdController const &
+    TrackingSystem::getBlobThresholdController() const {
+        return m_impl->thresholdController;
+    }
+
     BodyIndices const &
     TrackingSystem::updateBodiesFromVideoData(ImageOutputDataPtr &&imageData) {
         /// Do the second phase of stuff
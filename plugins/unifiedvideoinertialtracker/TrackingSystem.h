@@ -47,6 +47,7 @@ namespace osvr {
 namespace vbtracker {
     class TrackedBody;
     class TrackedBodyTarget;
+    class BlobThresholdController;
     using BodyIndices = std::vector<BodyId>;
 
     using LedUpdateCount = std::unordered_map<BodyTargetId, std::size_t>;
@@ -122,6 +123,9 @@ namespace vbtracker {
             return *m_bodies.at(i.value());
         }
         TrackedBodyTarget *getTarget(BodyTargetId target);
+        /// Adjusts blob extraction thresholds, if
+        /// blobParams.adaptiveThreshold is set.
+        BlobThresholdController const &getBlobThresholdController() const;
         /// @}
 
         /// @todo refactor;
@@ -156,6 +160,10 @@ namespace vbtracker {
         /// calibration is incomplete.
         void calibrationVideoPhaseThree();
 
+        /// Feeds the blob and identified beacon counts from the second phase
+        /// to the threshold controller.
+        void updateBlobThreshold(std::size_t numBlobs);
+
         using BodyPtr = std::unique_ptr<TrackedBody>;
         ConfigParams m_params;
 
@@ -38,6 +38,7 @@ namespace vbtracker {
 
     TrackingSystem::Impl::Impl(ConfigParams const &params)
         : blobExtractor(new SBDBlobExtractor(params.blobParams)),
+          thresholdController(params.blobParams),
           debugDisplay(new TrackingDebugDisplay(params)),
           calib(Eigen::Vector3d(params.cameraPosition), params.cameraIsForward),
           cameraPose(Eigen::Isometry3d::Identity()),
@@ -30,6 +30,7 @@
 #include "CameraParameters.h"
 #include "ConfigParams.h"
 #include "RoomCalibration.h"
+#include "BlobThresholdController.h"
 
 // Library/third-party includes
 #include <osvr/Util/TimeValue.h>
@@ -71,6 +72,8 @@ namespace vbtracker {
 
         LedUpdateCount updateCount;
         std::unique_ptr<SBDBlobExtractor> blobExtractor;
+        /// Only updated if blobParams.adaptiveThreshold is set.
+        BlobThresholdController thresholdController;
         std::unique_ptr<TrackingDebugDisplay> debugDisplay;
     };
 
@@ -44,15 +44,25 @@ static const auto FPS_MEASUREMENT_PERIOD = std::chrono::seconds(3);
 class FrameCounter {
   public:
     FrameCounter() { reset(); }
-    void gotFrame() {
+    /// @param age Seconds from when the source says the frame was captured
+    /// until we got it, if the source timestamps frames itself.
+    void gotFrame(double const *age = nullptr) {
         ++m_frames;
+        if (age) {
+            ++m_agedFrames;
+            m_totalAge += *age;
+        }
         auto now = clock::now();
         if (now >= m_end) {
             auto duration =
                 std::chrono::duration_cast<std::chrono::duration<double>>(
                     now - m_begin);
-            std::cout << m_frames / duration.count() << " FPS read from camera"
-                      << std::endl;
+            std::cout << m_frames / duration.count() << " FPS read from camera";
+            if (m_agedFrames) {
+                std::cout << ", " << m_totalAge / m_agedFrames * 1000.
+                          << " ms mean age when retrieved";
+            }
+            std::cout << std::endl;
             reset();
         }
     }
@@ -61,6 +71,8 @@ class FrameCounter {
         m_begin = clock::now();
         m_end = m_begin + FPS_MEASUREMENT_PERIOD;
         m_frames = 0;
+        m_agedFrames = 0;
+        m_totalAge = 0;
     }
 
   private:
@@ -69,6 +81,8 @@ class FrameCounter {
     time_point m_begin;
     time_point m_end;
     std::size_t m_frames = 0;
+    std::size_t m_agedFrames = 0;
+    double m_totalAge = 0;
 };
 
 int main(int argc, char *argv[]) {
@@ -76,10 +90,25 @@ int main(int argc, char *argv[]) {
 #ifdef _WIN32
     auto cam = osvr::vbtracker::openHDKCameraDirectShow();
 #else
-    std::cerr << "Warning: Just using OpenCV to open Camera #0, which may not "
-                 "be the tracker camera."
-              << std::endl;
-    auto cam = osvr::vbtracker::openOpenCVCamera(0);
+    auto cam = osvr::vbtracker::ImageSourcePtr{};
+#ifdef __linux__
+    /// Optional second argument: a V4L2 device to capture from directly.
+    /// Captured the way the tracker does by default: the HDK IR camera's
+    /// 640x480 at 100 frames per second.
+    static const auto V4L2_BUFFERS = 3u;
+    static const auto V4L2_FRAME_RATE = 100u;
+    if (argc > 2) {
+        cam = osvr::vbtracker::openV4L2Camera(argv[2], V4L2_BUFFERS,
+                                              cv::Size(640, 480),
+                                              V4L2_FRAME_RATE);
+    }
+#endif
+    if (!cam) {
+        std::cerr << "Warning: Just using OpenCV to open Camera #0, which may "
+                     "not be the tracker camera."
+                  << std::endl;
+        cam = osvr::vbtracker::openOpenCVCamera(0);
+    }
 #endif
     if (!cam || !cam->ok()) {
         std::cerr << "Couldn't find, open, or read from the OSVR HDK tracking "
@@ -122,8 +151,16 @@ int main(int argc, char *argv[]) {
     cv::namedWindow(windowNameAndInstructions);
     auto frameCount = std::size_t{0};
     do {
+        osvr::util::time::TimeValue captured;
+        auto haveTimestamp = cam->getGrabTimestamp(captured);
         cam->retrieve(frame, grayFrame);
-        counter.gotFrame();
+        if (haveTimestamp) {
+            auto age = osvr::util::time::duration(osvr::util::time::getNow(),
+                                                  captured);
+            counter.gotFrame(&age);
+        } else {
+            counter.gotFrame();
+        }
         ++frameCount;
         if (frameCount % FRAME_DISPLAY_STRIDE == 0) {
             frameCount = 0;
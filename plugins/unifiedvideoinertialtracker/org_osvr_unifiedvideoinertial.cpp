@@ -135,6 +135,11 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
             osvrRegisterAngularVelocityCallback(
                 m_clientInterface, &UnifiedVideoInertialTracker::angVelCallback,
                 this);
+            if (params.imu.useLinearAcceleration) {
+                osvrRegisterLinearAccelerationCallback(
+                    m_clientInterface,
+                    &UnifiedVideoInertialTracker::linAccelCallback, this);
+            }
         }
 
         /// Set up thread communication.
@@ -164,6 +169,12 @@ class UnifiedVideoInertialTracker : boost::noncopyable {
         auto &self = *static_cast<UnifiedVideoInertialTracker *>(userdata);
         self.handleData(*timestamp, *report);
     }
+    static void linAccelCallback(void *userdata,
+                                 const OSVR_TimeValue *timestamp,
+                                 const OSVR_LinearAccelerationReport *report) {
+        auto &self = *static_cast<UnifiedVideoInertialTracker *>(userdata);
+        self.handleData(*timestamp, *report);
+    }
 
     ~UnifiedVideoInertialTracker() { stopTrackerThread(); }
 
@@ -291,12 +302,25 @@ class ConfiguredDeviceConstructor {
 #ifdef _WIN32
         auto cam = osvr::vbtracker::openHDKCameraDirectShow();
 #else // !_WIN32
+        auto cam = osvr::vbtracker::ImageSourcePtr{};
+#ifdef __linux__
+        if (!config.v4l2Device.empty() && config.v4l2Buffers > 0 &&
+            config.v4l2Width > 0 && config.v4l2Height > 0 &&
+            config.v4l2FrameRate > 0) {
+            cam = osvr::vbtracker::openV4L2Camera(
+                config.v4l2Device,
+                static_cast<unsigned int>(config.v4l2Buffers),
+                cv::Size(config.v4l2Width, config.v4l2Height),
+                static_cast<unsigned int>(config.v4l2FrameRate));
+        }
+#endif
         /// @todo This is rather crude, as we can't select the exact camera we
         /// want, nor set the "50Hz" high-gain mode (and only works with HDK
         /// camera firmware v7 and up). Presumably eventually use libuvc on
         /// other platforms instead, at least for the HDK IR camera.
-
-        auto cam = osvr::vbtracker::openOpenCVCamera(0);
+        if (!cam || !cam->ok()) {
+            cam = osvr::vbtracker::openOpenCVCamera(0);
+        }
 #endif
 
         if (!cam || !cam->ok()) {
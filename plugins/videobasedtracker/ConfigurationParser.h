@@ -119,6 +119,8 @@ namespace vbtracker {
                                  "maxThresholdAlpha");
             getOptionalParameter(config.blobParams.thresholdSteps, blob,
                                  "thresholdSteps");
+            getOptionalParameter(config.blobParams.useIntegerMoments, blob,
+                                 "useIntegerMoments");
         }
 
         return config;
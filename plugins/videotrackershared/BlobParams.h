@@ -73,6 +73,44 @@ namespace vbtracker {
         /// the blob extractor will take between the two threshold extrema, and
         /// thus greatly impacts performance. Adjust with care.
         int thresholdSteps = 4;
+
+        /// If true, instead of OpenCV's SimpleBlobDetector (multiple
+        /// thresholds, contours, float moments), blobs are found with a
+        /// single-pass integer connected-component and moment computation at
+        /// the minimum threshold. This gives intensity-weighted sub-pixel
+        /// centroids and bounding boxes at a fraction of the cost. minArea,
+        /// minDistBetweenBlobs, and circularity (estimated from the blob's
+        /// moments) are applied; convexity is not.
+        bool useIntegerMoments = false;
+
+        /// @name Adaptive threshold control
+        /// @brief If enabled, an offset added to the computed thresholds is
+        /// adjusted from frame to frame to keep the number of spurious
+        /// (non-beacon) blobs down without losing dim beacons. See
+        /// BlobThresholdController.
+        /// @{
+        bool adaptiveThreshold = false;
+        /// If there are more blobs than this in a frame that aren't identified
+        /// beacons, the threshold needs to go up.
+        int adaptiveMaxSpuriousBlobs = 20;
+        /// If there are fewer identified beacons than this in a frame (and
+        /// spurious blobs are at most half of adaptiveMaxSpuriousBlobs), the
+        /// threshold needs to come down.
+        int adaptiveMinIdentifiedBeacons = 4;
+        /// The threshold is only lowered while some beacon has been
+        /// identified within this many frames: with no target in view, a
+        /// lack of beacons says nothing about the threshold.
+        int adaptiveTargetLostFrames = 10;
+        /// Number of consecutive frames needing the same adjustment before
+        /// each step is taken.
+        int adaptiveHysteresisFrames = 5;
+        /// Amount, in pixel values, the offset changes with each step.
+        double adaptiveThresholdStep = 4.;
+        /// Lower limit on the offset, in pixel values.
+        double adaptiveMinThresholdOffset = -30.;
+        /// Upper limit on the offset, in pixel values.
+        double adaptiveMaxThresholdOffset = 100.;
+        /// @}
     };
 
 } // namespace vbtracker
@@ -0,0 +1,116 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BlobThresholdController.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace vbtracker {
+    BlobThresholdController::BlobThresholdController(BlobParams const &params)
+        : m_params(params) {}
+
+    bool BlobThresholdController::update(std::size_t numBlobs,
+                                         std::size_t numIdentified) {
+        ++m_frames;
+        m_totalBlobs += numBlobs;
+        m_totalIdentified += numIdentified;
+        if (numIdentified > 0) {
+            m_framesSinceTargetSeen = 0;
+        } else if (m_framesSinceTargetSeen >= 0) {
+            ++m_framesSinceTargetSeen;
+        }
+
+        auto numSpurious =
+            numBlobs > numIdentified ? numBlobs - numIdentified : 0;
+        auto adjustment = m_getAdjustment(numSpurious, numIdentified);
+        if (adjustment != m_adjustment) {
+            m_adjustment = adjustment;
+            m_framesInAdjustment = 0;
+        }
+        if (Adjustment::Holding == adjustment) {
+            return false;
+        }
+        ++m_framesInAdjustment;
+        if (m_framesInAdjustment < m_params.adaptiveHysteresisFrames) {
+            return false;
+        }
+        /// Take a step, then require another full run of frames before the
+        /// next one, to give this one a chance to take effect.
+        m_framesInAdjustment = 0;
+        auto step = Adjustment::Raising == adjustment
+                        ? m_params.adaptiveThresholdStep
+                        : -m_params.adaptiveThresholdStep;
+        auto newOffset =
+            std::min(std::max(m_offset + step,
+                              m_params.adaptiveMinThresholdOffset),
+                     m_params.adaptiveMaxThresholdOffset);
+        if (newOffset == m_offset) {
+            return false;
+        }
+        m_offset = newOffset;
+        ++m_steps;
+        return true;
+    }
+
+    double BlobThresholdController::getMeanBlobsPerFrame() const {
+        return m_frames == 0 ? 0. : static_cast<double>(m_totalBlobs) /
+                                        static_cast<double>(m_frames);
+    }
+
+    double BlobThresholdController::getMeanIdentifiedPerFrame() const {
+        return m_frames == 0 ? 0. : static_cast<double>(m_totalIdentified) /
+                                        static_cast<double>(m_frames);
+    }
+
+    BlobThresholdController::Adjustment
+    BlobThresholdController::m_getAdjustment(std::size_t numSpurious,
+                                             std::size_t numIdentified) const {
+        auto maxSpurious = static_cast<std::size_t>(
+            std::max(m_params.adaptiveMaxSpuriousBlobs, 0));
+        if (numSpurious > maxSpurious) {
+            return Adjustment::Raising;
+        }
+        auto minIdentified = static_cast<std::size_t>(
+            std::max(m_params.adaptiveMinIdentifiedBeacons, 0));
+        /// Only lower the threshold while there's plenty of room below the
+        /// raising point, so the two don't fight each other.
+        if (numIdentified < minIdentified && numSpurious * 2 <= maxSpurious &&
+            m_targetRecentlySeen()) {
+            return Adjustment::Lowering;
+        }
+        return Adjustment::Holding;
+    }
+
+    bool BlobThresholdController::m_targetRecentlySeen() const {
+        return m_framesSinceTargetSeen >= 0 &&
+               m_framesSinceTargetSeen <= m_params.adaptiveTargetLostFrames;
+    }
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,115 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_BlobThresholdController_h_GUID_2B1CC1E6_ACB0_4C33_9745_006F4EACEBD5
+#define INCLUDED_BlobThresholdController_h_GUID_2B1CC1E6_ACB0_4C33_9745_006F4EACEBD5
+
+// Internal Includes
+#include "BlobParams.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+
+namespace osvr {
+namespace vbtracker {
+    /// Closed-loop control of an offset added to the blob extraction
+    /// thresholds, based on how many of the blobs in each frame turned out to
+    /// be identified beacons.
+    ///
+    /// Too many spurious blobs (from ambient IR, reflections, other headsets)
+    /// cost time in extraction and in LED association and identification, so
+    /// the threshold is raised; too few identified beacons with little noise
+    /// around suggests dim beacons are being missed, so it's lowered (but only
+    /// while a target is in view or was recently, since otherwise there are
+    /// no beacons to miss). Between
+    /// the two is a dead band where nothing changes, and a step is only taken
+    /// after the same adjustment has been called for over several consecutive
+    /// frames, so the offset doesn't chase single-frame fluctuations.
+    class BlobThresholdController {
+      public:
+        enum class Adjustment { Holding, Raising, Lowering };
+
+        explicit BlobThresholdController(BlobParams const &params);
+
+        /// @brief Feeds back the results of a frame.
+        /// @param numBlobs Number of blobs extracted from the frame.
+        /// @param numIdentified Number of those that were identified beacons.
+        /// @return true if the offset changed.
+        bool update(std::size_t numBlobs, std::size_t numIdentified);
+
+        /// Gets the offset, in pixel values, to add to the thresholds.
+        double getOffset() const { return m_offset; }
+
+        /// Gets the adjustment called for by the latest frame.
+        Adjustment getAdjustment() const { return m_adjustment; }
+
+        /// @name Statistics
+        /// @{
+        std::uint64_t getFrameCount() const { return m_frames; }
+        std::uint64_t getStepCount() const { return m_steps; }
+        double getMeanBlobsPerFrame() const;
+        double getMeanIdentifiedPerFrame() const;
+        /// @}
+
+      private:
+        Adjustment m_getAdjustment(std::size_t numSpurious,
+                                   std::size_t numIdentified) const;
+        /// Whether some beacon was identified recently enough that missing
+        /// beacons may mean the threshold is too high.
+        bool m_targetRecentlySeen() const;
+        BlobParams m_params;
+        double m_offset = 0;
+        Adjustment m_adjustment = Adjustment::Holding;
+        /// Consecutive frames calling for m_adjustment since the last step.
+        int m_framesInAdjustment = 0;
+        /// Frames since the last one with an identified beacon, or -1 if
+        /// there hasn't been one yet.
+        std::int64_t m_framesSinceTargetSeen = -1;
+
+        std::uint64_t m_frames = 0;
+        std::uint64_t m_steps = 0;
+        std::uint64_t m_totalBlobs = 0;
+        std::uint64_t m_totalIdentified = 0;
+    };
+
+    inline const char *
+    getAdjustmentName(BlobThresholdController::Adjustment adjustment) {
+        switch (adjustment) {
+        case BlobThresholdController::Adjustment::Raising:
+            return "raising";
+        case BlobThresholdController::Adjustment::Lowering:
+            return "lowering";
+        case BlobThresholdController::Adjustment::Holding:
+        default:
+            return "holding";
+        }
+    }
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_BlobThresholdController_h_GUID_2B1CC1E6_ACB0_4C33_9745_006F4EACEBD5
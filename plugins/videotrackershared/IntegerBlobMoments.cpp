@@ -0,0 +1,276 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "IntegerBlobMoments.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace osvr {
+namespace vbtracker {
+    /// Width of the chunks examined at once when skipping dark pixels: the
+    /// max-reduction over a chunk is a simple loop compilers vectorize.
+    static const int SKIP_CHUNK = 16;
+
+    /// Returns the column of the first pixel at or after x that is at or
+    /// above threshold, or width if there is none.
+    static inline int skipBelowThreshold(std::uint8_t const *row, int x,
+                                         int width, std::uint8_t threshold) {
+        // Tracking frames are mostly dark, so whole chunks can be skipped
+        // after a single comparison.
+        while (x + SKIP_CHUNK <= width) {
+            std::uint8_t chunkMax = 0;
+            for (int i = 0; i < SKIP_CHUNK; ++i) {
+                chunkMax = std::max(chunkMax, row[x + i]);
+            }
+            if (chunkMax >= threshold) {
+                break;
+            }
+            x += SKIP_CHUNK;
+        }
+        while (x < width && row[x] < threshold) {
+            ++x;
+        }
+        return x;
+    }
+
+    /// Sum of the integers in [0, n).
+    static inline std::uint64_t sumUpTo(int n) {
+        const std::uint64_t un = static_cast<std::uint64_t>(n);
+        return un * (un - 1) / 2;
+    }
+
+    /// Sum of the squares of the integers in [0, n).
+    static inline std::uint64_t sumOfSquaresUpTo(int n) {
+        const std::uint64_t un = static_cast<std::uint64_t>(n);
+        return (un - 1) * un * (2 * un - 1) / 6;
+    }
+
+    void IntegerBlobMoments::Accumulator::merge(Accumulator const &other) {
+        area += other.area;
+        sumW += other.sumW;
+        sumWX += other.sumWX;
+        sumWY += other.sumWY;
+        sumWXX += other.sumWXX;
+        sumWYY += other.sumWYY;
+        sumWXY += other.sumWXY;
+        sumX += other.sumX;
+        sumY += other.sumY;
+        sumXX += other.sumXX;
+        sumYY += other.sumYY;
+        sumXY += other.sumXY;
+        minX = std::min(minX, other.minX);
+        minY = std::min(minY, other.minY);
+        maxX = std::max(maxX, other.maxX);
+        maxY = std::max(maxY, other.maxY);
+    }
+
+    std::uint32_t IntegerBlobMoments::m_find(std::uint32_t label) {
+        while (m_parent[label] != label) {
+            // path halving
+            m_parent[label] = m_parent[m_parent[label]];
+            label = m_parent[label];
+        }
+        return label;
+    }
+
+    void IntegerBlobMoments::m_unite(std::uint32_t a, std::uint32_t b) {
+        a = m_find(a);
+        b = m_find(b);
+        if (a < b) {
+            m_parent[b] = a;
+        } else if (b < a) {
+            m_parent[a] = b;
+        }
+    }
+
+    std::vector<BlobMoments> const &IntegerBlobMoments::
+    operator()(std::uint8_t const *data, int width, int height,
+               std::size_t stride, std::uint8_t threshold) {
+        m_prevRuns.clear();
+        m_parent.clear();
+        m_accum.clear();
+        m_results.clear();
+
+        /// Subtracting this from a pixel at or above threshold gives a weight
+        /// of at least 1.
+        const std::uint32_t weightOffset = threshold - 1u;
+
+        for (int y = 0; y < height; ++y) {
+            auto row = data + stride * y;
+            m_curRuns.clear();
+            int x = 0;
+            while (true) {
+                x = skipBelowThreshold(row, x, width, threshold);
+                if (x >= width) {
+                    break;
+                }
+                const int begin = x;
+                std::uint64_t sumW = 0;
+                std::uint64_t sumWX = 0;
+                std::uint64_t sumWXX = 0;
+                for (; x < width && row[x] >= threshold; ++x) {
+                    const std::uint64_t w = row[x] - weightOffset;
+                    const std::uint64_t ux = static_cast<std::uint64_t>(x);
+                    sumW += w;
+                    sumWX += w * ux;
+                    sumWXX += w * ux * ux;
+                }
+                const std::uint64_t uy = static_cast<std::uint64_t>(y);
+                // The unweighted sums over a run have closed forms.
+                const std::uint64_t n = static_cast<std::uint64_t>(x - begin);
+                const std::uint64_t sumX = sumUpTo(x) - sumUpTo(begin);
+                const std::uint64_t sumXX =
+                    sumOfSquaresUpTo(x) - sumOfSquaresUpTo(begin);
+                auto label = static_cast<std::uint32_t>(m_parent.size());
+                m_parent.push_back(label);
+                m_accum.push_back(Accumulator{
+                    static_cast<std::uint32_t>(n), sumW, sumWX, sumW * uy,
+                    sumWXX, sumW * uy * uy, sumWX * uy, sumX, n * uy, sumXX,
+                    n * uy * uy, sumX * uy, begin, y, x - 1, y});
+                m_curRuns.push_back(Run{begin, x, label});
+            }
+
+            // Join with 8-connected runs from the previous row: both lists
+            // are sorted by column.
+            std::size_t j = 0;
+            for (auto const &run : m_curRuns) {
+                while (j < m_prevRuns.size() && m_prevRuns[j].end < run.begin) {
+                    ++j;
+                }
+                for (auto k = j;
+                     k < m_prevRuns.size() && m_prevRuns[k].begin <= run.end;
+                     ++k) {
+                    m_unite(run.label, m_prevRuns[k].label);
+                }
+            }
+            std::swap(m_prevRuns, m_curRuns);
+        }
+
+        // Fold each run's sums into the root of its component. Roots always
+        // have the smallest label in their set, so they precede their members.
+        const auto numLabels = static_cast<std::uint32_t>(m_parent.size());
+        for (std::uint32_t label = 0; label < numLabels; ++label) {
+            auto root = m_find(label);
+            if (root != label) {
+                m_accum[root].merge(m_accum[label]);
+            }
+        }
+
+        for (std::uint32_t label = 0; label < numLabels; ++label) {
+            if (m_parent[label] != label) {
+                continue;
+            }
+            auto const &acc = m_accum[label];
+            BlobMoments blob;
+            const double w = static_cast<double>(acc.sumW);
+            blob.x = acc.sumWX / w;
+            blob.y = acc.sumWY / w;
+            blob.area = acc.area;
+            blob.totalWeight = acc.sumW;
+            blob.mu20 = acc.sumWXX / w - blob.x * blob.x;
+            blob.mu02 = acc.sumWYY / w - blob.y * blob.y;
+            blob.mu11 = acc.sumWXY / w - blob.x * blob.y;
+            const double area = static_cast<double>(acc.area);
+            const double shapeX = acc.sumX / area;
+            const double shapeY = acc.sumY / area;
+            // Each pixel is a unit square, which adds its own 1/12 to the
+            // variance along each axis.
+            blob.shapeMu20 = acc.sumXX / area - shapeX * shapeX + 1. / 12.;
+            blob.shapeMu02 = acc.sumYY / area - shapeY * shapeY + 1. / 12.;
+            blob.shapeMu11 = acc.sumXY / area - shapeX * shapeY;
+            blob.minX = acc.minX;
+            blob.minY = acc.minY;
+            blob.maxX = acc.maxX;
+            blob.maxY = acc.maxY;
+            m_results.push_back(blob);
+        }
+        return m_results;
+    }
+
+    double estimateCircularity(BlobMoments const &blob) {
+        static const double PI = 3.14159265358979323846;
+        // Eigenvalues of the shape covariance are the variances along the
+        // principal axes; a uniform ellipse has semi-axes of twice their
+        // square roots.
+        const double mean = (blob.shapeMu20 + blob.shapeMu02) / 2;
+        const double halfDiff = (blob.shapeMu20 - blob.shapeMu02) / 2;
+        const double spread =
+            std::sqrt(halfDiff * halfDiff + blob.shapeMu11 * blob.shapeMu11);
+        const double a = 2 * std::sqrt(mean + spread);
+        const double b = 2 * std::sqrt(std::max(mean - spread, 0.));
+        // Ramanujan's approximation of the ellipse perimeter.
+        const double perimeter =
+            PI * (3 * (a + b) - std::sqrt((3 * a + b) * (a + 3 * b)));
+        if (perimeter <= 0) {
+            return 0;
+        }
+        return std::min(1., 4 * PI * blob.area / (perimeter * perimeter));
+    }
+
+    void mergeNearbyBlobs(std::vector<BlobMoments> &blobs, double minDist) {
+        const double minDistSq = minDist * minDist;
+        std::vector<BlobMoments> merged;
+        merged.reserve(blobs.size());
+        for (auto const &blob : blobs) {
+            auto existing = std::find_if(
+                merged.begin(), merged.end(), [&](BlobMoments const &other) {
+                    const double dx = other.x - blob.x;
+                    const double dy = other.y - blob.y;
+                    return dx * dx + dy * dy < minDistSq;
+                });
+            if (existing == merged.end()) {
+                merged.push_back(blob);
+                continue;
+            }
+            auto &target = *existing;
+            const double wTarget = static_cast<double>(target.totalWeight);
+            const double wBlob = static_cast<double>(blob.totalWeight);
+            const double w = wTarget + wBlob;
+            if (wBlob > wTarget) {
+                target.mu20 = blob.mu20;
+                target.mu02 = blob.mu02;
+                target.mu11 = blob.mu11;
+                target.shapeMu20 = blob.shapeMu20;
+                target.shapeMu02 = blob.shapeMu02;
+                target.shapeMu11 = blob.shapeMu11;
+            }
+            target.x = (target.x * wTarget + blob.x * wBlob) / w;
+            target.y = (target.y * wTarget + blob.y * wBlob) / w;
+            target.area += blob.area;
+            target.totalWeight += blob.totalWeight;
+            target.minX = std::min(target.minX, blob.minX);
+            target.minY = std::min(target.minY, blob.minY);
+            target.maxX = std::max(target.maxX, blob.maxX);
+            target.maxY = std::max(target.maxY, blob.maxY);
+        }
+        blobs.swap(merged);
+    }
+} // namespace vbtracker
+} // namespace osvr
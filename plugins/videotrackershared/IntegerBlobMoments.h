@@ -0,0 +1,138 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_IntegerBlobMoments_h_GUID_CF358E02_D909_4F35_A1E6_C865F913AA31
+#define INCLUDED_IntegerBlobMoments_h_GUID_CF358E02_D909_4F35_A1E6_C865F913AA31
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// Results for a single connected component of above-threshold pixels.
+    struct BlobMoments {
+        /// Intensity-weighted centroid, in pixel coordinates.
+        double x = 0;
+        double y = 0;
+        /// Number of pixels in the component.
+        std::uint32_t area = 0;
+        /// Sum of the pixel weights (value - threshold + 1) in the component.
+        std::uint64_t totalWeight = 0;
+        /// Intensity-weighted central second moments, normalized by
+        /// totalWeight (units: square pixels).
+        double mu20 = 0;
+        double mu02 = 0;
+        double mu11 = 0;
+        /// Unweighted central second moments of the component's pixels,
+        /// each treated as a unit square, normalized by area (units: square
+        /// pixels): the shape of the blob regardless of its brightness.
+        double shapeMu20 = 0;
+        double shapeMu02 = 0;
+        double shapeMu11 = 0;
+        /// Upright bounding box, inclusive.
+        int minX = 0;
+        int minY = 0;
+        int maxX = 0;
+        int maxY = 0;
+    };
+
+    /// Computes, in a single pass over an 8-bit image, the 8-connected
+    /// components of pixels at or above a threshold along with their
+    /// intensity-weighted centroid, area, second moments, and bounding box.
+    ///
+    /// All accumulation is done in integers, per run of above-threshold pixels,
+    /// with runs joined across rows by union-find, so there is no separate
+    /// thresholding, contour tracing, or float moment pass. Keeps its scratch
+    /// storage between calls to avoid per-frame allocation.
+    class IntegerBlobMoments {
+      public:
+        /// @param data Pointer to the first pixel of the first row.
+        /// @param width Width in pixels
+        /// @param height Height in pixels
+        /// @param stride Bytes from the start of one row to the next.
+        /// @param threshold Minimum pixel value to be part of a blob.
+        std::vector<BlobMoments> const &
+        operator()(std::uint8_t const *data, int width, int height,
+                   std::size_t stride, std::uint8_t threshold);
+
+      private:
+        struct Accumulator {
+            std::uint32_t area;
+            std::uint64_t sumW;
+            std::uint64_t sumWX;
+            std::uint64_t sumWY;
+            std::uint64_t sumWXX;
+            std::uint64_t sumWYY;
+            std::uint64_t sumWXY;
+            std::uint64_t sumX;
+            std::uint64_t sumY;
+            std::uint64_t sumXX;
+            std::uint64_t sumYY;
+            std::uint64_t sumXY;
+            int minX;
+            int minY;
+            int maxX;
+            int maxY;
+            void merge(Accumulator const &other);
+        };
+        struct Run {
+            /// First column in the run
+            int begin;
+            /// One past the last column in the run
+            int end;
+            std::uint32_t label;
+        };
+        std::uint32_t m_find(std::uint32_t label);
+        void m_unite(std::uint32_t a, std::uint32_t b);
+
+        std::vector<Run> m_prevRuns;
+        std::vector<Run> m_curRuns;
+        std::vector<std::uint32_t> m_parent;
+        std::vector<Accumulator> m_accum;
+        std::vector<BlobMoments> m_results;
+    };
+
+    /// Estimates the circularity (4 pi area / perimeter^2, in [0, 1]) that
+    /// OpenCV's SimpleBlobDetector would compute from the blob's contour,
+    /// using the perimeter of the ellipse with the same shape moments.
+    double estimateCircularity(BlobMoments const &blob);
+
+    /// Merges blobs whose centroids are closer than minDist, as
+    /// SimpleBlobDetector's minDistBetweenBlobs groups nearby centers. The
+    /// centroids combine weighted by totalWeight, and areas, weights, and
+    /// bounding boxes accumulate. The second moments of a merged blob are
+    /// those of its heaviest part, so apply shape filters before merging.
+    void mergeNearbyBlobs(std::vector<BlobMoments> &blobs, double minDist);
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_IntegerBlobMoments_h_GUID_CF358E02_D909_4F35_A1E6_C865F913AA31
@@ -30,7 +30,9 @@
 #include <opencv2/features2d/features2d.hpp>
 
 // Standard includes
-// - none
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 #include <iostream>
 
@@ -227,6 +229,11 @@ namespace vbtracker {
         m_debugThresholdImageDirty = true;
         m_debugBlobImageDirty = true;
 
+        if (m_params.useIntegerMoments) {
+            getIntegerMomentBlobs(grayImage);
+            return m_latestMeasurements;
+        }
+
         getKeypoints(grayImage);
 
 #if 0
@@ -254,18 +261,16 @@ namespace vbtracker {
         return m_latestMeasurements;
     }
 
-    void SBDBlobExtractor::getKeypoints(cv::Mat const &grayImage) {
-        m_keyPoints.clear();
-        //================================================================
-        // Tracking the points
-
-        // Construct a blob detector and find the blobs in the image.
+    bool SBDBlobExtractor::updateThresholds(cv::Mat const &grayImage) {
         double minVal, maxVal;
         cv::minMaxIdx(grayImage, &minVal, &maxVal);
         auto &p = m_params;
-        if (maxVal < p.absoluteMinThreshold) {
+        auto offsetThreshold = [&](double threshold) {
+            return std::min(std::max(threshold + m_thresholdOffset, 0.), 255.);
+        };
+        if (maxVal < offsetThreshold(p.absoluteMinThreshold)) {
             /// empty image, early out!
-            return;
+            return false;
         }
 
         auto imageRangeLerp = [=](double alpha) {
@@ -273,13 +278,25 @@ namespace vbtracker {
         };
         // 0.3 LERP between min and max as the min threshold, but
         // don't let really dim frames confuse us.
-        m_sbdParams.minThreshold = std::max(imageRangeLerp(p.minThresholdAlpha),
-                                            p.absoluteMinThreshold);
-        m_sbdParams.maxThreshold =
-            std::max(imageRangeLerp(0.8), p.absoluteMinThreshold);
+        m_sbdParams.minThreshold = static_cast<float>(offsetThreshold(std::max(
+            imageRangeLerp(p.minThresholdAlpha), p.absoluteMinThreshold)));
+        m_sbdParams.maxThreshold = static_cast<float>(offsetThreshold(
+            std::max(imageRangeLerp(0.8), p.absoluteMinThreshold)));
         m_sbdParams.thresholdStep =
             (m_sbdParams.maxThreshold - m_sbdParams.minThreshold) /
             p.thresholdSteps;
+        return true;
+    }
+
+    void SBDBlobExtractor::getKeypoints(cv::Mat const &grayImage) {
+        m_keyPoints.clear();
+        //================================================================
+        // Tracking the points
+
+        // Construct a blob detector and find the blobs in the image.
+        if (!updateThresholds(grayImage)) {
+            return;
+        }
 /// @todo: Make a different set of parameters optimized for the
 /// Oculus Dk2.
 /// @todo: Determine the maximum size of a trackable blob by seeing
@@ -306,6 +323,51 @@ namespace vbtracker {
         // or augmenting with a new frame.
     }
 
+    void SBDBlobExtractor::getIntegerMomentBlobs(cv::Mat const &grayImage) {
+        m_keyPoints.clear();
+        if (!updateThresholds(grayImage)) {
+            return;
+        }
+        auto threshold = static_cast<std::uint8_t>(std::min(
+            255., std::ceil(static_cast<double>(m_sbdParams.minThreshold))));
+        auto const &blobs =
+            m_integerMoments(grayImage.ptr<std::uint8_t>(0), grayImage.cols,
+                             grayImage.rows, grayImage.step, threshold);
+        // Same order as SimpleBlobDetector: filter each component, then
+        // group those that are too close together.
+        m_filteredBlobs.clear();
+        for (auto const &blob : blobs) {
+            if (blob.area < m_params.minArea) {
+                continue;
+            }
+            if (m_params.filterByCircularity &&
+                estimateCircularity(blob) < m_params.minCircularity) {
+                continue;
+            }
+            m_filteredBlobs.push_back(blob);
+        }
+        mergeNearbyBlobs(m_filteredBlobs, m_params.minDistBetweenBlobs);
+
+        cv::Size sz = grayImage.size();
+        for (auto const &blob : m_filteredBlobs) {
+            LedMeasurement meas;
+            meas.loc = cv::Point2f(static_cast<float>(blob.x),
+                                   static_cast<float>(blob.y));
+            meas.imageSize = sz;
+            meas.area = static_cast<float>(blob.area);
+            meas.diameter = static_cast<float>(2 * std::sqrt(blob.area / CV_PI));
+            /// Same "brightness" the keypoint path provides, so blink-code
+            /// identification behaves the same.
+            meas.brightness = meas.diameter;
+            meas.knowBoundingBox = true;
+            meas.boundingBox =
+                cv::Size2f(static_cast<float>(blob.maxX - blob.minX + 1),
+                           static_cast<float>(blob.maxY - blob.minY + 1));
+            m_latestMeasurements.push_back(meas);
+            m_keyPoints.emplace_back(meas.loc, meas.diameter);
+        }
+    }
+
     cv::Mat SBDBlobExtractor::generateDebugThresholdImage() const {
 
         // Fake the thresholded image to give an idea of what the
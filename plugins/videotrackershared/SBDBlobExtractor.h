@@ -26,8 +26,9 @@
 #define INCLUDED_SBDBlobExtractor_h_GUID_E67E1F86_F827_48A3_5FA2_F9F241BA79AF
 
 // Internal Includes
-#include "LedMeasurement.h"
 #include "BlobParams.h"
+#include "IntegerBlobMoments.h"
+#include "LedMeasurement.h"
 
 // Library/third-party includes
 #include <opencv2/features2d/features2d.hpp>
@@ -46,6 +47,11 @@ namespace vbtracker {
         ~SBDBlobExtractor();
         LedMeasurementVec const &extractBlobs(cv::Mat const &grayImage);
 
+        /// Sets an offset, in pixel values, added to the thresholds computed
+        /// for each frame (see BlobThresholdController).
+        void setThresholdOffset(double offset) { m_thresholdOffset = offset; }
+        double getThresholdOffset() const { return m_thresholdOffset; }
+
         cv::Mat const &getDebugThresholdImage();
 
         cv::Mat const &getDebugBlobImage();
@@ -53,16 +59,28 @@ namespace vbtracker {
         cv::Mat const &getDebugExtraImage();
 #endif
       private:
+        /// Computes the threshold range for this frame into m_sbdParams.
+        /// @return false if the frame is too dim to contain any blobs.
+        bool updateThresholds(cv::Mat const &grayImage);
         void getKeypoints(cv::Mat const &grayImage);
+        /// Alternate to getKeypoints() that fills m_latestMeasurements (and
+        /// m_keyPoints, for debugging) directly, using IntegerBlobMoments.
+        void getIntegerMomentBlobs(cv::Mat const &grayImage);
         cv::Mat generateDebugThresholdImage() const;
         cv::Mat generateDebugBlobImage() const;
 
         BlobParams m_params;
+        double m_thresholdOffset = 0;
         cv::SimpleBlobDetector::Params m_sbdParams;
         LedMeasurementVec m_latestMeasurements;
 
         std::vector<cv::KeyPoint> m_keyPoints;
 
+        IntegerBlobMoments m_integerMoments;
+        /// Blobs from m_integerMoments that passed the filters, kept to
+        /// avoid per-frame allocation.
+        std::vector<BlobMoments> m_filteredBlobs;
+
 #if 0
         std::unique_ptr<KeypointDetailer> m_keypointDetailer;
 #endif
@@ -32,6 +32,7 @@
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/TreeResolutionCache.h>
 
 // Library/third-party includes
 #include <boost/assert.hpp>
@@ -82,7 +83,8 @@ namespace client {
         /// up a handler) we don't have a leftover one still active.
         m_interfaces.eraseHandlerForPath(path);
 
-        auto source = common::resolveTreeNode(m_pathTree, path);
+        auto source =
+            common::resolveTreeNode(m_pathTree, path, m_resolutionCache);
         if (!source.is_initialized()) {
             if (verboseFailure) {
                 logger()->info() << "Could not resolve source for " << path;
@@ -30,6 +30,7 @@
 #include <osvr/Common/PathElementTools.h>
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Util/TimeValue.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/DeduplicatingFunctionWrapper.h>
 
@@ -181,6 +182,23 @@ namespace client {
         m_ifaceMgr.updateHandlers();
     }
 
+    void
+    PureClientContext::m_waitForData(util::time::TimeValue const &maxWait) {
+        if (!m_gotConnection || !m_mainConn->connected()) {
+            // VRPN doesn't block while connecting, so fall back to sleeping.
+            ::OSVR_ClientContextObject::m_waitForData(maxWait);
+            return;
+        }
+        /// VRPN's mainloop with a timeout select()s on the connection's
+        /// sockets until something arrives (and handles it) or the timeout
+        /// expires: VRPN has no way to wait without handling. Interface
+        /// callbacks for what it handles are held by the base class until
+        /// update(), and any other connections get serviced there too.
+        struct timeval timeout;
+        util::time::toStructTimeval(timeout, maxWait);
+        m_mainConn->mainloop(&timeout);
+    }
+
     void PureClientContext::m_sendRoute(std::string const &route) {
         m_systemComponent->sendClientRouteUpdate(route);
         m_update();
@@ -59,6 +59,7 @@ namespace client {
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
       private:
         void m_update() override;
+        void m_waitForData(util::time::TimeValue const &maxWait) override;
         void m_sendRoute(std::string const &route) override;
 
         /// @brief Called with each new interface object before it is returned
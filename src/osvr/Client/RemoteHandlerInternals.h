@@ -61,6 +61,9 @@ namespace client {
 
             forEachInterface(
                 [&timestamp, &report](common::ClientInterface &iface) {
+                    if (!iface.changeFilter().shouldDeliver(report)) {
+                        return;
+                    }
                     iface.setState(timestamp, report);
                     iface.triggerCallbacks(timestamp, report);
                 });
@@ -29,7 +29,7 @@
 #include "VRPNConnectionCollection.h"
 #include <osvr/Client/InterfaceTree.h>
 #include <osvr/Common/ClientInterface.h>
-#include <osvr/Common/JSONTransformVisitor.h>
+#include <osvr/Common/CompiledTransform.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Common/PathTreeFull.h>
 #include <osvr/Common/Tracing.h>
@@ -66,13 +66,14 @@ namespace client {
         VRPNTrackerHandler(vrpn_ConnectionPtr const &conn, const char *src,
                            Options const &options,
                            common::TrackerSensorInfo const &info,
-                           common::Transform const &t,
+                           common::CompiledTransformPtr const &t,
                            boost::optional<int> sensor,
                            common::InterfaceList &ifaces,
                            common::ClientContext &ctx)
             : m_remote(new vrpn_Tracker_Remote(src, conn.get())),
               m_transform(t), m_ctx(ctx), m_internals(ifaces), m_opts(options),
               m_info(info), m_sensor(sensor) {
+            m_composeTransform();
             if (m_info.reportsPosition || m_info.reportsOrientation) {
                 m_remote->register_change_handler(this,
                                                   &VRPNTrackerHandler::handle,
@@ -113,10 +114,15 @@ namespace client {
 
         EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
-        common::Transform getCurrentTransform() const {
-            auto ret = m_transform;
-            ret.transform(m_ctx.getRoomToWorldTransform());
-            return ret;
+        /// Gets the route transform composed with the room-to-world
+        /// transform, recomposing only if the latter has changed.
+        common::CompiledTransform const &getCurrentTransform() {
+            auto const &roomToWorld = m_ctx.getRoomToWorldTransform();
+            if (roomToWorld.getPre() != m_roomToWorld.getPre() ||
+                roomToWorld.getPost() != m_roomToWorld.getPost()) {
+                m_composeTransform();
+            }
+            return m_currentTransform;
         }
 
         static void VRPN_CALLBACK handle(void *userdata, vrpn_TRACKERCB info) {
@@ -145,9 +151,11 @@ namespace client {
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
             osvrQuatFromQuatlib(&(report.pose.rotation), info.quat);
             osvrVec3FromQuatlib(&(report.pose.translation), info.pos);
-            auto xform = getCurrentTransform();
-            ei::map(report.pose) =
-                xform.transform(ei::map(report.pose).matrix());
+            auto const &xform = getCurrentTransform();
+            if (!xform.isIdentity()) {
+                ei::map(report.pose) =
+                    xform.apply(ei::map(report.pose).matrix());
+            }
 
             if (m_opts.reportPose) {
                 m_internals.setStateAndTriggerCallbacks(timestamp, report);
@@ -181,7 +189,7 @@ namespace client {
 
             OSVR_VelocityReport overallReport;
             overallReport.sensor = info.sensor;
-            auto xform = getCurrentTransform();
+            auto const &xform = getCurrentTransform();
 
             overallReport.state.linearVelocityValid =
                 m_info.reportsLinearVelocity;
@@ -229,7 +237,7 @@ namespace client {
             OSVR_AccelerationReport overallReport;
             overallReport.sensor = info.sensor;
 
-            auto xform = getCurrentTransform();
+            auto const &xform = getCurrentTransform();
 
             overallReport.state.linearAccelerationValid =
                 m_info.reportsLinearAcceleration;
@@ -266,18 +274,30 @@ namespace client {
 
             m_internals.setStateAndTriggerCallbacks(timestamp, overallReport);
         }
+        void m_composeTransform() {
+            m_roomToWorld = m_ctx.getRoomToWorldTransform();
+            m_currentTransform =
+                m_transform ? m_transform->composedWith(m_roomToWorld)
+                            : common::CompiledTransform{m_roomToWorld};
+        }
         unique_ptr<vrpn_Tracker_Remote> m_remote;
-        common::Transform m_transform;
+        /// Transform from the route, if any.
+        common::CompiledTransformPtr m_transform;
         common::ClientContext &m_ctx;
         RemoteHandlerInternals m_internals;
         Options m_opts;
         common::TrackerSensorInfo m_info;
         boost::optional<int> m_sensor;
+        /// Room-to-world transform that m_currentTransform was composed
+        /// with.
+        common::Transform m_roomToWorld;
+        common::CompiledTransform m_currentTransform;
     };
 
     TrackerRemoteFactory::TrackerRemoteFactory(
         VRPNConnectionCollection const &conns)
-        : m_conns(conns) {}
+        : m_conns(conns),
+          m_transforms(make_shared<common::CompiledTransformCache>()) {}
 
     shared_ptr<RemoteHandler> TrackerRemoteFactory::
     operator()(common::OriginalSource const &source,
@@ -298,10 +318,9 @@ namespace client {
 
         auto const &devElt = source.getDeviceElement();
 
-        common::Transform xform{};
+        common::CompiledTransformPtr xform;
         if (source.hasTransform()) {
-            common::JSONTransformVisitor xformParse(source.getTransformJson());
-            xform = xformParse.getTransform();
+            xform = m_transforms->get(source.getTransformJson());
         }
 
         /// @todo find out why make_shared causes a crash here
@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "VRPNConnectionCollection.h"
+#include <osvr/Common/CompiledTransformCache.h>
 #include <osvr/Common/InterfaceList.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Util/SharedPtr.h>
@@ -57,6 +58,9 @@ namespace client {
 
       private:
         VRPNConnectionCollection m_conns;
+        /// Shared (rather than copied along with the factory) so that every
+        /// copy registered with a RemoteHandlerFactory uses the same cache.
+        shared_ptr<common::CompiledTransformCache> m_transforms;
     };
 
 } // namespace client
@@ -30,6 +30,7 @@
 #include <osvr/Util/GetEnvironmentVariable.h>
 #include <osvr/Util/Log.h>
 #include <osvr/Util/LogNames.h>
+#include <osvr/Util/TimeValue.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -75,6 +76,26 @@ OSVR_ReturnCode osvrClientUpdate(OSVR_ClientContext ctx) {
     return OSVR_RETURN_SUCCESS;
 }
 
+OSVR_ReturnCode osvrClientUpdateBlocking(OSVR_ClientContext ctx,
+                                         uint32_t maxWaitMicroseconds) {
+    osvr::common::tracing::ClientUpdate region;
+    OSVR_TimeValue maxWait;
+    maxWait.seconds = maxWaitMicroseconds / 1000000;
+    maxWait.microseconds = maxWaitMicroseconds % 1000000;
+    ctx->update(maxWait);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientUpdateWithBudget(OSVR_ClientContext ctx,
+                                           uint32_t maxMicroseconds) {
+    osvr::common::tracing::ClientUpdate region;
+    OSVR_TimeValue maxTime;
+    maxTime.seconds = maxMicroseconds / 1000000;
+    maxTime.microseconds = maxMicroseconds % 1000000;
+    ctx->updateWithBudget(maxTime);
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode osvrClientShutdown(OSVR_ClientContext ctx) {
     if (nullptr == ctx) {
         make_clientkit_logger()->error("Can't delete a null Client Context!");
@@ -71,3 +71,23 @@ OSVR_ReturnCode osvrClientFreeInterface(OSVR_ClientContext ctx,
     }
     return OSVR_RETURN_SUCCESS;
 }
+
+OSVR_ReturnCode osvrClientSetInterfaceChangeFilter(OSVR_ClientInterface iface,
+                                                   double analogDeadband) {
+    if (nullptr == iface) {
+        /// Return failure if given a null interface
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->changeFilter().enable(analogDeadband);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrClientClearInterfaceChangeFilter(OSVR_ClientInterface iface) {
+    if (nullptr == iface) {
+        /// Return failure if given a null interface
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->changeFilter().disable();
+    return OSVR_RETURN_SUCCESS;
+}
@@ -80,10 +80,12 @@ namespace common {
         for (auto const &component : m_components) {
             component->update();
         }
+        m_flushStreamingMessages();
         m_update();
     }
 
     void BaseDevice::sendPending() {
+        m_flushStreamingMessages();
         m_getConnection()->send_pending_reports();
     }
 
@@ -101,6 +103,49 @@ namespace common {
         if (ret != 0) {
             throw std::runtime_error("Could not pack message!");
         }
+        ++m_messagesSent;
+        m_bytesSent += len;
+    }
+
+    void BaseDevice::m_packOrderedMessage(
+        size_t len, const char *buf, RawMessageType const &msgType,
+        util::time::TimeValue const &timestamp, uint32_t classOfService) {
+        if (!m_streamingMessages.empty()) {
+            static const uint32_t RELIABLE = class_of_service::
+                VRPNConnectionValue<class_of_service::Reliable>::value;
+            const bool reliable = (classOfService & RELIABLE) != 0;
+            m_streamingMessages.flush(
+                [&](size_t pendingLen, const char *pendingBuf,
+                    RawMessageType const &pendingType,
+                    util::time::TimeValue const &pendingTimestamp,
+                    uint32_t pendingClassOfService) {
+                    m_packMessage(pendingLen, pendingBuf, pendingType,
+                                  pendingTimestamp,
+                                  reliable ? RELIABLE : pendingClassOfService);
+                });
+        }
+        m_packMessage(len, buf, msgType, timestamp, classOfService);
+    }
+
+    void BaseDevice::m_packStreamingMessage(
+        size_t len, const char *buf, RawMessageType const &msgType,
+        OSVR_ChannelCount sensor, util::time::TimeValue const &timestamp,
+        uint32_t classOfService) {
+        if (m_streamingMessages.push(msgType, sensor, timestamp, buf, len,
+                                     classOfService)) {
+            OSVR_DEV_VERBOSE("BaseDevice superseded an unsent message for "
+                             "sensor "
+                             << sensor);
+        }
+    }
+
+    void BaseDevice::m_flushStreamingMessages() {
+        m_streamingMessages.flush([&](size_t len, const char *buf,
+                                      RawMessageType const &msgType,
+                                      util::time::TimeValue const &timestamp,
+                                      uint32_t classOfService) {
+            m_packMessage(len, buf, msgType, timestamp, classOfService);
+        });
     }
 
     void BaseDevice::m_setup(vrpn_ConnectionPtr conn, RawSenderType sender,
@@ -26,6 +26,7 @@
 #include "GetJSONStringFromTree.h"
 #include <osvr/Common/ClientContext.h>
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Util/TimeValue.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -33,6 +34,8 @@
 
 // Standard includes
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 using ::osvr::common::ClientInterfacePtr;
 using ::osvr::common::ClientInterface;
@@ -85,12 +88,65 @@ std::string const &OSVR_ClientContextObject::getAppId() const {
 }
 
 void OSVR_ClientContextObject::update() {
+    m_deliverDeferredCallbacks();
     m_update();
     for (auto const &iface : m_interfaces) {
         iface->update();
     }
 }
 
+void OSVR_ClientContextObject::updateWithBudget(
+    osvr::util::time::TimeValue const &maxTime) {
+    m_updateDeadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::seconds(maxTime.seconds) +
+        std::chrono::microseconds(maxTime.microseconds);
+    m_haveUpdateDeadline = true;
+    /// Older data goes first: new data is only taken in once everything
+    /// already deferred has been delivered.
+    if (m_deliverDeferredCallbacks()) {
+        m_update();
+    }
+    for (auto const &iface : m_interfaces) {
+        iface->update();
+    }
+    m_haveUpdateDeadline = false;
+}
+
+bool OSVR_ClientContextObject::isUpdateBudgetExhausted() const {
+    return m_haveUpdateDeadline &&
+           std::chrono::steady_clock::now() >= m_updateDeadline;
+}
+
+bool OSVR_ClientContextObject::m_deliverDeferredCallbacks() {
+    for (auto const &iface : m_interfaces) {
+        if (!iface->deliverDeferredCallbacks()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool OSVR_ClientContextObject::m_haveDeferredCallbacks() const {
+    for (auto const &iface : m_interfaces) {
+        if (iface->hasDeferredCallbacks()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void OSVR_ClientContextObject::update(
+    osvr::util::time::TimeValue const &maxWait) {
+    /// Deferred callbacks are data that's already here.
+    if (!m_haveDeferredCallbacks()) {
+        m_waitingForData = true;
+        m_waitForData(maxWait);
+        m_waitingForData = false;
+    }
+    update();
+}
+
 ClientInterfacePtr OSVR_ClientContextObject::getInterface(const char path[]) {
     auto ret = m_clientInterfaceFactory(*this, path);
     if (!ret) {
@@ -170,6 +226,14 @@ bool OSVR_ClientContextObject::m_getStatus() const {
     return true;
 }
 
+void OSVR_ClientContextObject::m_waitForData(
+    osvr::util::time::TimeValue const &maxWait) {
+    // by default, no way to know when data arrives, so just sleep.
+    std::this_thread::sleep_for(
+        std::chrono::seconds(maxWait.seconds) +
+        std::chrono::microseconds(maxWait.microseconds));
+}
+
 void OSVR_ClientContextObject::m_handleNewInterface(
     ::osvr::common::ClientInterfacePtr const &) {
     // by default do nothing
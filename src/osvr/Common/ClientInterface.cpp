@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/ClientContext.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -31,6 +32,7 @@
 
 // Standard includes
 #include <boost/range/algorithm.hpp>
+#include <algorithm>
 
 OSVR_ClientInterfaceObject::OSVR_ClientInterfaceObject(
     ::osvr::common::ClientContext &ctx, std::string const &path)
@@ -43,3 +45,46 @@ std::string const &OSVR_ClientInterfaceObject::getPath() const {
 }
 
 void OSVR_ClientInterfaceObject::update() {}
+
+bool OSVR_ClientInterfaceObject::deliverDeferredCallbacks() {
+    while (!m_deferred.empty()) {
+        if (m_ctx.isUpdateBudgetExhausted()) {
+            return false;
+        }
+        /// Take it out first, in case a callback leads to more deferral.
+        auto call = std::move(m_deferred.front().call);
+        m_deferred.erase(m_deferred.begin());
+        call();
+    }
+    return true;
+}
+
+bool OSVR_ClientInterfaceObject::m_shouldDeferCallbacks() const {
+    return m_ctx.isUpdateBudgetExhausted() || m_ctx.isWaitingForData();
+}
+
+void OSVR_ClientInterfaceObject::m_deferCallbacks(
+    void const *key, OSVR_ChannelCount sensor, bool coalesce,
+    std::function<void()> &&call) {
+    if (m_ctx.isWaitingForData()) {
+        /// Only held until the update right after the wait, which would have
+        /// delivered every one of these.
+        m_deferred.push_back(DeferredCallbacks{key, sensor, std::move(call)});
+        return;
+    }
+    if (coalesce) {
+        auto it = std::find_if(m_deferred.begin(), m_deferred.end(),
+                               [&](DeferredCallbacks const &entry) {
+                                   return entry.key == key &&
+                                          entry.sensor == sensor;
+                               });
+        if (it != m_deferred.end()) {
+            /// Newest wins, but it keeps its place in line.
+            it->call = std::move(call);
+            m_ctx.noteDeferredReport(true);
+            return;
+        }
+    }
+    m_deferred.push_back(DeferredCallbacks{key, sensor, std::move(call)});
+    m_ctx.noteDeferredReport(false);
+}
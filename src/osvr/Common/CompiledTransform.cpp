@@ -0,0 +1,90 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "JSONTransformLevel.h"
+#include <osvr/Common/CompiledTransform.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// Folded matrices within this (elementwise) of the identity - e.g. from
+    /// a rotation and its inverse - are treated as exactly the identity.
+    static const double IDENTITY_PRECISION = 1e-12;
+
+    /// Exact comparison: levels that explicitly specify the identity (such as
+    /// a zero translation) are dropped without perturbing anything.
+    static inline bool isExactIdentity(Eigen::Matrix4d const &m) {
+        return m == Eigen::Matrix4d::Identity();
+    }
+
+    CompiledTransform::CompiledTransform(Json::Value const &root) {
+        Eigen::Matrix4d pre = Eigen::Matrix4d::Identity();
+        Eigen::Matrix4d post = Eigen::Matrix4d::Identity();
+        m_leaf = transform_json::visitLevels(
+            root, [&](transform_json::Level const &level) {
+                // Same order of multiplication as Transform::concatPre/Post.
+                if (level.havePost && !isExactIdentity(level.post)) {
+                    post = (level.post * post).eval();
+                    ++m_sourceOps;
+                }
+                if (level.havePre && !isExactIdentity(level.pre)) {
+                    pre *= level.pre;
+                    ++m_sourceOps;
+                }
+            });
+        m_setMatrices(pre, post);
+    }
+
+    CompiledTransform::CompiledTransform(Transform const &xform) {
+        m_setMatrices(xform.getPre(), xform.getPost());
+    }
+
+    CompiledTransform
+    CompiledTransform::composedWith(Transform const &outer) const {
+        auto xform = m_transform;
+        xform.transform(outer);
+        CompiledTransform ret(xform);
+        ret.m_leaf = m_leaf;
+        ret.m_sourceOps = m_sourceOps;
+        return ret;
+    }
+
+    void CompiledTransform::m_setMatrices(Eigen::Matrix4d const &pre,
+                                          Eigen::Matrix4d const &post) {
+        m_hasPre = !pre.isIdentity(IDENTITY_PRECISION);
+        m_hasPost = !post.isIdentity(IDENTITY_PRECISION);
+        m_transform =
+            Transform(m_hasPre ? pre : Eigen::Matrix4d::Identity().eval(),
+                      m_hasPost ? post : Eigen::Matrix4d::Identity().eval());
+    }
+
+} // namespace common
+} // namespace osvr
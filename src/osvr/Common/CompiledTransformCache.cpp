@@ -0,0 +1,60 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/CompiledTransformCache.h>
+
+// Library/third-party includes
+#include <json/writer.h>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    CompiledTransformPtr
+    CompiledTransformCache::get(Json::Value const &root) {
+        Json::FastWriter writer;
+        auto key = writer.write(root);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            ++m_hits;
+            return it->second;
+        }
+        ++m_misses;
+        /// Not make_shared: CompiledTransform needs its aligned operator new.
+        CompiledTransformPtr compiled(new CompiledTransform(root));
+        m_entries.emplace(std::move(key), compiled);
+        return compiled;
+    }
+
+    void CompiledTransformCache::clear() {
+        m_entries.clear();
+        m_hits = 0;
+        m_misses = 0;
+    }
+
+} // namespace common
+} // namespace osvr
@@ -82,8 +82,8 @@ namespace common {
         messages::DirectionRecord::MessageSerialization msg(direction, sensor);
         serialize(buf, msg);
 
-        m_getParent().packMessage(buf, directionRecord.getMessageType(),
-                                  timestamp);
+        m_getParent().packSensorMessage(buf, directionRecord, sensor,
+                                        timestamp);
     }
 
     int VRPN_CALLBACK
@@ -80,7 +80,7 @@ namespace common {
 
         serialize(buf, msg);
 
-        m_getParent().packMessage(buf, eyeRegion.getMessageType(), timestamp);
+        m_getParent().packSensorMessage(buf, eyeRegion, sensor, timestamp);
     }
 
     int VRPN_CALLBACK
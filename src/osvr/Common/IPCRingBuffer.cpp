@@ -34,8 +34,14 @@
 // Library/third-party includes
 #include <boost/version.hpp>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 // Standard includes
+#include <fstream>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -104,16 +110,82 @@ namespace common {
     } // namespace
 
     namespace {
+        /// @brief Page size assumed for entry alignment when large pages are
+        /// requested: entries are aligned to (normal) page boundaries, so an
+        /// entry never shares a page with a neighbor.
+        static const IPCRingBuffer::alignment_type PAGE_ALIGNMENT = 4096;
+
+        /// @brief Size of a large page, used to round the segment size so the
+        /// kernel can back all of it with large pages.
+        static const size_t LARGE_PAGE_SIZE = 2 * 1024 * 1024;
 
         static size_t computeRequiredSpace(IPCRingBuffer::Options const &opts) {
             size_t alignedEntrySize = opts.getEntrySize() + opts.getAlignment();
             size_t dataSize = alignedEntrySize * (opts.getEntries() + 1);
             // Give 33% overhead on the raw bookkeeping data
-            static const size_t BOOKKEEPING_SIZE =
+            const size_t BOOKKEEPING_SIZE =
                 (sizeof(detail::Bookkeeping) +
                  (sizeof(detail::ElementData) * opts.getEntries())) *
                 4 / 3;
-            return dataSize + BOOKKEEPING_SIZE;
+            size_t ret = dataSize + BOOKKEEPING_SIZE;
+            if (opts.getLargePages()) {
+                ret = ((ret + LARGE_PAGE_SIZE - 1) / LARGE_PAGE_SIZE) *
+                      LARGE_PAGE_SIZE;
+            }
+            return ret;
+        }
+
+        /// @brief Asks the OS to back the given mapping with large pages, if
+        /// it can.
+        /// @return true if the advice was accepted - which does not by itself
+        /// mean large pages will be used.
+        static bool adviseLargePages(void *addr, size_t len) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            return 0 == madvise(addr, len, MADV_HUGEPAGE);
+#else
+            (void)addr;
+            (void)len;
+            return false;
+#endif
+        }
+
+        /// @brief Whether the OS will honor large-page advice for shared
+        /// memory. On Linux, that depends on the active mode in
+        /// transparent_hugepage/shmem_enabled (the bracketed entry): "never"
+        /// and "deny" ignore the advice.
+        static bool sharedMemoryLargePagesEnabled() {
+#if defined(__linux__)
+            std::ifstream modes(
+                "/sys/kernel/mm/transparent_hugepage/shmem_enabled");
+            std::string mode;
+            while (modes >> mode) {
+                if (mode.size() > 2 && mode.front() == '[' &&
+                    mode.back() == ']') {
+                    mode = mode.substr(1, mode.size() - 2);
+                    return mode != "never" && mode != "deny";
+                }
+            }
+#endif
+            return false;
+        }
+
+        /// @brief Advises large pages for a segment mapping and logs what
+        /// that advice is expected to achieve.
+        static void adviseLargePagesForSegment(std::string const &name,
+                                               void *addr, size_t len) {
+            if (!adviseLargePages(addr, len)) {
+                getIPCRingBufferLogger().info()
+                    << "Large pages not available for segment " << name
+                    << ", using normal pages.";
+            } else if (!sharedMemoryLargePagesEnabled()) {
+                getIPCRingBufferLogger().info()
+                    << "Advised large pages for segment " << name
+                    << ", but the kernel's shared memory large page setting "
+                       "will not honor it; using normal pages.";
+            } else {
+                getIPCRingBufferLogger().debug()
+                    << "Advised large pages for segment " << name;
+            }
         }
 
         class SharedMemorySegmentHolder {
@@ -166,6 +238,14 @@ namespace common {
                         << opts.getName() << " with exception: " << e.what();
                     return;
                 }
+                if (opts.getLargePages()) {
+                    // Must happen before the entries are allocated (and
+                    // possibly prefaulted) so the pages are large from the
+                    // start.
+                    adviseLargePagesForSegment(opts.getName(),
+                                               Base::m_shm->get_address(),
+                                               Base::m_shm->get_size());
+                }
                 // detail::Bookkeeping::destroy(*Base::m_shm);
                 Base::m_bookkeeping =
                     detail::Bookkeeping::construct(*Base::m_shm, opts);
@@ -202,6 +282,11 @@ namespace common {
                         << opts.getName() << " with exception: " << e.what();
                     return;
                 }
+                if (opts.getLargePages()) {
+                    adviseLargePagesForSegment(opts.getName(),
+                                               Base::m_shm->get_address(),
+                                               Base::m_shm->get_size());
+                }
                 Base::m_bookkeeping = detail::Bookkeeping::find(*Base::m_shm);
             }
 
@@ -278,8 +363,13 @@ namespace common {
 
     IPCRingBuffer::Options &
     IPCRingBuffer::Options::setAlignment(alignment_type alignment) {
-        /// @todo ensure power of 2
-        m_alignment = alignment;
+        /// Round up to the nearest power of 2 (saturating at the largest one
+        /// representable)
+        alignment_type powerOfTwo = 1;
+        while (powerOfTwo < alignment && powerOfTwo < 0x8000) {
+            powerOfTwo <<= 1;
+        }
+        m_alignment = powerOfTwo;
         return *this;
     }
 
@@ -294,6 +384,17 @@ namespace common {
         m_entrySize = entrySize;
         return *this;
     }
+
+    IPCRingBuffer::Options &
+    IPCRingBuffer::Options::setLargePages(bool largePages) {
+        m_largePages = largePages;
+        return *this;
+    }
+
+    IPCRingBuffer::Options &IPCRingBuffer::Options::setPrefault(bool prefault) {
+        m_prefault = prefault;
+        return *this;
+    }
     class IPCRingBuffer::Impl {
       public:
         Impl(unique_ptr<SharedMemorySegmentHolder> &&segment,
@@ -393,6 +494,11 @@ namespace common {
     }
 
     IPCRingBufferPtr IPCRingBuffer::create(Options const &opts) {
+        if (opts.getLargePages() && opts.getAlignment() < PAGE_ALIGNMENT) {
+            Options pageAligned{opts};
+            pageAligned.setAlignment(PAGE_ALIGNMENT);
+            return m_constructorHelper(pageAligned, true);
+        }
         return m_constructorHelper(opts, true);
     }
     IPCRingBufferPtr IPCRingBuffer::find(Options const &opts) {
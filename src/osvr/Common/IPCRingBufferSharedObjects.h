@@ -37,6 +37,7 @@
 #include <boost/noncopyable.hpp>
 
 // Standard includes
+#include <cstring>
 #include <utility>
 
 namespace osvr {
@@ -63,6 +64,10 @@ namespace common {
                 freeBuf(shm);
                 m_buf = static_cast<BufferType *>(shm.allocate_aligned(
                     opts.getEntrySize(), opts.getAlignment()));
+                if (opts.getPrefault()) {
+                    // Touch every page now, instead of on first use.
+                    std::memset(m_buf.get(), 0, opts.getEntrySize());
+                }
             }
 
             template <typename ManagedMemory> void freeBuf(ManagedMemory &shm) {
@@ -43,6 +43,13 @@ namespace common {
     static inline uint32_t getBufferSize(OSVR_ImagingMetadata const &meta) {
         return meta.height * meta.width * meta.depth * meta.channels;
     }
+    /// @brief Whether frames of this size should use a large-page ring
+    /// buffer. Both ends compute this from the metadata so the client can
+    /// advise its own mapping to match the server's.
+    static inline bool wantLargePages(uint32_t imageBufferSize) {
+        static const uint32_t LARGE_PAGE_THRESHOLD = 1024 * 1024;
+        return imageBufferSize >= LARGE_PAGE_THRESHOLD;
+    }
     namespace messages {
         namespace {
             template <typename T>
@@ -262,10 +269,15 @@ namespace common {
                 os << "com.osvr.imaging/" << devName << "/" << int(sensor);
                 return os.str();
             };
+            // Frames are written and read in full every time, so fault the
+            // pages in up front, and let large frames use large pages to
+            // reduce TLB pressure on both ends.
             m_shmBuf[sensor] = IPCRingBuffer::create(
                 IPCRingBuffer::Options(
                     makeName(sensor, m_getParent().getDeviceName()))
-                    .setEntrySize(imageBufferSize));
+                    .setEntrySize(imageBufferSize)
+                    .setPrefault(true)
+                    .setLargePages(wantLargePages(imageBufferSize)));
         }
         if (!m_shmBuf[sensor]) {
             OSVR_DEV_VERBOSE(
@@ -378,7 +390,9 @@ namespace common {
         if (!self->m_shmBuf[msg.sensor] ||
             !checkSameRingBuf(msg, self->m_shmBuf[msg.sensor])) {
             self->m_shmBuf[msg.sensor] = IPCRingBuffer::find(
-                IPCRingBuffer::Options(msg.shmName, msg.backend));
+                IPCRingBuffer::Options(msg.shmName, msg.backend)
+                    .setLargePages(
+                        wantLargePages(getBufferSize(msg.metadata))));
         }
         if (!self->m_shmBuf[msg.sensor]) {
             /// Can't find the shared memory referred to - possibly not a local
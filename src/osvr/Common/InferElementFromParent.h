@@ -0,0 +1,67 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InferElementFromParent_h_GUID_D0568CE4_909F_438E_826D_B411B8C8D1F3
+#define INCLUDED_InferElementFromParent_h_GUID_D0568CE4_909F_438E_826D_B411B8C8D1F3
+
+// Internal Includes
+#include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/PathNode.h>
+
+// Library/third-party includes
+#include <boost/variant/get.hpp>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// @brief Given a node, if it's null, try to infer from the parent what it
+    /// should be.
+    ///
+    /// Right now can only infer that the children of an interface are sensors.
+    inline void ifNullTryInferFromParent(common::PathNode &node) {
+        if (nullptr == boost::get<elements::NullElement>(&node.value())) {
+            /// Not null.
+            return;
+        }
+
+        if (nullptr == node.getParent()) {
+            // couldn't help, no parent.
+            return;
+        }
+        auto const &parent = *node.getParent();
+
+        if (nullptr ==
+            boost::get<elements::InterfaceElement>(&(parent.value()))) {
+            return; // parent isn't an interface.
+        }
+        // So if we get here, parent is present and an interface, which means
+        // that we're a sensor.
+        node.value() = elements::SensorElement();
+    }
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_InferElementFromParent_h_GUID_D0568CE4_909F_438E_826D_B411B8C8D1F3
@@ -0,0 +1,217 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_JSONTransformLevel_h_GUID_749CE7F7_17DA_4C16_AFBD_6EF53D3575CC
+#define INCLUDED_JSONTransformLevel_h_GUID_749CE7F7_17DA_4C16_AFBD_6EF53D3575CC
+
+// Internal Includes
+#include <osvr/Common/ChangeOfBasis.h>
+#include <osvr/Common/DegreesToRadians.h>
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+#include <json/value.h>
+#include <boost/algorithm/string.hpp>
+#include <boost/assert.hpp>
+#include <boost/range/algorithm/count_if.hpp>
+
+// Standard includes
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace transform_json {
+        static const char AXIS_NAMES[] = "XYZ";
+        static const char MINUS[] = "-";
+        template <typename T = Eigen::Vector3d>
+        inline T vectorFromJson(Json::Value const &v) {
+            T ret = T::Zero();
+            if (v.isString()) {
+                std::string inVal = v.asString();
+                if (inVal.empty()) {
+                    throw std::runtime_error(
+                        "Empty string can't be turned into a vector!");
+                }
+                using boost::is_any_of;
+                std::string val(boost::to_upper_copy(inVal));
+                if ((!boost::algorithm::all(
+                         val, is_any_of(AXIS_NAMES) || is_any_of(MINUS) ||
+                                  boost::algorithm::is_space())) ||
+                    boost::count_if(val, is_any_of(AXIS_NAMES)) != 1 ||
+                    boost::count_if(val, is_any_of(MINUS)) > 1) {
+                    throw std::runtime_error(
+                        "Cannot turn the specified string into a vector: " +
+                        inVal);
+                }
+                double factor =
+                    (val.find(MINUS[0]) == std::string::npos) ? 1.0 : -1.0;
+                const std::string axisnames(AXIS_NAMES);
+                for (const char c : val) {
+                    auto location = axisnames.find(c);
+                    if (location != std::string::npos) {
+                        ret[location] = factor;
+                        return ret;
+                    }
+                }
+                BOOST_ASSERT_MSG(false, "Should never reach here!");
+            }
+            if (v.isArray()) {
+                if (v.size() != T::RowsAtCompileTime) {
+                    throw std::runtime_error(
+                        "Vector size wrong when converting from JSON!");
+                }
+                for (Json::ArrayIndex i = 0, e = v.size(); i < e; ++i) {
+                    ret[i] = v[i].asFloat();
+                }
+                return ret;
+            }
+            throw std::runtime_error("Could not convert JSON to vector: " +
+                                     v.toStyledString());
+        }
+
+        static const char DEGREES_KEY[] = "degrees";
+        static const char RADIANS_KEY[] = "radians";
+        inline double angleAsRadians(Json::Value const &rotation) {
+            double ret = 0;
+            if (rotation[DEGREES_KEY].isNumeric()) {
+                ret = degreesToRadians(rotation[DEGREES_KEY].asFloat());
+            } else if (rotation[RADIANS_KEY].isNumeric()) {
+                ret = rotation[RADIANS_KEY].asFloat();
+            } else {
+                throw std::runtime_error(
+                    "Cannot have a rotation with either degrees or radians!");
+            }
+            return ret;
+        }
+
+        static const char TRANSLATE_KEY[] = "posttranslate";
+        static const char PRETRANSLATE_KEY[] = "translate";
+        static const char ROTATE_KEY[] = "postrotate";
+        static const char PREROTATE_KEY[] = "rotate";
+        static const char AXIS_KEY[] = "axis";
+        static const char CHANGE_BASIS_KEY[] = "changeBasis";
+        static const char CHILD_KEY[] = "child";
+        static const char X_KEY[] = "x";
+        static const char Y_KEY[] = "y";
+        static const char Z_KEY[] = "z";
+
+        /// @brief The pre and post matrices described by a single level of
+        /// transform JSON, with flags indicating whether the level specified
+        /// each at all.
+        struct Level {
+            Level()
+                : pre(Eigen::Matrix4d::Identity()),
+                  post(Eigen::Matrix4d::Identity()) {}
+            EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+            Eigen::Matrix4d pre;
+            Eigen::Matrix4d post;
+            bool havePre = false;
+            bool havePost = false;
+        };
+
+        /// @brief Parses a single level (ignoring any child) of transform
+        /// JSON.
+        inline Level parseLevel(Json::Value const &v) {
+            Level ret;
+            if (!v.isObject()) {
+                // This is a non-object leaf node.
+                return ret;
+            }
+            if (v.isMember(CHANGE_BASIS_KEY)) {
+                Json::Value changeBasis = v[CHANGE_BASIS_KEY];
+                ChangeOfBasis cb;
+                cb.setNewX(vectorFromJson<>(changeBasis[X_KEY]));
+                cb.setNewY(vectorFromJson<>(changeBasis[Y_KEY]));
+                cb.setNewZ(vectorFromJson<>(changeBasis[Z_KEY]));
+                auto xform = cb.get();
+                ret.pre = xform.getPre();
+                ret.post = xform.getPost();
+                ret.havePre = true;
+                ret.havePost = true;
+                return ret;
+            }
+            Eigen::Vector3d position = Eigen::Vector3d::Zero();
+            Eigen::AngleAxisd orientation = Eigen::AngleAxisd::Identity();
+            Eigen::Vector3d preposition = Eigen::Vector3d::Zero();
+            Eigen::AngleAxisd preorientation = Eigen::AngleAxisd::Identity();
+            if (v.isMember(TRANSLATE_KEY)) {
+                position = vectorFromJson<>(v[TRANSLATE_KEY]);
+                ret.havePost = true;
+            }
+            if (v.isMember(PRETRANSLATE_KEY)) {
+                preposition = vectorFromJson<>(v[PRETRANSLATE_KEY]);
+                ret.havePre = true;
+            }
+            if (v.isMember(ROTATE_KEY)) {
+                Json::Value rotate = v[ROTATE_KEY];
+                orientation = Eigen::AngleAxisd(
+                    angleAsRadians(rotate), vectorFromJson<>(rotate[AXIS_KEY]));
+                ret.havePost = true;
+            }
+            if (v.isMember(PREROTATE_KEY)) {
+                Json::Value rotate = v[PREROTATE_KEY];
+                preorientation = Eigen::AngleAxisd(
+                    angleAsRadians(rotate), vectorFromJson<>(rotate[AXIS_KEY]));
+                ret.havePre = true;
+            }
+            if (ret.havePost) {
+                Eigen::Affine3d xform;
+                xform.fromPositionOrientationScale(
+                    position, orientation, Eigen::Vector3d::Constant(1));
+                ret.post = xform.matrix();
+            }
+            if (ret.havePre) {
+                Eigen::Affine3d xform;
+                xform.fromPositionOrientationScale(
+                    preposition, preorientation, Eigen::Vector3d::Constant(1));
+                ret.pre = xform.matrix();
+            }
+            return ret;
+        }
+
+        /// @brief Calls f with each level of the transform JSON, innermost
+        /// (closest to the leaf) first, and returns the leaf.
+        template <typename F>
+        inline Json::Value visitLevels(Json::Value const &root, F &&f) {
+            std::vector<Json::Value const *> levels;
+            auto current = &root;
+            levels.push_back(current);
+            while (current->isObject() && current->isMember(CHILD_KEY)) {
+                current = &((*current)[CHILD_KEY]);
+                levels.push_back(current);
+            }
+            while (!levels.empty()) {
+                f(parseLevel(*levels.back()));
+                levels.pop_back();
+            }
+            return *current;
+        }
+    } // namespace transform_json
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_JSONTransformLevel_h_GUID_749CE7F7_17DA_4C16_AFBD_6EF53D3575CC
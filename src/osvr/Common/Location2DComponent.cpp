@@ -82,8 +82,8 @@ namespace common {
         messages::LocationRecord::MessageSerialization msg(location, sensor);
         serialize(buf, msg);
 
-        m_getParent().packMessage(buf, locationRecord.getMessageType(),
-                                  timestamp);
+        m_getParent().packSensorMessage(buf, locationRecord, sensor,
+                                        timestamp);
     }
 
     int VRPN_CALLBACK
@@ -112,8 +112,8 @@ namespace common {
             naviVelocityState, sensor);
 
         serialize(buf, msg);
-        m_getParent().packMessage(buf, naviVelRecord.getMessageType(),
-                                  timestamp);
+        m_getParent().packSensorMessage(buf, naviVelRecord, sensor,
+                                        timestamp);
     }
 
     void LocomotionComponent::sendNaviPositionData(
@@ -126,8 +126,8 @@ namespace common {
             naviPositionState, sensor);
         serialize(buf, msg);
 
-        m_getParent().packMessage(buf, naviPosnRecord.getMessageType(),
-                                  timestamp);
+        m_getParent().packSensorMessage(buf, naviPosnRecord, sensor,
+                                        timestamp);
     }
 
     int VRPN_CALLBACK
@@ -24,15 +24,33 @@
 
 // Internal Includes
 #include <osvr/Common/LowLatency.h>
+#include <osvr/Util/Log.h>
+#include <osvr/Util/Logger.h>
 
 #ifdef _WIN32
 #define NO_MINMAX
 #include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
 #endif
 
+// Standard includes
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
 namespace osvr {
 namespace common {
 
+    /// Grab a logger for reporting which low-latency requests were granted.
+    static util::log::Logger &getLowLatencyLogger() {
+        static util::log::LoggerPtr logger =
+            util::log::make_logger("LowLatency");
+        return *logger;
+    }
+
 #ifdef _WIN32
 #define OSVR_HAVE_LOWLATENCY_CODE
     /// Drop timer period to 1ms when in low latency mode.
@@ -41,32 +59,157 @@ namespace common {
         bool beginSucceeded = false;
     };
 
-/// @todo Unclear from docs whether a failed call to timeEndPeriod must also be
-/// matched
-/// https://msdn.microsoft.com/en-us/library/windows/desktop/dd757624(v=vs.85).aspx
-#if 0
-    LowLatency::LowLatency() : m_impl(new Impl) {
-        auto result = timeBeginPeriod(TIMER_PERIOD);
-        if (TIMERR_NOERROR == result) {
-            m_impl->beginSucceeded = true;
-        }
+    /// @todo Unclear from docs whether a failed call to timeEndPeriod must
+    /// also be matched, so we always call it.
+    /// https://msdn.microsoft.com/en-us/library/windows/desktop/dd757624(v=vs.85).aspx
+    LowLatency::LowLatency(Options const &) : m_impl(new Impl) {
+        m_impl->beginSucceeded =
+            (TIMERR_NOERROR == timeBeginPeriod(TIMER_PERIOD));
     }
-#endif
-
-    LowLatency::LowLatency() { timeBeginPeriod(TIMER_PERIOD); }
     LowLatency::~LowLatency() {
         /// Don't really care about the success of this call - nothing we can
         /// do.
         timeEndPeriod(TIMER_PERIOD);
     }
+    bool LowLatency::isTimerResolutionRaised() const {
+        return m_impl->beginSucceeded;
+    }
+    bool LowLatency::isMemoryLocked() const { return false; }
+    bool LowLatency::isRealtimeScheduled() const { return false; }
+    bool LowLatency::isCpuPinned() const { return false; }
+#endif
+
+#ifdef __linux__
+#define OSVR_HAVE_LOWLATENCY_CODE
+    /// Timer slack (in nanoseconds) to use in low latency mode: the default is
+    /// 50us, which is added to nearly every sleep. 1 is the minimum, since 0
+    /// means "reset to the default".
+    static const unsigned long MIN_TIMER_SLACK = 1;
+
+    struct LowLatency::Impl {
+        bool slackSet = false;
+        int originalSlack = 0;
+
+        bool memoryLocked = false;
+
+        bool scheduled = false;
+        int originalPolicy = SCHED_OTHER;
+        sched_param originalParam;
+
+        bool pinned = false;
+        cpu_set_t originalCpus;
+    };
+
+    LowLatency::LowLatency(Options const &opts) : m_impl(new Impl) {
+        auto &log = getLowLatencyLogger();
+        auto &impl = *m_impl;
+
+        /// Timer slack - per-thread, and no privileges required.
+        impl.originalSlack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+        if (impl.originalSlack >= 0 &&
+            0 == prctl(PR_SET_TIMERSLACK, MIN_TIMER_SLACK, 0, 0, 0)) {
+            impl.slackSet = true;
+        } else {
+            log.warn() << "Could not reduce timer slack: "
+                       << std::strerror(errno);
+        }
+
+        if (opts.getLockMemory()) {
+            if (0 == mlockall(MCL_CURRENT | MCL_FUTURE)) {
+                impl.memoryLocked = true;
+                log.info() << "Process memory locked.";
+            } else {
+                log.warn() << "Could not lock process memory (requires "
+                              "CAP_IPC_LOCK or a sufficient RLIMIT_MEMLOCK): "
+                           << std::strerror(errno);
+            }
+        }
+
+        if (opts.getRealtimePriority() > 0) {
+            const int policy = opts.getRoundRobin() ? SCHED_RR : SCHED_FIFO;
+            sched_param param = {};
+            param.sched_priority = std::min(
+                std::max(opts.getRealtimePriority(),
+                         sched_get_priority_min(policy)),
+                sched_get_priority_max(policy));
+            impl.originalPolicy = sched_getscheduler(0);
+            if (impl.originalPolicy < 0 ||
+                0 != sched_getparam(0, &impl.originalParam)) {
+                log.warn() << "Could not retrieve current scheduling policy: "
+                           << std::strerror(errno);
+            } else if (0 == sched_setscheduler(0, policy, &param)) {
+                impl.scheduled = true;
+                log.info() << "Real-time scheduling enabled: "
+                           << (policy == SCHED_RR ? "SCHED_RR" : "SCHED_FIFO")
+                           << " priority " << param.sched_priority;
+            } else {
+                log.warn() << "Could not enable real-time scheduling "
+                              "(requires CAP_SYS_NICE or a sufficient "
+                              "RLIMIT_RTPRIO): "
+                           << std::strerror(errno);
+            }
+        }
+
+        if (!opts.getCpus().empty()) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            for (auto cpu : opts.getCpus()) {
+                if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                    CPU_SET(cpu, &cpus);
+                }
+            }
+            if (0 != sched_getaffinity(0, sizeof(cpu_set_t),
+                                       &impl.originalCpus)) {
+                log.warn() << "Could not retrieve current CPU affinity: "
+                           << std::strerror(errno);
+            } else if (0 == sched_setaffinity(0, sizeof(cpu_set_t), &cpus)) {
+                impl.pinned = true;
+                log.info() << "Pinned to " << CPU_COUNT(&cpus) << " CPU(s)";
+            } else {
+                log.warn() << "Could not set CPU affinity: "
+                           << std::strerror(errno);
+            }
+        }
+    }
+
+    LowLatency::~LowLatency() {
+        /// Undo in reverse order; nothing useful we can do on failure.
+        auto &impl = *m_impl;
+        if (impl.pinned) {
+            sched_setaffinity(0, sizeof(cpu_set_t), &impl.originalCpus);
+        }
+        if (impl.scheduled) {
+            sched_setscheduler(0, impl.originalPolicy, &impl.originalParam);
+        }
+        if (impl.memoryLocked) {
+            munlockall();
+        }
+        if (impl.slackSet) {
+            prctl(PR_SET_TIMERSLACK,
+                  static_cast<unsigned long>(impl.originalSlack), 0, 0, 0);
+        }
+    }
+
+    bool LowLatency::isTimerResolutionRaised() const {
+        return m_impl->slackSet;
+    }
+    bool LowLatency::isMemoryLocked() const { return m_impl->memoryLocked; }
+    bool LowLatency::isRealtimeScheduled() const { return m_impl->scheduled; }
+    bool LowLatency::isCpuPinned() const { return m_impl->pinned; }
 #endif
 
 #ifndef OSVR_HAVE_LOWLATENCY_CODE
     // Fallback no-op implementations
     struct LowLatency::Impl {};
-    LowLatency::LowLatency() {}
+    LowLatency::LowLatency(Options const &) {}
     LowLatency::~LowLatency() {}
+    bool LowLatency::isTimerResolutionRaised() const { return false; }
+    bool LowLatency::isMemoryLocked() const { return false; }
+    bool LowLatency::isRealtimeScheduled() const { return false; }
+    bool LowLatency::isCpuPinned() const { return false; }
 #endif
 
+    LowLatency::LowLatency() : LowLatency(Options()) {}
+
 } // namespace common
 } // namespace osvr
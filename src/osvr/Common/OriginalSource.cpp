@@ -70,6 +70,14 @@ namespace common {
         m_transform.nest(transform);
     }
 
+    void OriginalSource::setTransform(GeneralizedTransform const &transform) {
+        m_transform = transform;
+    }
+
+    GeneralizedTransform const &OriginalSource::getTransform() const {
+        return m_transform;
+    }
+
     std::string OriginalSource::getDevicePath() const {
         BOOST_ASSERT_MSG(isResolved(),
                          "Only makes sense when called on a resolved source.");
@@ -23,7 +23,9 @@
 // limitations under the License.
 
 // Internal Includes
+#include "InferElementFromParent.h"
 #include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/TreeResolutionCache.h>
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/PathNode.h>
 #include <osvr/Common/PathTreeFull.h>
@@ -40,46 +42,25 @@
 
 // Standard includes
 #include <sstream>
+#include <utility>
 
 namespace osvr {
 namespace common {
 
-    /// @brief Given a node, if it's null, try to infer from the parent what it
-    /// should be.
-    ///
-    /// Right now can only infer that the children of an interface are sensors.
-    inline void ifNullTryInferFromParent(common::PathNode &node) {
-        if (nullptr == boost::get<elements::NullElement>(&node.value())) {
-            /// Not null.
-            return;
-        }
-
-        if (nullptr == node.getParent()) {
-            // couldn't help, no parent.
-            return;
-        }
-        auto const &parent = *node.getParent();
-
-        if (nullptr ==
-            boost::get<elements::InterfaceElement>(&(parent.value()))) {
-            return; // parent isn't an interface.
-        }
-        // So if we get here, parent is present and an interface, which means
-        // that we're a sensor.
-        node.value() = elements::SensorElement();
-    }
+    typedef TreeResolutionCache::Dependencies Dependencies;
 
     // Forward declaration
     void resolveTreeNodeImpl(PathTree &pathTree, std::string const &path,
-                             OriginalSource &source);
+                             OriginalSource &source, Dependencies *deps);
 
     class TreeResolutionVisitor : public boost::static_visitor<>,
                                   boost::noncopyable {
       public:
         TreeResolutionVisitor(common::PathTree &tree, common::PathNode &node,
-                              common::OriginalSource &source)
+                              common::OriginalSource &source,
+                              Dependencies *deps)
             : boost::static_visitor<>(), m_tree(tree), m_node(node),
-              m_source(source) {}
+              m_source(source), m_deps(deps) {}
 
         /// @brief Fallback case
         template <typename T> void operator()(T const &) {
@@ -123,37 +104,72 @@ namespace common {
         }
 
       private:
-        void m_decompose() { m_source.decompose(m_node); }
+        void m_decompose() {
+            m_source.decompose(m_node);
+            if (m_deps) {
+                // Decomposition depends on the ancestors of the node we landed
+                // on, which was the last dependency recorded.
+                auto &lineage = m_deps->back().second;
+                for (auto node = m_node.getParent(); nullptr != node;
+                     node = node->getParent()) {
+                    lineage.push_back(node->value());
+                }
+            }
+        }
         void m_recurse(std::string const &path) {
-            resolveTreeNodeImpl(m_tree, path, m_source);
+            resolveTreeNodeImpl(m_tree, path, m_source, m_deps);
         }
         PathTree &m_getPathTree() { return m_tree; }
 
         PathTree &m_tree;
         PathNode &m_node;
         OriginalSource &m_source;
+        Dependencies *m_deps;
     };
 
     inline void resolveTreeNodeImpl(PathTree &pathTree, std::string const &path,
-                                    OriginalSource &source) {
+                                    OriginalSource &source,
+                                    Dependencies *deps) {
         auto &node = pathTree.getNodeByPath(path);
 
         // First do any inference possible here.
         ifNullTryInferFromParent(node);
+        if (deps) {
+            deps->emplace_back(
+                path, TreeResolutionCache::ElementLineage{node.value()});
+        }
 
         // Now visit.
-        TreeResolutionVisitor visitor(pathTree, node, source);
+        TreeResolutionVisitor visitor(pathTree, node, source, deps);
         boost::apply_visitor(visitor, node.value());
     }
 
     boost::optional<OriginalSource> resolveTreeNode(PathTree &pathTree,
                                                     std::string const &path) {
         OriginalSource source;
-        resolveTreeNodeImpl(pathTree, path, source);
+        resolveTreeNodeImpl(pathTree, path, source, nullptr);
         if (source.isResolved()) {
             return source;
         }
         return boost::optional<OriginalSource>();
     }
+
+    boost::optional<OriginalSource>
+    resolveTreeNode(PathTree &pathTree, std::string const &path,
+                    TreeResolutionCache &cache) {
+        auto cached = cache.get(pathTree, path);
+        if (cached) {
+            return std::move(*cached);
+        }
+        OriginalSource source;
+        Dependencies deps;
+        resolveTreeNodeImpl(pathTree, path, source, &deps);
+        boost::optional<OriginalSource> ret;
+        if (source.isResolved()) {
+            ret = source;
+        }
+        cache.store(path, ret, std::move(deps));
+        return ret;
+    }
 } // namespace common
 } // namespace osvr
\ No newline at end of file
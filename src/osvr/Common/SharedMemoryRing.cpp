@@ -0,0 +1,265 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/SharedMemoryRing.h>
+#include "SharedMemory.h"
+
+// Library/third-party includes
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace osvr {
+namespace common {
+    namespace bip = boost::interprocess;
+    namespace {
+        static const uint32_t RING_MAGIC = 0x4f535252; // "OSRR"
+        static const uint32_t RING_VERSION = 1;
+
+        /// @brief Stored at the start of the segment, followed (at
+        /// DATA_OFFSET) by the slots.
+        ///
+        /// head and tail are free-running counts of messages pushed and
+        /// released: only the producer writes head, only the consumer writes
+        /// tail, and their difference is the number queued.
+        struct RingHeader {
+            std::atomic<uint32_t> magic;
+            uint32_t version;
+            uint32_t entries;
+            uint32_t entrySize;
+            std::atomic<uint32_t> head;
+            std::atomic<uint32_t> tail;
+            std::atomic<uint32_t> dropped;
+        };
+        static_assert(ATOMIC_INT_LOCK_FREE == 2,
+                      "Shared memory ring requires lock-free 32-bit atomics, "
+                      "since they're shared between processes.");
+
+        /// Keep the slots off the cache line(s) holding the indices.
+        static const std::size_t DATA_OFFSET =
+            (sizeof(RingHeader) + 63) / 64 * 64;
+
+        /// Each slot is the message length followed by the message.
+        typedef uint32_t SlotHeader;
+
+        inline std::size_t getSlotStride(uint32_t entrySize) {
+            return (sizeof(SlotHeader) + entrySize + 7) / 8 * 8;
+        }
+
+        /// Indices are free-running and wrap at 2^32, so the slot count must
+        /// divide that evenly for index % entries to stay continuous.
+        inline uint32_t roundUpToPowerOfTwo(uint32_t n) {
+            uint32_t ret = 1;
+            while (ret < n && ret != 0) {
+                ret <<= 1;
+            }
+            return ret;
+        }
+
+        inline uint64_t getSegmentSize(uint32_t entries, uint32_t entrySize) {
+            return DATA_OFFSET +
+                   static_cast<uint64_t>(entries) * getSlotStride(entrySize);
+        }
+    } // namespace
+
+    class SharedMemoryRing::Impl {
+      public:
+        Impl(std::string const &name, bool owner)
+            : name(name), owner(owner) {}
+        ~Impl() {
+            region = bip::mapped_region{};
+            if (owner) {
+                bip::shared_memory_object::remove(name.c_str());
+            }
+        }
+
+        /// Caches the geometry: the header is shared with the other process,
+        /// so nothing read from it later may size or locate a memory access.
+        void setGeometry(RingHeader *hdr, uint32_t numEntries,
+                         uint32_t maxEntrySize) {
+            header = hdr;
+            entries = numEntries;
+            entrySize = maxEntrySize;
+            stride = getSlotStride(maxEntrySize);
+        }
+
+        char *getSlot(uint32_t index) const {
+            return static_cast<char *>(region.get_address()) + DATA_OFFSET +
+                   (index % entries) * stride;
+        }
+
+        std::string name;
+        bool owner;
+        bip::mapped_region region;
+        RingHeader *header = nullptr;
+        uint32_t entries = 0;
+        uint32_t entrySize = 0;
+        std::size_t stride = 0;
+    };
+
+    SharedMemoryRingPtr SharedMemoryRing::create(std::string const &name,
+                                                 size_type entries,
+                                                 size_type entrySize) {
+        SharedMemoryRingPtr ret;
+        entries = roundUpToPowerOfTwo(entries);
+        if (0 == entries || 0 == entrySize) {
+            return ret;
+        }
+        auto segmentSize = getSegmentSize(entries, entrySize);
+        if (segmentSize > std::numeric_limits<uint32_t>::max()) {
+            return ret;
+        }
+        unique_ptr<Impl> impl{new Impl{name, true}};
+        try {
+            bip::shared_memory_object::remove(name.c_str());
+            bip::shared_memory_object shm{bip::create_only, name.c_str(),
+                                          bip::read_write};
+            shm.truncate(static_cast<bip::offset_t>(segmentSize));
+            impl->region = bip::mapped_region{shm, bip::read_write};
+        } catch (bip::interprocess_exception &) {
+            return ret;
+        }
+        auto header = new (impl->region.get_address()) RingHeader;
+        header->version = RING_VERSION;
+        header->entries = entries;
+        header->entrySize = entrySize;
+        header->head.store(0, std::memory_order_relaxed);
+        header->tail.store(0, std::memory_order_relaxed);
+        header->dropped.store(0, std::memory_order_relaxed);
+        /// Written last, so open() never sees a half-initialized header.
+        header->magic.store(RING_MAGIC, std::memory_order_release);
+        impl->setGeometry(header, entries, entrySize);
+        ret.reset(new SharedMemoryRing{std::move(impl)});
+        return ret;
+    }
+
+    SharedMemoryRingPtr SharedMemoryRing::open(std::string const &name) {
+        SharedMemoryRingPtr ret;
+        unique_ptr<Impl> impl{new Impl{name, false}};
+        try {
+            bip::shared_memory_object shm{bip::open_only, name.c_str(),
+                                          bip::read_write};
+            impl->region = bip::mapped_region{shm, bip::read_write};
+        } catch (bip::interprocess_exception &) {
+            return ret;
+        }
+        if (impl->region.get_size() < sizeof(RingHeader)) {
+            return ret;
+        }
+        auto header = static_cast<RingHeader *>(impl->region.get_address());
+        if (header->magic.load(std::memory_order_acquire) != RING_MAGIC ||
+            header->version != RING_VERSION) {
+            return ret;
+        }
+        /// Read each once, so what's validated is what's used.
+        uint32_t entries = header->entries;
+        uint32_t entrySize = header->entrySize;
+        if (0 == entries || entries != roundUpToPowerOfTwo(entries) ||
+            impl->region.get_size() < getSegmentSize(entries, entrySize)) {
+            return ret;
+        }
+        impl->setGeometry(header, entries, entrySize);
+        ret.reset(new SharedMemoryRing{std::move(impl)});
+        return ret;
+    }
+
+    SharedMemoryRing::SharedMemoryRing(unique_ptr<Impl> &&impl)
+        : m_impl(std::move(impl)) {}
+
+    SharedMemoryRing::~SharedMemoryRing() {}
+
+    bool SharedMemoryRing::push(const char *data, std::size_t len) {
+        auto &header = *m_impl->header;
+        auto head = header.head.load(std::memory_order_relaxed);
+        auto tail = header.tail.load(std::memory_order_acquire);
+        if (len > m_impl->entrySize ||
+            static_cast<uint32_t>(head - tail) >= m_impl->entries) {
+            header.dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        auto slot = m_impl->getSlot(head);
+        auto slotLen = static_cast<SlotHeader>(len);
+        std::memcpy(slot, &slotLen, sizeof(slotLen));
+        if (len > 0) {
+            std::memcpy(slot + sizeof(slotLen), data, len);
+        }
+        header.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool SharedMemoryRing::peek(const char *&data, size_type &len) const {
+        auto &header = *m_impl->header;
+        auto tail = header.tail.load(std::memory_order_relaxed);
+        auto head = header.head.load(std::memory_order_acquire);
+        if (head == tail) {
+            return false;
+        }
+        auto slot = m_impl->getSlot(tail);
+        SlotHeader slotLen;
+        std::memcpy(&slotLen, slot, sizeof(slotLen));
+        /// Don't trust the other process any further than the slot size.
+        len = slotLen > m_impl->entrySize ? m_impl->entrySize : slotLen;
+        data = slot + sizeof(slotLen);
+        return true;
+    }
+
+    void SharedMemoryRing::release() {
+        auto &header = *m_impl->header;
+        auto tail = header.tail.load(std::memory_order_relaxed);
+        if (header.head.load(std::memory_order_acquire) == tail) {
+            return;
+        }
+        header.tail.store(tail + 1, std::memory_order_release);
+    }
+
+    std::string const &SharedMemoryRing::getName() const {
+        return m_impl->name;
+    }
+
+    SharedMemoryRing::size_type SharedMemoryRing::getEntries() const {
+        return m_impl->entries;
+    }
+
+    SharedMemoryRing::size_type SharedMemoryRing::getEntrySize() const {
+        return m_impl->entrySize;
+    }
+
+    SharedMemoryRing::size_type SharedMemoryRing::size() const {
+        auto &header = *m_impl->header;
+        return header.head.load(std::memory_order_acquire) -
+               header.tail.load(std::memory_order_acquire);
+    }
+
+    uint32_t SharedMemoryRing::getDroppedCount() const {
+        return m_impl->header->dropped.load(std::memory_order_relaxed);
+    }
+} // namespace common
+} // namespace osvr
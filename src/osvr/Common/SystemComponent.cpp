@@ -93,6 +93,28 @@ namespace common {
         const char *ReplacementTreeFromServer::identifier() {
             return "com.osvr.system.ReplacementTreeFromServer";
         }
+
+        const char *DeviceStatsRequestToServer::identifier() {
+            return "com.osvr.system.devicestatsrequest";
+        }
+
+        class DeviceStatsFromServer::MessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : m_msg(msg) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_msg, serialization::JsonOnlyMessageTag());
+            }
+
+            Json::Value const &getValue() const { return m_msg; }
+
+          private:
+            Json::Value m_msg;
+        };
+        const char *DeviceStatsFromServer::identifier() {
+            return "com.osvr.system.devicestatsfromserver";
+        }
     } // namespace messages
 
     const char *SystemComponent::deviceName() {
@@ -148,11 +170,40 @@ namespace common {
         m_replaceTreeHandlers.push_back(cb);
     }
 
+    void SystemComponent::sendDeviceStatsRequest() {
+        Buffer<> buf;
+        m_getParent().packMessage(buf, deviceStatsRequest.getMessageType());
+        m_getParent().sendPending();
+    }
+
+    void SystemComponent::registerDeviceStatsRequestHandler(
+        vrpn_MESSAGEHANDLER handler, void *userdata) {
+        m_registerHandler(handler, userdata,
+                          deviceStatsRequest.getMessageType());
+    }
+
+    void SystemComponent::sendDeviceStats(Json::Value const &stats) {
+        Buffer<> buf;
+        messages::DeviceStatsFromServer::MessageSerialization msg(stats);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, deviceStatsOut.getMessageType());
+    }
+
+    void SystemComponent::registerDeviceStatsHandler(JsonHandler cb) {
+        if (m_deviceStatsHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleDeviceStats, this,
+                              deviceStatsOut.getMessageType());
+        }
+        m_deviceStatsHandlers.push_back(cb);
+    }
+
     void SystemComponent::m_parentSet() {
         m_getParent().registerMessageType(routesOut);
         m_getParent().registerMessageType(appStartup);
         m_getParent().registerMessageType(routeIn);
         m_getParent().registerMessageType(treeOut);
+        m_getParent().registerMessageType(deviceStatsRequest);
+        m_getParent().registerMessageType(deviceStatsOut);
     }
 
     int SystemComponent::m_handleReplaceTree(void *userdata,
@@ -169,5 +220,18 @@ namespace common {
         }
         return 0;
     }
+
+    int SystemComponent::m_handleDeviceStats(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::DeviceStatsFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        for (auto const &cb : self->m_deviceStatsHandlers) {
+            cb(msg.getValue(), timestamp);
+        }
+        return 0;
+    }
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,92 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "InferElementFromParent.h"
+#include <osvr/Common/TreeResolutionCache.h>
+#include <osvr/Common/PathNode.h>
+#include <osvr/Common/PathTree.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <utility>
+
+namespace osvr {
+namespace common {
+    boost::optional<boost::optional<OriginalSource>>
+    TreeResolutionCache::get(PathTree &tree, std::string const &path) {
+        auto it = m_entries.find(path);
+        if (it == m_entries.end()) {
+            ++m_misses;
+            return boost::none;
+        }
+        auto const &entry = it->second;
+        PathNode *landing = nullptr;
+        for (auto const &dep : entry.deps) {
+            // Looking up the node may create it, but so would resolving.
+            PathNode *node = &tree.getNodeByPath(dep.first);
+            landing = node;
+            for (auto const &elt : dep.second) {
+                if (nullptr != node) {
+                    ifNullTryInferFromParent(*node);
+                }
+                if (nullptr == node || !(node->value() == elt)) {
+                    m_entries.erase(it);
+                    ++m_misses;
+                    return boost::none;
+                }
+                node = node->getParent();
+            }
+        }
+        ++m_hits;
+        boost::optional<OriginalSource> ret;
+        if (!entry.resolved) {
+            return ret;
+        }
+        // The cached source may point to nodes of a since-replaced tree, so
+        // rebuild it from the equivalent nodes in this one: decomposing the
+        // node we landed on is cheap, it's the transforms that aren't.
+        ret = OriginalSource{};
+        ret->decompose(*landing);
+        ret->setTransform(entry.transform);
+        return ret;
+    }
+
+    void TreeResolutionCache::store(
+        std::string const &path, boost::optional<OriginalSource> const &source,
+        Dependencies &&deps) {
+        Entry entry;
+        entry.deps = std::move(deps);
+        entry.resolved = source.is_initialized();
+        if (entry.resolved) {
+            entry.transform = source->getTransform();
+        }
+        m_entries[path] = std::move(entry);
+    }
+
+    void TreeResolutionCache::clear() { m_entries.clear(); }
+} // namespace common
+} // namespace osvr
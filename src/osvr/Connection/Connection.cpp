@@ -38,13 +38,25 @@
 #include <boost/assert.hpp>
 
 // Standard includes
-// - none
+#include <chrono>
 
 namespace osvr {
 namespace connection {
     /// @brief Internal constant string used as key into AnyMap
     static const char CONNECTION_KEY[] = "com.osvr.ConnectionPtr";
 
+    /// @brief Default time a single device update may take before it's
+    /// reported as slow: long enough that only a real stall trips it.
+    static const std::chrono::milliseconds DEFAULT_SLOW_UPDATE_THRESHOLD(20);
+
+    /// @brief Whether n is 1, 10, 100, ...
+    static inline bool isPowerOfTen(uint64_t n) {
+        while (n >= 10 && n % 10 == 0) {
+            n /= 10;
+        }
+        return n == 1;
+    }
+
     ConnectionPtr Connection::createLocalConnection() {
         ConnectionPtr conn(make_shared<VrpnBasedConnection>(
             VrpnBasedConnection::VRPN_LOCAL_ONLY));
@@ -61,6 +73,11 @@ namespace connection {
         return std::make_tuple(conn->getUnderlyingObject(),
                                ConnectionPtr{conn});
     }
+    ConnectionPtr Connection::createFromUnderlyingObject(void *underlying) {
+        ConnectionPtr conn(make_shared<VrpnBasedConnection>(
+            vrpn_ConnectionPtr(static_cast<vrpn_Connection *>(underlying))));
+        return conn;
+    }
 
     ConnectionPtr
     Connection::retrieveConnection(const pluginhost::RegistrationContext &ctx) {
@@ -142,10 +159,35 @@ namespace connection {
 
     void Connection::process() {
         // Process the connection first.
-        m_process();
+        {
+            ScopedUpdateTimer timer(m_dispatchStats);
+            m_process();
+        }
         // Process all devices.
         for (auto &dev : m_devices) {
             dev->process();
+            m_checkSlowUpdate(*dev);
+        }
+    }
+
+    void Connection::setSlowUpdateThreshold(
+        DeviceUpdateStats::duration threshold) {
+        m_slowUpdateThreshold = threshold;
+    }
+
+    void Connection::m_checkSlowUpdate(ConnectionDevice &dev) {
+        auto &stats = dev.getUpdateStats();
+        auto threshold =
+            static_cast<uint64_t>(m_slowUpdateThreshold.count());
+        if (threshold == 0 || stats.getLastNanoseconds() < threshold) {
+            return;
+        }
+        auto slowCount = stats.recordSlowUpdate();
+        if (isPowerOfTen(slowCount)) {
+            m_log->warn() << "Device " << dev.getName() << " took "
+                          << stats.getLastNanoseconds() / 1000
+                          << "us to update, blocking the server mainloop ("
+                          << slowCount << " slow update(s) so far)";
         }
     }
 
@@ -163,7 +205,8 @@ namespace connection {
     }
 
     Connection::Connection()
-        : m_log(util::log::make_logger(util::log::OSVR_SERVER_LOG)) {}
+        : m_log(util::log::make_logger(util::log::OSVR_SERVER_LOG)),
+          m_slowUpdateThreshold(DEFAULT_SLOW_UPDATE_THRESHOLD) {}
 
     Connection::~Connection() {}
 
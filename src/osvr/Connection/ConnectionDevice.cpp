@@ -51,12 +51,16 @@ namespace connection {
     ConnectionDevice::ConnectionDevice(ConnectionDevice::NameList const &names)
         : m_names(names), m_token(nullptr) {}
 
-    void ConnectionDevice::process() { m_process(); }
+    void ConnectionDevice::process() {
+        ScopedUpdateTimer timer(m_stats);
+        m_process();
+    }
 
     void ConnectionDevice::sendData(util::time::TimeValue const &timestamp,
                                     MessageType *type, const char *bytestream,
                                     size_t len) {
         BOOST_ASSERT(type);
+        m_stats.recordMessages(1, len);
         m_sendData(timestamp, type, bytestream, len);
     }
 
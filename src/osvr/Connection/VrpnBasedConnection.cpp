@@ -69,6 +69,9 @@ namespace connection {
         }
     }
 
+    VrpnBasedConnection::VrpnBasedConnection(vrpn_ConnectionPtr const &conn)
+        : m_vrpnConnection(conn) {}
+
     void VrpnBasedConnection::m_initConnection(const char iface[], int port) {
         if (!m_network.isUp()) {
             OSVR_DEV_VERBOSE("Network error: " << m_network.getError());
@@ -54,6 +54,9 @@ namespace connection {
         VrpnBasedConnection(boost::optional<std::string const &> iface,
                             boost::optional<int> port);
 
+        /// @brief Constructor wrapping an existing VRPN connection.
+        explicit VrpnBasedConnection(vrpn_ConnectionPtr const &conn);
+
         /// @brief Returns the vrpn_Connection pointer.
         virtual void *getUnderlyingObject();
         virtual const char *getConnectionKindID();
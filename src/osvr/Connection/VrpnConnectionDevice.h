@@ -58,6 +58,7 @@ namespace connection {
             m_getDeviceToken().connectionInteract();
             m_server->mainloop();
             m_baseobj->mainloop();
+            m_recordComponentMessages();
         }
         virtual void m_sendData(util::time::TimeValue const &timestamp,
                                 MessageType *type, const char *bytestream,
@@ -67,7 +68,19 @@ namespace connection {
         }
 
       private:
+        /// @brief Folds messages sent by the components of the base object
+        /// since the last call into the update statistics.
+        void m_recordComponentMessages() {
+            auto messages = m_baseobj->getMessagesSent();
+            auto bytes = m_baseobj->getBytesSent();
+            getUpdateStats().recordMessages(messages - m_messagesSeen,
+                                            bytes - m_bytesSeen);
+            m_messagesSeen = messages;
+            m_bytesSeen = bytes;
+        }
         vrpn_BaseFlexServer *m_baseobj;
+        uint64_t m_messagesSeen = 0;
+        uint64_t m_bytesSeen = 0;
         unique_ptr<vrpn_MainloopObject> m_server;
     };
 } // namespace connection
@@ -99,6 +99,25 @@ namespace pluginhost {
         }
     }
 
+    std::size_t PluginSpecificRegistrationContextImpl::
+        getNumAsyncHardwareDetectCallbacks() const {
+        return m_asyncHardwareDetectCallbacks.size();
+    }
+
+    bool PluginSpecificRegistrationContextImpl::probeHardware(
+        std::size_t index) const {
+        return OSVR_RETURN_SUCCESS ==
+               m_asyncHardwareDetectCallbacks.at(index).probe();
+    }
+
+    void PluginSpecificRegistrationContextImpl::completeHardwareDetect(
+        std::size_t index) {
+        OSVR_DEV_VERBOSE("PluginSpecificRegistrationContext:\t"
+                         "In completeHardwareDetect for "
+                         << getName());
+        m_asyncHardwareDetectCallbacks.at(index).detect(this);
+    }
+
     void PluginSpecificRegistrationContextImpl::instantiateDriver(
         const std::string &driverName, const std::string &params) const {
         auto it = m_driverInstantiationCallbacks.find(driverName);
@@ -137,6 +156,17 @@ namespace pluginhost {
                          << getName());
     }
 
+    void PluginSpecificRegistrationContextImpl::
+        registerAsyncHardwareDetectCallback(
+            OSVR_HardwareProbeCallback probeCallback,
+            OSVR_HardwareDetectCallback detectCallback, void *userData) {
+        OSVR_DEV_VERBOSE("PluginSpecificRegistrationContext:\t"
+                         "In registerAsyncHardwareDetectCallback");
+        m_asyncHardwareDetectCallbacks.push_back(AsyncHardwareDetectCallback{
+            HardwareProbeCallback(probeCallback, userData),
+            HardwareDetectCallback(detectCallback, userData)});
+    }
+
     void
     PluginSpecificRegistrationContextImpl::registerDriverInstantiationCallback(
         const char *name, OSVR_DriverInstantiationCallback constructor,
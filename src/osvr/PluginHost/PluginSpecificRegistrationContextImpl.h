@@ -36,6 +36,7 @@
 #include <libfunctionality/PluginHandle.h>
 
 // Standard includes
+#include <cstddef>
 #include <vector>
 #include <functional>
 
@@ -85,6 +86,19 @@ namespace pluginhost {
         /// if any.
         void triggerHardwareDetectCallbacks();
 
+        /// @brief Number of asynchronous hardware detect callbacks registered
+        /// by this plugin.
+        std::size_t getNumAsyncHardwareDetectCallbacks() const;
+
+        /// @brief Call the probe half of an asynchronous hardware detect
+        /// callback: may be called from any thread.
+        /// @return true if the detect half should be called.
+        bool probeHardware(std::size_t index) const;
+
+        /// @brief Call the detect half of an asynchronous hardware detect
+        /// callback.
+        void completeHardwareDetect(std::size_t index);
+
         /// @brief Call a driver instantiation callback for the given driver
         /// name.
         /// @throws std::runtime_error if there is no driver registered by that
@@ -110,6 +124,9 @@ namespace pluginhost {
 
         virtual void registerHardwareDetectCallback(
             OSVR_HardwareDetectCallback detectCallback, void *userData);
+        virtual void registerAsyncHardwareDetectCallback(
+            OSVR_HardwareProbeCallback probeCallback,
+            OSVR_HardwareDetectCallback detectCallback, void *userData);
         virtual void registerDriverInstantiationCallback(
             const char *name, OSVR_DriverInstantiationCallback constructor,
             void *userData);
@@ -130,6 +147,18 @@ namespace pluginhost {
         typedef std::vector<HardwareDetectCallback> HardwareDetectCallbackList;
         HardwareDetectCallbackList m_hardwareDetectCallbacks;
 
+        typedef util::CallbackWrapper<OSVR_HardwareProbeCallback>
+            HardwareProbeCallback;
+        struct AsyncHardwareDetectCallback {
+            HardwareProbeCallback probe;
+            HardwareDetectCallback detect;
+        };
+        typedef std::vector<AsyncHardwareDetectCallback>
+            AsyncHardwareDetectCallbackList;
+        /// Only appended to during plugin registration, before any probes
+        /// can be running.
+        AsyncHardwareDetectCallbackList m_asyncHardwareDetectCallbacks;
+
         typedef std::function<OSVR_ReturnCode(const char *)>
             DriverInstantiationCallback;
         typedef std::map<std::string, DriverInstantiationCallback>
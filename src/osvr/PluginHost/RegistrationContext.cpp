@@ -180,11 +180,39 @@ namespace pluginhost {
     }
 
     void RegistrationContext::triggerHardwareDetect() {
+        triggerSynchronousHardwareDetect();
+        for (auto &probe : getAsyncHardwareProbes()) {
+            auto complete = probe();
+            if (complete) {
+                complete();
+            }
+        }
+    }
+
+    void RegistrationContext::triggerSynchronousHardwareDetect() {
         for (auto &pluginPtr : m_regMap | boost::adaptors::map_values) {
             pluginPtr->triggerHardwareDetectCallbacks();
         }
     }
 
+    RegistrationContext::HardwareProbeList
+    RegistrationContext::getAsyncHardwareProbes() {
+        HardwareProbeList probes;
+        for (auto &pluginPtr : m_regMap | boost::adaptors::map_values) {
+            const auto n = pluginPtr->getNumAsyncHardwareDetectCallbacks();
+            for (std::size_t i = 0; i < n; ++i) {
+                PluginRegPtr plugin = pluginPtr;
+                probes.emplace_back([plugin, i]() -> std::function<void()> {
+                    if (!plugin->probeHardware(i)) {
+                        return std::function<void()>();
+                    }
+                    return [plugin, i] { plugin->completeHardwareDetect(i); };
+                });
+            }
+        }
+        return probes;
+    }
+
     void
     RegistrationContext::instantiateDriver(const std::string &pluginName,
                                            const std::string &driverName,
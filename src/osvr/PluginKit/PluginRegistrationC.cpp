@@ -53,6 +53,26 @@ OSVR_ReturnCode osvrPluginRegisterHardwareDetectCallback(
     return OSVR_RETURN_SUCCESS;
 }
 
+OSVR_ReturnCode osvrPluginRegisterAsyncHardwareDetectCallback(
+    OSVR_INOUT_PTR OSVR_PluginRegContext ctx,
+    OSVR_IN OSVR_HardwareProbeCallback probeCallback,
+    OSVR_IN OSVR_HardwareDetectCallback detectCallback,
+    OSVR_IN_OPT void *userData) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(
+        "osvrPluginRegisterAsyncHardwareDetectCallback", ctx);
+
+    try {
+        osvr::pluginhost::PluginSpecificRegistrationContext::get(ctx)
+            .registerAsyncHardwareDetectCallback(probeCallback,
+                                                 detectCallback, userData);
+    } catch (std::exception &e) {
+        std::cerr << "Error in osvrPluginRegisterAsyncHardwareDetectCallback - "
+                     "caught exception reporting: " << e.what() << std::endl;
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode osvrRegisterDriverInstantiationCallback(
     OSVR_INOUT_PTR OSVR_PluginRegContext ctx, OSVR_IN_STRZ const char *name,
     OSVR_IN_PTR OSVR_DriverInstantiationCallback cb,
@@ -0,0 +1,204 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "ChildProcess.h"
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+#ifdef OSVR_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <signal.h>
+#include <spawn.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <chrono>
+#include <sstream>
+
+#ifndef OSVR_WINDOWS
+extern char **environ;
+#endif
+
+namespace osvr {
+namespace server {
+#ifdef OSVR_WINDOWS
+    struct ChildProcess::Impl {
+        ~Impl() {
+            CloseHandle(info.hThread);
+            CloseHandle(info.hProcess);
+        }
+        PROCESS_INFORMATION info;
+        bool exited = false;
+    };
+
+    /// @brief Quotes an argument so CommandLineToArgvW and the C runtime
+    /// split it back out as a single argument.
+    static inline std::string quoteArgument(std::string const &arg) {
+        std::string ret{"\""};
+        std::size_t backslashes = 0;
+        for (auto c : arg) {
+            if ('\\' == c) {
+                ++backslashes;
+                continue;
+            }
+            if ('"' == c) {
+                backslashes = backslashes * 2 + 1;
+            }
+            ret.append(backslashes, '\\');
+            backslashes = 0;
+            ret.push_back(c);
+        }
+        ret.append(backslashes * 2, '\\');
+        ret.push_back('"');
+        return ret;
+    }
+
+    ChildProcessPtr ChildProcess::start(std::string const &executable,
+                                        ArgList const &args) {
+        ChildProcessPtr ret;
+        std::string cmdLine = quoteArgument(executable);
+        for (auto const &arg : args) {
+            cmdLine += " " + quoteArgument(arg);
+        }
+        STARTUPINFOA startupInfo = {0};
+        startupInfo.cb = sizeof(startupInfo);
+        unique_ptr<Impl> impl{new Impl};
+        if (!CreateProcessA(executable.c_str(), &cmdLine[0], nullptr, nullptr,
+                            FALSE, 0, nullptr, nullptr, &startupInfo,
+                            &impl->info)) {
+            return ret;
+        }
+        ret.reset(new ChildProcess{std::move(impl)});
+        return ret;
+    }
+
+    bool ChildProcess::waitForExit(unsigned int milliseconds) {
+        if (m_impl->exited) {
+            return true;
+        }
+        if (WAIT_OBJECT_0 !=
+            WaitForSingleObject(m_impl->info.hProcess, milliseconds)) {
+            return false;
+        }
+        m_impl->exited = true;
+        DWORD code = 0;
+        GetExitCodeProcess(m_impl->info.hProcess, &code);
+        std::ostringstream os;
+        os << "exited with code 0x" << std::hex << code;
+        m_exitDescription = os.str();
+        return true;
+    }
+
+    void ChildProcess::kill() {
+        if (m_impl->exited) {
+            return;
+        }
+        TerminateProcess(m_impl->info.hProcess, 1);
+        waitForExit(INFINITE);
+    }
+
+    unsigned long ChildProcess::getCurrentProcessId() {
+        return ::GetCurrentProcessId();
+    }
+#else
+    struct ChildProcess::Impl {
+        pid_t pid;
+        bool exited = false;
+    };
+
+    ChildProcessPtr ChildProcess::start(std::string const &executable,
+                                        ArgList const &args) {
+        ChildProcessPtr ret;
+        std::vector<char *> argv;
+        argv.push_back(const_cast<char *>(executable.c_str()));
+        for (auto const &arg : args) {
+            argv.push_back(const_cast<char *>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+        unique_ptr<Impl> impl{new Impl};
+        if (0 != posix_spawn(&impl->pid, executable.c_str(), nullptr, nullptr,
+                             argv.data(), environ)) {
+            return ret;
+        }
+        ret.reset(new ChildProcess{std::move(impl)});
+        return ret;
+    }
+
+    bool ChildProcess::waitForExit(unsigned int milliseconds) {
+        if (m_impl->exited) {
+            return true;
+        }
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(milliseconds);
+        int status = 0;
+        pid_t result;
+        while (0 == (result = waitpid(m_impl->pid, &status, WNOHANG))) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+        }
+        m_impl->exited = true;
+        std::ostringstream os;
+        if (result < 0) {
+            os << "could not be waited for";
+        } else if (WIFSIGNALED(status)) {
+            os << "killed by signal " << WTERMSIG(status);
+        } else {
+            os << "exited with code " << WEXITSTATUS(status);
+        }
+        m_exitDescription = os.str();
+        return true;
+    }
+
+    void ChildProcess::kill() {
+        if (m_impl->exited) {
+            return;
+        }
+        ::kill(m_impl->pid, SIGKILL);
+        waitForExit(1000);
+    }
+
+    unsigned long ChildProcess::getCurrentProcessId() {
+        return static_cast<unsigned long>(getpid());
+    }
+#endif
+
+    ChildProcess::ChildProcess(unique_ptr<Impl> &&impl)
+        : m_impl(std::move(impl)) {}
+
+    ChildProcess::~ChildProcess() { kill(); }
+
+    bool ChildProcess::isRunning() { return !waitForExit(0); }
+} // namespace server
+} // namespace osvr
@@ -0,0 +1,89 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_ChildProcess_h_GUID_7917371D_62D3_4C02_8B4D_58850E633B83
+#define INCLUDED_ChildProcess_h_GUID_7917371D_62D3_4C02_8B4D_58850E633B83
+
+// Internal Includes
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace server {
+    class ChildProcess;
+    typedef unique_ptr<ChildProcess> ChildProcessPtr;
+
+    /// @brief A process started by (and killed along with) this one.
+    class ChildProcess : boost::noncopyable {
+      public:
+        typedef std::vector<std::string> ArgList;
+
+        /// @brief Starts an executable with the given arguments (not
+        /// including the executable name itself).
+        /// @return an empty pointer if the process could not be started.
+        static ChildProcessPtr start(std::string const &executable,
+                                     ArgList const &args);
+
+        /// @brief Kills the process if it's still running.
+        ~ChildProcess();
+
+        /// @brief Checks, without blocking, whether the process is still
+        /// running.
+        bool isRunning();
+
+        /// @brief Waits up to the given number of milliseconds for the
+        /// process to exit.
+        /// @return true if it has exited.
+        bool waitForExit(unsigned int milliseconds);
+
+        /// @brief Forcibly terminates the process and waits for it.
+        void kill();
+
+        /// @brief Describes how the process exited (exit code or signal), or
+        /// an empty string if it hasn't.
+        std::string const &getExitDescription() const {
+            return m_exitDescription;
+        }
+
+        /// @brief Gets the ID of the current process, for use in naming
+        /// things unique to it.
+        static unsigned long getCurrentProcessId();
+
+      private:
+        struct Impl;
+        explicit ChildProcess(unique_ptr<Impl> &&impl);
+        unique_ptr<Impl> m_impl;
+        std::string m_exitDescription;
+    };
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_ChildProcess_h_GUID_7917371D_62D3_4C02_8B4D_58850E633B83
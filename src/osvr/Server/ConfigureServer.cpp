@@ -121,12 +121,47 @@ namespace server {
     static const char LOCAL_KEY[] = "local";
     static const char PORT_KEY[] = "port"; // not the triwizard cup.
     static const char SLEEP_KEY[] = "sleep";
+    static const char LOWLATENCY_KEY[] = "lowLatency";
+
+    /// Parses the optional "lowLatency" member of the server object, e.g.
+    /// `{"lockMemory": true, "realtimePriority": 50, "cpus": [2, 3]}`
+    static common::LowLatency::Options
+    parseLowLatencyOptions(Json::Value const &jsonLowLatency) {
+        common::LowLatency::Options opts;
+        if (!jsonLowLatency.isObject()) {
+            return opts;
+        }
+        Json::Value const &lockMemory = jsonLowLatency["lockMemory"];
+        if (lockMemory.isBool()) {
+            opts.setLockMemory(lockMemory.asBool());
+        }
+        Json::Value const &priority = jsonLowLatency["realtimePriority"];
+        if (priority.isInt()) {
+            opts.setRealtimePriority(priority.asInt());
+        }
+        Json::Value const &roundRobin = jsonLowLatency["roundRobin"];
+        if (roundRobin.isBool()) {
+            opts.setRoundRobin(roundRobin.asBool());
+        }
+        Json::Value const &cpus = jsonLowLatency["cpus"];
+        if (cpus.isArray()) {
+            std::vector<int> cpuList;
+            for (auto const &cpu : cpus) {
+                if (cpu.isInt()) {
+                    cpuList.push_back(cpu.asInt());
+                }
+            }
+            opts.setCpus(cpuList);
+        }
+        return opts;
+    }
 
     ServerPtr ConfigureServer::constructServer() {
         Json::Value const &root(m_data->root);
         bool local = true;
         std::string iface;
         boost::optional<int> port;
+        common::LowLatency::Options lowLatencyOptions;
 #ifdef _WIN32
         int sleepTime = 0; // microseconds - default to 0 on Windows
 #else
@@ -163,6 +198,9 @@ namespace server {
                 // Convert to microseconds for internal use.
                 sleepTime = static_cast<int>(jsonSleepTime.asDouble() * 1000.0);
             }
+
+            lowLatencyOptions =
+                parseLowLatencyOptions(jsonServer[LOWLATENCY_KEY]);
         }
 
         /// Construct a server, or a connection then a server, based on the
@@ -182,6 +220,7 @@ namespace server {
         if (sleepTime > 0.0) {
             m_server->setSleepTime(sleepTime);
         }
+        m_server->setLowLatencyOptions(lowLatencyOptions);
 
         m_server->setHardwareDetectOnConnection();
 
@@ -317,6 +356,27 @@ namespace server {
 
         return success;
     }
+    static const char PLUGINHOSTS_KEY[] = "pluginHosts";
+    static const char NAME_KEY[] = "name";
+    bool ConfigureServer::processPluginHosts() {
+        bool success = false;
+        Json::Value const &hosts = m_data->getMember(PLUGINHOSTS_KEY);
+        for (Json::ArrayIndex i = 0, e = hosts.size(); i < e; ++i) {
+            auto const &host = hosts[i];
+            if (!host.isObject()) {
+                OSVR_DEV_VERBOSE("Plugin host entry is not an object: "
+                                 << host.toStyledString());
+                continue;
+            }
+            auto name = host.isMember(NAME_KEY)
+                            ? host[NAME_KEY].asString()
+                            : "host" + boost::lexical_cast<std::string>(i);
+            m_server->addPluginHost(name, host);
+            success = true;
+        }
+        return success;
+    }
+
     static const char EXTERNALDEVICES_KEY[] = "externalDevices";
     static const char DEVICENAME_KEY[] = "deviceName";
     static const char DESCRIPTOR_KEY[] = "descriptor";
@@ -0,0 +1,82 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "DeviceStatsJson.h"
+#include <osvr/Connection/ConnectionDevice.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace server {
+    static Json::Value toMicroseconds(double nanoseconds) {
+        return nanoseconds / 1000.;
+    }
+
+    Json::Value
+    deviceUpdateStatsToJson(connection::DeviceUpdateStats const &s) {
+        Json::Value ret(Json::objectValue);
+        ret["updates"] = Json::UInt64(s.getUpdateCount());
+        ret["meanUs"] = toMicroseconds(s.getMeanNanoseconds());
+        ret["maxUs"] = toMicroseconds(double(s.getMaxNanoseconds()));
+        ret["lastUs"] = toMicroseconds(double(s.getLastNanoseconds()));
+        ret["totalUs"] = toMicroseconds(double(s.getTotalNanoseconds()));
+        ret["slowUpdates"] = Json::UInt64(s.getSlowUpdateCount());
+        ret["messages"] = Json::UInt64(s.getMessageCount());
+        ret["bytes"] = Json::UInt64(s.getByteCount());
+        Json::Value histogram(Json::arrayValue);
+        for (auto count : s.getHistogram()) {
+            histogram.append(Json::UInt64(count));
+        }
+        ret["histogram"] = histogram;
+        return ret;
+    }
+
+    Json::Value deviceStatsToJson(connection::Connection const &conn) {
+        typedef connection::DeviceUpdateStats Stats;
+        Json::Value ret(Json::objectValue);
+        Json::Value buckets(Json::arrayValue);
+        for (std::size_t i = 0; i < Stats::NUM_BUCKETS; ++i) {
+            buckets.append(
+                Json::UInt64(Stats::getBucketUpperBoundMicroseconds(i)));
+        }
+        ret["histogramBucketsUs"] = buckets;
+        ret["slowThresholdUs"] = toMicroseconds(
+            double(conn.getSlowUpdateThreshold().count()));
+        ret["dispatch"] = deviceUpdateStatsToJson(conn.getDispatchStats());
+        Json::Value devices(Json::objectValue);
+        for (auto const &dev : conn.getDevices()) {
+            devices[dev->getName()] =
+                deviceUpdateStatsToJson(dev->getUpdateStats());
+        }
+        ret["devices"] = devices;
+        return ret;
+    }
+} // namespace server
+} // namespace osvr
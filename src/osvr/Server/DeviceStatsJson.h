@@ -0,0 +1,55 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_DeviceStatsJson_h_GUID_8A682D0C_47E1_49D5_A22C_34AB4796463C
+#define INCLUDED_DeviceStatsJson_h_GUID_8A682D0C_47E1_49D5_A22C_34AB4796463C
+
+// Internal Includes
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/DeviceUpdateStats.h>
+
+// Library/third-party includes
+#include <json/value.h>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace server {
+    /// @brief Converts a single set of update statistics to a JSON object.
+    Json::Value deviceUpdateStatsToJson(connection::DeviceUpdateStats const &s);
+
+    /// @brief Builds the reply to a device stats request: the dispatch
+    /// statistics of the connection, plus those of each device, keyed by
+    /// (primary) device name.
+    ///
+    /// Durations are in microseconds. The histogram is an array of counts,
+    /// with the exclusive upper bound of each bucket in the top-level
+    /// "histogramBucketsUs" array.
+    Json::Value deviceStatsToJson(connection::Connection const &conn);
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_DeviceStatsJson_h_GUID_8A682D0C_47E1_49D5_A22C_34AB4796463C
@@ -0,0 +1,152 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "HardwareDetectWorker.h"
+#include <osvr/Util/LogNames.h>
+#include <osvr/Util/Logger.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <exception>
+#include <utility>
+
+namespace osvr {
+namespace server {
+    HardwareDetectWorker::HardwareDetectWorker()
+        : m_log(util::log::make_logger(util::log::OSVR_SERVER_LOG)) {}
+
+    HardwareDetectWorker::~HardwareDetectWorker() { stop(); }
+
+    void HardwareDetectWorker::trigger(ProbeList probes) {
+        {
+            boost::unique_lock<boost::mutex> lock(m_mutex);
+            if (m_stopRequested) {
+                return;
+            }
+            if (m_havePending) {
+                ++m_coalesced;
+            }
+            m_pending = std::move(probes);
+            m_havePending = true;
+        }
+        if (m_thread.get_id() == boost::thread::id()) {
+            m_thread = boost::thread([&] { m_threadFunction(); });
+        }
+        m_cond.notify_one();
+    }
+
+    std::size_t HardwareDetectWorker::runCompletions() {
+        std::vector<Completion> completions;
+        {
+            boost::unique_lock<boost::mutex> lock(m_mutex);
+            if (m_completions.empty()) {
+                return 0;
+            }
+            completions.swap(m_completions);
+        }
+        for (auto &complete : completions) {
+            try {
+                complete();
+            } catch (std::exception &e) {
+                m_log->error() << "Hardware detect callback failed: "
+                               << e.what();
+            }
+        }
+        return completions.size();
+    }
+
+    bool HardwareDetectWorker::isIdle() const {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        return !m_havePending && !m_passRunning;
+    }
+
+    std::size_t HardwareDetectWorker::getPassCount() const {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        return m_passes;
+    }
+
+    std::size_t HardwareDetectWorker::getCoalescedCount() const {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        return m_coalesced;
+    }
+
+    void HardwareDetectWorker::stop() {
+        {
+            boost::unique_lock<boost::mutex> lock(m_mutex);
+            m_stopRequested = true;
+            m_pending.clear();
+            m_havePending = false;
+        }
+        m_cond.notify_one();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        m_completions.clear();
+    }
+
+    void HardwareDetectWorker::m_threadFunction() {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        while (true) {
+            while (!m_havePending && !m_stopRequested) {
+                m_cond.wait(lock);
+            }
+            if (m_stopRequested) {
+                return;
+            }
+            ProbeList probes;
+            probes.swap(m_pending);
+            m_havePending = false;
+            m_passRunning = true;
+            ++m_passes;
+            lock.unlock();
+
+            std::vector<Completion> found;
+            for (auto &probe : probes) {
+                try {
+                    auto complete = probe();
+                    if (complete) {
+                        found.push_back(std::move(complete));
+                    }
+                } catch (std::exception &e) {
+                    m_log->error() << "Hardware probe callback failed: "
+                                   << e.what();
+                }
+            }
+            // Drop our references to the plugins before reporting done.
+            probes.clear();
+
+            lock.lock();
+            m_passRunning = false;
+            for (auto &complete : found) {
+                m_completions.push_back(std::move(complete));
+            }
+        }
+    }
+} // namespace server
+} // namespace osvr
@@ -0,0 +1,108 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_HardwareDetectWorker_h_GUID_085BBDF6_E075_4DA8_9F53_1D2D3DE9D82B
+#define INCLUDED_HardwareDetectWorker_h_GUID_085BBDF6_E075_4DA8_9F53_1D2D3DE9D82B
+
+// Internal Includes
+#include <osvr/PluginHost/RegistrationContext.h>
+#include <osvr/Util/Log.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace osvr {
+namespace server {
+    /// @brief Runs the probe halves of asynchronous hardware detect callbacks
+    /// in a worker thread, so slow probing (enumerating buses, opening
+    /// ports and cameras) doesn't stall the server main loop, and hands the
+    /// detect halves back to be run in the main loop.
+    ///
+    /// All methods other than the constructor and destructor are meant to be
+    /// called from the main loop.
+    class HardwareDetectWorker : boost::noncopyable {
+      public:
+        typedef pluginhost::RegistrationContext::HardwareProbeList ProbeList;
+
+        HardwareDetectWorker();
+
+        /// @brief Stops the worker thread, waiting for any probe in progress.
+        ~HardwareDetectWorker();
+
+        /// @brief Requests a detection pass with the given probes.
+        ///
+        /// If a pass is already running, this is coalesced with any other
+        /// requests made before it finishes into a single pass run after it,
+        /// using the probes from the most recent request.
+        void trigger(ProbeList probes);
+
+        /// @brief Completes detection for any probes that have found
+        /// hardware since the last call.
+        /// @return number of detect callbacks called.
+        std::size_t runCompletions();
+
+        /// @brief Whether there are no passes running or waiting to run.
+        bool isIdle() const;
+
+        /// @brief Number of detection passes run so far.
+        std::size_t getPassCount() const;
+
+        /// @brief Number of requests folded into an already-pending pass.
+        std::size_t getCoalescedCount() const;
+
+        /// @brief Stops the worker thread, waiting for any probe in
+        /// progress. Pending passes and completions are dropped.
+        void stop();
+
+      private:
+        typedef std::function<void()> Completion;
+        void m_threadFunction();
+
+        util::log::LoggerPtr m_log;
+        mutable boost::mutex m_mutex;
+        boost::condition_variable m_cond;
+        /// @name Protected by m_mutex
+        /// @{
+        ProbeList m_pending;
+        bool m_havePending = false;
+        bool m_passRunning = false;
+        bool m_stopRequested = false;
+        std::size_t m_passes = 0;
+        std::size_t m_coalesced = 0;
+        std::vector<Completion> m_completions;
+        /// @}
+        /// Started on the first request.
+        boost::thread m_thread;
+    };
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_HardwareDetectWorker_h_GUID_085BBDF6_E075_4DA8_9F53_1D2D3DE9D82B
@@ -0,0 +1,180 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_PluginHostMessages_h_GUID_1BB32D15_D185_4226_BCF2_B64DA425D371
+#define INCLUDED_PluginHostMessages_h_GUID_1BB32D15_D185_4226_BCF2_B64DA425D371
+
+// Internal Includes
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/SharedMemoryRing.h>
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+
+namespace osvr {
+namespace server {
+    /// @brief The protocol between the server and an out-of-process plugin
+    /// host (osvr_plugin_host), spoken over a pair of SharedMemoryRing objects
+    /// named after a channel: records flow "up" from the host to the server,
+    /// commands flow "down" from the server to the host.
+    ///
+    /// Every ring entry is a one-byte type followed by the serialized
+    /// message of that type.
+    namespace host_messages {
+        inline std::string getUpRingName(std::string const &channel) {
+            return channel + "_up";
+        }
+        inline std::string getDownRingName(std::string const &channel) {
+            return channel + "_down";
+        }
+
+        /// @name Ring sizes
+        /// @brief Big enough for a device descriptor per entry, and a few
+        /// hundred milliseconds of reports from several devices should the
+        /// server fall behind.
+        /// @{
+        static const uint32_t UP_RING_ENTRIES = 512;
+        static const uint32_t UP_RING_ENTRY_SIZE = 16 * 1024;
+        static const uint32_t DOWN_RING_ENTRIES = 32;
+        static const uint32_t DOWN_RING_ENTRY_SIZE = 64 * 1024;
+        /// @}
+
+        /// @brief Types of entries in the up ring.
+        enum class HostRecordType : uint8_t {
+            /// A new or updated device descriptor: DescriptorRecord
+            Descriptor = 1,
+            /// A message sent by a device: ReportRecord
+            Report = 2,
+            /// The host is alive and its main loop is running: HeartbeatRecord
+            Heartbeat = 3
+        };
+
+        /// @brief Types of entries in the down ring.
+        enum class HostCommandType : uint8_t {
+            /// Plugins to load and drivers to instantiate: ConfigureCommand.
+            /// Always the first command.
+            Configure = 1,
+            /// Run hardware detection: no message body.
+            Detect = 2,
+            /// The server is alive: no message body.
+            Ping = 3,
+            /// Exit cleanly: no message body.
+            Shutdown = 4
+        };
+
+        class EntryHeader {
+          public:
+            EntryHeader(uint8_t type = 0) : type(type) {}
+            template <typename T> void processMessage(T &p) { p(type); }
+            uint8_t type;
+        };
+
+        class DescriptorRecord {
+          public:
+            template <typename T> void processMessage(T &p) {
+                p(deviceName);
+                p(descriptor);
+            }
+            std::string deviceName;
+            std::string descriptor;
+        };
+
+        /// @brief A message as packed by a device in the host, identified by
+        /// name since sender and type IDs are local to a connection.
+        class ReportRecord {
+          public:
+            template <typename T> void processMessage(T &p) {
+                p(sender);
+                p(messageType);
+                p(timestamp.seconds);
+                p(timestamp.microseconds);
+                p(sent.seconds);
+                p(sent.microseconds);
+                p(classOfService);
+                p(payload);
+            }
+            std::string sender;
+            std::string messageType;
+            /// The VRPN class of service the device packed it with.
+            uint32_t classOfService = 0;
+            /// The message's own timestamp.
+            util::time::TimeValue timestamp;
+            /// When the host pushed the record, for measuring relay latency.
+            util::time::TimeValue sent;
+            std::string payload;
+        };
+
+        class HeartbeatRecord {
+          public:
+            template <typename T> void processMessage(T &p) {
+                p(sent.seconds);
+                p(sent.microseconds);
+            }
+            util::time::TimeValue sent;
+        };
+
+        class ConfigureCommand {
+          public:
+            template <typename T> void processMessage(T &p) { p(config); }
+            /// JSON object with `plugins` and `drivers` members, like those at
+            /// the top level of a server config file.
+            std::string config;
+        };
+
+        /// @brief Message class for entry types with no body.
+        class EmptyMessage {
+          public:
+            template <typename T> void processMessage(T &) {}
+        };
+
+        /// @brief Serializes an entry and pushes it onto a ring.
+        /// @return false if the ring was full or the entry too large.
+        template <typename EntryType, typename MessageClass>
+        inline bool pushEntry(common::SharedMemoryRing &ring, EntryType type,
+                              MessageClass &msg) {
+            common::Buffer<> buf;
+            EntryHeader header(static_cast<uint8_t>(type));
+            common::serialize(buf, header);
+            common::serialize(buf, msg);
+            return ring.push(buf.data(), buf.size());
+        }
+
+        /// @overload
+        template <typename EntryType>
+        inline bool pushEntry(common::SharedMemoryRing &ring, EntryType type) {
+            EmptyMessage msg;
+            return pushEntry(ring, type, msg);
+        }
+    } // namespace host_messages
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_PluginHostMessages_h_GUID_1BB32D15_D185_4226_BCF2_B64DA425D371
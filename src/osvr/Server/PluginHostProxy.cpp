@@ -0,0 +1,333 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "PluginHostProxy.h"
+#include "PluginHostMessages.h"
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Util/Logger.h>
+#include <osvr/Util/ReturnCodesC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/lexical_cast.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace osvr {
+namespace server {
+    namespace msgs = host_messages;
+    using std::chrono::milliseconds;
+    using std::chrono::seconds;
+
+    /// How long a freshly started host has to load its plugins and send its
+    /// first heartbeat.
+    static const auto STARTUP_TIMEOUT = seconds(20);
+    /// How long a running host may go without a heartbeat (which it sends
+    /// every time through its main loop, at most every 100ms) or any
+    /// other message before it's considered hung.
+    static const auto HEARTBEAT_TIMEOUT = seconds(5);
+    /// How often the host is told the server is still alive.
+    static const auto PING_INTERVAL = milliseconds(250);
+    /// How long a host gets to exit cleanly before it's killed.
+    static const unsigned int SHUTDOWN_WAIT_MS = 1000;
+    /// Restart delay after the first failure, doubling with each failure in
+    /// a row up to the maximum...
+    static const auto MIN_RESTART_DELAY = milliseconds(500);
+    static const auto MAX_RESTART_DELAY = seconds(30);
+    /// ...and reset once a host has run at least this long.
+    static const auto HEALTHY_RUN_TIME = seconds(30);
+
+    static OSVR_ReturnCode noopUpdate(void *) { return OSVR_RETURN_SUCCESS; }
+
+    /// @brief Makes a string usable as part of a shared memory name.
+    static inline std::string makeNameSafe(std::string const &input) {
+        std::string ret{input};
+        for (auto &c : ret) {
+            if (!std::isalnum(static_cast<unsigned char>(c))) {
+                c = '_';
+            }
+        }
+        return ret;
+    }
+
+    PluginHostProxy::PluginHostProxy(std::string const &name,
+                                     std::string const &executable,
+                                     Json::Value const &config,
+                                     connection::ConnectionPtr const &conn,
+                                     vrpn_Connection &vrpnConn)
+        : m_name(name), m_executable(executable),
+          m_config(config.toStyledString()), m_conn(conn),
+          m_vrpnConn(vrpnConn),
+          m_log(util::log::make_logger("PluginHostProxy")),
+          m_restartDelay(MIN_RESTART_DELAY) {
+        m_start();
+    }
+
+    PluginHostProxy::~PluginHostProxy() {
+        if (m_process) {
+            m_log->info() << "Shutting down plugin host " << m_name;
+            msgs::pushEntry(*m_downRing, msgs::HostCommandType::Shutdown);
+            if (!m_process->waitForExit(SHUTDOWN_WAIT_MS)) {
+                m_log->warn() << "Plugin host " << m_name
+                              << " didn't exit when asked, killing it.";
+                m_process->kill();
+            }
+        }
+        m_logRelayLatency();
+    }
+
+    void PluginHostProxy::update() {
+        auto now = clock::now();
+        if (!m_process) {
+            if (now >= m_restartAt) {
+                m_start();
+            }
+            return;
+        }
+        const char *data;
+        common::SharedMemoryRing::size_type len;
+        while (m_upRing->peek(data, len)) {
+            m_handleEntry(data, len);
+            m_upRing->release();
+        }
+        if (m_descriptorsChanged) {
+            m_conn->triggerDescriptorHandlers();
+            m_descriptorsChanged = false;
+        }
+        if (now - m_lastPing >= PING_INTERVAL) {
+            msgs::pushEntry(*m_downRing, msgs::HostCommandType::Ping);
+            m_lastPing = now;
+        }
+        m_checkHost(now);
+    }
+
+    void PluginHostProxy::triggerHardwareDetect() {
+        if (m_process) {
+            msgs::pushEntry(*m_downRing, msgs::HostCommandType::Detect);
+        }
+    }
+
+    void PluginHostProxy::m_start() {
+        auto now = clock::now();
+        ++m_starts;
+        /// Fresh names each time, so nothing left over from a host that died
+        /// mid-write can be mistaken for output of the new one.
+        auto channel = "osvr_plugin_host_" +
+                       boost::lexical_cast<std::string>(
+                           ChildProcess::getCurrentProcessId()) +
+                       "_" + makeNameSafe(m_name) + "_" +
+                       boost::lexical_cast<std::string>(m_starts);
+        m_upRing = common::SharedMemoryRing::create(
+            msgs::getUpRingName(channel), msgs::UP_RING_ENTRIES,
+            msgs::UP_RING_ENTRY_SIZE);
+        m_downRing = common::SharedMemoryRing::create(
+            msgs::getDownRingName(channel), msgs::DOWN_RING_ENTRIES,
+            msgs::DOWN_RING_ENTRY_SIZE);
+        if (!m_upRing || !m_downRing) {
+            m_log->error() << "Could not create shared memory for plugin host "
+                           << m_name;
+            m_scheduleRestart(now);
+            return;
+        }
+        msgs::ConfigureCommand configure;
+        configure.config = m_config;
+        if (!msgs::pushEntry(*m_downRing, msgs::HostCommandType::Configure,
+                             configure)) {
+            m_log->error() << "Configuration for plugin host " << m_name
+                           << " is too large!";
+        }
+
+        m_log->info() << "Starting plugin host " << m_name << " ("
+                      << m_executable << " " << channel << ")";
+        m_process = ChildProcess::start(m_executable, {channel});
+        if (!m_process) {
+            m_log->error() << "Could not start plugin host " << m_name << " - "
+                           << m_executable << " may be missing.";
+            m_scheduleRestart(now);
+            return;
+        }
+        m_startedAt = now;
+        m_lastHeartbeat = now;
+        m_lastPing = now;
+        m_gotHeartbeat = false;
+        m_reportedDrops = 0;
+    }
+
+    void PluginHostProxy::m_checkHost(clock::time_point now) {
+        auto drops = m_upRing->getDroppedCount();
+        if (drops != m_reportedDrops) {
+            m_log->warn() << "Plugin host " << m_name << " dropped "
+                          << (drops - m_reportedDrops)
+                          << " messages (queue full or message too large)";
+            m_reportedDrops = drops;
+        }
+
+        if (!m_process->isRunning()) {
+            m_log->error() << "Plugin host " << m_name
+                           << " exited unexpectedly ("
+                           << m_process->getExitDescription() << ")";
+            m_scheduleRestart(now);
+            return;
+        }
+        auto timeout = m_gotHeartbeat ? HEARTBEAT_TIMEOUT : STARTUP_TIMEOUT;
+        if (now - m_lastHeartbeat > timeout) {
+            m_log->error() << "Plugin host " << m_name
+                           << " stopped responding, killing it.";
+            m_process->kill();
+            m_scheduleRestart(now);
+        }
+    }
+
+    void PluginHostProxy::m_scheduleRestart(clock::time_point now) {
+        if (m_process && now - m_startedAt >= HEALTHY_RUN_TIME) {
+            m_restartDelay = MIN_RESTART_DELAY;
+        }
+        m_process.reset();
+        m_upRing.reset();
+        m_downRing.reset();
+        m_logRelayLatency();
+
+        m_restartAt = now + m_restartDelay;
+        m_log->info() << "Will restart plugin host " << m_name << " in "
+                      << std::chrono::duration_cast<milliseconds>(
+                             m_restartDelay)
+                             .count()
+                      << "ms";
+        m_restartDelay = std::min<clock::duration>(m_restartDelay * 2,
+                                                   MAX_RESTART_DELAY);
+    }
+
+    void PluginHostProxy::m_handleEntry(const char *data, std::size_t len) {
+        try {
+            auto reader = common::readExternalBuffer(data, len);
+            msgs::EntryHeader header;
+            common::deserialize(reader, header);
+            /// Heartbeats share the ring with everything else, so a host
+            /// flooding it with reports may have its heartbeats dropped: but
+            /// anything at all coming through shows the host's main loop is
+            /// still running.
+            m_lastHeartbeat = clock::now();
+            m_gotHeartbeat = true;
+            switch (static_cast<msgs::HostRecordType>(header.type)) {
+            case msgs::HostRecordType::Descriptor: {
+                msgs::DescriptorRecord record;
+                common::deserialize(reader, record);
+                m_handleDescriptor(record.deviceName, record.descriptor);
+                break;
+            }
+            case msgs::HostRecordType::Report: {
+                msgs::ReportRecord record;
+                common::deserialize(reader, record);
+                auto sender = m_getSender(record.sender);
+                auto type = m_getMessageType(record.messageType);
+                struct timeval timestamp;
+                util::time::toStructTimeval(timestamp, record.timestamp);
+                m_vrpnConn.pack_message(
+                    static_cast<vrpn_uint32>(record.payload.size()), timestamp,
+                    type, sender, record.payload.data(),
+                    record.classOfService);
+
+                auto dev = m_devices.find(record.sender);
+                if (dev != end(m_devices)) {
+                    dev->second->getUpdateStats().recordMessages(
+                        1, record.payload.size());
+                }
+                auto latency = util::time::duration(util::time::getNow(),
+                                                    record.sent);
+                m_relayLatency.recordUpdate(
+                    std::chrono::duration_cast<
+                        connection::DeviceUpdateStats::duration>(
+                        std::chrono::duration<double>(latency)));
+                break;
+            }
+            case msgs::HostRecordType::Heartbeat:
+                /// Already noted above.
+                break;
+            default:
+                m_log->warn() << "Unrecognized message from plugin host "
+                              << m_name;
+                break;
+            }
+        } catch (std::exception &e) {
+            m_log->error() << "Malformed message from plugin host " << m_name
+                           << ": " << e.what();
+        }
+    }
+
+    void PluginHostProxy::m_handleDescriptor(std::string const &deviceName,
+                                             std::string const &descriptor) {
+        auto &dev = m_devices[deviceName];
+        if (!dev) {
+            /// Updates (or rather, messages) come from the host: the
+            /// stand-in device's own update has nothing to do.
+            dev = m_conn->registerAdvancedDevice(deviceName, &noopUpdate,
+                                                 nullptr);
+        }
+        if (dev->getDeviceDescriptor() != descriptor) {
+            dev->setDeviceDescriptor(descriptor);
+            m_descriptorsChanged = true;
+        }
+    }
+
+    vrpn_int32 PluginHostProxy::m_getSender(std::string const &name) {
+        auto it = m_senders.find(name);
+        if (it == end(m_senders)) {
+            it = m_senders
+                     .emplace(name, m_vrpnConn.register_sender(name.c_str()))
+                     .first;
+        }
+        return it->second;
+    }
+
+    vrpn_int32 PluginHostProxy::m_getMessageType(std::string const &name) {
+        auto it = m_messageTypes.find(name);
+        if (it == end(m_messageTypes)) {
+            it = m_messageTypes
+                     .emplace(name,
+                              m_vrpnConn.register_message_type(name.c_str()))
+                     .first;
+        }
+        return it->second;
+    }
+
+    void PluginHostProxy::m_logRelayLatency() {
+        auto const &stats = m_relayLatency;
+        if (0 == stats.getUpdateCount()) {
+            return;
+        }
+        m_log->info() << "Plugin host " << m_name << " relayed "
+                      << stats.getUpdateCount() << " reports, latency mean "
+                      << stats.getMeanNanoseconds() / 1000. << "us, max "
+                      << stats.getMaxNanoseconds() / 1000 << "us";
+    }
+} // namespace server
+} // namespace osvr
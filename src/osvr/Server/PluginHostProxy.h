@@ -0,0 +1,148 @@
+/** @file
+    @brief Header
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_PluginHostProxy_h_GUID_8C9B5C00_A2BF_42F2_94A4_01B4AFC37D2E
+#define INCLUDED_PluginHostProxy_h_GUID_8C9B5C00_A2BF_42F2_94A4_01B4AFC37D2E
+
+// Internal Includes
+#include "ChildProcess.h"
+#include <osvr/Common/SharedMemoryRing.h>
+#include <osvr/Connection/ConnectionDevicePtr.h>
+#include <osvr/Connection/ConnectionPtr.h>
+#include <osvr/Connection/DeviceUpdateStats.h>
+#include <osvr/Util/Log.h>
+#include <osvr/Util/UniquePtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <json/value.h>
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+namespace osvr {
+namespace server {
+    /// @brief Runs a group of plugins in a separate osvr_plugin_host process
+    /// and re-exposes their devices from the server.
+    ///
+    /// The host publishes device descriptors and every message its devices
+    /// pack through a SharedMemoryRing, which this drains from the server
+    /// main loop: each device gets a stand-in on the server connection, and
+    /// each message is repacked onto it under the same sender and message
+    /// type names, so clients can't tell the difference. A host that exits
+    /// or stops sending anything (heartbeats or reports) is killed and
+    /// restarted (with backoff); the stand-in devices stay put in the
+    /// meantime, so clients stay connected and simply see a gap in reports.
+    class PluginHostProxy : boost::noncopyable {
+      public:
+        typedef std::chrono::steady_clock clock;
+
+        /// @param name Name for the host in log messages, and part of the
+        /// shared memory names.
+        /// @param executable Path to osvr_plugin_host.
+        /// @param config JSON object with `plugins` and `drivers` members,
+        /// like the top level of a server config file.
+        /// @param conn The server connection to re-expose devices on.
+        /// @param vrpnConn The VRPN connection underlying conn.
+        PluginHostProxy(std::string const &name, std::string const &executable,
+                        Json::Value const &config,
+                        connection::ConnectionPtr const &conn,
+                        vrpn_Connection &vrpnConn);
+
+        /// @brief Asks the host to shut down, killing it if it doesn't
+        /// promptly.
+        ~PluginHostProxy();
+
+        /// @brief Relays everything the host has sent, and checks on (or
+        /// restarts) the host. Call from the server main loop.
+        void update();
+
+        /// @brief Asks the host to run hardware detection.
+        void triggerHardwareDetect();
+
+        std::string const &getName() const { return m_name; }
+
+        /// @name Statistics
+        /// @{
+        /// @brief Number of times the host has been (re)started.
+        std::size_t getStartCount() const { return m_starts; }
+        /// @brief Histogram of time from the host pushing a report to it
+        /// being repacked on the server connection (recorded as "update"
+        /// durations).
+        connection::DeviceUpdateStats const &getRelayLatency() const {
+            return m_relayLatency;
+        }
+        /// @}
+
+      private:
+        void m_start();
+        void m_checkHost(clock::time_point now);
+        void m_scheduleRestart(clock::time_point now);
+        void m_handleEntry(const char *data, std::size_t len);
+        void m_handleDescriptor(std::string const &deviceName,
+                                std::string const &descriptor);
+        /// @name Server connection IDs for the host's sender and message
+        /// type names, registered on first use.
+        /// @{
+        vrpn_int32 m_getSender(std::string const &name);
+        vrpn_int32 m_getMessageType(std::string const &name);
+        /// @}
+        void m_logRelayLatency();
+
+        std::string m_name;
+        std::string m_executable;
+        std::string m_config;
+        connection::ConnectionPtr m_conn;
+        vrpn_Connection &m_vrpnConn;
+        util::log::LoggerPtr m_log;
+
+        ChildProcessPtr m_process;
+        common::SharedMemoryRingPtr m_upRing;
+        common::SharedMemoryRingPtr m_downRing;
+        std::size_t m_starts = 0;
+        uint32_t m_reportedDrops = 0;
+
+        clock::time_point m_startedAt;
+        clock::time_point m_lastHeartbeat;
+        bool m_gotHeartbeat = false;
+        bool m_descriptorsChanged = false;
+        clock::time_point m_lastPing;
+        /// When to start the host next, if it's not running.
+        clock::time_point m_restartAt;
+        clock::duration m_restartDelay;
+
+        std::unordered_map<std::string, connection::ConnectionDevicePtr>
+            m_devices;
+        std::unordered_map<std::string, vrpn_int32> m_senders;
+        std::unordered_map<std::string, vrpn_int32> m_messageTypes;
+        connection::DeviceUpdateStats m_relayLatency;
+    };
+} // namespace server
+} // namespace osvr
+
+#endif // INCLUDED_PluginHostProxy_h_GUID_8C9B5C00_A2BF_42F2_94A4_01B4AFC37D2E
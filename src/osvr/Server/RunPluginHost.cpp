@@ -0,0 +1,341 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Server/RunPluginHost.h>
+#include "PluginHostMessages.h"
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/SharedMemoryRing.h>
+#include <osvr/Common/SystemComponent.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Server/Server.h>
+#include <osvr/Util/Logger.h>
+#include <osvr/Util/Microsleep.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <json/reader.h>
+#include <json/value.h>
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <chrono>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace osvr {
+namespace server {
+    namespace msgs = host_messages;
+    using std::chrono::milliseconds;
+    using std::chrono::seconds;
+    typedef std::chrono::steady_clock clock;
+
+    /// How long to wait for the configuration after starting.
+    static const auto CONFIGURE_TIMEOUT = seconds(5);
+    /// How often to tell the server we're alive.
+    static const auto HEARTBEAT_INTERVAL = milliseconds(100);
+    /// How long without a ping before assuming the server is gone.
+    static const auto SERVER_TIMEOUT = seconds(5);
+
+    static const char SLEEP_KEY[] = "sleep";
+    static const char PLUGINS_KEY[] = "plugins";
+    static const char DRIVERS_KEY[] = "drivers";
+    static const char DRIVER_KEY[] = "driver";
+    static const char PLUGIN_KEY[] = "plugin";
+    static const char PARAMS_KEY[] = "params";
+
+    namespace {
+        /// @brief The host's connection: VRPN doesn't tell local handlers
+        /// the class of service a message was packed with, so note it on the
+        /// way through.
+        class ClassOfServiceLoopback : public vrpn_Connection_Loopback {
+          public:
+            int pack_message(vrpn_uint32 len, struct timeval time,
+                             vrpn_int32 type, vrpn_int32 sender,
+                             const char *buffer,
+                             vrpn_uint32 class_of_service) override {
+                /// Local handlers are called from within this.
+                m_classOfService = class_of_service;
+                return vrpn_Connection_Loopback::pack_message(
+                    len, time, type, sender, buffer, class_of_service);
+            }
+
+            /// @brief The class of service of the message being packed.
+            vrpn_uint32 getPackingClassOfService() const {
+                return m_classOfService;
+            }
+
+          private:
+            vrpn_uint32 m_classOfService = vrpn_CONNECTION_RELIABLE;
+        };
+
+        /// @brief Relays everything packed on the host's connection (except
+        /// by the host's own system device) up to the server.
+        class ReportForwarder : boost::noncopyable {
+          public:
+            ReportForwarder(common::SharedMemoryRing &ring,
+                            ClassOfServiceLoopback &conn)
+                : m_ring(ring), m_conn(conn),
+                  m_systemSender(conn.register_sender(
+                      common::SystemComponent::deviceName())) {
+                /// VRPN calls local handlers as messages are packed.
+                m_conn.register_handler(vrpn_ANY_TYPE,
+                                        &ReportForwarder::handleMessage,
+                                        this, vrpn_ANY_SENDER);
+            }
+
+            ~ReportForwarder() {
+                m_conn.unregister_handler(vrpn_ANY_TYPE,
+                                          &ReportForwarder::handleMessage,
+                                          this, vrpn_ANY_SENDER);
+            }
+
+          private:
+            static int VRPN_CALLBACK handleMessage(void *userdata,
+                                                   vrpn_HANDLERPARAM p) {
+                auto self = static_cast<ReportForwarder *>(userdata);
+                /// Negative types are VRPN system messages.
+                if (p.type < 0 || p.sender == self->m_systemSender) {
+                    return 0;
+                }
+                auto &record = self->m_record;
+                record.sender = self->m_conn.sender_name(p.sender);
+                record.messageType = self->m_conn.message_type_name(p.type);
+                record.timestamp = util::time::fromStructTimeval(p.msg_time);
+                record.sent = util::time::getNow();
+                record.classOfService = self->m_conn.getPackingClassOfService();
+                record.payload.assign(p.buffer, p.payload_len);
+                msgs::pushEntry(self->m_ring, msgs::HostRecordType::Report,
+                                record);
+                return 0;
+            }
+
+            common::SharedMemoryRing &m_ring;
+            ClassOfServiceLoopback &m_conn;
+            vrpn_int32 m_systemSender;
+            /// Reused to avoid reallocating strings for every message.
+            msgs::ReportRecord m_record;
+        };
+
+        /// @brief Sends new and changed device descriptors up to the server.
+        class DescriptorForwarder : boost::noncopyable {
+          public:
+            DescriptorForwarder(common::SharedMemoryRing &ring,
+                                connection::Connection &conn)
+                : m_ring(ring), m_conn(conn) {
+                m_conn.registerDescriptorHandler([&] { m_dirty = true; });
+            }
+
+            void update() {
+                if (!m_dirty) {
+                    return;
+                }
+                m_dirty = false;
+                for (auto const &dev : m_conn.getDevices()) {
+                    auto const &descriptor = dev->getDeviceDescriptor();
+                    auto &sent = m_sent[dev->getName()];
+                    if (descriptor.empty() || descriptor == sent) {
+                        continue;
+                    }
+                    msgs::DescriptorRecord record;
+                    record.deviceName = dev->getName();
+                    record.descriptor = descriptor;
+                    if (msgs::pushEntry(m_ring,
+                                        msgs::HostRecordType::Descriptor,
+                                        record)) {
+                        sent = descriptor;
+                    } else {
+                        /// Try again next time around.
+                        m_dirty = true;
+                    }
+                }
+            }
+
+          private:
+            common::SharedMemoryRing &m_ring;
+            connection::Connection &m_conn;
+            bool m_dirty = true;
+            std::unordered_map<std::string, std::string> m_sent;
+        };
+    } // namespace
+
+    static void configureHost(Server &server, Json::Value const &config,
+                              util::log::Logger &log) {
+        for (auto const &plugin : config[PLUGINS_KEY]) {
+            try {
+                server.loadPlugin(plugin.asString());
+                log.info() << "Loaded plugin " << plugin.asString();
+            } catch (std::exception &e) {
+                log.error() << "Failed to load plugin " << plugin.asString()
+                            << ": " << e.what();
+            }
+        }
+        for (auto const &thisDriver : config[DRIVERS_KEY]) {
+            auto plugin = thisDriver[PLUGIN_KEY].asString();
+            auto driver = thisDriver[DRIVER_KEY].asString();
+            try {
+                server.instantiateDriver(
+                    plugin, driver, thisDriver[PARAMS_KEY].toStyledString());
+                log.info() << "Instantiated " << plugin << "/" << driver;
+            } catch (std::exception &e) {
+                log.error() << "Failed to instantiate " << plugin << "/"
+                            << driver << ": " << e.what();
+            }
+        }
+    }
+
+    int runPluginHost(std::string const &channel) {
+        auto log = util::log::make_logger("OSVR Plugin Host");
+        auto upRing =
+            common::SharedMemoryRing::open(msgs::getUpRingName(channel));
+        auto downRing =
+            common::SharedMemoryRing::open(msgs::getDownRingName(channel));
+        if (!upRing || !downRing) {
+            log->error() << "Could not open shared memory for channel "
+                         << channel;
+            return -1;
+        }
+
+        /// Wait for the configuration.
+        Json::Value config;
+        {
+            auto deadline = clock::now() + CONFIGURE_TIMEOUT;
+            const char *data;
+            common::SharedMemoryRing::size_type len;
+            while (!downRing->peek(data, len)) {
+                if (clock::now() > deadline) {
+                    log->error() << "Never got a configuration from the "
+                                    "server.";
+                    return -1;
+                }
+                util::time::microsleep(1000);
+            }
+            try {
+                auto reader = common::readExternalBuffer(data, len);
+                msgs::EntryHeader header;
+                common::deserialize(reader, header);
+                if (header.type !=
+                    static_cast<uint8_t>(msgs::HostCommandType::Configure)) {
+                    throw std::runtime_error("expected configuration first");
+                }
+                msgs::ConfigureCommand configure;
+                common::deserialize(reader, configure);
+                Json::Reader jsonReader;
+                if (!jsonReader.parse(configure.config, config)) {
+                    throw std::runtime_error(
+                        jsonReader.getFormattedErrorMessages());
+                }
+            } catch (std::exception &e) {
+                log->error() << "Bad configuration from the server: "
+                             << e.what();
+                return -1;
+            }
+            downRing->release();
+        }
+
+#ifdef _WIN32
+        int sleepTime = 0; // microseconds - same defaults as the server
+#else
+        int sleepTime = 1000; // microseconds
+#endif
+        if (config[SLEEP_KEY].isNumeric()) {
+            sleepTime = static_cast<int>(config[SLEEP_KEY].asDouble() * 1000.0);
+        }
+
+        /// Owned (through its reference count) by the connection.
+        auto &vrpnConn = *new ClassOfServiceLoopback;
+        vrpnConn.setAutoDeleteStatus(true);
+        auto connPtr = connection::Connection::createFromUnderlyingObject(
+            static_cast<vrpn_Connection *>(&vrpnConn));
+        auto &conn = *connPtr;
+        auto server = Server::createNonListening(connPtr);
+
+        ReportForwarder reports(*upRing, vrpnConn);
+        DescriptorForwarder descriptors(*upRing, conn);
+
+        log->info() << "Loading plugins for channel " << channel;
+        msgs::HeartbeatRecord heartbeat;
+        heartbeat.sent = util::time::getNow();
+        msgs::pushEntry(*upRing, msgs::HostRecordType::Heartbeat, heartbeat);
+        configureHost(*server, config, *log);
+        server->triggerHardwareDetect();
+
+        auto lastHeartbeat = clock::time_point{};
+        auto lastPing = clock::now();
+        bool keepRunning = true;
+        while (keepRunning) {
+            server->update();
+            descriptors.update();
+
+            auto now = clock::now();
+            const char *data;
+            common::SharedMemoryRing::size_type len;
+            while (downRing->peek(data, len)) {
+                msgs::EntryHeader header;
+                try {
+                    auto reader = common::readExternalBuffer(data, len);
+                    common::deserialize(reader, header);
+                } catch (std::exception &) {
+                    /// Leaves the type as 0, which is ignored.
+                }
+                switch (static_cast<msgs::HostCommandType>(header.type)) {
+                case msgs::HostCommandType::Detect:
+                    server->triggerHardwareDetect();
+                    break;
+                case msgs::HostCommandType::Ping:
+                    lastPing = now;
+                    break;
+                case msgs::HostCommandType::Shutdown:
+                    log->info() << "Shutting down as requested.";
+                    keepRunning = false;
+                    break;
+                default:
+                    break;
+                }
+                downRing->release();
+            }
+            if (now - lastPing > SERVER_TIMEOUT) {
+                log->error() << "Lost contact with the server, exiting.";
+                keepRunning = false;
+            }
+            if (now - lastHeartbeat >= HEARTBEAT_INTERVAL) {
+                heartbeat.sent = util::time::getNow();
+                msgs::pushEntry(*upRing, msgs::HostRecordType::Heartbeat,
+                                heartbeat);
+                lastHeartbeat = now;
+            }
+            if (keepRunning && sleepTime > 0) {
+                util::time::microsleep(sleepTime);
+            }
+        }
+        /// Plugins go first, while the forwarders they might still send
+        /// through are alive.
+        server.reset();
+        return 0;
+    }
+} // namespace server
+} // namespace osvr
@@ -129,9 +129,19 @@ namespace server {
         m_impl->addExternalDevice(path, deviceName, server, descriptor);
     }
 
+    void Server::addPluginHost(std::string const &name,
+                               Json::Value const &config) {
+        m_impl->addPluginHost(name, config);
+    }
+
     void Server::setSleepTime(int microseconds) {
         m_impl->setSleepTime(microseconds);
     }
+
+    void
+    Server::setLowLatencyOptions(common::LowLatency::Options const &opts) {
+        m_impl->setLowLatencyOptions(opts);
+    }
 #if 0
     int Server::getSleepTime() const { return m_impl->getSleepTime(); }
 #endif
@@ -24,6 +24,7 @@
 
 // Internal Includes
 #include "ServerImpl.h"
+#include "DeviceStatsJson.h"
 #include "../Connection/VrpnConnectionKind.h" /// @todo warning - cross-library internal header!
 #include <osvr/Common/AliasProcessor.h>
 #include <osvr/Common/CommonComponent.h>
@@ -35,6 +36,7 @@
 #include <osvr/Connection/ConnectionDevice.h>
 #include <osvr/Connection/MessageType.h>
 #include <osvr/PluginHost/RegistrationContext.h>
+#include <osvr/Util/BinaryLocation.h>
 #include <osvr/Util/LogNames.h>
 #include <osvr/Util/Logger.h>
 #include <osvr/Util/MessageKeys.h>
@@ -46,6 +48,7 @@
 #include "osvr/Server/display_json.h" /// Fallback display descriptor.
 
 // Library/third-party includes
+#include <boost/filesystem.hpp>
 #include <boost/variant.hpp>
 #include <json/reader.h>
 #include <vrpn_ConnectionPtr.h>
@@ -94,6 +97,8 @@ namespace server {
             m_systemDevice->addComponent(common::SystemComponent::create());
         m_systemComponent->registerClientRouteUpdateHandler(
             &ServerImpl::m_handleUpdatedRoute, this);
+        m_systemComponent->registerDeviceStatsRequestHandler(
+            &ServerImpl::m_handleDeviceStatsRequest, this);
 
         // Things to do when we get a new incoming connection
         // No longer doing hardware detect unconditionally here - see
@@ -217,12 +222,20 @@ namespace server {
         for (auto &f : m_mainloopMethods) {
             f();
         }
+        for (auto &host : m_pluginHosts) {
+            host->update();
+        }
         if (m_triggeredDetect) {
             m_log->info() << "Performing hardware auto-detection.";
             common::tracing::markHardwareDetect();
-            m_ctx->triggerHardwareDetect();
+            m_ctx->triggerSynchronousHardwareDetect();
+            m_detectWorker.trigger(m_ctx->getAsyncHardwareProbes());
+            for (auto &host : m_pluginHosts) {
+                host->triggerHardwareDetect();
+            }
             m_triggeredDetect = false;
         }
+        m_detectWorker.runCompletions();
         if (m_treeDirty) {
             m_log->debug() << "Path tree updated or connection detected";
             m_sendTree();
@@ -314,7 +327,34 @@ namespace server {
         return wasChanged;
     }
 
+    static const char EXECUTABLE_KEY[] = "executable";
+    static inline std::string getDefaultPluginHostExecutable() {
+        namespace fs = boost::filesystem;
+        auto dir = fs::path{util::getBinaryLocation()}.parent_path();
+#ifdef _WIN32
+        return (dir / "osvr_plugin_host.exe").string();
+#else
+        return (dir / "osvr_plugin_host").string();
+#endif
+    }
+
+    void ServerImpl::addPluginHost(std::string const &name,
+                                   Json::Value const &config) {
+        auto executable = config.isMember(EXECUTABLE_KEY)
+                              ? config[EXECUTABLE_KEY].asString()
+                              : getDefaultPluginHostExecutable();
+        m_callControlled([&] {
+            auto vrpnConn = getVRPNConnection(m_conn);
+            m_pluginHosts.emplace_back(new PluginHostProxy(
+                name, executable, config, m_conn, *vrpnConn.get()));
+        });
+    }
+
     void ServerImpl::m_orderedDestruction() {
+        // Plugin hosts relay onto the connection, so go before it does.
+        m_pluginHosts.clear();
+        // Probes must be done before their plugins can be unloaded.
+        m_detectWorker.stop();
         m_ctx.reset();
         m_systemComponent = nullptr; // non-owning pointer
         m_systemDevice.reset();
@@ -332,6 +372,17 @@ namespace server {
         return 0;
     }
 
+    int ServerImpl::m_handleDeviceStatsRequest(void *userdata,
+                                               vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        BOOST_ASSERT_MSG(
+            self->m_inServerThread(),
+            "This callback should never happen outside the server thread!");
+        self->m_systemComponent->sendDeviceStats(
+            deviceStatsToJson(*self->m_conn));
+        return 0;
+    }
+
     bool ServerImpl::m_addRoute(std::string const &routingDirective) {
         bool change =
             common::addAliasFromRoute(m_tree.getRoot(), routingDirective);
@@ -371,6 +422,11 @@ namespace server {
     void ServerImpl::setSleepTime(int microseconds) {
         m_sleepTime = microseconds;
     }
+
+    void ServerImpl::setLowLatencyOptions(
+        common::LowLatency::Options const &opts) {
+        m_lowLatencyOptions = opts;
+    }
 #if 0
     int ServerImpl::getSleepTime() const { return m_sleepTime; }
 #endif
@@ -397,8 +453,13 @@ namespace server {
                 "Got first client connection, exiting idle mode.");
             self->m_currentSleepTime = self->m_sleepTime;
         }
-        /// Create the low-latency behavior object.
-        self->m_lowLatency.reset(new common::LowLatency);
+        /// Create the low-latency behavior object. (Only if we don't have
+        /// one: it restores the previous settings on destruction, so
+        /// replacing one would undo the settings of its replacement.)
+        if (!self->m_lowLatency) {
+            self->m_lowLatency.reset(
+                new common::LowLatency(self->m_lowLatencyOptions));
+        }
         return 0;
     }
 
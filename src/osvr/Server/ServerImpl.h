@@ -26,6 +26,8 @@
 #define INCLUDED_ServerImpl_h_GUID_BA15589C_D1AD_4BBE_4F93_8AC87043A982
 
 // Internal Includes
+#include "HardwareDetectWorker.h"
+#include "PluginHostProxy.h"
 #include <osvr/Common/CommonComponent_fwd.h>
 #include <osvr/Common/CreateDevice.h>
 #include <osvr/Common/LowLatency.h>
@@ -52,6 +54,7 @@
 
 // Standard includes
 #include <string>
+#include <vector>
 
 namespace osvr {
 namespace server {
@@ -119,8 +122,14 @@ namespace server {
         /// @copydoc Server::addString
         bool addString(std::string const &path, std::string const &value);
 
+        /// @copydoc Server::addPluginHost
+        void addPluginHost(std::string const &name, Json::Value const &config);
+
         /// @copydoc Server::setSleepTime()
         void setSleepTime(int microseconds);
+
+        /// @copydoc Server::setLowLatencyOptions()
+        void setLowLatencyOptions(common::LowLatency::Options const &opts);
 #if 0
         /// @copydoc Server::getSleepTime()
         int getSleepTime() const;
@@ -162,6 +171,10 @@ namespace server {
         static int VRPN_CALLBACK m_handleUpdatedRoute(void *userdata,
                                                       vrpn_HANDLERPARAM p);
 
+        /// @brief handles a client's request for per-device update statistics
+        static int VRPN_CALLBACK
+        m_handleDeviceStatsRequest(void *userdata, vrpn_HANDLERPARAM);
+
         /// @brief adds a route - assumes that you've handled ensuring this is
         /// the main server thread.
         bool m_addRoute(std::string const &routingDirective);
@@ -212,6 +225,13 @@ namespace server {
         /// detection.
         bool m_triggeredDetect = false;
 
+        /// @brief Runs the probes of plugins with asynchronous hardware
+        /// detection off the main thread.
+        HardwareDetectWorker m_detectWorker;
+
+        /// @brief Out-of-process plugin hosts.
+        std::vector<unique_ptr<PluginHostProxy>> m_pluginHosts;
+
         /// @brief Path tree
         common::PathTree m_tree;
         util::Flag m_treeDirty;
@@ -259,6 +279,9 @@ namespace server {
 
         /// Latency reduction RAII object
         unique_ptr<common::LowLatency> m_lowLatency;
+
+        /// Options used when creating m_lowLatency
+        common::LowLatency::Options m_lowLatencyOptions;
     };
 
     /// @brief Class to temporarily (in RAII style) change a thread ID variable
@@ -0,0 +1,265 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Common/CompiledTransformCache.h>
+#include <osvr/Common/JSONTransformVisitor.h>
+
+#include <SampleConfigList.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include "json/reader.h"
+
+// Standard includes
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using osvr::common::CompiledTransform;
+using osvr::common::CompiledTransformCache;
+using osvr::common::JSONTransformVisitor;
+
+namespace {
+static const char *SAMPLE_CONFIGS[] = {OSVR_SAMPLE_CONFIG_LIST};
+
+static const double TOLERANCE = 1e-10;
+
+static const char *TRANSFORM_KEYS[] = {"child",     "changeBasis",
+                                       "translate", "rotate",
+                                       "posttranslate", "postrotate"};
+
+inline bool looksLikeTransform(Json::Value const &v) {
+    if (!v.isObject()) {
+        return false;
+    }
+    for (auto key : TRANSFORM_KEYS) {
+        if (v.isMember(key)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Every object anywhere in the config that has a transform (or child) key,
+/// including the inner levels of nested transforms.
+inline void findTransforms(Json::Value const &v,
+                           std::vector<Json::Value> &found) {
+    if (looksLikeTransform(v)) {
+        found.push_back(v);
+    }
+    if (v.isObject() || v.isArray()) {
+        for (auto const &child : v) {
+            findTransforms(child, found);
+        }
+    }
+}
+
+inline std::vector<Eigen::Matrix4d> getTestPoses() {
+    std::vector<Eigen::Matrix4d> ret;
+    ret.push_back(Eigen::Matrix4d::Identity());
+    Eigen::Isometry3d pose(
+        Eigen::AngleAxisd(0.7, Eigen::Vector3d(1, 2, 3).normalized()));
+    pose.translation() = Eigen::Vector3d(0.1, -0.25, 1.5);
+    ret.push_back(pose.matrix());
+    pose = Eigen::AngleAxisd(-2.1, Eigen::Vector3d(-3, 0.5, 1).normalized());
+    pose.translation() = Eigen::Vector3d(-4, 2, 0.03);
+    ret.push_back(pose.matrix());
+    return ret;
+}
+
+inline void checkEquivalent(Json::Value const &root) {
+    bool visitorThrew = false;
+    std::unique_ptr<JSONTransformVisitor> visitor;
+    try {
+        visitor.reset(new JSONTransformVisitor(root));
+    } catch (std::runtime_error &) {
+        visitorThrew = true;
+    }
+    if (visitorThrew) {
+        ASSERT_THROW(CompiledTransform{root}, std::runtime_error);
+        return;
+    }
+    CompiledTransform compiled(root);
+    auto const &expected = visitor->getTransform();
+    ASSERT_TRUE(compiled.getTransform().getPre().isApprox(expected.getPre(),
+                                                          TOLERANCE));
+    ASSERT_TRUE(compiled.getTransform().getPost().isApprox(
+        expected.getPost(), TOLERANCE));
+    ASSERT_EQ(visitor->getLeaf(), compiled.getLeaf());
+    ASSERT_LE(compiled.getNumOperations(), 2u);
+    ASSERT_LE(compiled.getNumOperations(), compiled.getNumSourceOperations());
+    for (auto const &pose : getTestPoses()) {
+        ASSERT_TRUE(compiled.apply(pose).isApprox(expected.transform(pose),
+                                                  TOLERANCE));
+    }
+}
+} // namespace
+
+TEST(CompiledTransform, MatchesVisitorOnSampleConfigs) {
+    std::size_t numTransforms = 0;
+    for (auto name : SAMPLE_CONFIGS) {
+        SCOPED_TRACE(name);
+        std::ifstream file(std::string(OSVR_SAMPLE_CONFIG_DIR) + name);
+        ASSERT_TRUE(file.good());
+        std::string contents((std::istreambuf_iterator<char>(file)),
+                             std::istreambuf_iterator<char>());
+        Json::Value root;
+        Json::Reader reader;
+        ASSERT_TRUE(reader.parse(contents, root));
+        std::vector<Json::Value> transforms;
+        findTransforms(root, transforms);
+        for (auto const &xform : transforms) {
+            SCOPED_TRACE(xform.toStyledString());
+            checkEquivalent(xform);
+        }
+        numTransforms += transforms.size();
+    }
+    ASSERT_GT(numTransforms, 0u);
+}
+
+inline Json::Value parse(std::string const &json) {
+    Json::Value ret;
+    Json::Reader reader;
+    if (!reader.parse(json, ret)) {
+        throw std::runtime_error("Invalid test JSON");
+    }
+    return ret;
+}
+
+TEST(CompiledTransform, FoldsNestedLevels) {
+    auto root = parse(R"({
+        "rotate": {"axis": "y", "degrees": 90},
+        "child": {
+            "translate": [1, 2, 3],
+            "posttranslate": [0, 0.5, 0],
+            "child": {
+                "postrotate": {"axis": "-x", "degrees": 45},
+                "rotate": {"axis": "z", "radians": 0.3},
+                "child": "/path"
+            }
+        }
+    })");
+    checkEquivalent(root);
+    CompiledTransform compiled(root);
+    ASSERT_EQ(5u, compiled.getNumSourceOperations());
+    ASSERT_EQ(2u, compiled.getNumOperations());
+    ASSERT_EQ(Json::Value("/path"), compiled.getLeaf());
+}
+
+TEST(CompiledTransform, EliminatesIdentities) {
+    auto root = parse(R"({
+        "translate": [0, 0, 0],
+        "child": {
+            "rotate": {"axis": "x", "degrees": 30},
+            "child": {
+                "rotate": {"axis": "x", "degrees": -30},
+                "child": "/path"
+            }
+        }
+    })");
+    checkEquivalent(root);
+    CompiledTransform compiled(root);
+    ASSERT_EQ(2u, compiled.getNumSourceOperations());
+    ASSERT_TRUE(compiled.isIdentity());
+    ASSERT_EQ(0u, compiled.getNumOperations());
+}
+
+TEST(CompiledTransform, ChangeBasisAffectsBothSides) {
+    auto root = parse(R"({
+        "changeBasis": {"x": "x", "y": "z", "z": "-y"},
+        "child": {"rotate": {"axis": "x", "degrees": 90}, "child": "/p"}
+    })");
+    checkEquivalent(root);
+    CompiledTransform compiled(root);
+    ASSERT_EQ(2u, compiled.getNumOperations());
+}
+
+TEST(CompiledTransform, ThrowsLikeVisitor) {
+    auto root = parse(R"({"rotate": {"axis": "q", "degrees": 90}})");
+    ASSERT_THROW(JSONTransformVisitor{root}, std::runtime_error);
+    ASSERT_THROW(CompiledTransform{root}, std::runtime_error);
+}
+
+TEST(CompiledTransform, ComposesLikeTransform) {
+    auto root = parse(R"({
+        "changeBasis": {"x": "x", "y": "z", "z": "-y"},
+        "child": {"translate": [1, 2, 3], "child": "/p"}
+    })");
+    CompiledTransform compiled(root);
+    osvr::common::Transform outer;
+    outer.concatPost(osvr::common::rotate(30, Eigen::Vector3d::UnitY()));
+    outer.concatPre(Eigen::Isometry3d(Eigen::Translation3d(0, 1, 0)).matrix());
+
+    auto expected = compiled.getTransform();
+    expected.transform(outer);
+    auto composed = compiled.composedWith(outer);
+    ASSERT_EQ(Json::Value("/p"), composed.getLeaf());
+    for (auto const &pose : getTestPoses()) {
+        ASSERT_TRUE(composed.apply(pose).isApprox(expected.transform(pose),
+                                                  TOLERANCE));
+    }
+    const Eigen::Vector3d vel(0.5, -1, 2);
+    ASSERT_TRUE(composed.transformDerivative(vel).isApprox(
+        expected.transformDerivative(vel), TOLERANCE));
+    const Eigen::Quaterniond angVel(
+        Eigen::AngleAxisd(0.1, Eigen::Vector3d(1, 1, 0).normalized()));
+    ASSERT_TRUE(composed.transformDerivative(angVel).isApprox(
+        expected.transformDerivative(angVel), TOLERANCE));
+
+    // Composing with the identity (the usual room-to-world transform) keeps
+    // the folded form, and an identity route stays free to apply.
+    ASSERT_EQ(compiled.getNumOperations(),
+              compiled.composedWith(osvr::common::Transform{})
+                  .getNumOperations());
+    CompiledTransform identity;
+    ASSERT_TRUE(identity.isIdentity());
+    ASSERT_TRUE(identity.composedWith(osvr::common::Transform{}).isIdentity());
+    ASSERT_TRUE(identity.transformDerivative(vel).isApprox(vel));
+}
+
+TEST(CompiledTransformCache, ReusesCompiledTransforms) {
+    CompiledTransformCache cache;
+    auto a = parse(R"({"translate": [1, 2, 3], "child": "/a"})");
+    auto b = parse(R"({"translate": [1, 2, 4], "child": "/a"})");
+    auto first = cache.get(a);
+    ASSERT_EQ(first, cache.get(parse(a.toStyledString())));
+    ASSERT_NE(first, cache.get(b));
+    ASSERT_EQ(2u, cache.size());
+    ASSERT_EQ(1u, cache.getHits());
+    ASSERT_EQ(2u, cache.getMisses());
+
+    ASSERT_THROW(cache.get(parse(R"({"translate": "w"})")),
+                 std::runtime_error);
+    ASSERT_EQ(2u, cache.size());
+
+    cache.clear();
+    ASSERT_EQ(0u, cache.size());
+    ASSERT_NE(first, cache.get(a));
+}
@@ -0,0 +1,103 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/LowLatency.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/prctl.h>
+#endif
+
+// Standard includes
+#include <memory>
+
+using osvr::common::LowLatency;
+
+TEST(LowLatency, createAndDestroy) {
+    std::unique_ptr<LowLatency> lowLatency;
+    ASSERT_NO_THROW(lowLatency.reset(new LowLatency));
+    ASSERT_NO_THROW(lowLatency.reset());
+}
+
+TEST(LowLatency, unprivilegedRequestsFailGracefully) {
+    /// These may or may not be granted depending on privileges, but either
+    /// way construction must succeed.
+    std::unique_ptr<LowLatency> lowLatency;
+    auto opts = LowLatency::Options().setLockMemory(true).setRealtimePriority(10);
+    ASSERT_NO_THROW(lowLatency.reset(new LowLatency(opts)));
+    ASSERT_NO_THROW(lowLatency.reset());
+}
+
+#ifdef __linux__
+TEST(LowLatency, timerSlackAppliedAndRestored) {
+    const auto originalSlack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+    ASSERT_GE(originalSlack, 0);
+    {
+        LowLatency lowLatency;
+        ASSERT_TRUE(lowLatency.isTimerResolutionRaised());
+        ASSERT_EQ(1, prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0));
+    }
+    ASSERT_EQ(originalSlack, prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0));
+}
+
+TEST(LowLatency, schedulingRestored) {
+    const auto originalPolicy = sched_getscheduler(0);
+    ASSERT_GE(originalPolicy, 0);
+    {
+        LowLatency lowLatency(LowLatency::Options().setRealtimePriority(10));
+        if (lowLatency.isRealtimeScheduled()) {
+            ASSERT_EQ(SCHED_FIFO, sched_getscheduler(0));
+        } else {
+            ASSERT_EQ(originalPolicy, sched_getscheduler(0));
+        }
+    }
+    ASSERT_EQ(originalPolicy, sched_getscheduler(0));
+}
+
+TEST(LowLatency, cpuAffinityAppliedAndRestored) {
+    cpu_set_t originalCpus;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(cpu_set_t), &originalCpus));
+    /// Pick the first CPU we're already allowed on, so pinning can succeed.
+    int cpu = 0;
+    while (cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &originalCpus)) {
+        ++cpu;
+    }
+    ASSERT_LT(cpu, CPU_SETSIZE);
+    {
+        LowLatency lowLatency(LowLatency::Options().setCpus({cpu}));
+        ASSERT_TRUE(lowLatency.isCpuPinned());
+        cpu_set_t cpus;
+        ASSERT_EQ(0, sched_getaffinity(0, sizeof(cpu_set_t), &cpus));
+        ASSERT_EQ(1, CPU_COUNT(&cpus));
+        ASSERT_TRUE(CPU_ISSET(cpu, &cpus));
+    }
+    cpu_set_t restoredCpus;
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(cpu_set_t), &restoredCpus));
+    ASSERT_TRUE(CPU_EQUAL(&originalCpus, &restoredCpus));
+}
+#endif
@@ -26,6 +26,7 @@
 // Internal Includes
 #include "DummyTree.h"
 #include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/TreeResolutionCache.h>
 
 // Library/third-party includes
 #include "gtest/gtest.h"
@@ -91,4 +92,93 @@ TEST_F(PathTreeResolution, BackCompatRoute) {
 
     setAlias(val.toStyledString());
     checkResolution();
-}
\ No newline at end of file
+}
+class CachedPathTreeResolution : public PathTreeResolution {
+  public:
+    CachedPathTreeResolution() {
+        Json::Value val(Json::objectValue);
+        val["rotate"]["axis"] = "x";
+        val["rotate"]["degrees"] = 90;
+        val["child"] = getFullSourcePath();
+        transformedAlias = val.toStyledString();
+        setAlias(transformedAlias);
+    }
+    void checkCachedResolution() {
+        auto result =
+            common::resolveTreeNode(tree, dummy::getAlias(), cache);
+        ASSERT_TRUE(result.is_initialized());
+        auto expected = common::resolveTreeNode(tree, dummy::getAlias());
+        ASSERT_TRUE(expected.is_initialized());
+        ASSERT_EQ(expected->getDevice(), result->getDevice());
+        ASSERT_EQ(expected->getInterface(), result->getInterface());
+        ASSERT_EQ(expected->getSensor(), result->getSensor());
+        ASSERT_EQ(expected->getTransformJson(), result->getTransformJson());
+    }
+
+    std::string transformedAlias;
+    common::TreeResolutionCache cache;
+};
+
+TEST_F(CachedPathTreeResolution, FirstResolutionMisses) {
+    checkCachedResolution();
+    ASSERT_EQ(0u, cache.getHits());
+    ASSERT_EQ(1u, cache.getMisses());
+}
+
+TEST_F(CachedPathTreeResolution, UnchangedTreeHits) {
+    checkCachedResolution();
+    checkCachedResolution();
+    ASSERT_EQ(1u, cache.getHits());
+}
+
+TEST_F(CachedPathTreeResolution, UnrelatedChangeHits) {
+    checkCachedResolution();
+    tree.getNodeByPath("/me/head",
+                       common::elements::AliasElement(getFullSourcePath()));
+    checkCachedResolution();
+    ASSERT_EQ(1u, cache.getHits());
+}
+
+TEST_F(CachedPathTreeResolution, ReplacedTreeHits) {
+    checkCachedResolution();
+    // Rebuild an identical tree, as a client does on a tree update.
+    tree.reset();
+    dummy::setupDummyDevice(tree);
+    setAlias(transformedAlias);
+    checkCachedResolution();
+    ASSERT_EQ(1u, cache.getHits());
+}
+
+TEST_F(CachedPathTreeResolution, ChangedAliasMisses) {
+    checkCachedResolution();
+    tree.getNodeByPath(dummy::getAlias()).value() =
+        common::elements::AliasElement(getFullSourcePath());
+    checkCachedResolution();
+    ASSERT_EQ(0u, cache.getHits());
+    ASSERT_EQ(2u, cache.getMisses());
+}
+
+TEST_F(CachedPathTreeResolution, ChangedDeviceMisses) {
+    checkCachedResolution();
+    tree.getNodeByPath(dummy::getDevicePath()).value() =
+        common::elements::DeviceElement::createVRPNDeviceElement(
+            dummy::getDevice(), "otherhost:3883");
+    checkCachedResolution();
+    ASSERT_EQ(0u, cache.getHits());
+    auto result = common::resolveTreeNode(tree, dummy::getAlias(), cache);
+    ASSERT_TRUE(result.is_initialized());
+    ASSERT_EQ("otherhost:3883", result->getDeviceElement().getServer());
+}
+
+TEST_F(CachedPathTreeResolution, UnresolvedThenResolved) {
+    tree.reset();
+    setAlias(transformedAlias);
+    ASSERT_FALSE(common::resolveTreeNode(tree, dummy::getAlias(), cache)
+                     .is_initialized());
+    ASSERT_FALSE(common::resolveTreeNode(tree, dummy::getAlias(), cache)
+                     .is_initialized());
+    ASSERT_EQ(1u, cache.getHits());
+
+    dummy::setupDummyDevice(tree);
+    checkCachedResolution();
+}
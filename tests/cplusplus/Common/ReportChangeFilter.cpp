@@ -0,0 +1,151 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/ReportChangeFilter.h>
+#include <osvr/Common/InterfaceCallbacks.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+
+using osvr::common::ReportChangeFilter;
+
+namespace {
+inline OSVR_AnalogReport analog(OSVR_ChannelCount sensor, double state) {
+    OSVR_AnalogReport report;
+    report.sensor = sensor;
+    report.state = state;
+    return report;
+}
+inline OSVR_ButtonReport button(OSVR_ChannelCount sensor,
+                                OSVR_ButtonState state) {
+    OSVR_ButtonReport report;
+    report.sensor = sensor;
+    report.state = state;
+    return report;
+}
+} // namespace
+
+TEST(ReportChangeFilter, DisabledByDefault) {
+    ReportChangeFilter filter;
+    ASSERT_FALSE(filter.isEnabled());
+    ASSERT_TRUE(filter.shouldDeliver(analog(0, 1.)));
+    ASSERT_TRUE(filter.shouldDeliver(analog(0, 1.)));
+    ASSERT_TRUE(filter.shouldDeliver(button(0, OSVR_BUTTON_PRESSED)));
+    ASSERT_TRUE(filter.shouldDeliver(button(0, OSVR_BUTTON_PRESSED)));
+    ASSERT_EQ(0u, filter.getSuppressedCount());
+}
+
+TEST(ReportChangeFilter, ExactEquality) {
+    ReportChangeFilter filter;
+    filter.enable();
+    // First report for each channel always passes.
+    ASSERT_TRUE(filter.shouldDeliver(analog(0, 0.5)));
+    ASSERT_TRUE(filter.shouldDeliver(analog(1, 0.5)));
+    ASSERT_FALSE(filter.shouldDeliver(analog(0, 0.5)));
+    ASSERT_TRUE(filter.shouldDeliver(analog(0, 0.5000001)));
+    ASSERT_FALSE(filter.shouldDeliver(analog(1, 0.5)));
+
+    ASSERT_TRUE(filter.shouldDeliver(button(0, OSVR_BUTTON_NOT_PRESSED)));
+    ASSERT_FALSE(filter.shouldDeliver(button(0, OSVR_BUTTON_NOT_PRESSED)));
+    ASSERT_TRUE(filter.shouldDeliver(button(0, OSVR_BUTTON_PRESSED)));
+    ASSERT_EQ(3u, filter.getSuppressedCount());
+}
+
+TEST(ReportChangeFilter, DeadbandComparesToLastDelivered) {
+    ReportChangeFilter filter;
+    filter.enable(0.1);
+    ASSERT_TRUE(filter.shouldDeliver(analog(0, 0.)));
+    ASSERT_FALSE(filter.shouldDeliver(analog(0, 0.06)));
+    ASSERT_FALSE(filter.shouldDeliver(analog(0, -0.06)));
+    // Slow drift still gets through once it adds up.
+    ASSERT_FALSE(filter.shouldDeliver(analog(0, 0.09)));
+    ASSERT_TRUE(filter.shouldDeliver(analog(0, 0.12)));
+    ASSERT_FALSE(filter.shouldDeliver(analog(0, 0.2)));
+    ASSERT_TRUE(filter.shouldDeliver(analog(0, 0.23)));
+}
+
+TEST(ReportChangeFilter, DisableAndReenableForget) {
+    ReportChangeFilter filter;
+    filter.enable();
+    ASSERT_TRUE(filter.shouldDeliver(analog(3, 1.)));
+    filter.disable();
+    ASSERT_TRUE(filter.shouldDeliver(analog(3, 1.)));
+    filter.enable();
+    ASSERT_TRUE(filter.shouldDeliver(analog(3, 1.)));
+    ASSERT_FALSE(filter.shouldDeliver(analog(3, 1.)));
+}
+
+TEST(ReportChangeFilter, OtherReportTypesPass) {
+    ReportChangeFilter filter;
+    filter.enable();
+    OSVR_PoseReport report = {};
+    ASSERT_TRUE(filter.shouldDeliver(report));
+    ASSERT_TRUE(filter.shouldDeliver(report));
+}
+
+namespace {
+void countCallback(void *userdata, const OSVR_TimeValue *,
+                   const OSVR_AnalogReport *) {
+    ++*static_cast<std::size_t *>(userdata);
+}
+
+/// Feeds a stream of reports from a 32-axis device with one axis moving
+/// through the same filter-then-dispatch sequence the client uses.
+std::size_t simulateGamepad(bool filtered, std::size_t numReports) {
+    static const OSVR_ChannelCount numChannels = 32;
+    std::size_t callbacks = 0;
+    osvr::common::InterfaceCallbacks cbs;
+    cbs.addCallback(&countCallback, &callbacks);
+    ReportChangeFilter filter;
+    if (filtered) {
+        filter.enable();
+    }
+    OSVR_TimeValue timestamp = {};
+    for (std::size_t i = 0; i < numReports; ++i) {
+        for (OSVR_ChannelCount sensor = 0; sensor < numChannels; ++sensor) {
+            auto report =
+                analog(sensor, sensor == 0 ? std::sin(i * 0.01) : 0.);
+            if (filter.shouldDeliver(report)) {
+                cbs.triggerCallbacks(timestamp, report);
+            }
+        }
+    }
+    return callbacks;
+}
+} // namespace
+
+TEST(ReportChangeFilter, GamepadCallbackRate) {
+    static const std::size_t numReports = 1000;
+    auto unfiltered = simulateGamepad(false, numReports);
+    auto filtered = simulateGamepad(true, numReports);
+    ASSERT_EQ(32 * numReports, unfiltered);
+    // One callback per report for the moving axis, plus the first report
+    // of each of the other 31.
+    ASSERT_EQ(numReports + 31, filtered);
+}
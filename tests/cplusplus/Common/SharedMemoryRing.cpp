@@ -0,0 +1,191 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/SharedMemoryRing.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+// Standard includes
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+
+using osvr::common::SharedMemoryRing;
+
+namespace {
+inline bool push(SharedMemoryRing &ring, std::string const &data) {
+    return ring.push(data.data(), data.size());
+}
+
+inline bool pop(SharedMemoryRing &ring, std::string &data) {
+    const char *buf;
+    SharedMemoryRing::size_type len;
+    if (!ring.peek(buf, len)) {
+        return false;
+    }
+    data.assign(buf, len);
+    ring.release();
+    return true;
+}
+} // namespace
+
+TEST(SharedMemoryRing, CreateAndOpen) {
+    auto creator = SharedMemoryRing::create("osvrTestRingOpen", 5, 32);
+    ASSERT_TRUE(creator != nullptr);
+    /// Rounded up to a power of two.
+    ASSERT_EQ(8u, creator->getEntries());
+    ASSERT_EQ(32u, creator->getEntrySize());
+
+    auto opener = SharedMemoryRing::open("osvrTestRingOpen");
+    ASSERT_TRUE(opener != nullptr);
+    ASSERT_EQ(8u, opener->getEntries());
+    ASSERT_EQ(32u, opener->getEntrySize());
+
+    ASSERT_TRUE(push(*creator, "hello"));
+    ASSERT_EQ(1u, opener->size());
+    std::string data;
+    ASSERT_TRUE(pop(*opener, data));
+    ASSERT_EQ("hello", data);
+    ASSERT_EQ(0u, creator->size());
+}
+
+TEST(SharedMemoryRing, OpenMissing) {
+    ASSERT_TRUE(SharedMemoryRing::open("osvrTestRingDoesNotExist") ==
+                nullptr);
+}
+
+TEST(SharedMemoryRing, RemovedWithCreator) {
+    {
+        auto creator = SharedMemoryRing::create("osvrTestRingRemoved", 4, 8);
+        ASSERT_TRUE(creator != nullptr);
+    }
+    ASSERT_TRUE(SharedMemoryRing::open("osvrTestRingRemoved") == nullptr);
+}
+
+TEST(SharedMemoryRing, OrderAndBinaryData) {
+    auto ring = SharedMemoryRing::create("osvrTestRingOrder", 4, 16);
+    ASSERT_TRUE(ring != nullptr);
+    std::string binary("a\0b\0c", 5);
+    std::string data;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(push(*ring, std::to_string(i)));
+        ASSERT_TRUE(push(*ring, binary));
+        ASSERT_TRUE(push(*ring, ""));
+        ASSERT_TRUE(pop(*ring, data));
+        ASSERT_EQ(std::to_string(i), data);
+        ASSERT_TRUE(pop(*ring, data));
+        ASSERT_EQ(binary, data);
+        ASSERT_TRUE(pop(*ring, data));
+        ASSERT_TRUE(data.empty());
+        ASSERT_FALSE(pop(*ring, data));
+    }
+    ASSERT_EQ(0u, ring->getDroppedCount());
+}
+
+TEST(SharedMemoryRing, FullAndOversizedPushesAreDropped) {
+    auto ring = SharedMemoryRing::create("osvrTestRingFull", 2, 4);
+    ASSERT_TRUE(ring != nullptr);
+    ASSERT_FALSE(push(*ring, "toolong"));
+    ASSERT_EQ(1u, ring->getDroppedCount());
+
+    ASSERT_TRUE(push(*ring, "1"));
+    ASSERT_TRUE(push(*ring, "2"));
+    ASSERT_FALSE(push(*ring, "3"));
+    ASSERT_EQ(2u, ring->getDroppedCount());
+    ASSERT_EQ(2u, ring->size());
+
+    /// Nothing queued was overwritten.
+    std::string data;
+    ASSERT_TRUE(pop(*ring, data));
+    ASSERT_EQ("1", data);
+    ASSERT_TRUE(push(*ring, "4"));
+    ASSERT_TRUE(pop(*ring, data));
+    ASSERT_EQ("2", data);
+    ASSERT_TRUE(pop(*ring, data));
+    ASSERT_EQ("4", data);
+}
+
+TEST(SharedMemoryRing, ProducerConsumerThreads) {
+    auto ring = SharedMemoryRing::create("osvrTestRingThreads", 16, 16);
+    ASSERT_TRUE(ring != nullptr);
+    auto producerRing = SharedMemoryRing::open("osvrTestRingThreads");
+    ASSERT_TRUE(producerRing != nullptr);
+
+    static const int COUNT = 100000;
+    std::thread producer([&] {
+        for (int i = 0; i < COUNT; ++i) {
+            auto data = std::to_string(i);
+            while (!producerRing->push(data.data(), data.size())) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    std::string data;
+    for (int i = 0; i < COUNT; ++i) {
+        while (!pop(*ring, data)) {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(std::to_string(i), data);
+    }
+    producer.join();
+    ASSERT_EQ(0u, ring->size());
+}
+
+TEST(SharedMemoryRing, IgnoresHeaderRewrittenByPeer) {
+    namespace bip = boost::interprocess;
+    auto ring = SharedMemoryRing::create("osvrTestRingHostile", 4, 8);
+    ASSERT_TRUE(ring != nullptr);
+    auto peer = SharedMemoryRing::open("osvrTestRingHostile");
+    ASSERT_TRUE(peer != nullptr);
+    ASSERT_TRUE(push(*peer, "12345678"));
+
+    /// The other process scribbles on the entries and entrySize fields (after
+    /// the magic number and version), and on the queued slot's length (the
+    /// slots start on the first cache line after the header).
+    bip::shared_memory_object shm{bip::open_only, "osvrTestRingHostile",
+                                  bip::read_write};
+    bip::mapped_region region{shm, bip::read_write};
+    auto base = static_cast<char *>(region.get_address());
+    const std::uint32_t huge = 0xffffffff;
+    std::memcpy(base + 2 * sizeof(std::uint32_t), &huge, sizeof(huge));
+    std::memcpy(base + 3 * sizeof(std::uint32_t), &huge, sizeof(huge));
+    std::memcpy(base + 64, &huge, sizeof(huge));
+
+    ASSERT_EQ(4u, ring->getEntries());
+    ASSERT_EQ(8u, ring->getEntrySize());
+    std::string data;
+    ASSERT_TRUE(pop(*ring, data));
+    ASSERT_EQ("12345678", data);
+    ASSERT_FALSE(push(*peer, "123456789"));
+    ASSERT_EQ(1u, peer->getDroppedCount());
+
+    /// A ring whose header claims more than the segment holds won't open.
+    ASSERT_TRUE(SharedMemoryRing::open("osvrTestRingHostile") == nullptr);
+}
@@ -0,0 +1,172 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/StreamingMessageQueue.h>
+#include <osvr/Common/MessageRegistration.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <string>
+#include <vector>
+
+using osvr::common::StreamingMessageQueue;
+using osvr::common::RawMessageType;
+namespace delivery = osvr::common::delivery;
+
+namespace {
+struct Sent {
+    std::string data;
+    RawMessageType::UnderlyingMessageType msgType;
+    OSVR_TimeValue_Seconds seconds;
+};
+
+inline osvr::util::time::TimeValue makeTime(OSVR_TimeValue_Seconds seconds) {
+    osvr::util::time::TimeValue ret;
+    ret.seconds = seconds;
+    ret.microseconds = 0;
+    return ret;
+}
+
+inline void push(StreamingMessageQueue &queue, RawMessageType msgType,
+                 OSVR_ChannelCount sensor, OSVR_TimeValue_Seconds seconds,
+                 std::string const &data) {
+    queue.push(msgType, sensor, makeTime(seconds), data.data(), data.size(),
+               0);
+}
+
+inline std::vector<Sent> flush(StreamingMessageQueue &queue) {
+    std::vector<Sent> ret;
+    queue.flush([&](size_t len, const char *data,
+                    RawMessageType const &msgType,
+                    osvr::util::time::TimeValue const &timestamp, uint32_t) {
+        ret.push_back(
+            Sent{std::string(data, len), msgType.get(), timestamp.seconds});
+    });
+    return ret;
+}
+
+class SimpleMessage
+    : public osvr::common::MessageRegistration<SimpleMessage> {
+  public:
+    static const char *identifier() { return "simple"; }
+};
+class SampleMessage
+    : public osvr::common::MessageRegistration<SampleMessage> {
+  public:
+    typedef delivery::Streaming delivery_type;
+    static const char *identifier() { return "sample"; }
+};
+} // namespace
+
+TEST(MessageDelivery, DefaultsToReliable) {
+    ASSERT_FALSE(SimpleMessage::delivery_type::latest_wins);
+    ASSERT_TRUE(SampleMessage::delivery_type::latest_wins);
+}
+
+TEST(StreamingMessageQueue, StartsEmpty) {
+    StreamingMessageQueue queue;
+    ASSERT_TRUE(queue.empty());
+    ASSERT_EQ(0u, queue.size());
+    ASSERT_TRUE(flush(queue).empty());
+}
+
+TEST(StreamingMessageQueue, NewerSampleSupersedesPending) {
+    StreamingMessageQueue queue;
+    const RawMessageType msgType(5);
+    push(queue, msgType, 0, 1, "first");
+    push(queue, msgType, 0, 2, "second");
+    push(queue, msgType, 0, 3, "third");
+    ASSERT_EQ(1u, queue.size());
+    ASSERT_EQ(2u, queue.getSupersededCount());
+
+    auto sent = flush(queue);
+    ASSERT_EQ(1u, sent.size());
+    ASSERT_EQ("third", sent[0].data);
+    ASSERT_EQ(3, sent[0].seconds);
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(StreamingMessageQueue, SensorsAndTypesAreIndependent) {
+    StreamingMessageQueue queue;
+    const RawMessageType typeA(5);
+    const RawMessageType typeB(6);
+    push(queue, typeA, 0, 1, "a0");
+    push(queue, typeA, 1, 1, "a1");
+    push(queue, typeB, 0, 1, "b0");
+    ASSERT_EQ(3u, queue.size());
+    ASSERT_EQ(0u, queue.getSupersededCount());
+
+    auto sent = flush(queue);
+    ASSERT_EQ(3u, sent.size());
+    ASSERT_EQ("a0", sent[0].data);
+    ASSERT_EQ("a1", sent[1].data);
+    ASSERT_EQ("b0", sent[2].data);
+    ASSERT_EQ(typeB.get(), sent[2].msgType);
+}
+
+TEST(StreamingMessageQueue, FlushedSamplesAreNotResent) {
+    StreamingMessageQueue queue;
+    const RawMessageType typeA(5);
+    const RawMessageType typeB(6);
+    push(queue, typeA, 0, 1, "a");
+    push(queue, typeB, 0, 1, "b");
+    ASSERT_EQ(2u, flush(queue).size());
+
+    push(queue, typeB, 0, 2, "b2");
+    ASSERT_EQ(0u, queue.getSupersededCount());
+    auto sent = flush(queue);
+    ASSERT_EQ(1u, sent.size());
+    ASSERT_EQ("b2", sent[0].data);
+    ASSERT_TRUE(flush(queue).empty());
+}
+
+TEST(StreamingMessageQueue, FlushesInPushOrder) {
+    StreamingMessageQueue queue;
+    const RawMessageType notification(5);
+    const RawMessageType data(6);
+    // The first message ever seen is a notification, so its slot comes
+    // first: the data pushed before the next notification must still be
+    // sent ahead of it.
+    push(queue, notification, 0, 1, "n1");
+    ASSERT_EQ(1u, flush(queue).size());
+
+    push(queue, data, 0, 2, "d2");
+    push(queue, notification, 0, 2, "n2");
+    auto sent = flush(queue);
+    ASSERT_EQ(2u, sent.size());
+    ASSERT_EQ("d2", sent[0].data);
+    ASSERT_EQ("n2", sent[1].data);
+
+    // A superseding push moves to the back of the line.
+    push(queue, data, 0, 3, "d3");
+    push(queue, notification, 0, 3, "n3");
+    push(queue, data, 0, 4, "d4");
+    sent = flush(queue);
+    ASSERT_EQ(2u, sent.size());
+    ASSERT_EQ("n3", sent[0].data);
+    ASSERT_EQ("d4", sent[1].data);
+}
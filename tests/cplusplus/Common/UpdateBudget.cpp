@@ -0,0 +1,361 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/ClientContext.h>
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/PathTree.h>
+#include <osvr/Common/Transform.h>
+#include <osvr/Util/ClientCallbackTypesC.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+/// Number of reports in each burst
+static const int BURST_SIZE = 200;
+/// How long each callback takes
+static const std::chrono::microseconds CALLBACK_TIME(200);
+
+/// A context whose "incoming data" is a burst of reports delivered to every
+/// interface, the first time it's updated: m_sendReports() is called for each
+/// step of the burst.
+class BurstContextBase : public ::OSVR_ClientContextObject {
+  public:
+    BurstContextBase(const char appId[],
+                     osvr::common::ClientContextDeleter del)
+        : ::OSVR_ClientContextObject(appId, del) {}
+
+  protected:
+    template <typename ReportType>
+    void m_deliver(int step, ReportType const &report) {
+        OSVR_TimeValue timestamp = {step, 0};
+        for (auto const &iface : getInterfaces()) {
+            iface->setState(timestamp, report);
+            iface->triggerCallbacks(timestamp, report);
+        }
+    }
+
+  private:
+    virtual void m_sendReports(int step) = 0;
+
+    void m_update() override {
+        if (m_burstSent) {
+            return;
+        }
+        m_burstSent = true;
+        for (int i = 1; i <= BURST_SIZE; ++i) {
+            m_sendReports(i);
+        }
+    }
+    void m_sendRoute(std::string const &) override {}
+    osvr::common::PathTree const &m_getPathTree() const override {
+        return m_pathTree;
+    }
+    osvr::common::Transform const &m_getRoomToWorldTransform() const override {
+        return m_roomToWorld;
+    }
+    void m_setRoomToWorldTransform(
+        osvr::common::Transform const &xform) override {
+        m_roomToWorld = xform;
+    }
+
+    bool m_burstSent = false;
+    osvr::common::PathTree m_pathTree;
+    osvr::common::Transform m_roomToWorld;
+};
+
+/// A burst of analog reports on one sensor.
+class BurstContext : public BurstContextBase {
+  public:
+    BurstContext(const char appId[], osvr::common::ClientContextDeleter del)
+        : BurstContextBase(appId, del) {}
+
+  private:
+    void m_sendReports(int step) override {
+        OSVR_AnalogReport report;
+        report.sensor = 0;
+        report.state = step;
+        m_deliver(step, report);
+    }
+};
+
+/// A burst of analog reports on two sensors, along with button presses and
+/// releases.
+class MixedBurstContext : public BurstContextBase {
+  public:
+    MixedBurstContext(const char appId[],
+                      osvr::common::ClientContextDeleter del)
+        : BurstContextBase(appId, del) {}
+
+  private:
+    void m_sendReports(int step) override {
+        for (int32_t sensor = 0; sensor < 2; ++sensor) {
+            OSVR_AnalogReport report;
+            report.sensor = sensor;
+            report.state = step;
+            m_deliver(step, report);
+        }
+        OSVR_ButtonReport report;
+        report.sensor = 0;
+        report.state = (step % 2 == 1) ? OSVR_BUTTON_PRESSED
+                                       : OSVR_BUTTON_NOT_PRESSED;
+        m_deliver(step, report);
+    }
+};
+
+/// Number of reports that arrive while waiting for data
+static const int WAIT_REPORTS = 3;
+
+/// A context where WAIT_REPORTS analog reports arrive while waiting for data,
+/// before the burst: it logs a 0 when the wait ends, and the reports have
+/// states 1, 2, ... in the order they arrive.
+class WaitContext : public BurstContextBase {
+  public:
+    WaitContext(const char appId[], osvr::common::ClientContextDeleter del)
+        : BurstContextBase(appId, del) {}
+
+    std::vector<double> *log = nullptr;
+
+  protected:
+    void m_waitForData(osvr::util::time::TimeValue const &) override {
+        for (int i = 1; i <= WAIT_REPORTS; ++i) {
+            m_deliverAnalog(i);
+        }
+        log->push_back(0);
+    }
+
+  private:
+    void m_sendReports(int step) override {
+        m_deliverAnalog(WAIT_REPORTS + step);
+    }
+    void m_deliverAnalog(int state) {
+        OSVR_AnalogReport report;
+        report.sensor = 0;
+        report.state = state;
+        m_deliver(state, report);
+    }
+};
+
+struct Received {
+    int count = 0;
+    double last = 0;
+};
+
+/// A callback that takes a while.
+void slowCallback(void *userdata, const OSVR_TimeValue *,
+                  const OSVR_AnalogReport *report) {
+    auto &received = *static_cast<Received *>(userdata);
+    received.count++;
+    received.last = report->state;
+    std::this_thread::sleep_for(CALLBACK_TIME);
+}
+
+/// Analog reports received, by sensor.
+struct ReceivedBySensor {
+    Received sensors[2];
+};
+
+/// A slow analog callback that keeps track of sensors separately.
+void slowSensorCallback(void *userdata, const OSVR_TimeValue *,
+                        const OSVR_AnalogReport *report) {
+    auto &received = static_cast<ReceivedBySensor *>(userdata)
+                         ->sensors[report->sensor];
+    received.count++;
+    received.last = report->state;
+    std::this_thread::sleep_for(CALLBACK_TIME);
+}
+
+/// A quick button callback that records every state it gets, in order.
+void buttonCallback(void *userdata, const OSVR_TimeValue *,
+                    const OSVR_ButtonReport *report) {
+    static_cast<std::vector<OSVR_ButtonState> *>(userdata)->push_back(
+        report->state);
+}
+
+/// A quick analog callback that records every state it gets, in order.
+void analogLogCallback(void *userdata, const OSVR_TimeValue *,
+                       const OSVR_AnalogReport *report) {
+    static_cast<std::vector<double> *>(userdata)->push_back(report->state);
+}
+
+inline osvr::util::time::TimeValue microseconds(int usec) {
+    osvr::util::time::TimeValue ret;
+    ret.seconds = 0;
+    ret.microseconds = usec;
+    return ret;
+}
+
+class UpdateBudget : public ::testing::Test {
+  public:
+    UpdateBudget()
+        : ctx(osvr::common::wrapSharedContext(
+              osvr::common::makeContext<BurstContext>("org.osvr.test"))) {
+        iface = ctx->getInterface("/test/analog");
+        iface->registerCallback(&slowCallback, &received);
+    }
+    osvr::common::ClientContextSharedPtr ctx;
+    osvr::common::ClientInterfacePtr iface;
+    Received received;
+};
+
+class MixedUpdateBudget : public ::testing::Test {
+  public:
+    MixedUpdateBudget()
+        : ctx(osvr::common::wrapSharedContext(
+              osvr::common::makeContext<MixedBurstContext>("org.osvr.test"))) {
+        iface = ctx->getInterface("/test/mixed");
+        iface->registerCallback(&slowSensorCallback, &analog);
+        iface->registerCallback(&buttonCallback, &buttons);
+    }
+    osvr::common::ClientContextSharedPtr ctx;
+    osvr::common::ClientInterfacePtr iface;
+    ReceivedBySensor analog;
+    std::vector<OSVR_ButtonState> buttons;
+};
+} // namespace
+
+TEST_F(UpdateBudget, UnbudgetedUpdateDeliversEverything) {
+    ctx->update();
+    ASSERT_EQ(BURST_SIZE, received.count);
+    ASSERT_EQ(BURST_SIZE, received.last);
+    ASSERT_EQ(0u, ctx->getDeferredReportCount());
+}
+
+TEST_F(UpdateBudget, ReturnsWithinBudget) {
+    static const int BUDGET_USEC = 2000;
+    auto begin = std::chrono::steady_clock::now();
+    ctx->updateWithBudget(microseconds(BUDGET_USEC));
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    // One callback may start just before the deadline; the rest is slack for
+    // sleep imprecision, still well short of the unbudgeted time.
+    auto allowed = std::chrono::microseconds(BUDGET_USEC) + CALLBACK_TIME +
+                   std::chrono::milliseconds(10);
+    ASSERT_LT(elapsed, allowed);
+    ASSERT_LT(allowed, CALLBACK_TIME * BURST_SIZE);
+
+    ASSERT_LT(received.count, BURST_SIZE);
+    ASSERT_GT(ctx->getDeferredReportCount(), 0u);
+    ASSERT_GT(ctx->getCoalescedReportCount(), 0u);
+
+    // State isn't subject to the budget.
+    OSVR_TimeValue timestamp;
+    OSVR_AnalogState state;
+    ASSERT_TRUE(iface->getState<OSVR_AnalogReport>(timestamp, state));
+    ASSERT_EQ(BURST_SIZE, state);
+}
+
+TEST_F(UpdateBudget, ResumesWithNewestReport) {
+    ctx->updateWithBudget(microseconds(1000));
+    auto countAfterFirst = received.count;
+    ASSERT_LT(countAfterFirst, BURST_SIZE);
+
+    ctx->updateWithBudget(microseconds(1000));
+    // All the deferred reports were coalesced into one delivery.
+    ASSERT_EQ(countAfterFirst + 1, received.count);
+    ASSERT_EQ(BURST_SIZE, received.last);
+
+    // Nothing left over.
+    ctx->update();
+    ASSERT_EQ(countAfterFirst + 1, received.count);
+}
+
+TEST_F(MixedUpdateBudget, CoalescesPerSensor) {
+    ctx->updateWithBudget(microseconds(1000));
+    int countsAfterFirst[2];
+    for (int sensor = 0; sensor < 2; ++sensor) {
+        countsAfterFirst[sensor] = analog.sensors[sensor].count;
+        ASSERT_LT(countsAfterFirst[sensor], BURST_SIZE);
+    }
+    ASSERT_GT(ctx->getCoalescedReportCount(), 0u);
+
+    ctx->update();
+    // Each sensor got exactly one delivery of its own newest report.
+    for (int sensor = 0; sensor < 2; ++sensor) {
+        ASSERT_EQ(countsAfterFirst[sensor] + 1, analog.sensors[sensor].count)
+            << "sensor " << sensor;
+        ASSERT_EQ(BURST_SIZE, analog.sensors[sensor].last) << "sensor "
+                                                            << sensor;
+    }
+}
+
+TEST_F(MixedUpdateBudget, KeepsEveryButtonReportInOrder) {
+    ctx->updateWithBudget(microseconds(1000));
+    ASSERT_LT(buttons.size(), std::size_t(BURST_SIZE));
+
+    // Everything deferred gets delivered, with no presses or releases lost.
+    ctx->update();
+    ASSERT_EQ(std::size_t(BURST_SIZE), buttons.size());
+    for (int i = 1; i <= BURST_SIZE; ++i) {
+        OSVR_ButtonState expected =
+            (i % 2 == 1) ? OSVR_BUTTON_PRESSED : OSVR_BUTTON_NOT_PRESSED;
+        ASSERT_EQ(expected, buttons[i - 1]) << "button report " << i;
+    }
+}
+
+TEST(UpdateBlocking, DeliversCallbacksInOrderAfterWaiting) {
+    auto ctx = osvr::common::makeContext<WaitContext>("org.osvr.test");
+    auto shared = osvr::common::wrapSharedContext(ctx);
+    std::vector<double> log;
+    ctx->log = &log;
+    auto iface = shared->getInterface("/test/analog");
+    iface->registerCallback(&analogLogCallback, &log);
+
+    shared->update(microseconds(1000));
+
+    // Nothing was dispatched during the wait, then everything arrived in
+    // order.
+    ASSERT_EQ(std::size_t(1 + WAIT_REPORTS + BURST_SIZE), log.size());
+    ASSERT_EQ(0, log[0]);
+    for (int i = 1; i <= WAIT_REPORTS + BURST_SIZE; ++i) {
+        ASSERT_EQ(i, log[i]) << "report " << i;
+    }
+    ASSERT_EQ(0u, shared->getDeferredReportCount());
+}
+
+TEST_F(UpdateBudget, BlockingUpdateDoesNotWaitWithDeferredCallbacks) {
+    ctx->updateWithBudget(microseconds(1000));
+    auto countAfterFirst = received.count;
+    ASSERT_LT(countAfterFirst, BURST_SIZE);
+
+    // The default wait would sleep for all of maxWait; with callbacks
+    // already pending, there's no waiting, just delivery.
+    static const std::chrono::seconds MAX_WAIT(10);
+    osvr::util::time::TimeValue maxWait;
+    maxWait.seconds = MAX_WAIT.count();
+    maxWait.microseconds = 0;
+    auto begin = std::chrono::steady_clock::now();
+    ctx->update(maxWait);
+    ASSERT_LT(std::chrono::steady_clock::now() - begin, MAX_WAIT);
+    ASSERT_EQ(countAfterFirst + 1, received.count);
+    ASSERT_EQ(BURST_SIZE, received.last);
+}
@@ -0,0 +1,147 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Connection/DeviceUpdateStats.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using osvr::connection::ConnectionDevice;
+using osvr::connection::DeviceUpdateStats;
+using std::chrono::microseconds;
+
+TEST(DeviceUpdateStats, Buckets) {
+    EXPECT_EQ(0u, DeviceUpdateStats::getBucket(0));
+    EXPECT_EQ(0u, DeviceUpdateStats::getBucket(999));
+    EXPECT_EQ(1u, DeviceUpdateStats::getBucket(1000));
+    EXPECT_EQ(1u, DeviceUpdateStats::getBucket(1999));
+    EXPECT_EQ(2u, DeviceUpdateStats::getBucket(2000));
+    EXPECT_EQ(11u, DeviceUpdateStats::getBucket(1024 * 1000));
+    EXPECT_EQ(DeviceUpdateStats::NUM_BUCKETS - 1,
+              DeviceUpdateStats::getBucket(uint64_t(1) << 62));
+    for (std::size_t i = 0; i + 1 < DeviceUpdateStats::NUM_BUCKETS; ++i) {
+        auto bound = DeviceUpdateStats::getBucketUpperBoundMicroseconds(i);
+        EXPECT_EQ(i, DeviceUpdateStats::getBucket(bound * 1000 - 1));
+        EXPECT_EQ(i + 1, DeviceUpdateStats::getBucket(bound * 1000));
+    }
+}
+
+TEST(DeviceUpdateStats, Recording) {
+    DeviceUpdateStats stats;
+    stats.recordUpdate(microseconds(3));
+    stats.recordUpdate(microseconds(5));
+    stats.recordUpdate(microseconds(100));
+    stats.recordMessages(2, 64);
+    stats.recordMessages(1, 8);
+    EXPECT_EQ(3u, stats.getUpdateCount());
+    EXPECT_EQ(100000u, stats.getMaxNanoseconds());
+    EXPECT_EQ(100000u, stats.getLastNanoseconds());
+    EXPECT_DOUBLE_EQ(36000., stats.getMeanNanoseconds());
+    EXPECT_EQ(3u, stats.getMessageCount());
+    EXPECT_EQ(72u, stats.getByteCount());
+    auto const &hist = stats.getHistogram();
+    EXPECT_EQ(2u, hist[DeviceUpdateStats::getBucket(3000)] +
+                      hist[DeviceUpdateStats::getBucket(5000)]);
+    EXPECT_EQ(1u, hist[DeviceUpdateStats::getBucket(100000)]);
+    EXPECT_EQ(1u, stats.recordSlowUpdate());
+    EXPECT_EQ(2u, stats.recordSlowUpdate());
+
+    stats.reset();
+    EXPECT_EQ(0u, stats.getUpdateCount());
+    EXPECT_EQ(0u, stats.getSlowUpdateCount());
+    EXPECT_EQ(0., stats.getMeanNanoseconds());
+    for (auto count : stats.getHistogram()) {
+        EXPECT_EQ(0u, count);
+    }
+}
+
+namespace {
+/// Device whose update does a fixed amount of busy work.
+class DummyDevice : public ConnectionDevice {
+  public:
+    DummyDevice(std::string const &name, int work)
+        : ConnectionDevice(name), m_work(work) {}
+
+    void doWork() {
+        for (int i = 0; i < m_work; ++i) {
+            m_sink = m_sink * 31 + i;
+        }
+    }
+
+  protected:
+    void m_process() override { doWork(); }
+    void m_sendData(osvr::util::time::TimeValue const &,
+                    osvr::connection::MessageType *, const char *,
+                    size_t) override {}
+
+  private:
+    int m_work;
+    volatile unsigned m_sink = 0;
+};
+} // namespace
+
+TEST(DeviceUpdateStats, ProcessIsTimed) {
+    DummyDevice dev("com_osvr_Test/Dummy", 100);
+    for (int i = 0; i < 10; ++i) {
+        dev.process();
+    }
+    auto const &stats = dev.getUpdateStats();
+    EXPECT_EQ(10u, stats.getUpdateCount());
+    EXPECT_GT(stats.getTotalNanoseconds(), 0u);
+    EXPECT_GE(stats.getMaxNanoseconds(), stats.getLastNanoseconds());
+}
+
+TEST(DeviceUpdateStats, EachDeviceCountsItsOwnUpdates) {
+    static const int NUM_DEVICES = 50;
+    static const int LOOPS = 20;
+    std::vector<std::unique_ptr<DummyDevice> > devices;
+    for (int i = 0; i < NUM_DEVICES; ++i) {
+        devices.emplace_back(
+            new DummyDevice("com_osvr_Test/Dummy" + std::to_string(i), 10));
+    }
+    for (int loop = 0; loop < LOOPS; ++loop) {
+        for (int i = 0; i < NUM_DEVICES; ++i) {
+            // Device i is only updated on the first i + 1 passes, so the
+            // devices end up with different counts.
+            if (loop <= i) {
+                devices[i]->process();
+            }
+        }
+    }
+    for (int i = 0; i < NUM_DEVICES; ++i) {
+        EXPECT_EQ(uint64_t(std::min(i + 1, LOOPS)),
+                  devices[i]->getUpdateStats().getUpdateCount())
+            << "device " << i;
+    }
+}
@@ -0,0 +1,172 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Kalman/FlexibleKalmanFilter.h>
+#include <osvr/Kalman/PoseSeparatelyDampedConstantVelocity.h>
+#include <osvr/Kalman/AbsolutePositionMeasurement.h>
+#include <osvr/Kalman/InnovationAdaptiveNoise.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+#include <random>
+
+using ProcessModel =
+    osvr::kalman::PoseSeparatelyDampedConstantVelocityProcessModel;
+using State = ProcessModel::State;
+using AbsolutePositionMeasurement =
+    osvr::kalman::AbsolutePositionMeasurement<State>;
+using osvr::kalman::InnovationAdaptiveNoiseScale;
+
+TEST(InnovationAdaptiveNoiseScale, StartsAtOne) {
+    InnovationAdaptiveNoiseScale scale;
+    ASSERT_EQ(1., scale.getScale());
+    ASSERT_EQ(0u, scale.getCount());
+}
+
+TEST(InnovationAdaptiveNoiseScale, Bounded) {
+    InnovationAdaptiveNoiseScale scale(10, 0.25, 4.);
+    for (int i = 0; i < 1000; ++i) {
+        scale.addInnovation(1e6, 3);
+    }
+    ASSERT_NEAR(4., scale.getScale(), 1e-9);
+    for (int i = 0; i < 1000; ++i) {
+        scale.addInnovation(0, 3);
+    }
+    ASSERT_NEAR(0.25, scale.getScale(), 1e-9);
+    scale.reset();
+    ASSERT_EQ(1., scale.getScale());
+}
+
+TEST(InnovationAdaptiveNoiseScale, IgnoresInvalid) {
+    InnovationAdaptiveNoiseScale scale;
+    scale.addInnovation(std::nan(""), 2);
+    scale.addInnovation(-1, 2);
+    scale.addInnovation(5, 0);
+    ASSERT_EQ(0u, scale.getCount());
+    ASSERT_EQ(1., scale.getScale());
+}
+
+TEST(InnovationAdaptiveNoiseScale, ConsistentInnovationsKeepScaleNearOne) {
+    std::mt19937 engine(1234);
+    std::chi_squared_distribution<double> chi2(2);
+    InnovationAdaptiveNoiseScale scale;
+    for (int i = 0; i < 5000; ++i) {
+        scale.addInnovation(chi2(engine), 2);
+    }
+    ASSERT_GT(scale.getScale(), 0.5);
+    ASSERT_LT(scale.getScale(), 2.);
+    ASSERT_NEAR(1., scale.getMeanNormalizedInnovation(), 0.5);
+}
+
+TEST(KalmanCorrect, ReturnsNormalizedInnovationSquared) {
+    ProcessModel model;
+    State state;
+    state.setErrorCovariance(
+        osvr::kalman::types::DimVector<State>::Constant(1).asDiagonal());
+    const Eigen::Vector3d variance = Eigen::Vector3d::Constant(3);
+    AbsolutePositionMeasurement meas{Eigen::Vector3d(2, 0, 4), variance};
+    // S is 4 I, so NIS is (2^2 + 4^2) / 4
+    ASSERT_NEAR(5., osvr::kalman::correct(state, model, meas), 1e-9);
+}
+
+namespace {
+struct TrackingResults {
+    /// RMS frame-to-frame change in estimated position while at rest.
+    double jitter;
+    /// RMS position error while moving.
+    double motionError;
+};
+
+/// Simulates a body at rest for a few seconds, then swinging sinusoidally,
+/// observed by noisy position measurements at 60Hz.
+TrackingResults simulate(bool adaptive, double positionNoise) {
+    static const double dt = 1. / 60.;
+    static const int restSteps = 600;
+    static const int motionSteps = 600;
+    static const double measurementStdDev = 2e-3;
+    static const double amplitude = 0.2;
+    static const double frequency = 1.;
+    static const double pi = 3.14159265358979323846;
+
+    std::mt19937 engine(5678);
+    std::normal_distribution<double> noise(0, measurementStdDev);
+    const Eigen::Vector3d variance =
+        Eigen::Vector3d::Constant(measurementStdDev * measurementStdDev);
+
+    ProcessModel model(0.8, 0.9, positionNoise, 1.);
+    InnovationAdaptiveNoiseScale scale(50, 0.1, 10.);
+    State state;
+    state.setErrorCovariance(
+        osvr::kalman::types::DimVector<State>::Constant(1).asDiagonal());
+
+    double jitterSum = 0;
+    int jitterCount = 0;
+    double errorSum = 0;
+    int errorCount = 0;
+    Eigen::Vector3d prev = Eigen::Vector3d::Zero();
+    for (int i = 0; i < restSteps + motionSteps; ++i) {
+        Eigen::Vector3d truth = Eigen::Vector3d::Zero();
+        if (i >= restSteps) {
+            const double t = (i - restSteps) * dt;
+            truth.x() = amplitude * std::sin(2 * pi * frequency * t);
+        }
+        osvr::kalman::predict(state, model, dt);
+        state.externalizeRotation();
+        Eigen::Vector3d measured =
+            truth + Eigen::Vector3d(noise(engine), noise(engine), noise(engine));
+        AbsolutePositionMeasurement meas{measured, variance};
+        auto nis = osvr::kalman::correct(state, model, meas);
+        if (adaptive) {
+            scale.addInnovation(nis, 3);
+            model.setNoiseScale(scale.getScale(), 1);
+        }
+        const Eigen::Vector3d estimate = state.position();
+        // Skip the initial convergence in each phase.
+        if (i >= restSteps / 2 && i < restSteps) {
+            jitterSum += (estimate - prev).squaredNorm();
+            ++jitterCount;
+        } else if (i >= restSteps + 60) {
+            errorSum += (estimate - truth).squaredNorm();
+            ++errorCount;
+        }
+        prev = estimate;
+    }
+    return TrackingResults{std::sqrt(jitterSum / jitterCount),
+                           std::sqrt(errorSum / errorCount)};
+}
+} // namespace
+
+TEST(AdaptiveProcessNoise, LessJitterAtRestLessLagInMotion) {
+    static const double nominalNoise = 3e-2;
+    auto fixedNominal = simulate(false, nominalNoise);
+    auto fixedSmooth = simulate(false, nominalNoise * 0.1);
+    auto adaptive = simulate(true, nominalNoise);
+    ASSERT_LT(adaptive.jitter, fixedNominal.jitter);
+    ASSERT_LT(adaptive.motionError, fixedSmooth.motionError);
+}
@@ -0,0 +1,122 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Kalman/DampingAttenuation.h>
+#include <osvr/Kalman/PoseSeparatelyDampedConstantVelocity.h>
+#include <osvr/Kalman/PoseDampedConstantVelocity.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+#include <random>
+
+using osvr::kalman::DampingAttenuation;
+namespace pose = osvr::kalman::pose_externalized_rotation;
+
+/// exp(log(d) * dt) and pow(d, dt) differ only by rounding.
+static const double Tolerance = 1e-12;
+
+TEST(DampingAttenuation, MatchesPow) {
+    for (double damping : {0.001, 0.01, 0.2, 0.3, 0.5, 0.9, 0.999, 2.}) {
+        DampingAttenuation attenuation(damping);
+        ASSERT_EQ(damping, attenuation.getDamping());
+        for (double dt : {0., 1e-4, 1. / 400., 1. / 100., 1. / 60., 0.1, 1.,
+                          3.5}) {
+            auto expected = std::pow(damping, dt);
+            ASSERT_NEAR(expected, attenuation(dt), expected * Tolerance)
+                << "damping " << damping << ", dt " << dt;
+        }
+    }
+}
+
+TEST(DampingAttenuation, RepeatedDtReusesResult) {
+    DampingAttenuation attenuation(0.2);
+    auto first = attenuation(1. / 400.);
+    ASSERT_EQ(first, attenuation(1. / 400.));
+    ASSERT_NE(first, attenuation(1. / 60.));
+    ASSERT_EQ(first, attenuation(1. / 400.));
+    ASSERT_EQ(1., attenuation(0.));
+}
+
+TEST(DampingAttenuation, SetDampingInvalidatesCache) {
+    DampingAttenuation attenuation(0.2);
+    auto dt = 1. / 400.;
+    attenuation(dt);
+    attenuation.setDamping(0.5);
+    ASSERT_NEAR(std::pow(0.5, dt), attenuation(dt), Tolerance);
+}
+
+TEST(DampingAttenuation, SeparatelyDampedModelMatchesPow) {
+    auto posDamping = 0.3;
+    auto oriDamping = 0.01;
+    osvr::kalman::PoseSeparatelyDampedConstantVelocityProcessModel model(
+        posDamping, oriDamping);
+    std::mt19937 engine(1234);
+    std::uniform_real_distribution<double> values(-2., 2.);
+    std::uniform_real_distribution<double> dts(0., 0.05);
+    pose::State state;
+    for (int i = 0; i < 100; ++i) {
+        pose::StateVector x;
+        for (int j = 0; j < x.size(); ++j) {
+            x[j] = values(engine);
+        }
+        state.setStateVector(x);
+        /// Exercise the repeated-dt path half of the time.
+        auto dt = (i % 2) ? 1. / 400. : dts(engine);
+
+        pose::StateVector expected = pose::applyVelocity(x, dt);
+        pose::separatelyDampenVelocities(expected, posDamping, oriDamping,
+                                         dt);
+        ASSERT_TRUE(expected.isApprox(model.computeEstimate(state, dt),
+                                      Tolerance));
+
+        ASSERT_TRUE(
+            pose::stateTransitionMatrixWithSeparateVelocityDamping(
+                dt, posDamping, oriDamping)
+                .isApprox(model.getStateTransitionMatrix(state, dt),
+                          Tolerance));
+    }
+}
+
+TEST(DampingAttenuation, DampedModelMatchesPow) {
+    auto damping = 0.1;
+    osvr::kalman::PoseDampedConstantVelocityProcessModel model(damping);
+    pose::State state;
+    pose::StateVector x;
+    x << 1, 2, 3, 0.1, 0.2, 0.3, 4, 5, 6, 0.7, 0.8, 0.9;
+    state.setStateVector(x);
+    for (double dt : {1. / 400., 1. / 400., 1. / 60., 0.}) {
+        pose::StateVector expected = pose::applyVelocity(x, dt);
+        pose::dampenVelocities(expected, damping, dt);
+        ASSERT_TRUE(expected.isApprox(model.computeEstimate(state, dt),
+                                      Tolerance));
+        ASSERT_TRUE(
+            pose::stateTransitionMatrixWithVelocityDamping(dt, damping)
+                .isApprox(model.getStateTransitionMatrix(state, dt),
+                          Tolerance));
+    }
+}
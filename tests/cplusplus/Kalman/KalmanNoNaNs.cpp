@@ -41,11 +41,15 @@ inline void dumpKalmanDebugOuput(const char name[], const char expr[],
 #include <osvr/Kalman/PoseDampedConstantVelocity.h>
 #include <osvr/Kalman/AbsoluteOrientationMeasurement.h>
 #include <osvr/Kalman/AbsolutePositionMeasurement.h>
+#include <osvr/Kalman/AngularVelocityMeasurement.h>
+#include <osvr/Kalman/OrientationAndAngularVelocityMeasurement.h>
+#include <osvr/Kalman/LinearAccelerationInput.h>
 
 // Library/third-party includes
 #include "gtest/gtest.h"
 
 // Standard includes
+#include <cmath>
 #include <iostream>
 
 using ProcessModel = osvr::kalman::PoseConstantVelocityProcessModel;
@@ -54,6 +58,10 @@ using AbsoluteOrientationMeasurement =
     osvr::kalman::AbsoluteOrientationMeasurement<State>;
 using AbsolutePositionMeasurement =
     osvr::kalman::AbsolutePositionMeasurement<State>;
+using AngularVelocityMeasurement =
+    osvr::kalman::AngularVelocityMeasurement<State>;
+using OrientationAndAngularVelocityMeasurement =
+    osvr::kalman::OrientationAndAngularVelocityMeasurement<State>;
 using Filter = osvr::kalman::FlexibleKalmanFilter<ProcessModel>;
 
 class Stability : public ::testing::Test {
@@ -195,3 +203,113 @@ TYPED_TEST(VariedProcessModelStability, AbsolutePositionMeasurementXlate111) {
     this->filterAndCheckRepeatedly(filter, meas);
     /// @todo check that it's roughly identity orientation, position of 1, 1, 1
 }
+
+TYPED_TEST(VariedProcessModelStability,
+           IdentityOrientationAndAngularVelocityMeasurement) {
+    using Filter = osvr::kalman::FlexibleKalmanFilter<TypeParam>;
+
+    auto filter = Filter{};
+    auto meas = OrientationAndAngularVelocityMeasurement{
+        Eigen::Quaterniond::Identity(), Eigen::Vector3d::Constant(0.00001),
+        Eigen::Vector3d::Zero(), Eigen::Vector3d::Constant(1.0e-8)};
+    this->dumpInitialState(filter);
+    this->filterAndCheckRepeatedly(filter, meas);
+    /// @todo check that it's roughly identity
+}
+
+TEST(OrientationAndAngularVelocity, MatchesSequentialCorrections) {
+    /// Since the two halves of the measurement are independent, the joint
+    /// correction should match correcting with each half in turn.
+    const Eigen::Quaterniond quat(
+        Eigen::AngleAxisd(0.1, Eigen::Vector3d(1, 2, 3).normalized()));
+    const Eigen::Vector3d quatVar = Eigen::Vector3d::Constant(1.0e-5);
+    const Eigen::Vector3d angVel(0.5, -0.25, 1.);
+    const Eigen::Vector3d angVelVar = Eigen::Vector3d::Constant(1.0e-3);
+
+    auto jointFilter = Filter{};
+    jointFilter.predict(0.01);
+    auto sequentialFilter = jointFilter;
+
+    auto joint = OrientationAndAngularVelocityMeasurement{quat, quatVar, angVel,
+                                                          angVelVar};
+    jointFilter.correct(joint);
+
+    auto ori = AbsoluteOrientationMeasurement{quat, quatVar};
+    sequentialFilter.correct(ori);
+    auto vel = AngularVelocityMeasurement{angVel, angVelVar};
+    sequentialFilter.correct(vel);
+
+    ASSERT_TRUE(jointFilter.state().stateVector().isApprox(
+        sequentialFilter.state().stateVector(), 1.0e-6))
+        << "joint: " << jointFilter.state().stateVector().transpose()
+        << "\nsequential: "
+        << sequentialFilter.state().stateVector().transpose();
+    ASSERT_TRUE(jointFilter.state().getCombinedQuaternion().isApprox(
+        sequentialFilter.state().getCombinedQuaternion(), 1.0e-6));
+    ASSERT_TRUE(jointFilter.state().errorCovariance().isApprox(
+        sequentialFilter.state().errorCovariance(), 1.0e-6));
+}
+
+TEST(LinearAccelerationInput, ConstantAccelerationKinematics) {
+    const Eigen::Vector3d accel(1., -2., 0.5);
+    const double dt = 0.01;
+    const std::size_t steps = 100;
+    auto filter = Filter{};
+    for (std::size_t i = 0; i < steps; ++i) {
+        filter.predict(dt);
+        osvr::kalman::pose_externalized_rotation::applyLinearAcceleration(
+            filter.state(), accel, 1.0e-2, dt);
+        ASSERT_FALSE(stateContentsInvalid(filter.state()));
+        ASSERT_FALSE(covarianceContentsInvalid(filter.state()));
+    }
+    const double t = dt * steps;
+    ASSERT_TRUE(filter.state().position().isApprox(0.5 * t * t * accel, 1e-9))
+        << filter.state().position().transpose();
+    ASSERT_TRUE(filter.state().velocity().isApprox(t * accel, 1e-9))
+        << filter.state().velocity().transpose();
+}
+
+TEST(LinearAccelerationInput, ReducesDriftDuringPositionDropout) {
+    /// Track a body moving sinusoidally with position measurements, then
+    /// stop the measurements and see how far off each filter gets.
+    const double dt = 0.01;
+    const double amplitude = 0.1;
+    const double pi = 3.14159265358979323846;
+    const double omega = 2. * pi;
+    const std::size_t trackedSteps = 100;
+    const std::size_t dropoutSteps = 30;
+    auto truePosition = [&](double t) {
+        return Eigen::Vector3d(amplitude * std::sin(omega * t), 0, 0);
+    };
+    auto trueAccel = [&](double t) {
+        return Eigen::Vector3d(-amplitude * omega * omega * std::sin(omega * t),
+                               0, 0);
+    };
+
+    auto unaided = Filter{};
+    auto aided = Filter{};
+    for (std::size_t i = 1; i <= trackedSteps + dropoutSteps; ++i) {
+        const double t = dt * i;
+        unaided.predict(dt);
+        aided.predict(dt);
+        osvr::kalman::pose_externalized_rotation::applyLinearAcceleration(
+            aided.state(), trueAccel(t), 1.0e-2, dt);
+        if (i <= trackedSteps) {
+            auto meas = AbsolutePositionMeasurement{
+                truePosition(t), Eigen::Vector3d::Constant(1.0e-6)};
+            unaided.correct(meas);
+            aided.correct(meas);
+        }
+    }
+    const auto expected = truePosition(dt * (trackedSteps + dropoutSteps));
+    const double unaidedError = (unaided.state().position() - expected).norm();
+    const double aidedError = (aided.state().position() - expected).norm();
+    ASSERT_FALSE(stateContentsInvalid(aided.state()));
+    ASSERT_FALSE(covarianceContentsInvalid(aided.state()));
+    ASSERT_LT(aidedError, unaidedError)
+        << "Position error after dropout: unaided " << unaidedError
+        << " m, aided " << aidedError << " m";
+    ASSERT_LT(aidedError, 0.01) << "Position error after dropout: unaided "
+                                << unaidedError << " m, aided " << aidedError
+                                << " m";
+}
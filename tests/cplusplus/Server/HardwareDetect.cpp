@@ -0,0 +1,184 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "../../../src/osvr/Server/HardwareDetectWorker.h"
+#include "../../../src/osvr/Server/HardwareDetectWorker.cpp"
+#include <osvr/PluginHost/RegistrationContext.h>
+#include "../../../src/osvr/PluginHost/PluginSpecificRegistrationContextImpl.h"
+#include <osvr/PluginKit/PluginRegistration.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using osvr::pluginhost::RegistrationContext;
+using osvr::pluginhost::PluginSpecificRegistrationContext;
+using osvr::server::HardwareDetectWorker;
+using std::chrono::steady_clock;
+using std::chrono::milliseconds;
+
+/// Stands in for a plugin whose hardware probe is slow (enumerating buses,
+/// opening a camera...)
+class SlowProbe {
+  public:
+    SlowProbe(milliseconds probeTime) : m_probeTime(probeTime) {}
+    OSVR_ReturnCode probe() {
+        ++probes;
+        boost::this_thread::sleep_for(
+            boost::chrono::milliseconds(m_probeTime.count()));
+        return OSVR_RETURN_SUCCESS;
+    }
+    OSVR_ReturnCode operator()(OSVR_PluginRegContext) {
+        ++detects;
+        detectThread = boost::this_thread::get_id();
+        return OSVR_RETURN_SUCCESS;
+    }
+    std::atomic<int> probes{0};
+    std::atomic<int> detects{0};
+    boost::thread::id detectThread;
+
+  private:
+    milliseconds m_probeTime;
+};
+
+/// A plugin with an ordinary, synchronous detect callback.
+class SyncDetect {
+  public:
+    OSVR_ReturnCode operator()(OSVR_PluginRegContext) {
+        ++detects;
+        return OSVR_RETURN_SUCCESS;
+    }
+    int detects = 0;
+};
+
+class HardwareDetect : public ::testing::Test {
+  public:
+    /// Returns a non-owning pointer: the plugin owns the object.
+    template <typename T> T *addAsyncPlugin(std::string const &name, T *obj) {
+        auto plugin = PluginSpecificRegistrationContext::create(name);
+        osvr::pluginkit::registerAsyncHardwareDetectCallback(
+            plugin->extractOpaquePointer(), obj);
+        ctx.adoptPluginRegistrationContext(plugin);
+        return obj;
+    }
+    template <typename T> T *addSyncPlugin(std::string const &name, T *obj) {
+        auto plugin = PluginSpecificRegistrationContext::create(name);
+        osvr::pluginkit::registerHardwareDetectCallback(
+            plugin->extractOpaquePointer(), obj);
+        ctx.adoptPluginRegistrationContext(plugin);
+        return obj;
+    }
+    RegistrationContext ctx;
+};
+
+TEST_F(HardwareDetect, InlineTriggerRunsEverything) {
+    auto slow = addAsyncPlugin("org.osvr.test.slowprobe",
+                               new SlowProbe(milliseconds(1)));
+    auto sync = addSyncPlugin("org.osvr.test.syncdetect", new SyncDetect);
+    ctx.triggerHardwareDetect();
+    ASSERT_EQ(1, slow->probes);
+    ASSERT_EQ(1, slow->detects);
+    ASSERT_EQ(1, sync->detects);
+
+    ctx.triggerSynchronousHardwareDetect();
+    ASSERT_EQ(1, slow->probes);
+    ASSERT_EQ(2, sync->detects);
+    ASSERT_EQ(1u, ctx.getAsyncHardwareProbes().size());
+}
+
+TEST_F(HardwareDetect, MainLoopCadenceUnaffectedBySlowProbe) {
+    static const auto probeTime = milliseconds(300);
+    static const auto tick = milliseconds(2);
+    auto slow =
+        addAsyncPlugin("org.osvr.test.slowprobe", new SlowProbe(probeTime));
+    HardwareDetectWorker worker;
+
+    // Stand-in for the server main loop: "report" every tick, and trigger a
+    // detection (as a client connecting would) a few times along the way.
+    const auto mainThread = boost::this_thread::get_id();
+    auto start = steady_clock::now();
+    auto last = start;
+    auto maxGap = steady_clock::duration::zero();
+    // All well within the first probe.
+    std::vector<milliseconds> triggerTimes = {
+        milliseconds(0), milliseconds(50), milliseconds(100)};
+    while (steady_clock::now() - start < milliseconds(1000)) {
+        if (!triggerTimes.empty() &&
+            steady_clock::now() - start >= triggerTimes.front()) {
+            triggerTimes.erase(triggerTimes.begin());
+            worker.trigger(ctx.getAsyncHardwareProbes());
+        }
+        worker.runCompletions();
+        boost::this_thread::sleep_for(
+            boost::chrono::milliseconds(tick.count()));
+        auto now = steady_clock::now();
+        if (now - last > maxGap) {
+            maxGap = now - last;
+        }
+        last = now;
+    }
+    while (!worker.isIdle()) {
+        boost::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    }
+    worker.runCompletions();
+
+    // A report was never delayed by anything near the length of a probe.
+    ASSERT_LT(maxGap, probeTime / 3);
+
+    // The two triggers that arrived during the first pass became one more.
+    ASSERT_EQ(2u, worker.getPassCount());
+    ASSERT_EQ(1u, worker.getCoalescedCount());
+    ASSERT_EQ(2, slow->probes);
+
+    // Device creation happened back on the main loop.
+    ASSERT_EQ(2, slow->detects);
+    ASSERT_EQ(mainThread, slow->detectThread);
+}
+
+TEST_F(HardwareDetect, StopWaitsForProbeAndDropsCompletions) {
+    auto slow = addAsyncPlugin("org.osvr.test.slowprobe",
+                               new SlowProbe(milliseconds(100)));
+    HardwareDetectWorker worker;
+    worker.trigger(ctx.getAsyncHardwareProbes());
+    while (slow->probes == 0) {
+        boost::this_thread::yield();
+    }
+    worker.stop();
+    ASSERT_TRUE(worker.isIdle());
+    ASSERT_EQ(0u, worker.runCompletions());
+    ASSERT_EQ(0, slow->detects);
+
+    // Stopped for good.
+    worker.trigger(ctx.getAsyncHardwareProbes());
+    ASSERT_TRUE(worker.isIdle());
+    ASSERT_EQ(1, slow->probes);
+}
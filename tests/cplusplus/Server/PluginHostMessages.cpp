@@ -0,0 +1,122 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "../../../src/osvr/Server/PluginHostMessages.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <string>
+
+using osvr::common::SharedMemoryRing;
+using osvr::common::readExternalBuffer;
+using osvr::common::deserialize;
+namespace msgs = osvr::server::host_messages;
+
+namespace {
+/// Pops an entry, checking its type and deserializing its body.
+template <typename EntryType, typename MessageClass>
+inline void popEntry(SharedMemoryRing &ring, EntryType expectedType,
+                     MessageClass &msg) {
+    const char *data;
+    SharedMemoryRing::size_type len;
+    ASSERT_TRUE(ring.peek(data, len));
+    auto reader = readExternalBuffer(data, len);
+    msgs::EntryHeader header;
+    deserialize(reader, header);
+    ASSERT_EQ(static_cast<uint8_t>(expectedType), header.type);
+    deserialize(reader, msg);
+    ring.release();
+}
+} // namespace
+
+TEST(PluginHostMessages, RoundTrip) {
+    auto up = SharedMemoryRing::create(
+        msgs::getUpRingName("osvrTestPluginHost"), msgs::UP_RING_ENTRIES,
+        msgs::UP_RING_ENTRY_SIZE);
+    ASSERT_TRUE(up != nullptr);
+
+    msgs::DescriptorRecord descriptor;
+    descriptor.deviceName = "com_osvr_example_Crashing/CrashingDevice";
+    descriptor.descriptor = "{\"interfaces\": {\"analog\": {}}}";
+    ASSERT_TRUE(
+        msgs::pushEntry(*up, msgs::HostRecordType::Descriptor, descriptor));
+
+    msgs::ReportRecord report;
+    report.sender = descriptor.deviceName;
+    report.messageType = "vrpn_Analog Channel";
+    report.timestamp.seconds = 1234;
+    report.timestamp.microseconds = 5678;
+    report.sent.seconds = 1235;
+    report.sent.microseconds = 42;
+    report.classOfService = 1 << 2;
+    report.payload = std::string("\x00\x01\x02\x03", 4);
+    ASSERT_TRUE(msgs::pushEntry(*up, msgs::HostRecordType::Report, report));
+
+    msgs::HeartbeatRecord heartbeat;
+    heartbeat.sent = report.sent;
+    ASSERT_TRUE(
+        msgs::pushEntry(*up, msgs::HostRecordType::Heartbeat, heartbeat));
+
+    msgs::DescriptorRecord gotDescriptor;
+    popEntry(*up, msgs::HostRecordType::Descriptor, gotDescriptor);
+    ASSERT_EQ(descriptor.deviceName, gotDescriptor.deviceName);
+    ASSERT_EQ(descriptor.descriptor, gotDescriptor.descriptor);
+
+    msgs::ReportRecord gotReport;
+    popEntry(*up, msgs::HostRecordType::Report, gotReport);
+    ASSERT_EQ(report.sender, gotReport.sender);
+    ASSERT_EQ(report.messageType, gotReport.messageType);
+    ASSERT_EQ(1234, gotReport.timestamp.seconds);
+    ASSERT_EQ(5678, gotReport.timestamp.microseconds);
+    ASSERT_EQ(1235, gotReport.sent.seconds);
+    ASSERT_EQ(42, gotReport.sent.microseconds);
+    ASSERT_EQ(report.classOfService, gotReport.classOfService);
+    ASSERT_EQ(report.payload, gotReport.payload);
+
+    msgs::HeartbeatRecord gotHeartbeat;
+    popEntry(*up, msgs::HostRecordType::Heartbeat, gotHeartbeat);
+    ASSERT_EQ(1235, gotHeartbeat.sent.seconds);
+    ASSERT_EQ(0u, up->size());
+}
+
+TEST(PluginHostMessages, OversizedEntriesAreDropped) {
+    auto down = SharedMemoryRing::create(
+        msgs::getDownRingName("osvrTestPluginHost"), msgs::DOWN_RING_ENTRIES,
+        msgs::DOWN_RING_ENTRY_SIZE);
+    ASSERT_TRUE(down != nullptr);
+
+    msgs::ConfigureCommand configure;
+    configure.config.assign(msgs::DOWN_RING_ENTRY_SIZE, ' ');
+    ASSERT_FALSE(
+        msgs::pushEntry(*down, msgs::HostCommandType::Configure, configure));
+    ASSERT_EQ(1u, down->getDroppedCount());
+
+    ASSERT_TRUE(msgs::pushEntry(*down, msgs::HostCommandType::Ping));
+    msgs::EmptyMessage ping;
+    popEntry(*down, msgs::HostCommandType::Ping, ping);
+}
@@ -0,0 +1,148 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+
+// Internal Includes
+#include "../../../src/osvr/Server/PluginHostProxy.h"
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/ConnectionDevice.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/value.h>
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <chrono>
+#include <string>
+#include <thread>
+#include <tuple>
+
+using osvr::server::PluginHostProxy;
+using osvr::connection::Connection;
+using osvr::connection::ConnectionPtr;
+using osvr::connection::ConnectionDevicePtr;
+
+namespace {
+/// Name of the device created by the crashing example plugin.
+static const char DEVICE_NAME[] = "com_osvr_example_Crashing/CrashingDevice";
+/// The device crashes its host after running this long...
+static const double FAIL_AFTER_SECONDS = 1.;
+/// ...so this is plenty of time for it to start, crash and be restarted.
+static const std::chrono::seconds TEST_TIMEOUT(30);
+
+inline Json::Value makeHostConfig() {
+    Json::Value config(Json::objectValue);
+    config["plugins"].append("com_osvr_example_Crashing");
+    Json::Value driver(Json::objectValue);
+    driver["plugin"] = "com_osvr_example_Crashing";
+    driver["driver"] = "CrashingDevice";
+    driver["params"]["failAfter"] = FAIL_AFTER_SECONDS;
+    config["drivers"].append(driver);
+    return config;
+}
+
+/// Runs a real osvr_plugin_host (with the crashing example plugin) behind a
+/// loopback connection, counting the messages relayed from its device.
+class PluginHostRestart : public ::testing::Test {
+  public:
+    typedef std::chrono::steady_clock clock;
+    PluginHostRestart()
+        : conns(Connection::createLoopbackConnection()),
+          vrpnConn(*static_cast<vrpn_Connection *>(std::get<0>(conns))),
+          conn(std::get<1>(conns)),
+          sender(vrpnConn.register_sender(DEVICE_NAME)),
+          deadline(clock::now() + TEST_TIMEOUT) {
+        /// VRPN calls local handlers as messages are packed.
+        vrpnConn.register_handler(vrpn_ANY_TYPE, &handleMessage, this, sender);
+    }
+
+    ~PluginHostRestart() {
+        vrpnConn.unregister_handler(vrpn_ANY_TYPE, &handleMessage, this,
+                                    sender);
+    }
+
+    /// Finds the stand-in device on the connection, if it's been registered.
+    ConnectionDevicePtr findDevice() const {
+        ConnectionDevicePtr ret;
+        for (auto const &dev : conn->getDevices()) {
+            if (dev->getName() == DEVICE_NAME) {
+                EXPECT_FALSE(ret) << "Device registered more than once";
+                ret = dev;
+            }
+        }
+        return ret;
+    }
+
+    /// Updates the proxy until the predicate is true or the test times out.
+    /// @return the final value of the predicate.
+    template <typename F>
+    bool updateUntil(PluginHostProxy &proxy, F &&predicate) {
+        while (clock::now() < deadline) {
+            proxy.update();
+            if (predicate()) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return predicate();
+    }
+
+    std::tuple<void *, ConnectionPtr> conns;
+    vrpn_Connection &vrpnConn;
+    ConnectionPtr conn;
+    vrpn_int32 sender;
+    clock::time_point deadline;
+    std::size_t messages = 0;
+
+  private:
+    static int VRPN_CALLBACK handleMessage(void *userdata, vrpn_HANDLERPARAM) {
+        ++static_cast<PluginHostRestart *>(userdata)->messages;
+        return 0;
+    }
+};
+} // namespace
+
+TEST_F(PluginHostRestart, RestartsCrashedHostAndKeepsDevice) {
+    PluginHostProxy proxy("crashing", OSVR_PLUGIN_HOST_EXECUTABLE,
+                          makeHostConfig(), conn, vrpnConn);
+    ASSERT_EQ(1u, proxy.getStartCount());
+
+    ASSERT_TRUE(updateUntil(proxy, [&] { return findDevice() && messages; }))
+        << "Device never showed up and reported";
+    auto device = findDevice();
+
+    ASSERT_TRUE(updateUntil(proxy, [&] { return proxy.getStartCount() > 1; }))
+        << "Host was not restarted after crashing";
+
+    // The new host's reports come through the same stand-in device, which
+    // never went away.
+    ASSERT_EQ(device, findDevice());
+    auto messagesBeforeRestart = messages;
+    ASSERT_TRUE(
+        updateUntil(proxy, [&] { return messages > messagesBeforeRestart; }))
+        << "No reports after the restart";
+    ASSERT_EQ(device, findDevice());
+}
@@ -0,0 +1,179 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "BlobThresholdController.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+
+using osvr::vbtracker::BlobParams;
+using osvr::vbtracker::BlobThresholdController;
+using Adjustment = BlobThresholdController::Adjustment;
+
+namespace {
+inline BlobParams makeParams() {
+    BlobParams params;
+    params.adaptiveThreshold = true;
+    params.adaptiveMaxSpuriousBlobs = 20;
+    params.adaptiveMinIdentifiedBeacons = 4;
+    params.adaptiveTargetLostFrames = 10;
+    params.adaptiveHysteresisFrames = 5;
+    params.adaptiveThresholdStep = 4.;
+    params.adaptiveMinThresholdOffset = -12.;
+    params.adaptiveMaxThresholdOffset = 20.;
+    return params;
+}
+
+/// Feeds the same frame results a number of times.
+/// @return the number of times the offset changed.
+inline int repeat(BlobThresholdController &controller, int frames,
+                  std::size_t numBlobs, std::size_t numIdentified) {
+    int changes = 0;
+    for (int i = 0; i < frames; ++i) {
+        if (controller.update(numBlobs, numIdentified)) {
+            ++changes;
+        }
+    }
+    return changes;
+}
+} // namespace
+
+TEST(BlobThresholdController, HoldsWithinTargets) {
+    BlobThresholdController controller(makeParams());
+    ASSERT_EQ(0, repeat(controller, 100, 18, 8));
+    ASSERT_EQ(0., controller.getOffset());
+    ASSERT_EQ(Adjustment::Holding, controller.getAdjustment());
+    ASSERT_EQ(100u, controller.getFrameCount());
+    ASSERT_DOUBLE_EQ(18., controller.getMeanBlobsPerFrame());
+    ASSERT_DOUBLE_EQ(8., controller.getMeanIdentifiedPerFrame());
+}
+
+TEST(BlobThresholdController, RaisesAfterHysteresis) {
+    BlobThresholdController controller(makeParams());
+    ASSERT_EQ(0, repeat(controller, 4, 50, 8));
+    ASSERT_EQ(0., controller.getOffset());
+    ASSERT_EQ(Adjustment::Raising, controller.getAdjustment());
+    ASSERT_TRUE(controller.update(50, 8));
+    ASSERT_EQ(4., controller.getOffset());
+    ASSERT_EQ(1u, controller.getStepCount());
+}
+
+TEST(BlobThresholdController, InterruptedRunDoesNotStep) {
+    BlobThresholdController controller(makeParams());
+    ASSERT_EQ(0, repeat(controller, 4, 50, 8));
+    ASSERT_EQ(0, repeat(controller, 1, 10, 8));
+    ASSERT_EQ(0, repeat(controller, 4, 50, 8));
+    ASSERT_EQ(0., controller.getOffset());
+}
+
+TEST(BlobThresholdController, LowersWhenBeaconsAreMissing) {
+    BlobThresholdController controller(makeParams());
+    ASSERT_EQ(1, repeat(controller, 5, 2, 2));
+    ASSERT_EQ(-4., controller.getOffset());
+    ASSERT_EQ(Adjustment::Lowering, controller.getAdjustment());
+    // Clamped to the minimum offset.
+    ASSERT_EQ(2, repeat(controller, 50, 2, 2));
+    ASSERT_EQ(-12., controller.getOffset());
+}
+
+TEST(BlobThresholdController, DoesNotLowerIntoNoise) {
+    BlobThresholdController controller(makeParams());
+    // Beacons are missing, but there's already a fair amount of noise.
+    ASSERT_EQ(0, repeat(controller, 50, 15, 2));
+    ASSERT_EQ(0., controller.getOffset());
+    ASSERT_EQ(Adjustment::Holding, controller.getAdjustment());
+}
+
+TEST(BlobThresholdController, DoesNotLowerWithNoTargetInView) {
+    BlobThresholdController controller(makeParams());
+    // Out of view from the start: no blobs, nothing identified.
+    ASSERT_EQ(0, repeat(controller, 200, 0, 0));
+    ASSERT_EQ(0., controller.getOffset());
+    ASSERT_EQ(Adjustment::Holding, controller.getAdjustment());
+}
+
+TEST(BlobThresholdController, StopsLoweringOnceTargetIsLost) {
+    auto params = makeParams();
+    BlobThresholdController controller(params);
+    // In view and within targets, then out of view for a long time.
+    ASSERT_EQ(0, repeat(controller, 20, 10, 8));
+    repeat(controller, 200, 0, 0);
+    // At most the steps that fit in the frames right after it was last seen,
+    // nowhere near ratcheting down to the minimum.
+    auto maxSteps =
+        params.adaptiveTargetLostFrames / params.adaptiveHysteresisFrames;
+    ASSERT_GE(controller.getOffset(),
+              -maxSteps * params.adaptiveThresholdStep);
+    ASSERT_GT(controller.getOffset(), params.adaptiveMinThresholdOffset);
+    ASSERT_EQ(Adjustment::Holding, controller.getAdjustment());
+
+    // Back in view with too few beacons: lowering resumes.
+    auto offset = controller.getOffset();
+    ASSERT_EQ(1, repeat(controller, 5, 2, 2));
+    ASSERT_EQ(offset - params.adaptiveThresholdStep, controller.getOffset());
+}
+
+TEST(BlobThresholdController, ClampsAtMaximum) {
+    BlobThresholdController controller(makeParams());
+    ASSERT_EQ(5, repeat(controller, 100, 100, 0));
+    ASSERT_EQ(20., controller.getOffset());
+    ASSERT_EQ(5u, controller.getStepCount());
+}
+
+TEST(BlobThresholdController, SettlesUnderSimulatedAmbientLight) {
+    auto params = makeParams();
+    params.adaptiveMaxThresholdOffset = 100.;
+    BlobThresholdController controller(params);
+    // Ambient IR makes spurious blobs that fade as the threshold goes up,
+    // while the ten beacons stay visible until it's far too high.
+    auto spuriousAt = [](double offset) {
+        return static_cast<std::size_t>(std::max(0., 100. - 2. * offset));
+    };
+    auto beaconsAt = [](double offset) {
+        return offset <= 60. ? std::size_t{10} : std::size_t{0};
+    };
+    for (int frame = 0; frame < 300; ++frame) {
+        auto offset = controller.getOffset();
+        auto beacons = beaconsAt(offset);
+        controller.update(spuriousAt(offset) + beacons, beacons);
+    }
+    auto offset = controller.getOffset();
+    ASSERT_LE(spuriousAt(offset), 20u);
+    ASSERT_EQ(10u, beaconsAt(offset));
+    // And it stays put.
+    auto steps = controller.getStepCount();
+    for (int frame = 0; frame < 100; ++frame) {
+        auto beacons = beaconsAt(controller.getOffset());
+        controller.update(spuriousAt(controller.getOffset()) + beacons,
+                          beacons);
+    }
+    ASSERT_EQ(steps, controller.getStepCount());
+    ASSERT_EQ(Adjustment::Holding, controller.getAdjustment());
+}
@@ -0,0 +1,253 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "FrameGrabber.h"
+#include "ImageSources/ImageSource.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+using osvr::vbtracker::FrameGrabber;
+using osvr::vbtracker::FrameTimestampModel;
+using osvr::vbtracker::GrabbedFrame;
+using osvr::vbtracker::ImageSource;
+
+namespace {
+/// Produces small images whose pixels all hold the (low byte of the) frame
+/// number. The test decides when each frame arrives: grab() blocks until a
+/// frame is released (or the source is closed, which makes it fail).
+class SyntheticImageSource : public ImageSource {
+  public:
+    explicit SyntheticImageSource(bool ok = true) : m_ok(ok) {}
+    bool ok() const override { return m_ok; }
+    bool grab() override {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [&] { return m_released > m_grabbed || m_closed; });
+        if (m_closed) {
+            return false;
+        }
+        ++m_grabbed;
+        m_pixelValue = static_cast<double>(m_grabbed % 256);
+        return true;
+    }
+    /// Like real capture backends, writes into the existing buffers when
+    /// they're the right size.
+    void retrieve(cv::Mat &color, cv::Mat &gray) override {
+        retrieveColor(color);
+        gray.create(RES, CV_8UC1);
+        gray.setTo(cv::Scalar(m_pixelValue));
+    }
+    void retrieveColor(cv::Mat &color) override {
+        color.create(RES, CV_8UC3);
+        color.setTo(cv::Scalar::all(m_pixelValue));
+    }
+    cv::Size resolution() const override { return RES; }
+
+    /// Lets the next @p frames frames be grabbed.
+    void release(std::uint64_t frames) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_released += frames;
+        }
+        m_cv.notify_all();
+    }
+
+    /// Makes grab() fail from now on, so the grabber can be stopped.
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_cv.notify_all();
+    }
+
+  private:
+    static const cv::Size RES;
+    bool m_ok;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::uint64_t m_released = 0;
+    std::uint64_t m_grabbed = 0;
+    bool m_closed = false;
+    /// Only used by the grabbing thread.
+    double m_pixelValue = 0;
+};
+const cv::Size SyntheticImageSource::RES{8, 6};
+
+/// Reports, like a driver would, that each frame was captured well before
+/// grab() returned it.
+class DriverTimestampedImageSource : public SyntheticImageSource {
+  public:
+    static const double CAPTURE_AGE;
+    bool getGrabTimestamp(osvr::util::time::TimeValue &tv) const override {
+        tv = osvr::util::time::getNow();
+        osvr::util::time::TimeValue age = {};
+        age.microseconds =
+            static_cast<OSVR_TimeValue_Microseconds>(CAPTURE_AGE * 1e6);
+        osvrTimeValueDifference(&tv, &age);
+        return true;
+    }
+};
+const double DriverTimestampedImageSource::CAPTURE_AGE = 0.5;
+
+/// Counts the frames the grabber has made available, as its new-frame
+/// callback.
+class FrameCounter {
+  public:
+    FrameGrabber::Callback callback() {
+        return [&] {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_count;
+            }
+            m_cv.notify_all();
+        };
+    }
+    /// Blocks until the grabber has made @p count frames available in all.
+    void waitFor(std::uint64_t count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [&] { return m_count >= count; });
+    }
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::uint64_t m_count = 0;
+};
+
+/// A grabber running on a synthetic source, with the frames it has captured
+/// counted. Closes the source before stopping the grabber, so the grabbing
+/// thread isn't left waiting for a frame.
+struct SteppedGrabber {
+    explicit SteppedGrabber(SyntheticImageSource &src)
+        : source(src),
+          grabber(source, FrameTimestampModel{}, counter.callback()) {
+        grabber.start();
+    }
+    ~SteppedGrabber() {
+        source.close();
+        grabber.stop();
+    }
+    /// Lets @p frames more frames arrive, and waits until they've all been
+    /// captured.
+    void deliver(std::uint64_t frames) {
+        delivered += frames;
+        source.release(frames);
+        counter.waitFor(delivered);
+    }
+    SyntheticImageSource &source;
+    FrameCounter counter;
+    FrameGrabber grabber;
+    std::uint64_t delivered = 0;
+};
+} // namespace
+
+TEST(FrameGrabber, SkipsToNewestFrameWhenProcessingIsSlow) {
+    SyntheticImageSource source;
+    SteppedGrabber stepped(source);
+    auto &grabber = stepped.grabber;
+
+    /// Frames the camera delivers while each one is being processed.
+    static const std::uint64_t FRAMES_PER_STEP = 5;
+    static const int NUM_STEPS = 10;
+    GrabbedFrame frame;
+    stepped.deliver(FRAMES_PER_STEP);
+    for (int i = 0; i < NUM_STEPS; ++i) {
+        ASSERT_TRUE(grabber.waitForNewestFrame(frame));
+        // We get the newest frame, not the oldest one in a backlog.
+        ASSERT_EQ(stepped.delivered, frame.sequence);
+
+        // Image data belongs to this frame, not a later one captured into a
+        // recycled buffer.
+        ASSERT_EQ(frame.sequence % 256,
+                  frame.frameGray.at<unsigned char>(0, 0));
+
+        // "Process" the frame while more arrive.
+        stepped.deliver(FRAMES_PER_STEP);
+
+        // The image data we're holding on to must not have been overwritten
+        // while we worked.
+        ASSERT_EQ(frame.sequence % 256,
+                  frame.frameGray.at<unsigned char>(0, 0));
+    }
+
+    auto stats = grabber.getStats();
+    ASSERT_EQ(stepped.delivered, stats.captured);
+    ASSERT_EQ(0u, stats.grabFailures);
+    // Skipped frames are exactly those we never took: all but the one we
+    // took each step, and the newest, not yet taken.
+    ASSERT_EQ(stats.captured - NUM_STEPS - 1, stats.superseded);
+}
+
+TEST(FrameGrabber, FramesAreOnlyTakenOnce) {
+    SyntheticImageSource source;
+    SteppedGrabber stepped(source);
+    auto &grabber = stepped.grabber;
+    GrabbedFrame frame;
+    ASSERT_FALSE(grabber.takeNewestFrame(frame));
+    for (std::uint64_t i = 1; i <= 5; ++i) {
+        stepped.deliver(1);
+        ASSERT_TRUE(grabber.haveNewFrame());
+        ASSERT_TRUE(grabber.takeNewestFrame(frame));
+        ASSERT_EQ(i, frame.sequence);
+        ASSERT_FALSE(grabber.haveNewFrame());
+        ASSERT_FALSE(grabber.takeNewestFrame(frame));
+    }
+    ASSERT_EQ(0u, grabber.getStats().superseded);
+}
+
+TEST(FrameGrabber, UsesSourceTimestamps) {
+    DriverTimestampedImageSource source;
+    SteppedGrabber stepped(source);
+    stepped.deliver(1);
+    GrabbedFrame frame;
+    ASSERT_TRUE(stepped.grabber.takeNewestFrame(frame));
+    // The frame can only have gotten older since the grab.
+    auto age =
+        osvr::util::time::duration(osvr::util::time::getNow(), frame.tv);
+    ASSERT_GE(age, DriverTimestampedImageSource::CAPTURE_AGE);
+}
+
+TEST(FrameGrabber, StopWakesWaiter) {
+    // A camera that's not OK never delivers a frame.
+    SyntheticImageSource source{false};
+    FrameGrabber grabber(source, FrameTimestampModel{});
+    grabber.start();
+    GrabbedFrame frame;
+    std::thread waiter(
+        [&] { ASSERT_FALSE(grabber.waitForNewestFrame(frame)); });
+    // Whether or not the waiter has started waiting yet, it must not block
+    // forever.
+    grabber.stop();
+    waiter.join();
+}
@@ -0,0 +1,119 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "FrameTimestampModel.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cmath>
+#include <random>
+
+using osvr::vbtracker::FrameTimestampModel;
+using osvr::util::time::TimeValue;
+
+namespace {
+static const double PERIOD = 0.01;
+static const double LATENCY = 0.005;
+static const double MAX_JITTER = 0.004;
+
+inline TimeValue toTimeValue(double seconds) {
+    TimeValue ret;
+    ret.seconds = static_cast<OSVR_TimeValue_Seconds>(std::floor(seconds));
+    ret.microseconds = static_cast<OSVR_TimeValue_Microseconds>(
+        std::round((seconds - std::floor(seconds)) * 1e6));
+    return ret;
+}
+
+/// Simulates a 100 Hz camera whose frames are delivered after a constant
+/// latency plus uniformly-distributed jitter, with some frames dropped.
+class SimulatedCamera {
+  public:
+    SimulatedCamera(double dropProbability, unsigned seed = 1234)
+        : m_engine(seed), m_jitter(0., MAX_JITTER),
+          m_drop(dropProbability) {}
+
+    /// Advances to the next delivered frame.
+    void next() {
+        do {
+            ++m_frame;
+        } while (m_drop(m_engine));
+        m_delivery = exposureTime() + LATENCY + m_jitter(m_engine);
+    }
+    /// Middle of the exposure of the current frame.
+    double exposureTime() const { return START + m_frame * PERIOD; }
+    double deliveryTime() const { return m_delivery; }
+
+  private:
+    static const double START;
+    std::mt19937 m_engine;
+    std::uniform_real_distribution<double> m_jitter;
+    std::bernoulli_distribution m_drop;
+    long m_frame = 0;
+    double m_delivery = 0;
+};
+const double SimulatedCamera::START = 1000.;
+} // namespace
+
+TEST(FrameTimestampModel, WarmupIgnoresDroppedFrames) {
+    // Frames 3 and 7 are dropped: the intervals across them must not be
+    // averaged into the period as if they were single frames.
+    FrameTimestampModel model;
+    double t = 1000.;
+    for (int frame = 0; !model.havePeriod(); ++frame) {
+        t += (frame == 3 || frame == 7) ? 2 * PERIOD : PERIOD;
+        model(toTimeValue(t));
+    }
+    ASSERT_NEAR(PERIOD, model.getFramePeriod(), 1e-5);
+}
+
+TEST(FrameTimestampModel, RemovesJitterAndLatency) {
+    FrameTimestampModel model(LATENCY);
+    SimulatedCamera camera(0.05);
+    double rawError = 0;
+    double modelError = 0;
+    int samples = 0;
+    for (int i = 0; i < 2000; ++i) {
+        camera.next();
+        auto estimate = model(toTimeValue(camera.deliveryTime()));
+        // Let the frame clock settle before scoring.
+        if (i < 200) {
+            continue;
+        }
+        auto exposure = toTimeValue(camera.exposureTime());
+        auto delivery = toTimeValue(camera.deliveryTime());
+        rawError += std::abs(osvr::util::time::duration(delivery, exposure));
+        modelError +=
+            std::abs(osvr::util::time::duration(estimate, exposure));
+        ++samples;
+    }
+    rawError /= samples;
+    modelError /= samples;
+    ASSERT_NEAR(PERIOD, model.getFramePeriod(), 1e-4);
+    // Delivery time is off by the latency plus the mean jitter: about 7 ms.
+    ASSERT_NEAR(LATENCY + MAX_JITTER / 2, rawError, 5e-4);
+    ASSERT_LT(modelError, 5e-4) << "Mean absolute error " << modelError;
+}
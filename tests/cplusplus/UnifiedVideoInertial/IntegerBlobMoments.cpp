@@ -0,0 +1,262 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "IntegerBlobMoments.h"
+#include "SBDBlobExtractor.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using osvr::vbtracker::BlobMoments;
+using osvr::vbtracker::BlobParams;
+using osvr::vbtracker::IntegerBlobMoments;
+using osvr::vbtracker::LedMeasurement;
+using osvr::vbtracker::LedMeasurementVec;
+using osvr::vbtracker::SBDBlobExtractor;
+
+namespace {
+static const double PI = 3.14159265358979323846;
+static const int WIDTH = 320;
+static const int HEIGHT = 240;
+static const int BACKGROUND = 10;
+static const int PEAK = 240;
+
+/// Maximum distance between the centroids the two paths report for the
+/// same blob, in pixels. Both are quantized by the pixel grid differently:
+/// the SimpleBlobDetector path averages contour centroids over several
+/// thresholds, the integer path weights every pixel at one threshold.
+static const double MAX_CENTROID_DIFFERENCE = 0.5;
+
+/// Maximum difference in equivalent diameter (from the reported area),
+/// in pixels. The SimpleBlobDetector path measures the median distance to
+/// the contour, which runs through the centers of the boundary pixels, so
+/// it reads about one pixel smaller than the integer path's pixel count.
+static const double MAX_DIAMETER_DIFFERENCE = 1.5;
+
+enum class BlobShape { Disc, Gaussian };
+
+struct SyntheticBlob {
+    double x;
+    double y;
+    double radius;
+};
+
+/// A grid of blobs at assorted sub-pixel positions and sizes.
+inline std::vector<SyntheticBlob> makeBlobs() {
+    std::vector<SyntheticBlob> ret;
+    for (int j = 0; j < 6; ++j) {
+        for (int i = 0; i < 8; ++i) {
+            ret.push_back(SyntheticBlob{20 + i * 38 + 0.13 * i + 0.07 * j,
+                                        20 + j * 38 + 0.11 * j + 0.05 * i,
+                                        3. + (i + j) % 4});
+        }
+    }
+    return ret;
+}
+
+/// Draws the blobs: either flat discs (every threshold sees the same shape)
+/// or Gaussians with a standard deviation of half the radius (like LEDs).
+inline cv::Mat makeImage(std::vector<SyntheticBlob> const &blobs,
+                         BlobShape shape) {
+    cv::Mat img(HEIGHT, WIDTH, CV_8UC1, cv::Scalar(BACKGROUND));
+    for (auto const &blob : blobs) {
+        auto sigma = blob.radius / 2;
+        for (int y = static_cast<int>(blob.y) - 12;
+             y <= static_cast<int>(blob.y) + 12; ++y) {
+            for (int x = static_cast<int>(blob.x) - 12;
+                 x <= static_cast<int>(blob.x) + 12; ++x) {
+                auto dx = x - blob.x;
+                auto dy = y - blob.y;
+                auto distSq = dx * dx + dy * dy;
+                double value = BACKGROUND;
+                if (BlobShape::Disc == shape) {
+                    if (distSq <= blob.radius * blob.radius) {
+                        value = PEAK;
+                    }
+                } else {
+                    value += (PEAK - BACKGROUND) *
+                             std::exp(-distSq / (2 * sigma * sigma));
+                }
+                auto &pixel = img.at<unsigned char>(y, x);
+                pixel = static_cast<unsigned char>(
+                    std::max<long>(pixel, std::lround(value)));
+            }
+        }
+    }
+    return img;
+}
+
+inline BlobParams makeParams(bool integerMoments) {
+    BlobParams params;
+    // Compare localization only, not the shape filters only one path has.
+    params.filterByCircularity = false;
+    params.filterByConvexity = false;
+    params.useIntegerMoments = integerMoments;
+    return params;
+}
+
+inline double distance(cv::Point2f const &a, double x, double y) {
+    return std::hypot(a.x - x, a.y - y);
+}
+
+/// Finds the measurement closest to a location.
+inline LedMeasurement const &nearest(LedMeasurementVec const &measurements,
+                                     double x, double y) {
+    return *std::min_element(
+        measurements.begin(), measurements.end(),
+        [&](LedMeasurement const &a, LedMeasurement const &b) {
+            return distance(a.loc, x, y) < distance(b.loc, x, y);
+        });
+}
+
+inline double equivalentDiameter(LedMeasurement const &meas) {
+    return 2 * std::sqrt(meas.area / PI);
+}
+
+/// Extracts blobs with both paths, checks they found the same blobs at
+/// (nearly) the same places, and checks the integer path against the true
+/// centers.
+inline void compareToSimpleBlobDetector(BlobShape shape,
+                                        double maxIntegerError) {
+    auto blobs = makeBlobs();
+    auto img = makeImage(blobs, shape);
+
+    SBDBlobExtractor sbd(makeParams(false));
+    SBDBlobExtractor integer(makeParams(true));
+    auto const &sbdBlobs = sbd.extractBlobs(img);
+    auto const &integerBlobs = integer.extractBlobs(img);
+    ASSERT_EQ(blobs.size(), sbdBlobs.size());
+    ASSERT_EQ(blobs.size(), integerBlobs.size());
+
+    for (auto const &blob : blobs) {
+        auto const &sbdMeas = nearest(sbdBlobs, blob.x, blob.y);
+        auto const &integerMeas = nearest(integerBlobs, blob.x, blob.y);
+        EXPECT_LT(distance(integerMeas.loc, sbdMeas.loc.x, sbdMeas.loc.y),
+                  MAX_CENTROID_DIFFERENCE)
+            << "Blob at " << blob.x << ", " << blob.y << ": integer path "
+            << integerMeas.loc.x << ", " << integerMeas.loc.y
+            << ", SimpleBlobDetector path " << sbdMeas.loc.x << ", "
+            << sbdMeas.loc.y;
+        EXPECT_LT(distance(integerMeas.loc, blob.x, blob.y), maxIntegerError)
+            << "Blob at " << blob.x << ", " << blob.y << ": integer path "
+            << integerMeas.loc.x << ", " << integerMeas.loc.y;
+        if (BlobShape::Disc == shape) {
+            EXPECT_NEAR(equivalentDiameter(sbdMeas),
+                        equivalentDiameter(integerMeas),
+                        MAX_DIAMETER_DIFFERENCE)
+                << "Blob of radius " << blob.radius << " at " << blob.x
+                << ", " << blob.y;
+            // The pixel count of a disc is within 10% of its true area for
+            // these radii.
+            auto trueArea = PI * blob.radius * blob.radius;
+            EXPECT_NEAR(trueArea, integerMeas.area, 0.1 * trueArea)
+                << "Blob of radius " << blob.radius << " at " << blob.x
+                << ", " << blob.y;
+        }
+    }
+}
+} // namespace
+
+TEST(IntegerBlobMoments, DiscsMatchSimpleBlobDetector) {
+    // Flat discs quantize to the pixel grid, so the centroid of the
+    // pixels is only within about a quarter pixel of the true center.
+    compareToSimpleBlobDetector(BlobShape::Disc, 0.3);
+}
+
+TEST(IntegerBlobMoments, GaussiansMatchSimpleBlobDetector) {
+    // Intensity weighting recovers the center of a Gaussian closely.
+    compareToSimpleBlobDetector(BlobShape::Gaussian, 0.1);
+}
+
+namespace {
+/// A plain 8-bit image, for exercising IntegerBlobMoments directly.
+struct RawImage {
+    RawImage() : pixels(WIDTH * HEIGHT, BACKGROUND) {}
+    void fillRect(int x, int y, int w, int h) {
+        for (int row = y; row < y + h; ++row) {
+            for (int col = x; col < x + w; ++col) {
+                pixels[row * WIDTH + col] = PEAK;
+            }
+        }
+    }
+    void fillDisc(int cx, int cy, int radius) {
+        for (int row = cy - radius; row <= cy + radius; ++row) {
+            for (int col = cx - radius; col <= cx + radius; ++col) {
+                auto dx = col - cx;
+                auto dy = row - cy;
+                if (dx * dx + dy * dy <= radius * radius) {
+                    pixels[row * WIDTH + col] = PEAK;
+                }
+            }
+        }
+    }
+    std::vector<BlobMoments> extract() {
+        return moments(pixels.data(), WIDTH, HEIGHT, WIDTH, PEAK / 2);
+    }
+    std::vector<std::uint8_t> pixels;
+    IntegerBlobMoments moments;
+};
+} // namespace
+
+TEST(IntegerBlobMoments, CircularityFromMoments) {
+    RawImage img;
+    img.fillDisc(50, 50, 6);
+    img.fillRect(100, 50, 12, 1);
+    auto blobs = img.extract();
+    ASSERT_EQ(2u, blobs.size());
+    auto const &disc = blobs[0].x < blobs[1].x ? blobs[0] : blobs[1];
+    auto const &line = blobs[0].x < blobs[1].x ? blobs[1] : blobs[0];
+    EXPECT_GT(osvr::vbtracker::estimateCircularity(disc), 0.85);
+    EXPECT_LT(osvr::vbtracker::estimateCircularity(line), 0.3);
+}
+
+TEST(IntegerBlobMoments, MergesBlobsCloserThanMinDist) {
+    RawImage img;
+    // Two 2x2 squares, not 8-connected, with centers 4 pixels apart.
+    img.fillRect(10, 10, 2, 2);
+    img.fillRect(14, 10, 2, 2);
+    auto blobs = img.extract();
+    ASSERT_EQ(2u, blobs.size());
+
+    auto kept = blobs;
+    osvr::vbtracker::mergeNearbyBlobs(kept, 3.);
+    EXPECT_EQ(2u, kept.size());
+
+    osvr::vbtracker::mergeNearbyBlobs(blobs, 5.);
+    ASSERT_EQ(1u, blobs.size());
+    EXPECT_DOUBLE_EQ(12.5, blobs[0].x);
+    EXPECT_DOUBLE_EQ(10.5, blobs[0].y);
+    EXPECT_EQ(8u, blobs[0].area);
+    EXPECT_EQ(10, blobs[0].minX);
+    EXPECT_EQ(15, blobs[0].maxX);
+}
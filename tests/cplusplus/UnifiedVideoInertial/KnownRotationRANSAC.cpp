@@ -0,0 +1,214 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "KnownRotationRANSAC.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using osvr::vbtracker::KnownRotationRANSAC;
+
+namespace {
+static const double FOCAL_LENGTH = 700.;
+/// 8 pixels, as in the RANSAC pose estimator.
+static const double INLIER_THRESHOLD = 8. / FOCAL_LENGTH;
+static const double ONE_DEGREE = 3.14159265358979323846 / 180.;
+
+/// A target roughly the size of the HDK front panel, in meters.
+class SimulatedTarget {
+  public:
+    SimulatedTarget() : m_rng(1234) {
+        std::uniform_real_distribution<double> x(-0.08, 0.08);
+        std::uniform_real_distribution<double> y(-0.04, 0.04);
+        std::uniform_real_distribution<double> z(-0.02, 0.01);
+        for (int i = 0; i < 34; ++i) {
+            m_beacons.emplace_back(x(m_rng), y(m_rng), z(m_rng));
+        }
+    }
+
+    /// A random pose in front of the camera.
+    void randomPose(Eigen::Quaterniond &rot, Eigen::Vector3d &xlate) {
+        std::uniform_real_distribution<double> angle(-0.5, 0.5);
+        std::uniform_real_distribution<double> lateral(-0.2, 0.2);
+        std::uniform_real_distribution<double> depth(0.4, 1.2);
+        rot = Eigen::AngleAxisd(angle(m_rng), Eigen::Vector3d::UnitX()) *
+              Eigen::AngleAxisd(angle(m_rng), Eigen::Vector3d::UnitY()) *
+              Eigen::AngleAxisd(angle(m_rng), Eigen::Vector3d::UnitZ());
+        xlate = Eigen::Vector3d(lateral(m_rng), lateral(m_rng), depth(m_rng));
+    }
+
+    /// Perturbs a rotation by a random rotation of the given standard
+    /// deviation (radians), as an IMU orientation error.
+    Eigen::Quaterniond perturb(Eigen::Quaterniond const &rot, double sigma) {
+        std::normal_distribution<double> noise(0., sigma);
+        Eigen::Vector3d v(noise(m_rng), noise(m_rng), noise(m_rng));
+        if (v.norm() == 0) {
+            return rot;
+        }
+        return Eigen::Quaterniond(Eigen::AngleAxisd(v.norm(), v.normalized())) *
+               rot;
+    }
+
+    /// Picks numVisible distinct beacons and measures them, with Gaussian
+    /// pixel noise, optionally replacing one with a misidentified blob.
+    void observe(Eigen::Quaterniond const &rot, Eigen::Vector3d const &xlate,
+                 std::size_t numVisible, double pixelNoise, bool outlier,
+                 std::vector<Eigen::Vector3d> &normalized,
+                 std::vector<Eigen::Vector3d> &model) {
+        std::vector<std::size_t> ids(m_beacons.size());
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            ids[i] = i;
+        }
+        std::shuffle(ids.begin(), ids.end(), m_rng);
+        normalized.clear();
+        model.clear();
+        std::normal_distribution<double> noise(0., pixelNoise / FOCAL_LENGTH);
+        for (std::size_t i = 0; i < numVisible; ++i) {
+            auto const &beacon = m_beacons[ids[i]];
+            Eigen::Vector3d cam = rot * beacon + xlate;
+            normalized.emplace_back(cam.x() / cam.z() + noise(m_rng),
+                                    cam.y() / cam.z() + noise(m_rng), 1.);
+            model.push_back(beacon);
+        }
+        if (outlier) {
+            std::uniform_real_distribution<double> px(-0.4, 0.4);
+            normalized.front() = Eigen::Vector3d(px(m_rng), px(m_rng), 1.);
+        }
+    }
+
+  private:
+    std::mt19937 m_rng;
+    std::vector<Eigen::Vector3d> m_beacons;
+};
+} // namespace
+
+TEST(KnownRotationRANSAC, ExactFromTwoBeacons) {
+    SimulatedTarget target;
+    KnownRotationRANSAC ransac;
+    Eigen::Quaterniond rot;
+    Eigen::Vector3d xlate;
+    std::vector<Eigen::Vector3d> normalized, model;
+    for (int i = 0; i < 20; ++i) {
+        target.randomPose(rot, xlate);
+        target.observe(rot, xlate, 2, 0., false, normalized, model);
+        Eigen::Vector3d result;
+        std::vector<std::size_t> inliers;
+        ASSERT_TRUE(ransac(INLIER_THRESHOLD, rot, normalized, model, result,
+                           inliers));
+        EXPECT_EQ(2u, inliers.size());
+        EXPECT_LT((result - xlate).norm(), 1.e-9);
+    }
+}
+
+TEST(KnownRotationRANSAC, RejectsMisidentifiedBeacon) {
+    SimulatedTarget target;
+    KnownRotationRANSAC ransac;
+    Eigen::Quaterniond rot;
+    Eigen::Vector3d xlate;
+    std::vector<Eigen::Vector3d> normalized, model;
+    for (int i = 0; i < 20; ++i) {
+        target.randomPose(rot, xlate);
+        target.observe(rot, xlate, 5, 0.5, true, normalized, model);
+        Eigen::Vector3d result;
+        std::vector<std::size_t> inliers;
+        ASSERT_TRUE(ransac(INLIER_THRESHOLD, rot, normalized, model, result,
+                           inliers));
+        EXPECT_EQ(4u, inliers.size());
+        for (auto idx : inliers) {
+            EXPECT_NE(0u, idx) << "The misidentified beacon is an inlier";
+        }
+        EXPECT_LT((result - xlate).norm(), 0.01);
+    }
+}
+
+TEST(KnownRotationRANSAC, NoEstimateFromOneBeacon) {
+    SimulatedTarget target;
+    KnownRotationRANSAC ransac;
+    Eigen::Quaterniond rot;
+    Eigen::Vector3d xlate;
+    std::vector<Eigen::Vector3d> normalized, model;
+    target.randomPose(rot, xlate);
+    target.observe(rot, xlate, 1, 0., false, normalized, model);
+    Eigen::Vector3d result;
+    std::vector<std::size_t> inliers;
+    EXPECT_FALSE(
+        ransac(INLIER_THRESHOLD, rot, normalized, model, result, inliers));
+}
+
+/// Reacquisition success rate and time with few visible beacons, half a
+/// pixel of measurement noise, a degree of IMU orientation error, and (for
+/// three or more beacons) a misidentified beacon in a fifth of the frames.
+/// The 6-DoF PnP RANSAC needs at least four beacons, so it can't reacquire
+/// at all from two or three.
+TEST(KnownRotationRANSAC, ReacquisitionWithFewBeacons) {
+    static const int TRIALS = 2000;
+    /// Within 2cm is good enough to hand off to the Kalman filter.
+    static const double MAX_ERROR = 0.02;
+    SimulatedTarget target;
+    KnownRotationRANSAC ransac;
+    std::mt19937 rng(42);
+    std::bernoulli_distribution hasOutlier(0.2);
+    typedef std::chrono::steady_clock clock;
+    for (std::size_t numVisible = 2; numVisible <= 6; ++numVisible) {
+        int successes = 0;
+        clock::duration elapsed{};
+        Eigen::Quaterniond rot;
+        Eigen::Vector3d xlate;
+        std::vector<Eigen::Vector3d> normalized, model;
+        for (int i = 0; i < TRIALS; ++i) {
+            target.randomPose(rot, xlate);
+            target.observe(rot, xlate, numVisible, 0.5,
+                           numVisible >= 3 && hasOutlier(rng), normalized,
+                           model);
+            auto imuRot = target.perturb(rot, ONE_DEGREE);
+            Eigen::Vector3d result;
+            std::vector<std::size_t> inliers;
+            auto begin = clock::now();
+            auto ok = ransac(INLIER_THRESHOLD, imuRot, normalized, model,
+                             result, inliers);
+            elapsed += clock::now() - begin;
+            if (ok && (result - xlate).norm() < MAX_ERROR) {
+                ++successes;
+            }
+        }
+        auto rate = double(successes) / TRIALS;
+        std::cout << numVisible << " beacons: " << 100. * rate
+                  << "% reacquired within " << MAX_ERROR * 100. << "cm, "
+                  << std::chrono::duration<double, std::micro>(elapsed)
+                             .count() /
+                         TRIALS
+                  << "us per attempt" << std::endl;
+        /// Two beacons close together pin down depth poorly.
+        EXPECT_GT(rate, numVisible == 2 ? 0.7 : 0.85);
+    }
+}
@@ -0,0 +1,215 @@
+/** @file
+    @brief Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include "LED.h"
+#include "LedIdentifier.h"
+#include "PoseEstimator_RANSAC.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using osvr::vbtracker::Led;
+using osvr::vbtracker::LedIdentifier;
+using osvr::vbtracker::LedMeasurement;
+using osvr::vbtracker::ZeroBasedBeaconId;
+using osvr::vbtracker::BrightnessList;
+using osvr::vbtracker::BeaconData;
+using osvr::vbtracker::BeaconState;
+using osvr::vbtracker::BeaconStateVec;
+using osvr::vbtracker::CameraParameters;
+using osvr::vbtracker::LedPtrList;
+using osvr::vbtracker::RANSACPoseEstimator;
+
+namespace {
+/// Stands in for the blink code: reports whatever ID it's told to.
+class FakeIdentifier : public LedIdentifier {
+  public:
+    ZeroBasedBeaconId getId(ZeroBasedBeaconId, BrightnessList &brightnesses,
+                            bool &lastBright, bool) const override {
+        brightnesses.clear();
+        lastBright = false;
+        return ZeroBasedBeaconId(id);
+    }
+    int id = Led::SENTINEL_NO_IDENTIFIER_OBJECT_OR_INSUFFICIENT_DATA;
+};
+
+/// Avoids odr-using the in-class constant, which has no definition.
+inline std::uint8_t maxNovelty() { return Led::MAX_NOVELTY; }
+
+inline LedMeasurement makeMeasurement() {
+    LedMeasurement meas;
+    meas.loc = cv::Point2f(320.f, 240.f);
+    meas.imageSize = cv::Size(640, 480);
+    meas.brightness = 10.f;
+    meas.diameter = 4.f;
+    meas.area = 12.f;
+    return meas;
+}
+
+class ProvisionalLedId : public ::testing::Test {
+  public:
+    ProvisionalLedId() : led(&identifier, makeMeasurement()) {}
+    void addFrames(int n) {
+        for (int i = 0; i < n; ++i) {
+            led.addMeasurement(makeMeasurement(), false);
+        }
+    }
+    FakeIdentifier identifier;
+    Led led;
+};
+} // namespace
+
+TEST_F(ProvisionalLedId, StartsUnidentified) {
+    ASSERT_FALSE(led.identified());
+    ASSERT_FALSE(led.provisionallyIdentified());
+}
+
+TEST_F(ProvisionalLedId, ProvisionalIdIsUsedUntilBlinkCodeIsRead) {
+    led.setProvisionalID(ZeroBasedBeaconId(5));
+    addFrames(10);
+    ASSERT_TRUE(led.identified());
+    ASSERT_TRUE(led.provisionallyIdentified());
+    ASSERT_EQ(5, led.getID().value());
+    ASSERT_EQ(maxNovelty(), led.novelty())
+        << "Provisional IDs should stay fully novel";
+}
+
+TEST_F(ProvisionalLedId, ConfirmedByBlinkCode) {
+    led.setProvisionalID(ZeroBasedBeaconId(5));
+    addFrames(3);
+    identifier.id = 5;
+    addFrames(1);
+    ASSERT_TRUE(led.identified());
+    ASSERT_FALSE(led.provisionallyIdentified());
+    ASSERT_EQ(5, led.getID().value());
+    ASSERT_LT(led.novelty(), maxNovelty())
+        << "Confirmation isn't a new identification";
+}
+
+TEST_F(ProvisionalLedId, RevokedByDifferentBlinkCode) {
+    led.setProvisionalID(ZeroBasedBeaconId(5));
+    addFrames(3);
+    identifier.id = 7;
+    addFrames(1);
+    ASSERT_TRUE(led.identified());
+    ASSERT_FALSE(led.provisionallyIdentified());
+    ASSERT_EQ(7, led.getID().value());
+    ASSERT_EQ(maxNovelty(), led.novelty());
+}
+
+TEST_F(ProvisionalLedId, RevokedWhenBlinkCodeSaysNotABeacon) {
+    led.setProvisionalID(ZeroBasedBeaconId(5));
+    identifier.id =
+        Led::SENTINEL_NO_PATTERN_RECOGNIZED_DESPITE_SUFFICIENT_DATA;
+    addFrames(1);
+    ASSERT_FALSE(led.identified());
+    ASSERT_FALSE(led.provisionallyIdentified());
+}
+
+TEST_F(ProvisionalLedId, ClearedWhenMisidentified) {
+    led.setProvisionalID(ZeroBasedBeaconId(5));
+    led.markMisidentified();
+    ASSERT_FALSE(led.identified());
+    ASSERT_FALSE(led.provisionallyIdentified());
+}
+
+TEST_F(ProvisionalLedId, ClearedOnRequest) {
+    led.setProvisionalID(ZeroBasedBeaconId(5));
+    led.clearProvisionalID();
+    ASSERT_FALSE(led.identified());
+    addFrames(2);
+    ASSERT_FALSE(led.identified());
+}
+
+TEST(ProvisionalLedIdRANSAC, ProvisionalLedBeforeIdentifiedIsSkipped) {
+    static const double FOCAL_LENGTH = 700.;
+    CameraParameters cam(FOCAL_LENGTH, cv::Size(640, 480));
+    BeaconStateVec beacons;
+    beacons.emplace_back(new BeaconState(-0.05, -0.03, 0.));
+    beacons.emplace_back(new BeaconState(0.05, -0.03, 0.));
+    beacons.emplace_back(new BeaconState(0.05, 0.03, 0.));
+    beacons.emplace_back(new BeaconState(-0.05, 0.03, 0.));
+    std::vector<BeaconData> beaconDebug(beacons.size());
+    Eigen::Quaterniond rot = Eigen::Quaterniond::Identity();
+    Eigen::Vector3d xlate(0., 0., 0.5);
+
+    std::vector<std::unique_ptr<FakeIdentifier>> identifiers;
+    std::vector<std::unique_ptr<Led>> owned;
+    /// Where beacon i shows up, un-inverted the way the LED will invert it.
+    auto measure = [&](std::size_t i) {
+        Eigen::Vector3d p = rot * beacons[i]->stateVector() + xlate;
+        auto meas = makeMeasurement();
+        meas.loc = cv::Point2f(
+            static_cast<float>(meas.imageSize.width -
+                               (FOCAL_LENGTH * p.x() / p.z() + 320.)),
+            static_cast<float>(meas.imageSize.height -
+                               (FOCAL_LENGTH * p.y() / p.z() + 240.)));
+        return meas;
+    };
+
+    /// First the provisional one, claiming beacon 3 but seen somewhere else
+    /// entirely.
+    identifiers.emplace_back(new FakeIdentifier);
+    auto provisionalMeas = makeMeasurement();
+    provisionalMeas.loc = cv::Point2f(40.f, 40.f);
+    owned.emplace_back(new Led(identifiers.back().get(), provisionalMeas));
+    owned.back()->setProvisionalID(ZeroBasedBeaconId(3));
+
+    /// Then three identified by blink code: too few for the full PnP.
+    for (std::size_t i = 0; i < 3; ++i) {
+        identifiers.emplace_back(new FakeIdentifier);
+        identifiers.back()->id = static_cast<int>(i);
+        owned.emplace_back(new Led(identifiers.back().get(), measure(i)));
+    }
+
+    LedPtrList leds;
+    for (auto &led : owned) {
+        leds.push_back(led.get());
+    }
+    ASSERT_TRUE(leds.front()->provisionallyIdentified());
+    for (std::size_t i = 1; i < leds.size(); ++i) {
+        ASSERT_TRUE(leds[i]->identified());
+        ASSERT_FALSE(leds[i]->provisionallyIdentified());
+    }
+
+    RANSACPoseEstimator estimator;
+    Eigen::Vector3d outXlate;
+    Eigen::Quaterniond outQuat;
+    ASSERT_TRUE(
+        estimator(cam, leds, beacons, beaconDebug, outXlate, outQuat, &rot));
+    EXPECT_LT((outXlate - xlate).norm(), 0.001);
+    EXPECT_FALSE(leds.front()->wasUsedLastFrame())
+        << "Provisional LED marked as a RANSAC inlier";
+    for (std::size_t i = 1; i < leds.size(); ++i) {
+        EXPECT_TRUE(leds[i]->wasUsedLastFrame())
+            << "Identified LED " << i << " not marked as used";
+    }
+}
@@ -0,0 +1,133 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/TripleBuffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using osvr::util::TripleBuffer;
+
+TEST(TripleBuffer, nothingPublished) {
+    TripleBuffer<int> buf;
+    ASSERT_FALSE(buf.consume());
+    ASSERT_EQ(0, buf.getReadBuffer());
+}
+
+TEST(TripleBuffer, publishThenConsume) {
+    TripleBuffer<int> buf;
+    buf.getWriteBuffer() = 5;
+    buf.publish();
+    ASSERT_TRUE(buf.consume());
+    ASSERT_EQ(5, buf.getReadBuffer());
+    // Nothing new: keep the old value.
+    ASSERT_FALSE(buf.consume());
+    ASSERT_EQ(5, buf.getReadBuffer());
+}
+
+TEST(TripleBuffer, consumerGetsLatest) {
+    TripleBuffer<int> buf;
+    for (int i = 1; i <= 10; ++i) {
+        buf.getWriteBuffer() = i;
+        buf.publish();
+    }
+    ASSERT_TRUE(buf.consume());
+    ASSERT_EQ(10, buf.getReadBuffer());
+    ASSERT_FALSE(buf.consume());
+}
+
+TEST(TripleBuffer, interleaved) {
+    TripleBuffer<int> buf;
+    for (int i = 1; i <= 10; ++i) {
+        buf.getWriteBuffer() = i;
+        buf.publish();
+        ASSERT_TRUE(buf.consume());
+        ASSERT_EQ(i, buf.getReadBuffer());
+    }
+}
+
+namespace {
+/// Large enough that a torn read would be likely to show up.
+struct Payload {
+    std::uint64_t sequence = 0;
+    std::array<std::uint64_t, 63> copies{};
+};
+} // namespace
+
+TEST(TripleBuffer, concurrentNoTornValues) {
+    static const std::uint64_t ITERATIONS = 1000000;
+    TripleBuffer<Payload> buf;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        for (std::uint64_t i = 1; i <= ITERATIONS; ++i) {
+            auto &payload = buf.getWriteBuffer();
+            payload.sequence = i;
+            payload.copies.fill(i);
+            buf.publish();
+        }
+        done = true;
+    });
+
+    std::uint64_t lastSeen = 0;
+    std::uint64_t valuesSeen = 0;
+    std::uint64_t tornValues = 0;
+    std::uint64_t outOfOrder = 0;
+    auto check = [&] {
+        if (!buf.consume()) {
+            return;
+        }
+        auto const &payload = buf.getReadBuffer();
+        valuesSeen++;
+        for (auto copy : payload.copies) {
+            if (copy != payload.sequence) {
+                tornValues++;
+                break;
+            }
+        }
+        if (payload.sequence <= lastSeen) {
+            outOfOrder++;
+        }
+        lastSeen = payload.sequence;
+    };
+    while (!done) {
+        check();
+    }
+    writer.join();
+    // Pick up the final value.
+    check();
+
+    ASSERT_EQ(0u, tornValues);
+    ASSERT_EQ(0u, outOfOrder);
+    ASSERT_GT(valuesSeen, 0u);
+    ASSERT_EQ(ITERATIONS, lastSeen);
+}